@@ -99,6 +99,18 @@ ALWAYS_INLINE static int maskcount(i32x4 mask)
     return count_lut[maskbits(mask)];
 }
 
+ALWAYS_INLINE static u32 maskbits(i8x16 mask)
+{
+#if defined(__SSE2__)
+    return static_cast<u32>(__builtin_ia32_pmovmskb128((c8x16)mask));
+#else
+    u32 bits = 0;
+    for (int i = 0; i < 16; ++i)
+        bits |= static_cast<u32>((mask[i] & 0x80) >> 7) << i;
+    return bits;
+#endif
+}
+
 // Load / Store
 
 ALWAYS_INLINE static f32x4 load4(float const* a, float const* b, float const* c, float const* d)
@@ -11,6 +11,7 @@
 #include <Kernel/Arch/SafeMem.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Thread.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
@@ -36,6 +37,7 @@ void PageFault::handle(RegisterState& regs)
     if (current_thread) {
         current_thread->set_handling_page_fault(true);
         PerformanceManager::add_page_fault_event(*current_thread, regs);
+        Tracepoints::record(TracepointCategory::PageFault, Tracepoint::PageFault, fault_address, regs.ip());
     }
 
     ScopeGuard guard = [current_thread] {
@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+// Overflow sampling of hardware performance counters (PERF_EVENT_MASK_HARDWARE_COUNTERS).
+// Architectures or CPUs without a usable PMU report that they are unsupported, in which
+// case profiling falls back to the regular timer-based samples.
+bool arch_performance_counters_supported();
+ErrorOr<void> arch_enable_performance_counters(u64 event_mask);
+void arch_disable_performance_counters();
+
+}
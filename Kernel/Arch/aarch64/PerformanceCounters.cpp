@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Arch/PerformanceCounters.h>
+
+namespace Kernel {
+
+// FIXME: Implement sampling with the architectural performance monitors.
+bool arch_performance_counters_supported()
+{
+    return false;
+}
+
+ErrorOr<void> arch_enable_performance_counters(u64)
+{
+    return ENOTSUP;
+}
+
+void arch_disable_performance_counters()
+{
+}
+
+}
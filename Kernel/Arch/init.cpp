@@ -57,8 +57,8 @@
 #include <Kernel/Tasks/FinalizerTask.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
-#include <Kernel/Tasks/SyncTask.h>
 #include <Kernel/Tasks/WorkQueue.h>
+#include <Kernel/Tasks/WritebackTask.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/kstdio.h>
 
@@ -416,7 +416,7 @@ void init_stage2(void*)
     GraphicsManagement::the().initialize();
     ConsoleManagement::the().initialize();
 
-    SyncTask::spawn();
+    WritebackTask::spawn();
     FinalizerTask::spawn();
 
     auto boot_profiling = kernel_command_line().is_boot_profiling_enabled();
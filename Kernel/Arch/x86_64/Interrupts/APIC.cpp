@@ -25,6 +25,7 @@
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/Thread.h>
 
+#define IRQ_APIC_PERFORMANCE_COUNTER (0xfb - IRQ_VECTOR_BASE)
 #define IRQ_APIC_TIMER (0xfc - IRQ_VECTOR_BASE)
 #define IRQ_APIC_IPI (0xfd - IRQ_VECTOR_BASE)
 #define IRQ_APIC_ERR (0xfe - IRQ_VECTOR_BASE)
@@ -231,6 +232,23 @@ u8 APIC::spurious_interrupt_vector()
     return IRQ_APIC_SPURIOUS;
 }
 
+u8 APIC::performance_counter_interrupt_vector()
+{
+    return IRQ_APIC_PERFORMANCE_COUNTER;
+}
+
+void APIC::enable_performance_counter_interrupt()
+{
+    // NOTE: The local APIC masks this entry every time it delivers an interrupt,
+    //       so the interrupt handler has to call this again after each overflow.
+    write_register(APIC_REG_LVT_PERFORMANCE_COUNTER, APIC_LVT(IRQ_APIC_PERFORMANCE_COUNTER + IRQ_VECTOR_BASE, 0));
+}
+
+void APIC::disable_performance_counter_interrupt()
+{
+    write_register(APIC_REG_LVT_PERFORMANCE_COUNTER, APIC_LVT(0, 0) | APIC_LVT_MASKED);
+}
+
 #define APIC_INIT_VAR_PTR(tpe, vaddr, varname)                         \
     reinterpret_cast<tpe volatile*>(reinterpret_cast<ptrdiff_t>(vaddr) \
         + reinterpret_cast<ptrdiff_t>(&varname)                        \
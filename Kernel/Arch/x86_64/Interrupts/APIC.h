@@ -33,6 +33,9 @@ public:
     void broadcast_ipi();
     void send_ipi(u32 cpu);
     static u8 spurious_interrupt_vector();
+    static u8 performance_counter_interrupt_vector();
+    void enable_performance_counter_interrupt();
+    void disable_performance_counter_interrupt();
     Thread* get_idle_thread(u32 cpu) const;
     u32 enabled_processor_count() const { return m_processor_enabled_cnt; }
 
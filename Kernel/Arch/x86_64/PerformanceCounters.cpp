@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <Kernel/API/POSIX/serenity.h>
+#include <Kernel/Arch/PerformanceCounters.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Arch/RegisterState.h>
+#include <Kernel/Arch/x86_64/CPUID.h>
+#include <Kernel/Arch/x86_64/Interrupts/APIC.h>
+#include <Kernel/Arch/x86_64/MSR.h>
+#include <Kernel/Interrupts/GenericInterruptHandler.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
+#include <Kernel/Library/ScopedCritical.h>
+#include <Kernel/Locking/Spinlock.h>
+#include <Kernel/Tasks/PerformanceManager.h>
+#include <Kernel/Tasks/Thread.h>
+
+#define IA32_PMC0 0xc1
+#define IA32_PERFEVTSEL0 0x186
+#define IA32_PERF_GLOBAL_STATUS 0x38e
+#define IA32_PERF_GLOBAL_CTRL 0x38f
+#define IA32_PERF_GLOBAL_OVF_CTRL 0x390
+
+#define PERFEVTSEL_USR (1 << 16)
+#define PERFEVTSEL_OS (1 << 17)
+#define PERFEVTSEL_INT (1 << 20)
+#define PERFEVTSEL_EN (1 << 22)
+
+namespace Kernel {
+
+// Architectural performance events, see Intel SDM Vol. 3B, 20.2.1.2 "Pre-defined Architectural Performance Events".
+struct ArchitecturalEvent {
+    int perf_event_type;
+    u8 event_select;
+    u8 unit_mask;
+    u8 unavailable_bit; // Bit in CPUID.0AH:EBX that is set if this event is *not* available.
+    u64 sample_period;
+};
+
+static constexpr ArchitecturalEvent s_architectural_events[] = {
+    { PERF_EVENT_CPU_CYCLES, 0x3c, 0x00, 0, 1'000'000 },
+    { PERF_EVENT_INSTRUCTIONS, 0xc0, 0x00, 1, 1'000'000 },
+    { PERF_EVENT_CACHE_MISSES, 0x2e, 0x41, 4, 1'000 },
+    { PERF_EVENT_BRANCH_MISSES, 0xc5, 0x00, 6, 10'000 },
+};
+
+static constexpr size_t max_programmed_counters = array_size(s_architectural_events);
+
+struct PerformanceMonitoringUnit {
+    bool detected { false };
+    bool supported { false };
+    u8 general_purpose_counter_count { 0 };
+    u64 counter_mask { 0 };
+    u64 available_event_mask { 0 };
+};
+
+static PerformanceMonitoringUnit s_pmu;
+static Spinlock<LockRank::None> s_pmu_lock {};
+static u32 s_enable_count { 0 };
+static u64 s_enabled_event_mask { 0 };
+
+struct ProgrammedCounters {
+    // Which architectural event each general purpose counter is programmed with.
+    Array<ArchitecturalEvent const*, max_programmed_counters> events {};
+    size_t count { 0 };
+};
+
+// The assignment that is being programmed, protected by s_pmu_lock.
+static ProgrammedCounters s_programmed_counters;
+
+// NOTE: The overflow interrupt handler only looks at the copy of its own processor. That copy is only updated on
+//       the processor itself, with interrupts disabled and the counters stopped, so reprogramming can't race it.
+static Array<ProgrammedCounters, MAX_CPU_COUNT> s_programmed_counters_per_processor;
+
+class PerformanceCounterInterruptHandler final : public GenericInterruptHandler {
+public:
+    explicit PerformanceCounterInterruptHandler(u8 interrupt_vector)
+        : GenericInterruptHandler(interrupt_vector, true)
+    {
+    }
+
+    virtual bool handle_interrupt(RegisterState const&) override;
+
+    virtual bool eoi() override
+    {
+        APIC::the().eoi();
+        return true;
+    }
+
+    virtual HandlerType type() const override { return HandlerType::IRQHandler; }
+    virtual StringView purpose() const override { return "Performance Counter Overflow"sv; }
+    virtual StringView controller() const override { return {}; }
+
+    virtual size_t sharing_devices_count() const override { return 0; }
+    virtual bool is_shared_handler() const override { return false; }
+};
+
+static Atomic<PerformanceCounterInterruptHandler*> s_interrupt_handler;
+
+static void detect_performance_monitoring_unit()
+{
+    if (s_pmu.detected)
+        return;
+    s_pmu.detected = true;
+
+    if (CPUID(0).eax() < 0xa)
+        return;
+
+    CPUID leaf(0xa);
+    u8 version = leaf.eax() & 0xff;
+    u8 counter_count = (leaf.eax() >> 8) & 0xff;
+    u8 counter_width = (leaf.eax() >> 16) & 0xff;
+    u8 event_vector_length = (leaf.eax() >> 24) & 0xff;
+
+    // NOTE: We rely on the global control and overflow status MSRs, which were introduced in version 2.
+    //       AMD processors and most emulators (e.g. QEMU without KVM) report version 0 here.
+    if (version < 2 || counter_count == 0 || counter_width == 0) {
+        dmesgln("PMU: No usable architectural performance monitoring (version {}, {} counters)", version, counter_count);
+        return;
+    }
+
+    s_pmu.general_purpose_counter_count = counter_count;
+    s_pmu.counter_mask = counter_width >= 64 ? NumericLimits<u64>::max() : (1ull << counter_width) - 1;
+    for (auto const& event : s_architectural_events) {
+        if (event.unavailable_bit >= event_vector_length)
+            continue;
+        if ((leaf.ebx() & (1u << event.unavailable_bit)) != 0)
+            continue;
+        s_pmu.available_event_mask |= event.perf_event_type;
+    }
+    s_pmu.supported = s_pmu.available_event_mask != 0;
+    dmesgln("PMU: Architectural performance monitoring version {}, {} counters of {} bits", version, counter_count, counter_width);
+}
+
+static void rearm_counter(size_t index, ArchitecturalEvent const& event)
+{
+    MSR counter(IA32_PMC0 + index);
+    counter.set(-event.sample_period & s_pmu.counter_mask);
+}
+
+static void program_counters_on_current_processor()
+{
+    InterruptDisabler disabler;
+    APIC::the().disable_performance_counter_interrupt();
+
+    MSR global_control(IA32_PERF_GLOBAL_CTRL);
+    global_control.set(0);
+
+    for (size_t i = 0; i < s_pmu.general_purpose_counter_count; ++i) {
+        MSR event_select(IA32_PERFEVTSEL0 + i);
+        event_select.set(0);
+    }
+
+    auto& programmed_counters = s_programmed_counters_per_processor[Processor::current_id()];
+    programmed_counters = s_programmed_counters;
+    if (programmed_counters.count == 0)
+        return;
+
+    u64 enabled_counters = 0;
+    for (size_t i = 0; i < programmed_counters.count; ++i) {
+        auto const& event = *programmed_counters.events[i];
+        rearm_counter(i, event);
+        MSR event_select(IA32_PERFEVTSEL0 + i);
+        event_select.set(event.event_select | (event.unit_mask << 8) | PERFEVTSEL_USR | PERFEVTSEL_OS | PERFEVTSEL_INT | PERFEVTSEL_EN);
+        enabled_counters |= 1ull << i;
+    }
+
+    MSR overflow_control(IA32_PERF_GLOBAL_OVF_CTRL);
+    overflow_control.set(enabled_counters);
+    APIC::the().enable_performance_counter_interrupt();
+    global_control.set(enabled_counters);
+}
+
+static void program_counters_on_all_processors()
+{
+    ScopedCritical critical;
+    auto current_id = Processor::current_id();
+    for (u32 cpu = 0; cpu < Processor::count(); ++cpu) {
+        if (cpu == current_id)
+            continue;
+        Processor::smp_unicast(cpu, [] { program_counters_on_current_processor(); }, false);
+    }
+    program_counters_on_current_processor();
+}
+
+static void assign_counters(u64 event_mask)
+{
+    s_programmed_counters.count = 0;
+    for (auto const& event : s_architectural_events) {
+        if ((event_mask & event.perf_event_type) == 0)
+            continue;
+        if (s_programmed_counters.count == s_pmu.general_purpose_counter_count) {
+            dmesgln("PMU: Not enough counters to sample all requested events");
+            break;
+        }
+        s_programmed_counters.events[s_programmed_counters.count++] = &event;
+    }
+}
+
+bool arch_performance_counters_supported()
+{
+    SpinlockLocker locker(s_pmu_lock);
+    detect_performance_monitoring_unit();
+    return s_pmu.supported;
+}
+
+static ErrorOr<void> ensure_interrupt_handler()
+{
+    if (s_interrupt_handler.load(AK::memory_order_acquire))
+        return {};
+    auto* handler = new (nothrow) PerformanceCounterInterruptHandler(APIC::performance_counter_interrupt_vector());
+    if (!handler)
+        return ENOMEM;
+    PerformanceCounterInterruptHandler* expected = nullptr;
+    if (!s_interrupt_handler.compare_exchange_strong(expected, handler, AK::memory_order_acq_rel)) {
+        delete handler;
+        return {};
+    }
+    handler->register_interrupt_handler();
+    return {};
+}
+
+ErrorOr<void> arch_enable_performance_counters(u64 event_mask)
+{
+    event_mask &= PERF_EVENT_MASK_HARDWARE_COUNTERS;
+    if (!arch_performance_counters_supported())
+        return ENOTSUP;
+    TRY(ensure_interrupt_handler());
+
+    SpinlockLocker locker(s_pmu_lock);
+    if ((event_mask & ~s_pmu.available_event_mask) != 0)
+        return ENOTSUP;
+
+    ++s_enable_count;
+    // NOTE: Counters are shared by everyone profiling at the same time, so we sample the union of all requested events.
+    if ((s_enabled_event_mask | event_mask) != s_enabled_event_mask) {
+        s_enabled_event_mask |= event_mask;
+        assign_counters(s_enabled_event_mask);
+        program_counters_on_all_processors();
+    }
+    return {};
+}
+
+void arch_disable_performance_counters()
+{
+    SpinlockLocker locker(s_pmu_lock);
+    if (s_enable_count == 0 || --s_enable_count > 0)
+        return;
+    s_enabled_event_mask = 0;
+    s_programmed_counters.count = 0;
+    program_counters_on_all_processors();
+}
+
+bool PerformanceCounterInterruptHandler::handle_interrupt(RegisterState const& regs)
+{
+    MSR global_status(IA32_PERF_GLOBAL_STATUS);
+    auto status = global_status.get();
+
+    auto const& programmed_counters = s_programmed_counters_per_processor[Processor::current_id()];
+    auto* current_thread = Thread::current();
+    for (size_t i = 0; i < programmed_counters.count; ++i) {
+        if ((status & (1ull << i)) == 0)
+            continue;
+        auto const& event = *programmed_counters.events[i];
+        rearm_counter(i, event);
+        // FIXME: Like timer samples, we don't attribute anything to the idle thread yet.
+        if (current_thread && current_thread != Processor::idle_thread())
+            PerformanceManager::add_hardware_sample_event(*current_thread, regs, event.perf_event_type, event.sample_period);
+    }
+
+    MSR overflow_control(IA32_PERF_GLOBAL_OVF_CTRL);
+    overflow_control.set(status);
+    // NOTE: The counters may have been turned off while this interrupt was pending.
+    if (programmed_counters.count > 0)
+        APIC::the().enable_performance_counter_interrupt();
+    return true;
+}
+
+}
@@ -210,6 +210,11 @@ bool CommandLine::is_nvme_polling_enabled() const
     return contains("nvme_poll"sv);
 }
 
+bool CommandLine::is_ahci_polling_enabled() const
+{
+    return contains("ahci_poll"sv);
+}
+
 UNMAP_AFTER_INIT AcpiFeatureLevel CommandLine::acpi_feature_level() const
 {
     auto value = kernel_command_line().lookup("acpi"sv).value_or("limited"sv);
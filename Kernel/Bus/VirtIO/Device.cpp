@@ -52,10 +52,8 @@ ErrorOr<void> Device::accept_device_features(u64 device_features, u64 accepted_f
         accepted_features &= ~(VIRTIO_F_RING_PACKED);
     }
 
-    // TODO: implement indirect descriptors to allow queue_size buffers instead of buffers totalling (PAGE_SIZE * queue_size) bytes
-    if (is_feature_set(device_features, VIRTIO_F_INDIRECT_DESC)) {
-        // accepted_features |= VIRTIO_F_INDIRECT_DESC;
-    }
+    // NOTE: VIRTIO_F_INDIRECT_DESC is only accepted if the driver asked for it, as it has
+    //       to build the indirect descriptor tables itself (see BufferType::IndirectDescriptorTable).
 
     if (is_feature_set(device_features, VIRTIO_F_IN_ORDER)) {
         accepted_features |= VIRTIO_F_IN_ORDER;
@@ -144,13 +142,16 @@ bool Device::handle_irq(Badge<TransportInterruptHandler>)
     }
     if (isr_type & QUEUE_INTERRUPT) {
         dbgln_if(VIRTIO_DEBUG, "{}: VirtIO Queue interrupt!", class_name());
+        // NOTE: All queues share this interrupt, so more than one of them may have new buffers for us.
+        bool handled_any_queue = false;
         for (size_t i = 0; i < m_queues.size(); i++) {
             if (get_queue(i).new_data_available()) {
                 handle_queue_update(i);
-                return true;
+                handled_any_queue = true;
             }
         }
-        dbgln_if(VIRTIO_DEBUG, "{}: Got queue interrupt but all queues are up to date!", class_name());
+        if (!handled_any_queue)
+            dbgln_if(VIRTIO_DEBUG, "{}: Got queue interrupt but all queues are up to date!", class_name());
     }
     return true;
 }
@@ -16,6 +16,7 @@ class Device;
 class QueueChain;
 
 #define VIRTQ_DESC_F_NEXT 1
+#define VIRTQ_DESC_F_WRITE 2
 #define VIRTQ_DESC_F_INDIRECT 4
 
 #define VIRTQ_AVAIL_F_NO_INTERRUPT 1
@@ -23,9 +24,20 @@ class QueueChain;
 
 enum class BufferType {
     DeviceReadable = 0,
-    DeviceWritable = 2
+    DeviceWritable = VIRTQ_DESC_F_WRITE,
+    // Note: A table of IndirectDescriptors, only usable if VIRTIO_F_INDIRECT_DESC was negotiated.
+    IndirectDescriptorTable = VIRTQ_DESC_F_INDIRECT,
 };
 
+// An entry of an indirect descriptor table, which lets a whole buffer chain occupy a single descriptor of the queue.
+struct [[gnu::packed]] IndirectDescriptor {
+    u64 address;
+    u32 length;
+    u16 flags;
+    u16 next;
+};
+static_assert(AssertSize<IndirectDescriptor, 16>());
+
 class Queue {
 public:
     static ErrorOr<NonnullOwnPtr<Queue>> try_create(u16 queue_size, u16 notify_offset);
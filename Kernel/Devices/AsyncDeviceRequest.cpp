@@ -6,6 +6,7 @@
 
 #include <Kernel/Devices/AsyncDeviceRequest.h>
 #include <Kernel/Devices/Device.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
@@ -135,6 +136,8 @@ void AsyncDeviceRequest::complete(RequestResult result)
         VERIFY(m_result == Started);
         m_result = result;
     }
+    if (m_device.is_block_device())
+        Tracepoints::record(TracepointCategory::BlockIO, Tracepoint::BlockRequestComplete, bit_cast<FlatPtr>(this), result);
     if (Processor::current_in_irq()) {
         ref(); // Make sure we don't get freed
         Processor::deferred_call_queue([this]() {
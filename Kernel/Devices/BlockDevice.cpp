@@ -6,6 +6,7 @@
 
 #include <Kernel/Devices/BlockDevice.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/DeviceIdentifiers/BlockDevicesDirectory.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
@@ -22,6 +23,7 @@ AsyncBlockDeviceRequest::AsyncBlockDeviceRequest(Device& block_device, RequestTy
 
 void AsyncBlockDeviceRequest::start()
 {
+    Tracepoints::record(TracepointCategory::BlockIO, m_request_type == Write ? Tracepoint::BlockWriteStart : Tracepoint::BlockReadStart, bit_cast<FlatPtr>(this), m_block_count);
     m_block_device.start_request(*this);
 }
 
@@ -72,12 +72,29 @@ ErrorOr<NonnullRefPtr<OpenFileDescription>> Device::open(int options)
 void Device::process_next_queued_request(Badge<AsyncDeviceRequest>, AsyncDeviceRequest const& completed_request)
 {
     SpinlockLocker lock(m_requests_lock);
-    VERIFY(!m_requests.is_empty());
-    VERIFY(m_requests.first().ptr() == &completed_request);
-    m_requests.remove(m_requests.begin());
-    if (!m_requests.is_empty()) {
-        auto* next_request = m_requests.first().ptr();
-        next_request->do_start(move(lock));
+    VERIFY(m_requests_in_flight > 0);
+
+    // NOTE: Drivers that allow more than one request in flight may complete them out of order.
+    size_t index = 0;
+    auto it = m_requests.begin();
+    for (; it != m_requests.end(); ++it, ++index) {
+        if (it->ptr() == &completed_request)
+            break;
+    }
+    VERIFY(it != m_requests.end());
+    VERIFY(index < m_requests_in_flight);
+    m_requests.remove(it);
+    --m_requests_in_flight;
+
+    if (m_requests_in_flight < max_requests_in_flight()) {
+        auto next = m_requests.begin();
+        for (size_t i = 0; i < m_requests_in_flight && next != m_requests.end(); ++i)
+            ++next;
+        if (next != m_requests.end()) {
+            auto* next_request = next->ptr();
+            ++m_requests_in_flight;
+            next_request->do_start(move(lock));
+        }
     }
 
     evaluate_block_conditions();
@@ -56,13 +56,18 @@ public:
     {
         auto request = TRY(adopt_nonnull_lock_ref_or_enomem(new (nothrow) AsyncRequestType(*this, forward<Args>(args)...)));
         SpinlockLocker lock(m_requests_lock);
-        bool was_empty = m_requests.is_empty();
         TRY(m_requests.try_append(request));
-        if (was_empty)
+        if (m_requests_in_flight < max_requests_in_flight()) {
+            ++m_requests_in_flight;
             request->do_start(move(lock));
+        }
         return request;
     }
 
+    // The number of requests that may be handed to the driver before the previous ones completed.
+    // NOTE: This is called with the requests spinlock held, so it must not block.
+    virtual size_t max_requests_in_flight() const { return 1; }
+
 protected:
     Device(MajorNumber major, MinorNumber minor);
 
@@ -84,7 +89,10 @@ private:
     State m_state { State::Normal };
 
     Spinlock<LockRank::None> m_requests_lock {};
+    // NOTE: Requests are started in the order they were queued, so the first
+    //       m_requests_in_flight entries are always the ones that have been started.
     DoublyLinkedList<LockRefPtr<AsyncDeviceRequest>> m_requests;
+    size_t m_requests_in_flight { 0 };
 
 protected:
     // FIXME: This pointer will be eventually removed after all nodes in /sys/dev/block/ and
@@ -9,6 +9,7 @@
 
 #include <AK/Atomic.h>
 #include <Kernel/Arch/Delay.h>
+#include <Kernel/Boot/CommandLine.h>
 #include <Kernel/Devices/Storage/ATA/AHCI/Port.h>
 #include <Kernel/Devices/Storage/ATA/ATADiskDevice.h>
 #include <Kernel/Devices/Storage/ATA/Definitions.h>
@@ -21,6 +22,9 @@
 
 namespace Kernel {
 
+// Note: Requests are never larger than a page, so each command slot only needs a single DMA buffer page.
+static constexpr size_t dma_pages_per_command_slot = 1;
+
 UNMAP_AFTER_INIT ErrorOr<NonnullLockRefPtr<AHCIPort>> AHCIPort::create(AHCIController const& controller, AHCI::HBADefinedCapabilities hba_capabilities, volatile AHCI::PortRegisters& registers, u32 port_index)
 {
     auto identify_buffer_page = MUST(MM.allocate_physical_page());
@@ -38,13 +42,21 @@ ErrorOr<void> AHCIPort::allocate_resources_and_initialize_ports()
 
     m_fis_receive_page = TRY(MM.allocate_physical_page());
 
-    for (size_t index = 0; index < 1; index++) {
+    // Note: We don't know yet whether the attached device supports NCQ, but if the HBA does,
+    // allocate everything we need to use all of its command slots.
+    size_t command_slots_to_allocate = 1;
+    if (m_hba_capabilities.native_command_queuing_supported)
+        command_slots_to_allocate = min(m_hba_capabilities.max_command_list_entries_count, m_command_slots.size());
+
+    for (size_t index = 0; index < command_slots_to_allocate * dma_pages_per_command_slot; index++) {
         auto dma_page = TRY(MM.allocate_physical_page());
-        m_dma_buffers.append(move(dma_page));
+        TRY(m_dma_buffers.try_append(move(dma_page)));
     }
-    for (size_t index = 0; index < 1; index++) {
+    for (size_t index = 0; index < command_slots_to_allocate; index++) {
         auto command_table_page = TRY(MM.allocate_physical_page());
-        m_command_table_pages.append(move(command_table_page));
+        auto command_table_region = TRY(MM.allocate_kernel_region(command_table_page->paddr(), Memory::page_round_up(sizeof(AHCI::CommandTable)).value(), "AHCI Command Table"sv, Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No));
+        TRY(m_command_table_pages.try_append(move(command_table_page)));
+        TRY(m_command_table_regions.try_append(move(command_table_region)));
     }
 
     m_command_list_region = TRY(MM.allocate_dma_buffer_page("AHCI Port Command List"sv, Memory::Region::Access::ReadWrite, m_command_list_page));
@@ -56,7 +68,8 @@ ErrorOr<void> AHCIPort::allocate_resources_and_initialize_ports()
 }
 
 UNMAP_AFTER_INIT AHCIPort::AHCIPort(AHCIController const& controller, NonnullRefPtr<Memory::PhysicalPage> identify_buffer_page, AHCI::HBADefinedCapabilities hba_capabilities, volatile AHCI::PortRegisters& registers, u32 port_index)
-    : m_port_index(port_index)
+    : m_polling_enabled(kernel_command_line().is_ahci_polling_enabled())
+    , m_port_index(port_index)
     , m_hba_capabilities(hba_capabilities)
     , m_identify_buffer_page(move(identify_buffer_page))
     , m_port_registers(registers)
@@ -86,20 +99,14 @@ void AHCIPort::handle_interrupt()
             auto work_item_creation_result = g_io_work->try_queue([this]() {
                 m_connected_device.clear();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                fail_active_requests_later();
         } else {
             auto work_item_creation_result = g_io_work->try_queue([this]() {
                 reset();
             });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
-            }
+            if (work_item_creation_result.is_error())
+                fail_active_requests_later();
         }
         return;
     }
@@ -112,64 +119,133 @@ void AHCIPort::handle_interrupt()
         auto work_item_creation_result = g_io_work->try_queue([this]() {
             reset();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            fail_active_requests_later();
         return;
     }
     if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::IF) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::TFE) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBD) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::HBF)) {
         auto work_item_creation_result = g_io_work->try_queue([this]() {
             recover_from_fatal_error();
         });
-        if (work_item_creation_result.is_error()) {
-            auto current_request = m_current_request;
-            m_current_request.clear();
-            current_request->complete(AsyncDeviceRequest::OutOfMemory);
-        }
+        if (work_item_creation_result.is_error())
+            fail_active_requests_later();
         return;
     }
-    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS)) {
-        m_wait_for_completion = false;
-
-        // Now schedule reading/writing the buffer as soon as we leave the irq handler.
-        // This is important so that we can safely access the buffers, which could
-        // trigger page faults
-        if (!m_current_request) {
+    // Note: Non-queued commands complete with a D2H Register FIS, NCQ commands with a Set Device Bits FIS.
+    if (m_interrupt_status.is_set(AHCI::PortInterruptFlag::DHR) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::SDB) || m_interrupt_status.is_set(AHCI::PortInterruptFlag::PS)) {
+        if (m_active_command_slots.load() == 0) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled, probably identify request", representative_port_index());
         } else {
-            auto work_item_creation_result = g_io_work->try_queue([this]() {
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request handled", representative_port_index());
-                MutexLocker locker(m_lock);
-                VERIFY(m_current_request);
-                VERIFY(m_current_scatter_list);
-                if (!m_connected_device) {
-                    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                    complete_current_request(AsyncDeviceRequest::Failure);
-                    return;
-                }
-                if (m_current_request->request_type() == AsyncBlockDeviceRequest::Read) {
-                    if (auto result = m_current_request->write_to_buffer(m_current_request->buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * m_current_request->block_count()); result.is_error()) {
-                        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
-                        m_current_scatter_list = nullptr;
-                        complete_current_request(AsyncDeviceRequest::MemoryFault);
-                        return;
-                    }
+            schedule_completion_processing();
+        }
+    }
+
+    m_interrupt_status.clear();
+}
+
+void AHCIPort::schedule_completion_processing()
+{
+    // Note: If a work item is already pending it will pick up this completion as well,
+    // so a burst of interrupts results in a single pass over all finished command slots.
+    if (m_completion_processing_scheduled.exchange(true))
+        return;
+
+    // Now schedule reading/writing the buffers as soon as we leave the irq handler.
+    // This is important so that we can safely access the buffers, which could
+    // trigger page faults
+    auto work_item_creation_result = g_io_work->try_queue([this]() {
+        m_completion_processing_scheduled.store(false);
+        process_completed_commands();
+    });
+    if (work_item_creation_result.is_error()) {
+        // Note: We can't complete anything from the interrupt handler, as the command slots are protected by m_lock.
+        //       The next completion pass (from a later interrupt or the polling loop) will fail the requests.
+        m_completion_processing_scheduled.store(false);
+        m_should_fail_active_requests.store(true);
+    }
+}
+
+void AHCIPort::fail_active_requests_later()
+{
+    m_should_fail_active_requests.store(true);
+    schedule_completion_processing();
+}
+
+bool AHCIPort::process_completed_commands()
+{
+    struct CompletedRequest {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        AsyncDeviceRequest::RequestResult result;
+    };
+    Array<CompletedRequest, 32> completed_requests;
+    size_t completed_requests_count = 0;
+
+    {
+        MutexLocker locker(m_lock);
+        if (m_should_fail_active_requests.exchange(false)) {
+            for (auto& request : detach_all_active_requests())
+                completed_requests[completed_requests_count++] = { move(request), AsyncDeviceRequest::OutOfMemory };
+        }
+        u32 still_running = m_port_registers.ci | m_port_registers.sact;
+        u32 finished_command_slots = m_active_command_slots.load() & ~still_running;
+        for (u8 command_slot = 0; command_slot < m_command_slots_count; command_slot++) {
+            if (!(finished_command_slots & (1u << command_slot)))
+                continue;
+            auto& slot = m_command_slots[command_slot];
+            VERIFY(slot.request);
+            VERIFY(slot.scatter_list);
+            auto& request = *slot.request;
+            auto result = AsyncDeviceRequest::Success;
+            if (!m_connected_device) {
+                result = AsyncDeviceRequest::Failure;
+            } else if (request.request_type() == AsyncBlockDeviceRequest::Read) {
+                if (auto write_result = request.write_to_buffer(request.buffer(), slot.scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); write_result.is_error()) {
+                    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, memory fault occurred when reading in data.", representative_port_index());
+                    result = AsyncDeviceRequest::MemoryFault;
                 }
-                m_current_scatter_list = nullptr;
-                dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request success", representative_port_index());
-                complete_current_request(AsyncDeviceRequest::Success);
-            });
-            if (work_item_creation_result.is_error()) {
-                auto current_request = m_current_request;
-                m_current_request.clear();
-                current_request->complete(AsyncDeviceRequest::OutOfMemory);
             }
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request in command slot {} handled", representative_port_index(), command_slot);
+            completed_requests[completed_requests_count++] = { slot.request, result };
+            release_command_slot(command_slot);
         }
     }
 
-    m_interrupt_status.clear();
+    // Note: Completing a request may start the next queued one, which needs m_lock and a free command slot.
+    for (size_t index = 0; index < completed_requests_count; index++)
+        completed_requests[index].request->complete(completed_requests[index].result);
+    return completed_requests_count > 0;
+}
+
+void AHCIPort::poll_for_completions()
+{
+    VERIFY(m_polling_enabled);
+    while (true) {
+        // Note: Only one thread polls a port at a time, it reaps the commands submitted by everyone else too.
+        //       This also keeps us from recursing in here when completing a request starts the next one.
+        if (m_polling_in_progress.exchange(true))
+            return;
+        while (m_active_command_slots.load() != 0) {
+            if (!process_completed_commands())
+                microseconds_delay(1);
+        }
+        m_polling_in_progress.store(false);
+        // Note: Another thread may have submitted a command right before we stopped polling.
+        if (m_active_command_slots.load() == 0)
+            return;
+    }
+}
+
+Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32> AHCIPort::detach_all_active_requests()
+{
+    Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32> requests;
+    for (u8 command_slot = 0; command_slot < m_command_slots_count; command_slot++) {
+        auto request = m_command_slots[command_slot].request;
+        if (!request)
+            continue;
+        release_command_slot(command_slot);
+        requests.unchecked_append(move(request));
+    }
+    return requests;
 }
 
 bool AHCIPort::is_interrupts_enabled() const
@@ -179,32 +255,56 @@ bool AHCIPort::is_interrupts_enabled() const
 
 void AHCIPort::recover_from_fatal_error()
 {
-    MutexLocker locker(m_lock);
-    SpinlockLocker lock(m_hard_lock);
-    LockRefPtr<AHCIController> controller = m_parent_controller.strong_ref();
-    if (!controller) {
-        dmesgln("AHCI Port {}: fatal error, controller not available", representative_port_index());
-        return;
+    Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32> aborted_requests;
+    {
+        MutexLocker locker(m_lock);
+        SpinlockLocker lock(m_hard_lock);
+        LockRefPtr<AHCIController> controller = m_parent_controller.strong_ref();
+        if (!controller) {
+            dmesgln("AHCI Port {}: fatal error, controller not available", representative_port_index());
+            return;
+        }
+
+        dmesgln("{}: AHCI Port {} fatal error, restarting!", controller->device_identifier().address(), representative_port_index());
+        dmesgln("{}: AHCI Port {} fatal error, SError {}", controller->device_identifier().address(), representative_port_index(), (u32)m_port_registers.serr);
+        stop_command_list_processing();
+        stop_fis_receiving();
+        if (!reset_and_detach_active_requests(aborted_requests))
+            dmesgln("{}: AHCI Port {} could not be restarted after a fatal error", controller->device_identifier().address(), representative_port_index());
     }
 
-    dmesgln("{}: AHCI Port {} fatal error, shutting down!", controller->device_identifier().address(), representative_port_index());
-    dmesgln("{}: AHCI Port {} fatal error, SError {}", controller->device_identifier().address(), representative_port_index(), (u32)m_port_registers.serr);
-    stop_command_list_processing();
-    stop_fis_receiving();
-    m_interrupt_enable.clear();
+    // Note: Completing a request may start the next queued one, which needs m_lock and a running port.
+    for (auto& request : aborted_requests)
+        request->complete(AsyncDeviceRequest::Failure);
 }
 
 bool AHCIPort::reset()
 {
-    MutexLocker locker(m_lock);
-    SpinlockLocker lock(m_hard_lock);
+    Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32> aborted_requests;
+    bool reset_succeeded = false;
+    {
+        MutexLocker locker(m_lock);
+        SpinlockLocker lock(m_hard_lock);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Resetting", representative_port_index());
+        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Resetting", representative_port_index());
 
-    if (m_disabled_by_firmware) {
-        dmesgln("AHCI Port {}: Disabled by firmware ", representative_port_index());
-        return false;
+        if (m_disabled_by_firmware) {
+            dmesgln("AHCI Port {}: Disabled by firmware ", representative_port_index());
+            return false;
+        }
+        reset_succeeded = reset_and_detach_active_requests(aborted_requests);
     }
+
+    // Note: Completing a request may start the next queued one, which needs m_lock.
+    for (auto& request : aborted_requests)
+        request->complete(AsyncDeviceRequest::Failure);
+    return reset_succeeded;
+}
+
+bool AHCIPort::reset_and_detach_active_requests(Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32>& aborted_requests)
+{
+    VERIFY(m_lock.is_locked());
+    VERIFY(m_hard_lock.is_locked());
     full_memory_barrier();
     m_interrupt_enable.clear();
     m_interrupt_status.clear();
@@ -213,10 +313,15 @@ bool AHCIPort::reset()
     full_memory_barrier();
     clear_sata_error_register();
     full_memory_barrier();
-    if (!initiate_sata_reset()) {
-        return false;
-    }
-    return initialize();
+    bool reset_succeeded = initiate_sata_reset();
+
+    // Note: The COMRESET aborted every command that was still in flight, so none of them are going to complete.
+    // Take their requests out of the command slots before initializing the port again, as that issues
+    // an IDENTIFY command and may change the number of command slots.
+    aborted_requests = detach_all_active_requests();
+    if (reset_succeeded)
+        reset_succeeded = initialize();
+    return reset_succeeded;
 }
 
 UNMAP_AFTER_INIT bool AHCIPort::initialize_without_reset()
@@ -235,7 +340,7 @@ bool AHCIPort::initialize()
         // Note: If PHY is not enabled, just clear the interrupt status and enable interrupts, in case
         // we are going to hotplug a device later.
         m_interrupt_status.clear();
-        m_interrupt_enable.set_all();
+        enable_interrupts();
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Bailing initialization, Phy is not enabled.", representative_port_index());
         return false;
     }
@@ -246,7 +351,7 @@ bool AHCIPort::initialize()
     start_fis_receiving();
     set_active_state();
     m_interrupt_status.clear();
-    m_interrupt_enable.set_all();
+    enable_interrupts();
 
     full_memory_barrier();
     // This actually enables the port...
@@ -278,8 +383,11 @@ bool AHCIPort::initialize()
         if (is_atapi_attached()) {
             m_port_registers.cmd = m_port_registers.cmd | (1 << 24);
         }
+        configure_native_command_queuing(*identify_block);
 
         dmesgln("AHCI Port {}: Device found, Capacity={}, Bytes per logical sector={}, Bytes per physical sector={}", representative_port_index(), max_addressable_sector * logical_sector_size, logical_sector_size, physical_sector_size);
+        if (m_native_command_queuing_enabled)
+            dmesgln("AHCI Port {}: Native command queuing enabled, queue depth {}{}", representative_port_index(), m_command_slots_count, m_polling_enabled ? ", polling for completions"sv : ""sv);
 
         // FIXME: We don't support ATAPI devices yet, so for now we don't "create" them
         if (!is_atapi_attached()) {
@@ -289,6 +397,7 @@ bool AHCIPort::initialize()
                 return false;
             }
             m_connected_device = ATADiskDevice::create(*controller, { m_port_index, 0 }, 0, logical_sector_size, max_addressable_sector);
+            m_connected_device->set_max_requests_in_flight(m_command_slots_count);
         } else {
             dbgln("AHCI Port {}: Ignoring ATAPI devices as we don't support them.", representative_port_index());
         }
@@ -296,6 +405,37 @@ bool AHCIPort::initialize()
     return true;
 }
 
+void AHCIPort::configure_native_command_queuing(ATAIdentifyBlock const& identify_block)
+{
+    VERIFY(m_lock.is_locked());
+    m_native_command_queuing_enabled = false;
+    m_command_slots_count = 1;
+
+    // Note: Word 76 bit 8 indicates NCQ support, and word 75 holds the maximum queue depth minus one.
+    bool device_supports_native_command_queuing = identify_block.serial_ata_capabilities != 0xffff && (identify_block.serial_ata_capabilities & (1 << 8));
+    if (!m_hba_capabilities.native_command_queuing_supported || !device_supports_native_command_queuing || is_atapi_attached())
+        return;
+    size_t device_queue_depth = (identify_block.queue_depth & 0x1f) + 1;
+    size_t queue_depth = min(device_queue_depth, m_command_table_pages.size());
+    if (queue_depth < 2)
+        return;
+    m_native_command_queuing_enabled = true;
+    m_command_slots_count = queue_depth;
+}
+
+void AHCIPort::enable_interrupts()
+{
+    m_interrupt_enable.set_all();
+    if (!m_polling_enabled)
+        return;
+    // Note: In polling mode we only want to hear about errors and hotplug events,
+    // command completions are picked up by the submitting thread.
+    m_interrupt_enable.clear_at(AHCI::PortInterruptFlag::DHR);
+    m_interrupt_enable.clear_at(AHCI::PortInterruptFlag::SDB);
+    m_interrupt_enable.clear_at(AHCI::PortInterruptFlag::PS);
+    m_interrupt_enable.clear_at(AHCI::PortInterruptFlag::DS);
+}
+
 char const* AHCIPort::try_disambiguate_sata_status()
 {
     switch (m_port_registers.ssts & 0xf) {
@@ -415,25 +555,26 @@ size_t AHCIPort::calculate_descriptors_count(size_t block_count) const
 {
     VERIFY(m_connected_device);
     size_t needed_dma_regions_count = Memory::page_round_up((block_count * m_connected_device->block_size())).value() / PAGE_SIZE;
-    VERIFY(needed_dma_regions_count <= m_dma_buffers.size());
+    VERIFY(needed_dma_regions_count <= dma_pages_per_command_slot);
     return needed_dma_regions_count;
 }
 
-Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request)
+Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_list(u8 command_slot, AsyncBlockDeviceRequest& request)
 {
     VERIFY(m_lock.is_locked());
     VERIFY(request.block_count() > 0);
 
     Vector<NonnullRefPtr<Memory::PhysicalPage>> allocated_dma_regions;
     for (size_t index = 0; index < calculate_descriptors_count(request.block_count()); index++) {
-        allocated_dma_regions.append(m_dma_buffers.at(index));
+        allocated_dma_regions.append(m_dma_buffers.at(command_slot * dma_pages_per_command_slot + index));
     }
 
-    m_current_scatter_list = Memory::ScatterGatherList::try_create(request, allocated_dma_regions.span(), m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
-    if (!m_current_scatter_list)
+    auto& scatter_list = m_command_slots[command_slot].scatter_list;
+    scatter_list = Memory::ScatterGatherList::try_create(request, allocated_dma_regions.span(), m_connected_device->block_size(), "AHCI Scattered DMA"sv).release_value_but_fixme_should_propagate_errors();
+    if (!scatter_list)
         return AsyncDeviceRequest::Failure;
     if (request.request_type() == AsyncBlockDeviceRequest::Write) {
-        if (auto result = request.read_from_buffer(request.buffer(), m_current_scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
+        if (auto result = request.read_from_buffer(request.buffer(), scatter_list->dma_region().as_ptr(), m_connected_device->block_size() * request.block_count()); result.is_error()) {
             return AsyncDeviceRequest::MemoryFault;
         }
     }
@@ -442,36 +583,64 @@ Optional<AsyncDeviceRequest::RequestResult> AHCIPort::prepare_and_set_scatter_li
 
 void AHCIPort::start_request(AsyncBlockDeviceRequest& request)
 {
-    MutexLocker locker(m_lock);
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request start", representative_port_index());
-    VERIFY(!m_current_request);
-    VERIFY(!m_current_scatter_list);
+    {
+        MutexLocker locker(m_lock);
+        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request start", representative_port_index());
 
-    m_current_request = request;
+        if (!m_connected_device || !is_operable()) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure, port is not operable.", representative_port_index());
+            locker.unlock();
+            request.complete(AsyncDeviceRequest::Failure);
+            return;
+        }
 
-    auto result = prepare_and_set_scatter_list(request);
-    if (result.has_value()) {
-        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
-        locker.unlock();
-        complete_current_request(result.value());
-        return;
+        // Note: The device never hands us more requests than we have command slots for.
+        auto command_slot = try_to_allocate_command_slot();
+        VERIFY(command_slot.has_value());
+        m_command_slots[command_slot.value()].request = request;
+
+        auto result = prepare_and_set_scatter_list(command_slot.value(), request);
+        if (result.has_value()) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
+            release_command_slot(command_slot.value());
+            locker.unlock();
+            request.complete(result.value());
+            return;
+        }
+
+        auto success = access_device(command_slot.value(), request.request_type(), request.block_index(), request.block_count());
+        if (!success) {
+            dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
+            release_command_slot(command_slot.value());
+            locker.unlock();
+            request.complete(AsyncDeviceRequest::Failure);
+            return;
+        }
     }
 
-    auto success = access_device(request.request_type(), request.block_index(), request.block_count());
-    if (!success) {
-        dbgln_if(AHCI_DEBUG, "AHCI Port {}: Request failure.", representative_port_index());
-        locker.unlock();
-        complete_current_request(AsyncDeviceRequest::Failure);
-        return;
+    if (m_polling_enabled)
+        poll_for_completions();
+}
+
+Optional<u8> AHCIPort::try_to_allocate_command_slot()
+{
+    VERIFY(m_lock.is_locked());
+    u32 active_command_slots = m_active_command_slots.load();
+    for (u8 command_slot = 0; command_slot < m_command_slots_count; command_slot++) {
+        if (active_command_slots & (1u << command_slot))
+            continue;
+        m_active_command_slots.fetch_or(1u << command_slot);
+        return command_slot;
     }
+    return {};
 }
 
-void AHCIPort::complete_current_request(AsyncDeviceRequest::RequestResult result)
+void AHCIPort::release_command_slot(u8 command_slot)
 {
-    VERIFY(m_current_request);
-    auto current_request = m_current_request;
-    m_current_request.clear();
-    current_request->complete(result);
+    auto& slot = m_command_slots[command_slot];
+    slot.request.clear();
+    slot.scatter_list.clear();
+    m_active_command_slots.fetch_and(~(1u << command_slot));
 }
 
 bool AHCIPort::spin_until_ready() const
@@ -490,44 +659,44 @@ bool AHCIPort::spin_until_ready() const
     return true;
 }
 
-bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
+bool AHCIPort::access_device(u8 command_slot, AsyncBlockDeviceRequest::RequestType direction, u64 lba, u8 block_count)
 {
     VERIFY(m_connected_device);
     VERIFY(is_operable());
     VERIFY(m_lock.is_locked());
-    VERIFY(m_current_scatter_list);
+    auto& scatter_list = m_command_slots[command_slot].scatter_list;
+    VERIFY(scatter_list);
     SpinlockLocker lock(m_hard_lock);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count);
-    if (!spin_until_ready())
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {}, command slot {}", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, command_slot);
+
+    // Note: Queued commands may be issued while others are still in flight, non-queued ones
+    // (and the first queued one) have to wait until the device is no longer busy.
+    bool other_commands_in_flight = (m_active_command_slots.load() & ~(1u << command_slot)) != 0;
+    if (!other_commands_in_flight && !spin_until_ready())
         return false;
 
-    auto unused_command_header = try_to_find_unused_command_header();
-    VERIFY(unused_command_header.has_value());
     auto* command_list_entries = (volatile AHCI::CommandHeader*)m_command_list_region->vaddr().as_ptr();
-    command_list_entries[unused_command_header.value()].ctba = m_command_table_pages[unused_command_header.value()]->paddr().get();
-    command_list_entries[unused_command_header.value()].ctbau = 0;
-    command_list_entries[unused_command_header.value()].prdbc = 0;
-    command_list_entries[unused_command_header.value()].prdtl = m_current_scatter_list->scatters_count();
+    command_list_entries[command_slot].ctba = m_command_table_pages[command_slot]->paddr().get();
+    command_list_entries[command_slot].ctbau = 0;
+    command_list_entries[command_slot].prdbc = 0;
+    command_list_entries[command_slot].prdtl = scatter_list->scatters_count();
 
     // Note: we must set the correct Dword count in this register. Real hardware
     // AHCI controllers do care about this field! QEMU doesn't care if we don't
     // set the correct CFL field in this register, real hardware will set an
     // handshake error bit in PxSERR register if CFL is incorrect.
-    command_list_entries[unused_command_header.value()].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
-
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entries[unused_command_header.value()].ctba, (u32)command_list_entries[unused_command_header.value()].ctbau, (u32)command_list_entries[unused_command_header.value()].prdbc, (u16)command_list_entries[unused_command_header.value()].prdtl, (u16)command_list_entries[unused_command_header.value()].attributes);
+    command_list_entries[command_slot].attributes = (size_t)FIS::DwordCount::RegisterHostToDevice | AHCI::CommandHeaderAttributes::P | (is_atapi_attached() ? AHCI::CommandHeaderAttributes::A : 0) | (direction == AsyncBlockDeviceRequest::RequestType::Write ? AHCI::CommandHeaderAttributes::W : 0);
 
-    auto command_table_region = MM.allocate_kernel_region(m_command_table_pages[unused_command_header.value()]->paddr().page_base(), Memory::page_round_up(sizeof(AHCI::CommandTable)).value(), "AHCI Command Table"sv, Memory::Region::Access::ReadWrite, Memory::Region::Cacheable::No).release_value();
-    auto& command_table = *(volatile AHCI::CommandTable*)command_table_region->vaddr().as_ptr();
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: CLE: ctba={:#08x}, ctbau={:#08x}, prdbc={:#08x}, prdtl={:#04x}, attributes={:#04x}", representative_port_index(), (u32)command_list_entries[command_slot].ctba, (u32)command_list_entries[command_slot].ctbau, (u32)command_list_entries[command_slot].prdbc, (u16)command_list_entries[command_slot].prdtl, (u16)command_list_entries[command_slot].attributes);
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Allocated command table at {}", representative_port_index(), command_table_region->vaddr());
+    auto& command_table = *(volatile AHCI::CommandTable*)m_command_table_regions[command_slot]->vaddr().as_ptr();
 
     memset(const_cast<u8*>(command_table.command_fis), 0, 64);
 
     size_t scatter_entry_index = 0;
     size_t data_transfer_count = (block_count * m_connected_device->block_size());
-    for (auto scatter_page : m_current_scatter_list->vmobject().physical_pages()) {
+    for (auto scatter_page : scatter_list->vmobject().physical_pages()) {
         VERIFY(data_transfer_count != 0);
         VERIFY(scatter_page);
         dbgln_if(AHCI_DEBUG, "AHCI Port {}: Add a transfer scatter entry @ {}", representative_port_index(), scatter_page->paddr());
@@ -551,6 +720,11 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     if (is_atapi_attached()) {
         fis.command = ATA_CMD_PACKET;
         TODO();
+    } else if (m_native_command_queuing_enabled) {
+        if (direction == AsyncBlockDeviceRequest::RequestType::Write)
+            fis.command = ATA_CMD_WRITE_FPDMA_QUEUED;
+        else
+            fis.command = ATA_CMD_READ_FPDMA_QUEUED;
     } else {
         if (direction == AsyncBlockDeviceRequest::RequestType::Write)
             fis.command = ATA_CMD_WRITE_DMA_EXT;
@@ -569,17 +743,27 @@ bool AHCIPort::access_device(AsyncBlockDeviceRequest::RequestType direction, u64
     fis.lba_low[0] = lba & 0xff;
     fis.lba_low[1] = (lba >> 8) & 0xff;
     fis.lba_low[2] = (lba >> 16) & 0xff;
-    fis.count = (block_count);
+    if (m_native_command_queuing_enabled) {
+        // Note: For FPDMA QUEUED commands the sector count moves to the features field,
+        // and the count field carries the command tag in bits 7:3.
+        fis.features_low = block_count;
+        fis.features_high = 0;
+        fis.count = command_slot << 3;
+    } else {
+        fis.count = (block_count);
+    }
 
     // The below loop waits until the port is no longer busy before issuing a new command
-    if (!spin_until_ready())
+    if (!other_commands_in_flight && !spin_until_ready())
         return false;
 
     full_memory_barrier();
-    mark_command_header_ready_to_process(unused_command_header.value());
+    if (m_native_command_queuing_enabled)
+        m_port_registers.sact = 1u << command_slot;
+    mark_command_header_ready_to_process(command_slot);
     full_memory_barrier();
 
-    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[0]->paddr());
+    dbgln_if(AHCI_DEBUG, "AHCI Port {}: Do a {}, lba {}, block count {} @ {}, ended", representative_port_index(), direction == AsyncBlockDeviceRequest::RequestType::Write ? "write" : "read", lba, block_count, m_dma_buffers[command_slot * dma_pages_per_command_slot]->paddr());
     return true;
 }
 
@@ -656,7 +840,7 @@ bool AHCIPort::identify_device()
     // FIXME: Do that in a better way so we don't need to actually remember this every time
     // we need to do this.
     m_interrupt_status.clear();
-    m_interrupt_enable.set_all();
+    enable_interrupts();
 
     return success;
 }
@@ -684,8 +868,8 @@ bool AHCIPort::shutdown()
 Optional<u8> AHCIPort::try_to_find_unused_command_header()
 {
     VERIFY(m_lock.is_locked());
-    u32 commands_issued = m_port_registers.ci;
-    for (size_t index = 0; index < 32; index++) {
+    u32 commands_issued = m_port_registers.ci | m_port_registers.sact | m_active_command_slots.load();
+    for (size_t index = 0; index < m_command_table_pages.size(); index++) {
         if (!(commands_issued & 1)) {
             dbgln_if(AHCI_DEBUG, "AHCI Port {}: unused command header at index {}", representative_port_index(), index);
             return index;
@@ -709,8 +893,6 @@ void AHCIPort::mark_command_header_ready_to_process(u8 command_header_index) con
     VERIFY(m_lock.is_locked());
     VERIFY(m_hard_lock.is_locked());
     VERIFY(is_operable());
-    VERIFY(!m_wait_for_completion);
-    m_wait_for_completion = true;
     dbgln_if(AHCI_DEBUG, "AHCI Port {}: Marking command header at index {} as ready to process.", representative_port_index(), command_header_index);
     m_port_registers.ci = 1 << command_header_index;
 }
@@ -6,8 +6,11 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <Kernel/Devices/Device.h>
 #include <Kernel/Devices/Storage/ATA/AHCI/Definitions.h>
 #include <Kernel/Devices/Storage/ATA/AHCI/InterruptHandler.h>
@@ -43,6 +46,8 @@ public:
     u32 representative_port_index() const { return port_index() + 1; }
     bool is_operable() const;
     bool is_atapi_attached() const { return m_port_registers.sig == (u32)ATA::DeviceSignature::ATAPI; }
+    bool is_native_command_queuing_enabled() const { return m_native_command_queuing_enabled; }
+    size_t command_slots_count() const { return m_command_slots_count; }
 
     LockRefPtr<StorageDevice> connected_device() const { return m_connected_device; }
 
@@ -71,10 +76,20 @@ private:
     ALWAYS_INLINE void power_on() const;
 
     void start_request(AsyncBlockDeviceRequest&);
-    void complete_current_request(AsyncDeviceRequest::RequestResult);
-    bool access_device(AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
+    bool access_device(u8 command_slot, AsyncBlockDeviceRequest::RequestType, u64 lba, u8 block_count);
     size_t calculate_descriptors_count(size_t block_count) const;
-    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(AsyncBlockDeviceRequest& request);
+    [[nodiscard]] Optional<AsyncDeviceRequest::RequestResult> prepare_and_set_scatter_list(u8 command_slot, AsyncBlockDeviceRequest& request);
+    void release_command_slot(u8 command_slot);
+
+    void schedule_completion_processing();
+    bool process_completed_commands();
+    void poll_for_completions();
+    Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32> detach_all_active_requests();
+    void fail_active_requests_later();
+    bool reset_and_detach_active_requests(Vector<LockRefPtr<AsyncBlockDeviceRequest>, 32>&);
+
+    void configure_native_command_queuing(ATAIdentifyBlock const&);
+    void enable_interrupts();
 
     ALWAYS_INLINE bool is_interrupts_enabled() const;
 
@@ -95,6 +110,7 @@ private:
     void set_interface_state(AHCI::DeviceDetectionInitialization);
 
     Optional<u8> try_to_find_unused_command_header();
+    Optional<u8> try_to_allocate_command_slot();
 
     ALWAYS_INLINE bool is_interface_disabled() const { return (m_port_registers.ssts & 0xf) == 4; }
 
@@ -103,14 +119,31 @@ private:
     // Data members
 
     EntropySource m_entropy_source;
-    LockRefPtr<AsyncBlockDeviceRequest> m_current_request;
     Spinlock<LockRank::None> m_hard_lock {};
     Mutex m_lock { "AHCIPort"sv };
 
-    mutable bool m_wait_for_completion { false };
-
+    // Each command slot (command header and command table) carries at most one request.
+    // Without NCQ only one slot is ever used, as the device can only handle one non-queued command at a time.
+    struct CommandSlot {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        LockRefPtr<Memory::ScatterGatherList> scatter_list;
+    };
+    Array<CommandSlot, 32> m_command_slots;
+    // Note: Bits are only set and cleared with m_lock held, but the interrupt handler peeks at them.
+    Atomic<u32> m_active_command_slots { 0 };
+    size_t m_command_slots_count { 1 };
+    bool m_native_command_queuing_enabled { false };
+
+    bool const m_polling_enabled { false };
+    Atomic<bool> m_polling_in_progress { false };
+    Atomic<bool> m_completion_processing_scheduled { false };
+    Atomic<bool> m_should_fail_active_requests { false };
+
+    // Note: Every command slot gets its own DMA buffer and command table page, the
+    // command tables are mapped once so we don't have to allocate a kernel region per command.
     Vector<NonnullRefPtr<Memory::PhysicalPage>> m_dma_buffers;
     Vector<NonnullRefPtr<Memory::PhysicalPage>> m_command_table_pages;
+    Vector<NonnullOwnPtr<Memory::Region>> m_command_table_regions;
     RefPtr<Memory::PhysicalPage> m_command_list_page;
     OwnPtr<Memory::Region> m_command_list_region;
     RefPtr<Memory::PhysicalPage> m_fis_receive_page;
@@ -130,7 +163,6 @@ private:
     AHCI::PortInterruptStatusBitField m_interrupt_status;
     AHCI::PortInterruptEnableBitField m_interrupt_enable;
 
-    LockRefPtr<Memory::ScatterGatherList> m_current_scatter_list;
     bool m_disabled_by_firmware { false };
 };
 }
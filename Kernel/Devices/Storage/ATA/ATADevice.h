@@ -32,15 +32,22 @@ public:
     // ^BlockDevice
     virtual void start_request(AsyncBlockDeviceRequest&) override;
 
+    // ^Device
+    virtual size_t max_requests_in_flight() const override { return m_max_requests_in_flight; }
+
     u16 ata_capabilites() const { return m_capabilities; }
     Address const& ata_address() const { return m_ata_address; }
 
+    // Note: This is set by controllers that can queue more than one command (e.g. AHCI with NCQ).
+    void set_max_requests_in_flight(size_t count) { m_max_requests_in_flight = count; }
+
 protected:
     ATADevice(ATAController const&, Address, u16, u16, u64);
 
     LockWeakPtr<ATAController> m_controller;
     Address const m_ata_address;
     u16 const m_capabilities;
+    size_t m_max_requests_in_flight { 1 };
 };
 
 }
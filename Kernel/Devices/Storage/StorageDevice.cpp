@@ -77,6 +77,8 @@ StringView StorageDevice::command_set_to_string_view() const
         return "nvme"sv;
     case CommandSet::SD:
         return "sd"sv;
+    case CommandSet::VirtIO:
+        return "virtio"sv;
     default:
         break;
     }
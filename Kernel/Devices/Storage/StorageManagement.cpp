@@ -28,6 +28,7 @@
 #include <Kernel/Devices/Storage/SD/PCISDHostController.h>
 #include <Kernel/Devices/Storage/SD/SDHostController.h>
 #include <Kernel/Devices/Storage/StorageManagement.h>
+#include <Kernel/Devices/Storage/VirtIO/VirtIOBlockController.h>
 #include <Kernel/FileSystem/Ext2FS/FileSystem.h>
 #include <Kernel/FileSystem/VirtualFileSystem.h>
 #include <Kernel/Library/Panic.h>
@@ -45,6 +46,7 @@ static Atomic<u32> s_controller_id;
 static Atomic<u32> s_relative_ata_controller_id;
 static Atomic<u32> s_relative_nvme_controller_id;
 static Atomic<u32> s_relative_sd_controller_id;
+static Atomic<u32> s_relative_virtio_block_controller_id;
 
 static constexpr StringView partition_uuid_prefix = "PARTUUID:"sv;
 
@@ -55,6 +57,7 @@ static constexpr StringView ata_device_prefix = "ata"sv;
 static constexpr StringView nvme_device_prefix = "nvme"sv;
 static constexpr StringView logical_unit_number_device_prefix = "lun"sv;
 static constexpr StringView sd_device_prefix = "sd"sv;
+static constexpr StringView virtio_block_device_prefix = "virtio"sv;
 
 UNMAP_AFTER_INIT StorageManagement::StorageManagement()
 {
@@ -81,6 +84,13 @@ u32 StorageManagement::generate_relative_sd_controller_id(Badge<SDHostController
     return controller_id;
 }
 
+u32 StorageManagement::generate_relative_virtio_block_controller_id(Badge<VirtIOBlockController>)
+{
+    auto controller_id = s_relative_virtio_block_controller_id.load();
+    s_relative_virtio_block_controller_id++;
+    return controller_id;
+}
+
 void StorageManagement::add_device(StorageDevice& device)
 {
     m_storage_devices.append(device);
@@ -111,6 +121,14 @@ UNMAP_AFTER_INIT void StorageManagement::enumerate_pci_controllers(bool force_pi
         auto const& handle_mass_storage_device = [&](PCI::DeviceIdentifier const& device_identifier) {
             using SubclassID = PCI::MassStorage::SubclassID;
 
+            if (!kernel_command_line().disable_virtio() && MUST(VirtIOBlockController::probe(device_identifier))) {
+                if (auto controller_or_error = VirtIOBlockController::try_initialize(device_identifier); !controller_or_error.is_error())
+                    m_controllers.append(controller_or_error.release_value());
+                else
+                    dmesgln("Unable to initialize VirtIO block controller: {}", controller_or_error.error());
+                return;
+            }
+
             auto subclass_code = static_cast<SubclassID>(device_identifier.subclass_code().value());
 #if ARCH(X86_64)
             if (subclass_code == SubclassID::IDEController && kernel_command_line().is_ide_enabled()) {
@@ -345,6 +363,13 @@ UNMAP_AFTER_INIT void StorageManagement::determine_sd_boot_device()
     });
 }
 
+UNMAP_AFTER_INIT void StorageManagement::determine_virtio_block_boot_device()
+{
+    determine_hardware_relative_boot_device(virtio_block_device_prefix, [](StorageDevice const& device) -> bool {
+        return device.command_set() == StorageDevice::CommandSet::VirtIO;
+    });
+}
+
 UNMAP_AFTER_INIT void StorageManagement::determine_block_boot_device()
 {
     VERIFY(m_boot_argument.starts_with(block_device_prefix));
@@ -410,6 +435,11 @@ UNMAP_AFTER_INIT bool StorageManagement::determine_boot_device(StringView boot_a
         return m_boot_block_device;
     }
 
+    if (m_boot_argument.starts_with(virtio_block_device_prefix)) {
+        determine_virtio_block_boot_device();
+        return m_boot_block_device;
+    }
+
     if (m_boot_argument.starts_with(sd_device_prefix)) {
         determine_sd_boot_device();
         return m_boot_block_device;
@@ -20,6 +20,7 @@ namespace Kernel {
 
 class ATAController;
 class NVMeController;
+class VirtIOBlockController;
 class StorageManagement {
 
 public:
@@ -40,6 +41,7 @@ public:
     static u32 generate_relative_nvme_controller_id(Badge<NVMeController>);
     static u32 generate_relative_ata_controller_id(Badge<ATAController>);
     static u32 generate_relative_sd_controller_id(Badge<SDHostController>);
+    static u32 generate_relative_virtio_block_controller_id(Badge<VirtIOBlockController>);
 
     void add_device(StorageDevice&);
     void remove_device(StorageDevice&);
@@ -57,6 +59,7 @@ private:
     void determine_block_boot_device();
     void determine_nvme_boot_device();
     void determine_sd_boot_device();
+    void determine_virtio_block_boot_device();
     void determine_ata_boot_device();
     void determine_hardware_relative_boot_device(StringView relative_hardware_prefix, Function<bool(StorageDevice const&)> filter_device_callback);
     Array<unsigned, 3> extract_boot_device_address_parameters(StringView device_prefix);
@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <AK/Endian.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Bus/PCI/IDs.h>
+#include <Kernel/Bus/VirtIO/Transport/PCIe/TransportLink.h>
+#include <Kernel/Devices/Storage/StorageManagement.h>
+#include <Kernel/Devices/Storage/VirtIO/VirtIOBlockController.h>
+#include <Kernel/Tasks/WorkQueue.h>
+
+namespace Kernel {
+
+namespace VirtIO {
+
+// https://docs.oasis-open.org/virtio/virtio/v1.2/csd01/virtio-v1.2-csd01.html#x1-2740002
+
+static constexpr u64 VIRTIO_BLK_F_RO = (1ull << 5);       // Device is read-only.
+static constexpr u64 VIRTIO_BLK_F_BLK_SIZE = (1ull << 6); // Block size of disk is in blk_size.
+static constexpr u64 VIRTIO_BLK_F_MQ = (1ull << 12);      // Device supports multiqueue.
+
+static constexpr u32 VIRTIO_BLK_T_IN = 0;
+static constexpr u32 VIRTIO_BLK_T_OUT = 1;
+
+static constexpr u8 VIRTIO_BLK_S_OK = 0;
+
+// Note: The sector field of a request is always in units of 512 bytes, regardless of blk_size.
+static constexpr size_t VIRTIO_BLK_SECTOR_SIZE = 512;
+
+struct [[gnu::packed]] VirtIOBlockConfig {
+    LittleEndian<u64> capacity;
+    LittleEndian<u32> size_max;
+    LittleEndian<u32> seg_max;
+    LittleEndian<u16> geometry_cylinders;
+    u8 geometry_heads;
+    u8 geometry_sectors;
+    LittleEndian<u32> blk_size;
+    u8 topology_physical_block_exp;
+    u8 topology_alignment_offset;
+    LittleEndian<u16> topology_min_io_size;
+    LittleEndian<u32> topology_opt_io_size;
+    u8 writeback;
+    u8 unused0;
+    LittleEndian<u16> num_queues;
+};
+
+struct [[gnu::packed]] VirtIOBlockRequestHeader {
+    LittleEndian<u32> type;
+    LittleEndian<u32> reserved;
+    LittleEndian<u64> sector;
+};
+
+// Everything the device needs to know about a request, apart from its data, lives in one control block per tag.
+struct [[gnu::packed]] VirtIOBlockControlBlock {
+    IndirectDescriptor descriptors[3];
+    VirtIOBlockRequestHeader header;
+    u8 status;
+};
+
+}
+
+using namespace VirtIO;
+
+static constexpr size_t control_block_stride = 128;
+static_assert(sizeof(VirtIOBlockControlBlock) <= control_block_stride);
+
+UNMAP_AFTER_INIT ErrorOr<bool> VirtIOBlockController::probe(PCI::DeviceIdentifier const& pci_device_identifier)
+{
+    if (pci_device_identifier.hardware_id().vendor_id != PCI::VendorID::VirtIO)
+        return false;
+    if (pci_device_identifier.hardware_id().device_id != PCI::DeviceID::VirtIOBlockDevice)
+        return false;
+    return true;
+}
+
+UNMAP_AFTER_INIT ErrorOr<NonnullRefPtr<VirtIOBlockController>> VirtIOBlockController::try_initialize(PCI::DeviceIdentifier const& pci_device_identifier)
+{
+    auto pci_transport_link = TRY(VirtIO::PCIeTransportLink::create(pci_device_identifier));
+    auto controller = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) VirtIOBlockController(move(pci_transport_link), StorageManagement::generate_relative_virtio_block_controller_id({}))));
+    TRY(controller->initialize());
+    return controller;
+}
+
+UNMAP_AFTER_INIT VirtIOBlockController::VirtIOBlockController(NonnullOwnPtr<VirtIO::TransportEntity> pci_transport_link, u32 hardware_relative_controller_id)
+    : StorageController(hardware_relative_controller_id)
+    , VirtIO::Device(move(pci_transport_link))
+{
+}
+
+UNMAP_AFTER_INIT ErrorOr<void> VirtIOBlockController::initialize()
+{
+    TRY(initialize_virtio_resources());
+
+    auto max_addressable_block = (m_capacity_in_sectors * VIRTIO_BLK_SECTOR_SIZE / m_block_size) - 1;
+    m_device = TRY(VirtIOBlockDevice::try_create(*this, m_block_size, max_addressable_block, max_requests_in_flight()));
+    dmesgln("VirtIOBlockController: {} blocks of {} bytes, {} queue(s) of {} requests{}{}", max_addressable_block + 1, m_block_size,
+        m_request_queues.size(), m_tags_per_queue,
+        m_indirect_descriptors_enabled ? ", indirect descriptors"sv : ""sv,
+        m_read_only ? ", read-only"sv : ""sv);
+    return {};
+}
+
+UNMAP_AFTER_INIT ErrorOr<void> VirtIOBlockController::initialize_virtio_resources()
+{
+    dbgln_if(VIRTIO_DEBUG, "VirtIOBlockController: initialize_virtio_resources");
+    TRY(Device::initialize_virtio_resources());
+    m_device_config = TRY(transport_entity().get_config(VirtIO::ConfigurationType::Device));
+
+    // NOTE: We deliberately don't negotiate VIRTIO_BLK_F_FLUSH. The block layer has no way to ask for a flush, and
+    //       without that feature the device has to keep its cache in writethrough mode, so a write is durable
+    //       (and ordered against later writes) once it completes.
+    //       VIRTIO_BLK_F_SIZE_MAX and VIRTIO_BLK_F_SEG_MAX don't matter to us either, as every request carries
+    //       a single data segment of at most one page.
+    TRY(negotiate_features([&](u64 supported_features) {
+        u64 negotiated = 0;
+        if (is_feature_set(supported_features, VIRTIO_BLK_F_BLK_SIZE))
+            negotiated |= VIRTIO_BLK_F_BLK_SIZE;
+        if (is_feature_set(supported_features, VIRTIO_BLK_F_RO))
+            negotiated |= VIRTIO_BLK_F_RO;
+        if (is_feature_set(supported_features, VIRTIO_BLK_F_MQ))
+            negotiated |= VIRTIO_BLK_F_MQ;
+        if (is_feature_set(supported_features, VIRTIO_F_INDIRECT_DESC))
+            negotiated |= VIRTIO_F_INDIRECT_DESC;
+        return negotiated;
+    }));
+    m_indirect_descriptors_enabled = is_feature_accepted(VIRTIO_F_INDIRECT_DESC);
+    m_read_only = is_feature_accepted(VIRTIO_BLK_F_RO);
+
+    TRY(handle_device_config_change());
+    if (m_capacity_in_sectors == 0)
+        return ENODEV;
+    if (m_block_size < VIRTIO_BLK_SECTOR_SIZE || m_block_size > PAGE_SIZE || !is_power_of_two(m_block_size))
+        return ENOTSUP;
+
+    // NOTE: Ideally every processor submits to its own queue, so we never ask for more queues than we have processors.
+    u16 queue_count = 1;
+    if (is_feature_accepted(VIRTIO_BLK_F_MQ)) {
+        u16 device_queue_count = 0;
+        transport_entity().read_config_atomic([&]() {
+            device_queue_count = transport_entity().config_read16(*m_device_config, offsetof(VirtIOBlockConfig, num_queues));
+        });
+        queue_count = clamp<u16>(device_queue_count, 1, Processor::count());
+    }
+    TRY(setup_queues(queue_count));
+    TRY(allocate_request_queues(queue_count));
+
+    finish_init();
+    return {};
+}
+
+UNMAP_AFTER_INIT ErrorOr<void> VirtIOBlockController::allocate_request_queues(u16 queue_count)
+{
+    static_assert(max_tags_per_queue * control_block_stride <= PAGE_SIZE);
+
+    // Without indirect descriptors every request occupies three descriptors (header, data and status) of the queue.
+    size_t descriptors_per_request = m_indirect_descriptors_enabled ? 1 : 3;
+    m_tags_per_queue = max_tags_per_queue;
+    for (u16 queue_index = 0; queue_index < queue_count; ++queue_index)
+        m_tags_per_queue = min(m_tags_per_queue, get_queue(queue_index).size() / descriptors_per_request);
+    if (m_tags_per_queue == 0)
+        return ENOTSUP;
+
+    for (u16 queue_index = 0; queue_index < queue_count; ++queue_index) {
+        auto request_queue = TRY(adopt_nonnull_own_or_enomem(new (nothrow) RequestQueue));
+        request_queue->control_region = TRY(MM.allocate_dma_buffer_page("VirtIOBlockController Control Blocks"sv, Memory::Region::Access::ReadWrite));
+        request_queue->data_region = TRY(MM.allocate_dma_buffer_pages(m_tags_per_queue * PAGE_SIZE, "VirtIOBlockController Data Buffers"sv, Memory::Region::Access::ReadWrite));
+        request_queue->free_tags = m_tags_per_queue == 32 ? NumericLimits<u32>::max() : (1u << m_tags_per_queue) - 1;
+        TRY(m_request_queues.try_append(move(request_queue)));
+    }
+    return {};
+}
+
+LockRefPtr<StorageDevice> VirtIOBlockController::device(u32 index) const
+{
+    if (index != 0)
+        return {};
+    return m_device;
+}
+
+ErrorOr<void> VirtIOBlockController::handle_device_config_change()
+{
+    dbgln_if(VIRTIO_DEBUG, "VirtIOBlockController: handle_device_config_change");
+    transport_entity().read_config_atomic([&]() {
+        // NOTE: There is no 64-bit configuration access, so the capacity is read in two halves.
+        u64 capacity_low = transport_entity().config_read32(*m_device_config, offsetof(VirtIOBlockConfig, capacity));
+        u64 capacity_high = transport_entity().config_read32(*m_device_config, offsetof(VirtIOBlockConfig, capacity) + 4);
+        m_capacity_in_sectors = (capacity_high << 32) | capacity_low;
+        if (is_feature_accepted(VIRTIO_BLK_F_BLK_SIZE))
+            m_block_size = transport_entity().config_read32(*m_device_config, offsetof(VirtIOBlockConfig, blk_size));
+    });
+    // FIXME: Propagate capacity changes (e.g. after a disk was resized on the host) to the StorageDevice.
+    return {};
+}
+
+static PhysicalAddress control_block_address(Memory::Region const& control_region, u8 tag)
+{
+    return control_region.physical_page(0)->paddr().offset(tag * control_block_stride);
+}
+
+static VirtIOBlockControlBlock& control_block(Memory::Region& control_region, u8 tag)
+{
+    return *reinterpret_cast<VirtIOBlockControlBlock*>(control_region.vaddr().offset(tag * control_block_stride).as_ptr());
+}
+
+Optional<u8> VirtIOBlockController::try_to_allocate_tag(u16 queue_index)
+{
+    auto& request_queue = *m_request_queues[queue_index];
+    SpinlockLocker locker(get_queue(queue_index).lock());
+    if (request_queue.free_tags == 0)
+        return {};
+    u8 tag = count_trailing_zeroes(request_queue.free_tags);
+    request_queue.free_tags &= ~(1u << tag);
+    return tag;
+}
+
+void VirtIOBlockController::release_tag(u16 queue_index, u8 tag)
+{
+    auto& request_queue = *m_request_queues[queue_index];
+    VERIFY(get_queue(queue_index).lock().is_locked());
+    VERIFY(!(request_queue.free_tags & (1u << tag)));
+    request_queue.requests[tag] = nullptr;
+    request_queue.free_tags |= 1u << tag;
+}
+
+void VirtIOBlockController::start_request(AsyncBlockDeviceRequest& request)
+{
+    bool is_read = request.request_type() == AsyncBlockDeviceRequest::Read;
+    if (!is_read && m_read_only) {
+        request.complete(AsyncDeviceRequest::Failure);
+        return;
+    }
+    // TODO: For now we support only IO transfers of size PAGE_SIZE (Going along with the current constraint in the block layer).
+    VERIFY(request.block_count() * m_block_size <= PAGE_SIZE);
+
+    // Note: Prefer the queue of the current processor, so concurrent submitters don't contend on the same queue lock.
+    u16 queue_count = m_request_queues.size();
+    u16 preferred_queue_index = Processor::current_id() % queue_count;
+    Optional<u8> tag;
+    u16 queue_index = preferred_queue_index;
+    for (u16 attempt = 0; attempt < queue_count; ++attempt) {
+        queue_index = (preferred_queue_index + attempt) % queue_count;
+        tag = try_to_allocate_tag(queue_index);
+        if (tag.has_value())
+            break;
+    }
+    // Note: The device never hands us more requests than we have tags across all queues.
+    VERIFY(tag.has_value());
+
+    auto& request_queue = *m_request_queues[queue_index];
+    if (!is_read) {
+        auto* data = request_queue.data_region->vaddr().offset(tag.value() * PAGE_SIZE).as_ptr();
+        if (auto result = request.read_from_buffer(request.buffer(), data, request.block_count() * m_block_size); result.is_error()) {
+            {
+                SpinlockLocker locker(get_queue(queue_index).lock());
+                release_tag(queue_index, tag.value());
+            }
+            request.complete(AsyncDeviceRequest::MemoryFault);
+            return;
+        }
+    }
+
+    if (!submit_tag(queue_index, tag.value(), request))
+        request.complete(AsyncDeviceRequest::Failure);
+}
+
+bool VirtIOBlockController::submit_tag(u16 queue_index, u8 tag, AsyncBlockDeviceRequest& request)
+{
+    auto& queue = get_queue(queue_index);
+    auto& request_queue = *m_request_queues[queue_index];
+    bool is_read = request.request_type() == AsyncBlockDeviceRequest::Read;
+
+    auto control_address = control_block_address(*request_queue.control_region, tag);
+    auto header_address = control_address.offset(offsetof(VirtIOBlockControlBlock, header));
+    auto status_address = control_address.offset(offsetof(VirtIOBlockControlBlock, status));
+    auto data_address = request_queue.data_region->physical_page(tag)->paddr();
+    u32 data_length = request.block_count() * m_block_size;
+
+    SpinlockLocker locker(queue.lock());
+    request_queue.requests[tag] = request;
+
+    auto& control = control_block(*request_queue.control_region, tag);
+    control.header.type = is_read ? VIRTIO_BLK_T_IN : VIRTIO_BLK_T_OUT;
+    control.header.reserved = 0;
+    control.header.sector = request.block_index() * (m_block_size / VIRTIO_BLK_SECTOR_SIZE);
+    control.status = 0xff;
+
+    VirtIO::QueueChain chain(queue);
+    bool did_add_buffers = false;
+    if (m_indirect_descriptors_enabled) {
+        // The whole request only takes up a single descriptor of the queue, which lets us keep as many
+        // requests in flight as the queue has descriptors.
+        control.descriptors[0] = { header_address.get(), sizeof(VirtIOBlockRequestHeader), VIRTQ_DESC_F_NEXT, 1 };
+        control.descriptors[1] = { data_address.get(), data_length, static_cast<u16>((is_read ? VIRTQ_DESC_F_WRITE : 0) | VIRTQ_DESC_F_NEXT), 2 };
+        control.descriptors[2] = { status_address.get(), sizeof(u8), VIRTQ_DESC_F_WRITE, 0 };
+        did_add_buffers = chain.add_buffer_to_chain(control_address, sizeof(control.descriptors), VirtIO::BufferType::IndirectDescriptorTable);
+    } else {
+        did_add_buffers = chain.add_buffer_to_chain(header_address, sizeof(VirtIOBlockRequestHeader), VirtIO::BufferType::DeviceReadable)
+            && chain.add_buffer_to_chain(data_address, data_length, is_read ? VirtIO::BufferType::DeviceWritable : VirtIO::BufferType::DeviceReadable)
+            && chain.add_buffer_to_chain(status_address, sizeof(u8), VirtIO::BufferType::DeviceWritable);
+    }
+
+    if (!did_add_buffers) {
+        dmesgln("VirtIOBlockController: Ran out of descriptors in queue {}", queue_index);
+        chain.release_buffer_slots_to_queue();
+        release_tag(queue_index, tag);
+        return false;
+    }
+
+    supply_chain_and_notify(queue_index, chain);
+    return true;
+}
+
+void VirtIOBlockController::handle_queue_update(u16 queue_index)
+{
+    dbgln_if(VIRTIO_DEBUG, "VirtIOBlockController: handle_queue_update {}", queue_index);
+    if (queue_index >= m_request_queues.size()) {
+        dmesgln("VirtIOBlockController: unexpected update for queue {}", queue_index);
+        return;
+    }
+
+    auto& queue = get_queue(queue_index);
+    auto& request_queue = *m_request_queues[queue_index];
+    auto control_region_address = control_block_address(*request_queue.control_region, 0);
+    {
+        SpinlockLocker locker(queue.lock());
+        size_t used;
+        for (auto chain = queue.pop_used_buffer_chain(used); !chain.is_empty(); chain = queue.pop_used_buffer_chain(used)) {
+            // Note: Both an indirect descriptor table and a request header sit at the start of the
+            // control block of a tag, so the first buffer of a chain tells us which request finished.
+            Optional<PhysicalAddress> first_buffer_address;
+            chain.for_each([&](PhysicalAddress address, size_t) {
+                if (!first_buffer_address.has_value())
+                    first_buffer_address = address;
+            });
+            chain.release_buffer_slots_to_queue();
+            VERIFY(first_buffer_address.has_value());
+            u8 tag = (first_buffer_address->get() - control_region_address.get()) / control_block_stride;
+            VERIFY(tag < m_tags_per_queue);
+            request_queue.completed_tags |= 1u << tag;
+        }
+    }
+    schedule_completion_processing(queue_index);
+}
+
+void VirtIOBlockController::schedule_completion_processing(u16 queue_index)
+{
+    auto& request_queue = *m_request_queues[queue_index];
+    // Note: If a work item is already pending it will pick up this completion as well,
+    // so a burst of interrupts results in a single pass over all finished requests of the queue.
+    if (request_queue.completion_processing_scheduled.exchange(true))
+        return;
+
+    // Now schedule reading the buffers as soon as we leave the irq handler.
+    // This is important so that we can safely access the buffers, which could
+    // trigger page faults
+    auto work_item_creation_result = g_io_work->try_queue([this, queue_index]() {
+        m_request_queues[queue_index]->completion_processing_scheduled.store(false);
+        process_completed_requests(queue_index);
+    });
+    if (work_item_creation_result.is_error()) {
+        // FIXME: The finished requests stay around until the next interrupt of this queue schedules another pass.
+        request_queue.completion_processing_scheduled.store(false);
+        dmesgln("VirtIOBlockController: Unable to schedule completion processing for queue {}", queue_index);
+    }
+}
+
+void VirtIOBlockController::process_completed_requests(u16 queue_index)
+{
+    struct CompletedRequest {
+        LockRefPtr<AsyncBlockDeviceRequest> request;
+        u8 tag { 0 };
+        AsyncDeviceRequest::RequestResult result { AsyncDeviceRequest::Success };
+    };
+    Array<CompletedRequest, max_tags_per_queue> completed_requests;
+    size_t completed_requests_count = 0;
+
+    auto& queue = get_queue(queue_index);
+    auto& request_queue = *m_request_queues[queue_index];
+    {
+        SpinlockLocker locker(queue.lock());
+        auto completed_tags = request_queue.completed_tags;
+        request_queue.completed_tags = 0;
+        for (u8 tag = 0; tag < m_tags_per_queue; ++tag) {
+            if (!(completed_tags & (1u << tag)))
+                continue;
+            VERIFY(request_queue.requests[tag]);
+            auto status = control_block(*request_queue.control_region, tag).status;
+            auto result = status == VIRTIO_BLK_S_OK ? AsyncDeviceRequest::Success : AsyncDeviceRequest::Failure;
+            completed_requests[completed_requests_count++] = { request_queue.requests[tag], tag, result };
+        }
+    }
+
+    // Note: The tags are still ours, so the bounce buffers can't be reused while we copy out of them.
+    //       Copying may page fault, which is why it happens outside of the queue lock.
+    for (size_t index = 0; index < completed_requests_count; ++index) {
+        auto& completed = completed_requests[index];
+        auto& request = *completed.request;
+        if (completed.result != AsyncDeviceRequest::Success || request.request_type() != AsyncBlockDeviceRequest::Read)
+            continue;
+        auto* data = request_queue.data_region->vaddr().offset(completed.tag * PAGE_SIZE).as_ptr();
+        if (auto result = request.write_to_buffer(request.buffer(), data, request.block_count() * m_block_size); result.is_error())
+            completed.result = AsyncDeviceRequest::MemoryFault;
+    }
+
+    {
+        SpinlockLocker locker(queue.lock());
+        for (size_t index = 0; index < completed_requests_count; ++index)
+            release_tag(queue_index, completed_requests[index].tag);
+    }
+
+    // Note: Completing a request may start the next queued one, which needs a free tag.
+    for (size_t index = 0; index < completed_requests_count; ++index)
+        completed_requests[index].request->complete(completed_requests[index].result);
+}
+
+}
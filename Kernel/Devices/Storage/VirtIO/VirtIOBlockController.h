@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <Kernel/Bus/VirtIO/Device.h>
+#include <Kernel/Devices/Storage/StorageController.h>
+#include <Kernel/Devices/Storage/VirtIO/VirtIOBlockDevice.h>
+#include <Kernel/Library/LockWeakable.h>
+
+namespace Kernel {
+
+class VirtIOBlockController final
+    : public StorageController
+    , public VirtIO::Device
+    , public LockWeakable<VirtIOBlockController> {
+    friend class VirtIOBlockDevice;
+
+public:
+    static ErrorOr<bool> probe(PCI::DeviceIdentifier const&);
+    static ErrorOr<NonnullRefPtr<VirtIOBlockController>> try_initialize(PCI::DeviceIdentifier const&);
+    virtual ~VirtIOBlockController() override = default;
+
+    // ^StorageController
+    virtual LockRefPtr<StorageDevice> device(u32 index) const override;
+    virtual size_t devices_count() const override { return m_device ? 1 : 0; }
+
+    // ^VirtIO::Device
+    virtual ErrorOr<void> initialize_virtio_resources() override;
+
+protected:
+    // ^StorageController
+    virtual ErrorOr<void> reset() override { return ENOTIMPL; }
+    virtual ErrorOr<void> shutdown() override { return ENOTIMPL; }
+    virtual void complete_current_request(AsyncDeviceRequest::RequestResult) override { VERIFY_NOT_REACHED(); }
+
+    // ^VirtIO::Device
+    virtual StringView class_name() const override { return "VirtIOBlockController"sv; }
+
+private:
+    static constexpr size_t max_tags_per_queue = 32;
+
+    // Every request of a queue is identified by a tag, which owns a control block (indirect
+    // descriptor table, request header and status byte) and a page sized bounce buffer.
+    struct RequestQueue {
+        OwnPtr<Memory::Region> control_region;
+        OwnPtr<Memory::Region> data_region;
+        Array<LockRefPtr<AsyncBlockDeviceRequest>, max_tags_per_queue> requests;
+        // Note: Both bitmaps are protected by the lock of the corresponding VirtIO::Queue.
+        u32 free_tags { 0 };
+        u32 completed_tags { 0 };
+        Atomic<bool> completion_processing_scheduled { false };
+    };
+
+    VirtIOBlockController(NonnullOwnPtr<VirtIO::TransportEntity>, u32 hardware_relative_controller_id);
+
+    ErrorOr<void> initialize();
+    ErrorOr<void> allocate_request_queues(u16 queue_count);
+
+    void start_request(AsyncBlockDeviceRequest&);
+    size_t max_requests_in_flight() const { return m_tags_per_queue * m_request_queues.size(); }
+
+    Optional<u8> try_to_allocate_tag(u16 queue_index);
+    void release_tag(u16 queue_index, u8 tag);
+    bool submit_tag(u16 queue_index, u8 tag, AsyncBlockDeviceRequest&);
+
+    void schedule_completion_processing(u16 queue_index);
+    void process_completed_requests(u16 queue_index);
+
+    // ^VirtIO::Device
+    virtual ErrorOr<void> handle_device_config_change() override;
+    virtual void handle_queue_update(u16 queue_index) override;
+
+    VirtIO::Configuration const* m_device_config { nullptr };
+    u64 m_capacity_in_sectors { 0 };
+    u32 m_block_size { 512 };
+    bool m_indirect_descriptors_enabled { false };
+    bool m_read_only { false };
+    size_t m_tags_per_queue { 0 };
+
+    Vector<NonnullOwnPtr<RequestQueue>> m_request_queues;
+    LockRefPtr<VirtIOBlockDevice> m_device;
+};
+
+}
@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/Devices/DeviceManagement.h>
+#include <Kernel/Devices/Storage/VirtIO/VirtIOBlockController.h>
+#include <Kernel/Devices/Storage/VirtIO/VirtIOBlockDevice.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT ErrorOr<NonnullLockRefPtr<VirtIOBlockDevice>> VirtIOBlockDevice::try_create(VirtIOBlockController const& controller, size_t block_size, u64 max_addressable_block, size_t max_requests_in_flight)
+{
+    return TRY(DeviceManagement::try_create_device<VirtIOBlockDevice>(controller, StorageDevice::LUNAddress { controller.controller_id(), 0, 0 }, controller.hardware_relative_controller_id(), block_size, max_addressable_block, max_requests_in_flight));
+}
+
+UNMAP_AFTER_INIT VirtIOBlockDevice::VirtIOBlockDevice(VirtIOBlockController const& controller, LUNAddress logical_unit_number_address, u32 hardware_relative_controller_id, size_t block_size, u64 max_addressable_block, size_t max_requests_in_flight)
+    : StorageDevice(logical_unit_number_address, hardware_relative_controller_id, block_size, max_addressable_block)
+    , m_controller(controller)
+    , m_max_requests_in_flight(max_requests_in_flight)
+{
+}
+
+void VirtIOBlockDevice::start_request(AsyncBlockDeviceRequest& request)
+{
+    auto controller = m_controller.strong_ref();
+    if (!controller) {
+        request.complete(AsyncDeviceRequest::Failure);
+        return;
+    }
+    controller->start_request(request);
+}
+
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <Kernel/Devices/Storage/StorageDevice.h>
+#include <Kernel/Library/LockWeakPtr.h>
+
+namespace Kernel {
+
+class VirtIOBlockController;
+class VirtIOBlockDevice final : public StorageDevice {
+    friend class DeviceManagement;
+
+public:
+    static ErrorOr<NonnullLockRefPtr<VirtIOBlockDevice>> try_create(VirtIOBlockController const&, size_t block_size, u64 max_addressable_block, size_t max_requests_in_flight);
+
+    // ^StorageDevice
+    virtual CommandSet command_set() const override { return CommandSet::VirtIO; }
+
+    // ^BlockDevice
+    virtual void start_request(AsyncBlockDeviceRequest&) override;
+
+    // ^Device
+    virtual size_t max_requests_in_flight() const override { return m_max_requests_in_flight; }
+
+private:
+    VirtIOBlockDevice(VirtIOBlockController const&, LUNAddress, u32 hardware_relative_controller_id, size_t block_size, u64 max_addressable_block, size_t max_requests_in_flight);
+
+    LockWeakPtr<VirtIOBlockController> m_controller;
+    size_t const m_max_requests_in_flight;
+};
+
+}
@@ -5,9 +5,12 @@
  */
 
 #include <AK/IntrusiveList.h>
+#include <AK/QuickSort.h>
 #include <Kernel/Debug.h>
 #include <Kernel/FileSystem/BlockBasedFileSystem.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WritebackTask.h>
+#include <Kernel/Time/TimeManagement.h>
 
 namespace Kernel {
 
@@ -16,14 +19,25 @@ struct CacheEntry {
     BlockBasedFileSystem::BlockIndex block_index { 0 };
     u8* data { nullptr };
     bool has_data { false };
+    i64 dirtied_at_in_ms { 0 };
 };
 
 class DiskCache {
 public:
     static constexpr size_t EntryCount = 10000;
-    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer)
+
+    // When this many blocks are dirty, we wake up the writeback task to start writing back the oldest ones.
+    static constexpr size_t BackgroundDirtyLimit = EntryCount / 10;
+    // Writers that push us past this limit are throttled by having to write back dirty blocks themselves.
+    static constexpr size_t DirtyLimit = EntryCount * 2 / 5;
+
+    // Adjacent dirty blocks are coalesced into writes of up to this size.
+    static constexpr size_t MaxClusterSize = 128 * KiB;
+
+    explicit DiskCache(BlockBasedFileSystem& fs, NonnullOwnPtr<KBuffer> cached_block_data, NonnullOwnPtr<KBuffer> entries_buffer, NonnullOwnPtr<KBuffer> cluster_buffer)
         : m_fs(fs)
         , m_cached_block_data(move(cached_block_data))
+        , m_cluster_buffer(move(cluster_buffer))
         , m_entries(move(entries_buffer))
     {
         for (size_t i = 0; i < EntryCount; ++i) {
@@ -36,20 +50,22 @@ public:
 
     bool is_dirty() const { return !m_dirty_list.is_empty(); }
     bool entry_is_dirty(CacheEntry const& entry) const { return m_dirty_list.contains(entry); }
-
-    void mark_all_clean()
-    {
-        while (auto* entry = m_dirty_list.first())
-            m_clean_list.prepend(*entry);
-    }
+    size_t dirty_count() const { return m_dirty_count; }
 
     void mark_dirty(CacheEntry& entry)
     {
+        // NOTE: Entries that are already dirty keep their place, so the dirty list stays ordered by age (oldest last).
+        if (entry_is_dirty(entry))
+            return;
+        entry.dirtied_at_in_ms = TimeManagement::the().monotonic_time().milliseconds();
         m_dirty_list.prepend(entry);
+        ++m_dirty_count;
     }
 
     void mark_clean(CacheEntry& entry)
     {
+        if (entry_is_dirty(entry))
+            --m_dirty_count;
         m_clean_list.prepend(entry);
     }
 
@@ -93,19 +109,28 @@ public:
         return &new_entry;
     }
 
+    CacheEntry* oldest_dirty_entry() { return m_dirty_list.last(); }
+
     CacheEntry const* entries() const { return (CacheEntry const*)m_entries->data(); }
     CacheEntry* entries() { return (CacheEntry*)m_entries->data(); }
 
+    // Calls the callback for every dirty entry, from the least recently dirtied to the most recently dirtied one.
     template<typename Callback>
-    void for_each_dirty_entry(Callback callback)
+    void for_each_dirty_entry_oldest_first(Callback callback)
     {
-        for (auto& entry : m_dirty_list)
-            callback(entry);
+        for (auto it = m_dirty_list.rbegin(); it != m_dirty_list.rend(); ++it) {
+            if (callback(*it) == IterationDecision::Break)
+                break;
+        }
     }
 
+    u8* cluster_buffer() { return m_cluster_buffer->data(); }
+    size_t max_cluster_block_count() const { return m_cluster_buffer->size() / m_fs->logical_block_size(); }
+
 private:
     mutable NonnullRefPtr<BlockBasedFileSystem> m_fs;
     NonnullOwnPtr<KBuffer> m_cached_block_data;
+    NonnullOwnPtr<KBuffer> m_cluster_buffer;
 
     // NOTE: m_entries must be declared before m_dirty_list and m_clean_list because their entries are allocated from it.
     // We need to ensure that the destructors of m_dirty_list and m_clean_list are called before m_entries is destroyed.
@@ -113,6 +138,7 @@ private:
     mutable IntrusiveList<&CacheEntry::list_node> m_dirty_list;
     mutable IntrusiveList<&CacheEntry::list_node> m_clean_list;
     mutable HashMap<BlockBasedFileSystem::BlockIndex, CacheEntry*> m_hash;
+    size_t m_dirty_count { 0 };
 };
 
 BlockBasedFileSystem::BlockBasedFileSystem(OpenFileDescription& file_description)
@@ -138,7 +164,8 @@ ErrorOr<void> BlockBasedFileSystem::initialize_while_locked()
     VERIFY(logical_block_size() != 0);
     auto cached_block_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache blocks"sv, DiskCache::EntryCount * logical_block_size()));
     auto entries_data = TRY(KBuffer::try_create_with_size("BlockBasedFS: Cache entries"sv, DiskCache::EntryCount * sizeof(CacheEntry)));
-    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data))));
+    auto cluster_buffer = TRY(KBuffer::try_create_with_size("BlockBasedFS: Writeback cluster"sv, max(DiskCache::MaxClusterSize, logical_block_size())));
+    auto disk_cache = TRY(adopt_nonnull_own_or_enomem(new (nothrow) DiskCache(*this, move(cached_block_data), move(entries_data), move(cluster_buffer))));
 
     m_cache.with_exclusive([&](auto& cache) {
         cache = move(disk_cache);
@@ -177,6 +204,15 @@ ErrorOr<void> BlockBasedFileSystem::write_block(BlockIndex index, UserOrKernelBu
 
         cache->mark_dirty(*entry);
         entry->has_data = true;
+
+        if (cache->dirty_count() >= DiskCache::DirtyLimit) {
+            // NOTE: This writer is dirtying blocks faster than the writeback task can write them back,
+            //       so make it write back the oldest blocks itself until we're back under the background limit.
+            WritebackTask::statistics().throttled_writes++;
+            write_back_dirty_entries(*cache, WritebackMode::Oldest, cache->dirty_count() - DiskCache::BackgroundDirtyLimit);
+        } else if (cache->dirty_count() >= DiskCache::BackgroundDirtyLimit) {
+            WritebackTask::wake();
+        }
         return {};
     });
 }
@@ -288,27 +324,128 @@ void BlockBasedFileSystem::flush_specific_block_if_needed(BlockIndex index)
     });
 }
 
+static bool is_expired(CacheEntry const& entry)
+{
+    auto now_in_ms = TimeManagement::the().monotonic_time().milliseconds();
+    return now_in_ms - entry.dirtied_at_in_ms >= WritebackTask::dirty_expire_time.to_milliseconds();
+}
+
+size_t BlockBasedFileSystem::write_back_dirty_entries(DiskCache& cache, WritebackMode mode, size_t max_count)
+{
+    if (!cache.is_dirty() || max_count == 0)
+        return 0;
+
+    size_t written_count = 0;
+    auto write_entry = [&](CacheEntry& entry) {
+        auto base_offset = entry.block_index.value() * logical_block_size();
+        auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
+        auto result = file_description().write(base_offset, entry_data_buffer, logical_block_size());
+        WritebackTask::statistics().write_requests++;
+        if (result.is_error())
+            dbgln("{}: Failed to write back block {}: {}", class_name(), entry.block_index, result.error());
+        // NOTE: Like before, we drop blocks that failed to write. Keeping them dirty could make ensure() loop forever.
+        cache.mark_clean(entry);
+        ++written_count;
+    };
+
+    Vector<CacheEntry*> entries;
+    if (entries.try_ensure_capacity(min(cache.dirty_count(), max_count)).is_error()) {
+        // We can't cluster without memory for the list, but we still have to make forward progress.
+        while (auto* entry = cache.oldest_dirty_entry()) {
+            if (written_count == max_count)
+                break;
+            if (mode == WritebackMode::Expired && !is_expired(*entry))
+                break;
+            write_entry(*entry);
+        }
+        WritebackTask::statistics().blocks_written += written_count;
+        return written_count;
+    }
+
+    cache.for_each_dirty_entry_oldest_first([&](CacheEntry& entry) {
+        if (mode == WritebackMode::Expired && !is_expired(entry))
+            return IterationDecision::Break;
+        entries.unchecked_append(&entry);
+        if (entries.size() == max_count)
+            return IterationDecision::Break;
+        return IterationDecision::Continue;
+    });
+
+    // Write the selected blocks in ascending order, so runs of adjacent blocks become a single large write.
+    quick_sort(entries, [](auto* a, auto* b) { return a->block_index < b->block_index; });
+
+    auto max_cluster_block_count = cache.max_cluster_block_count();
+    for (size_t run_start = 0; run_start < entries.size();) {
+        size_t run_length = 1;
+        while (run_start + run_length < entries.size()
+            && run_length < max_cluster_block_count
+            && entries[run_start + run_length]->block_index.value() == entries[run_start]->block_index.value() + run_length) {
+            ++run_length;
+        }
+
+        if (run_length == 1) {
+            write_entry(*entries[run_start]);
+        } else {
+            for (size_t i = 0; i < run_length; ++i)
+                memcpy(cache.cluster_buffer() + i * logical_block_size(), entries[run_start + i]->data, logical_block_size());
+            auto base_offset = entries[run_start]->block_index.value() * logical_block_size();
+            auto cluster_buffer = UserOrKernelBuffer::for_kernel_buffer(cache.cluster_buffer());
+            auto result = file_description().write(base_offset, cluster_buffer, run_length * logical_block_size());
+            WritebackTask::statistics().write_requests++;
+            if (result.is_error())
+                dbgln("{}: Failed to write back blocks {}-{}: {}", class_name(), entries[run_start]->block_index, entries[run_start]->block_index.value() + run_length - 1, result.error());
+            for (size_t i = 0; i < run_length; ++i)
+                cache.mark_clean(*entries[run_start + i]);
+            written_count += run_length;
+        }
+        run_start += run_length;
+    }
+
+    WritebackTask::statistics().blocks_written += written_count;
+    return written_count;
+}
+
 void BlockBasedFileSystem::flush_writes_impl()
 {
-    size_t count = 0;
     m_cache.with_exclusive([&](auto& cache) {
-        if (!cache->is_dirty())
-            return;
-        cache->for_each_dirty_entry([&](CacheEntry& entry) {
-            auto base_offset = entry.block_index.value() * logical_block_size();
-            auto entry_data_buffer = UserOrKernelBuffer::for_kernel_buffer(entry.data);
-            [[maybe_unused]] auto rc = file_description().write(base_offset, entry_data_buffer, logical_block_size());
-            ++count;
-        });
-        cache->mark_all_clean();
-        dbgln("{}: Flushed {} blocks to disk", class_name(), count);
+        auto count = write_back_dirty_entries(*cache, WritebackMode::All);
+        if (count > 0)
+            dbgln_if(BBFS_DEBUG, "{}: Flushed {} blocks to disk", class_name(), count);
     });
 }
 
 ErrorOr<void> BlockBasedFileSystem::flush_writes()
 {
+    TRY(flush_cached_metadata());
     flush_writes_impl();
     return {};
 }
 
+ErrorOr<void> BlockBasedFileSystem::flush_expired_writes()
+{
+    TRY(flush_cached_metadata());
+    m_cache.with_exclusive([&](auto& cache) {
+        if (!cache)
+            return;
+        if (write_back_dirty_entries(*cache, WritebackMode::Expired) > 0)
+            WritebackTask::statistics().expired_writebacks++;
+
+        if (cache->dirty_count() >= DiskCache::BackgroundDirtyLimit) {
+            // Write back the oldest half of the background limit, so that a steady writer doesn't wake us up on every block.
+            write_back_dirty_entries(*cache, WritebackMode::Oldest, cache->dirty_count() - DiskCache::BackgroundDirtyLimit / 2);
+            WritebackTask::statistics().background_writebacks++;
+        }
+    });
+    return {};
+}
+
+size_t BlockBasedFileSystem::dirty_block_count() const
+{
+    return m_cache.with_shared([](auto const& cache) -> size_t {
+        if (!cache)
+            return 0;
+        return cache->dirty_count();
+    });
+}
+
 }
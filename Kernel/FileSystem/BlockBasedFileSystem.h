@@ -20,6 +20,8 @@ public:
     u64 device_block_size() const { return m_device_block_size; }
 
     virtual ErrorOr<void> flush_writes() override;
+    virtual ErrorOr<void> flush_expired_writes() override;
+    virtual size_t dirty_block_count() const override;
     void flush_writes_impl();
 
 protected:
@@ -43,8 +45,18 @@ protected:
 
     void remove_disk_cache_before_last_unmount();
 
+    // Writes file system metadata that is cached outside of the block cache (e.g. the superblock) into the block cache.
+    virtual ErrorOr<void> flush_cached_metadata() { return {}; }
+
 private:
+    enum class WritebackMode {
+        All,
+        Expired,
+        Oldest,
+    };
+
     void flush_specific_block_if_needed(BlockIndex index);
+    size_t write_back_dirty_entries(DiskCache&, WritebackMode, size_t max_count = NumericLimits<size_t>::max());
 
     mutable MutexProtected<OwnPtr<DiskCache>> m_cache;
 };
@@ -671,56 +671,48 @@ void Ext2FS::flush_block_group_descriptor_table()
     }
 }
 
-ErrorOr<void> Ext2FS::flush_writes()
+ErrorOr<void> Ext2FS::flush_cached_metadata()
 {
-    {
-        MutexLocker locker(m_lock);
-        if (m_super_block_dirty) {
-            auto result = flush_super_block();
-            if (result.is_error()) {
-                dbgln("Ext2FS[{}]::flush_writes(): Failed to write superblock: {}", fsid(), result.error());
-                return result.release_error();
-            }
-            m_super_block_dirty = false;
-        }
-        if (m_block_group_descriptors_dirty) {
-            flush_block_group_descriptor_table();
-            m_block_group_descriptors_dirty = false;
+    MutexLocker locker(m_lock);
+    if (m_super_block_dirty) {
+        auto result = flush_super_block();
+        if (result.is_error()) {
+            dbgln("Ext2FS[{}]::flush_cached_metadata(): Failed to write superblock: {}", fsid(), result.error());
+            return result.release_error();
         }
-        for (auto& cached_bitmap : m_cached_bitmaps) {
-            if (cached_bitmap->dirty) {
-                auto buffer = UserOrKernelBuffer::for_kernel_buffer(cached_bitmap->buffer->data());
-                if (auto result = write_block(cached_bitmap->bitmap_block_index, buffer, logical_block_size()); result.is_error()) {
-                    dbgln("Ext2FS[{}]::flush_writes(): Failed to write blocks: {}", fsid(), result.error());
-                }
-                cached_bitmap->dirty = false;
-                dbgln_if(EXT2_DEBUG, "Ext2FS[{}]::flush_writes(): Flushed bitmap block {}", fsid(), cached_bitmap->bitmap_block_index);
+        m_super_block_dirty = false;
+    }
+    if (m_block_group_descriptors_dirty) {
+        flush_block_group_descriptor_table();
+        m_block_group_descriptors_dirty = false;
+    }
+    for (auto& cached_bitmap : m_cached_bitmaps) {
+        if (cached_bitmap->dirty) {
+            auto buffer = UserOrKernelBuffer::for_kernel_buffer(cached_bitmap->buffer->data());
+            if (auto result = write_block(cached_bitmap->bitmap_block_index, buffer, logical_block_size()); result.is_error()) {
+                dbgln("Ext2FS[{}]::flush_cached_metadata(): Failed to write blocks: {}", fsid(), result.error());
             }
+            cached_bitmap->dirty = false;
+            dbgln_if(EXT2_DEBUG, "Ext2FS[{}]::flush_cached_metadata(): Flushed bitmap block {}", fsid(), cached_bitmap->bitmap_block_index);
         }
+    }
 
-        // Uncache Inodes that are only kept alive by the index-to-inode lookup cache.
-        // We don't uncache Inodes that are being watched by at least one InodeWatcher.
-
-        // FIXME: It would be better to keep a capped number of Inodes around.
-        //        The problem is that they are quite heavy objects, and use a lot of heap memory
-        //        for their (child name lookup) and (block list) caches.
+    // Uncache Inodes that are only kept alive by the index-to-inode lookup cache.
+    // We don't uncache Inodes that are being watched by at least one InodeWatcher.
 
-        m_inode_cache.remove_all_matching([](InodeIndex, RefPtr<Ext2FSInode> const& cached_inode) {
-            // NOTE: If we're asked to look up an inode by number (via get_inode) and it turns out
-            //       to not exist, we remember the fact that it doesn't exist by caching a nullptr.
-            //       This seems like a reasonable time to uncache ideas about unknown inodes, so do that.
-            if (cached_inode == nullptr)
-                return true;
+    // FIXME: It would be better to keep a capped number of Inodes around.
+    //        The problem is that they are quite heavy objects, and use a lot of heap memory
+    //        for their (child name lookup) and (block list) caches.
 
-            return cached_inode->ref_count() == 1 && !cached_inode->has_watchers();
-        });
-    }
+    m_inode_cache.remove_all_matching([](InodeIndex, RefPtr<Ext2FSInode> const& cached_inode) {
+        // NOTE: If we're asked to look up an inode by number (via get_inode) and it turns out
+        //       to not exist, we remember the fact that it doesn't exist by caching a nullptr.
+        //       This seems like a reasonable time to uncache ideas about unknown inodes, so do that.
+        if (cached_inode == nullptr)
+            return true;
 
-    auto result = BlockBasedFileSystem::flush_writes();
-    if (result.is_error()) {
-        dbgln("Ext2FS[{}]::flush_writes(): Failed to flush writes: {}", BlockBasedFileSystem::fsid(), result.error());
-        return result.release_error();
-    }
+        return cached_inode->ref_count() == 1 && !cached_inode->has_watchers();
+    });
 
     return {};
 }
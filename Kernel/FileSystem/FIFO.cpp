@@ -18,7 +18,7 @@ static Atomic<int> s_next_fifo_id = 1;
 
 ErrorOr<NonnullRefPtr<FIFO>> FIFO::try_create(UserID uid)
 {
-    auto buffer = TRY(DoubleBuffer::try_create("FIFO: Buffer"sv));
+    auto buffer = TRY(PipeBuffer::try_create("FIFO: Buffer"sv));
     return adopt_nonnull_ref_or_enomem(new (nothrow) FIFO(uid, move(buffer)));
 }
 
@@ -64,7 +64,7 @@ ErrorOr<NonnullRefPtr<OpenFileDescription>> FIFO::open_direction_blocking(FIFO::
     return description;
 }
 
-FIFO::FIFO(UserID uid, NonnullOwnPtr<DoubleBuffer> buffer)
+FIFO::FIFO(UserID uid, NonnullOwnPtr<PipeBuffer> buffer)
     : m_buffer(move(buffer))
     , m_uid(uid)
 {
@@ -101,7 +101,9 @@ bool FIFO::can_read(OpenFileDescription const&, u64) const
 
 bool FIFO::can_write(OpenFileDescription const&, u64) const
 {
-    return m_buffer->space_for_writing() || !m_readers;
+    // NOTE: We don't report the FIFO as writable for every freed byte, so that a blocked writer
+    //       gets to write at least a page at a time instead of ping-ponging with the reader.
+    return m_buffer->space_for_writing() >= m_buffer->writer_wakeup_threshold() || !m_readers;
 }
 
 ErrorOr<size_t> FIFO::read(OpenFileDescription& fd, u64, UserOrKernelBuffer& buffer, size_t size)
@@ -125,6 +127,17 @@ ErrorOr<size_t> FIFO::write(OpenFileDescription& fd, u64, UserOrKernelBuffer con
     return m_buffer->write(buffer, size);
 }
 
+ErrorOr<size_t> FIFO::set_buffer_size(size_t size, Credentials const& credentials)
+{
+    if (size == 0 || size > PipeBuffer::max_capacity)
+        return EINVAL;
+    if (size > PipeBuffer::max_unprivileged_capacity && !credentials.is_superuser())
+        return EPERM;
+    auto new_size = TRY(m_buffer->try_resize(size));
+    evaluate_block_conditions();
+    return new_size;
+}
+
 ErrorOr<NonnullOwnPtr<KString>> FIFO::pseudo_path(OpenFileDescription const&) const
 {
     return KString::formatted("fifo:{}", m_fifo_id);
@@ -7,7 +7,7 @@
 #pragma once
 
 #include <Kernel/FileSystem/File.h>
-#include <Kernel/Library/DoubleBuffer.h>
+#include <Kernel/Library/PipeBuffer.h>
 #include <Kernel/Locking/Mutex.h>
 #include <Kernel/Tasks/WaitQueue.h>
 #include <Kernel/UnixTypes.h>
@@ -32,6 +32,9 @@ public:
     ErrorOr<NonnullRefPtr<OpenFileDescription>> open_direction(Direction);
     ErrorOr<NonnullRefPtr<OpenFileDescription>> open_direction_blocking(Direction);
 
+    size_t buffer_size() const { return m_buffer->capacity(); }
+    ErrorOr<size_t> set_buffer_size(size_t, Credentials const&);
+
 private:
     // ^File
     virtual ErrorOr<size_t> write(OpenFileDescription&, u64, UserOrKernelBuffer const&, size_t) override;
@@ -44,11 +47,11 @@ private:
     virtual StringView class_name() const override { return "FIFO"sv; }
     virtual bool is_fifo() const override { return true; }
 
-    explicit FIFO(UserID, NonnullOwnPtr<DoubleBuffer> buffer);
+    explicit FIFO(UserID, NonnullOwnPtr<PipeBuffer> buffer);
 
     unsigned m_writers { 0 };
     unsigned m_readers { 0 };
-    NonnullOwnPtr<DoubleBuffer> m_buffer;
+    NonnullOwnPtr<PipeBuffer> m_buffer;
 
     UserID m_uid { 0 };
 
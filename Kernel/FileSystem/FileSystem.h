@@ -58,6 +58,11 @@ public:
 
     virtual ErrorOr<void> flush_writes() { return {}; }
 
+    // Called periodically by the writeback task. File systems with a write cache should
+    // only write back data that has been dirty for a while, or whatever is needed to relieve memory pressure.
+    virtual ErrorOr<void> flush_expired_writes() { return flush_writes(); }
+    virtual size_t dirty_block_count() const { return 0; }
+
     u64 logical_block_size() const { return m_logical_block_size; }
     size_t fragment_size() const { return m_fragment_size; }
 
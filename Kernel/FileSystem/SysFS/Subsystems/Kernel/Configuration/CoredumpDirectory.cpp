@@ -28,11 +28,12 @@ ErrorOr<NonnullOwnPtr<KString>> SysFSCoredumpDirectory::value() const
         return KString::try_create(""sv);
     });
 }
-void SysFSCoredumpDirectory::set_value(NonnullOwnPtr<KString> new_value)
+ErrorOr<void> SysFSCoredumpDirectory::set_value(NonnullOwnPtr<KString> new_value)
 {
     Coredump::directory_path().with([&](auto& coredump_directory_path) {
         coredump_directory_path = move(new_value);
     });
+    return {};
 }
 
 mode_t SysFSCoredumpDirectory::permissions() const
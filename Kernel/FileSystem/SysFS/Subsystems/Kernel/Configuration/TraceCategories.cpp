@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Configuration/TraceCategories.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/Tracepoints.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSTraceCategories::SysFSTraceCategories(SysFSDirectory const& parent_directory)
+    : SysFSSystemStringVariable(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSTraceCategories> SysFSTraceCategories::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSTraceCategories(parent_directory)).release_nonnull();
+}
+
+ErrorOr<NonnullOwnPtr<KString>> SysFSTraceCategories::value() const
+{
+    return Tracepoints::serialize_categories(Tracepoints::enabled_categories());
+}
+
+ErrorOr<void> SysFSTraceCategories::set_value(NonnullOwnPtr<KString> new_value)
+{
+    // NOTE: Unknown category names fail with EINVAL, and running out of memory for the trace rings with ENOMEM.
+    auto categories = TRY(Tracepoints::parse_categories(new_value->view()));
+    return Tracepoints::set_enabled_categories(categories);
+}
+
+mode_t SysFSTraceCategories::permissions() const
+{
+    // NOTE: Tracepoints observe every process on the system, so only root may toggle them.
+    return S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH;
+}
+
+}
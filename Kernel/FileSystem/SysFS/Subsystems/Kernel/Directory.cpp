@@ -25,7 +25,9 @@
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Profile.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/RequestPanic.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/SystemStatistics.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Trace.h>
 #include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Uptime.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Writeback.h>
 
 namespace Kernel {
 
@@ -35,6 +37,7 @@ UNMAP_AFTER_INIT NonnullRefPtr<SysFSGlobalKernelStatsDirectory> SysFSGlobalKerne
     MUST(global_kernel_stats_directory->m_child_components.with([&](auto& list) -> ErrorOr<void> {
         list.append(SysFSDiskUsage::must_create(*global_kernel_stats_directory));
         list.append(SysFSMemoryStatus::must_create(*global_kernel_stats_directory));
+        list.append(SysFSWriteback::must_create(*global_kernel_stats_directory));
         list.append(SysFSSystemStatistics::must_create(*global_kernel_stats_directory));
         list.append(SysFSOverallProcesses::must_create(*global_kernel_stats_directory));
         list.append(SysFSCPUInformation::must_create(*global_kernel_stats_directory));
@@ -43,6 +46,7 @@ UNMAP_AFTER_INIT NonnullRefPtr<SysFSGlobalKernelStatsDirectory> SysFSGlobalKerne
         list.append(SysFSKeymap::must_create(*global_kernel_stats_directory));
         list.append(SysFSUptime::must_create(*global_kernel_stats_directory));
         list.append(SysFSProfile::must_create(*global_kernel_stats_directory));
+        list.append(SysFSTrace::must_create(*global_kernel_stats_directory));
         list.append(SysFSPowerStateSwitchNode::must_create(*global_kernel_stats_directory));
         list.append(SysFSJails::must_create(*global_kernel_stats_directory));
         list.append(SysFSSystemRequestPanic::must_create(*global_kernel_stats_directory));
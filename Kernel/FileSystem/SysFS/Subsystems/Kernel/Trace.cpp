@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Trace.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/Tracepoints.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT SysFSTrace::SysFSTrace(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSTrace> SysFSTrace::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSTrace(parent_directory)).release_nonnull();
+}
+
+ErrorOr<void> SysFSTrace::try_generate(KBufferBuilder& builder)
+{
+    // NOTE: Every open of this node consumes the events that were pending in the
+    //       per-processor trace rings, so a consumer can stream them by re-reading it.
+    return Tracepoints::drain_to_json(builder);
+}
+
+mode_t SysFSTrace::permissions() const
+{
+    return S_IRUSR;
+}
+
+}
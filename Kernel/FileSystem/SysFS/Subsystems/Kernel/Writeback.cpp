@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/FileSystem/SysFS/Subsystems/Kernel/Writeback.h>
+#include <Kernel/FileSystem/VirtualFileSystem.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/WritebackTask.h>
+
+namespace Kernel {
+
+UNMAP_AFTER_INIT NonnullRefPtr<SysFSWriteback> SysFSWriteback::must_create(SysFSDirectory const& parent_directory)
+{
+    return adopt_ref_if_nonnull(new (nothrow) SysFSWriteback(parent_directory)).release_nonnull();
+}
+
+UNMAP_AFTER_INIT SysFSWriteback::SysFSWriteback(SysFSDirectory const& parent_directory)
+    : SysFSGlobalInformation(parent_directory)
+{
+}
+
+ErrorOr<void> SysFSWriteback::try_generate(KBufferBuilder& builder)
+{
+    auto& statistics = WritebackTask::statistics();
+    auto json = TRY(JsonObjectSerializer<>::try_create(builder));
+    TRY(json.add("blocks_written"sv, statistics.blocks_written.load()));
+    TRY(json.add("write_requests"sv, statistics.write_requests.load()));
+    TRY(json.add("expired_writebacks"sv, statistics.expired_writebacks.load()));
+    TRY(json.add("background_writebacks"sv, statistics.background_writebacks.load()));
+    TRY(json.add("throttled_writes"sv, statistics.throttled_writes.load()));
+
+    auto file_systems = TRY(json.add_array("file_systems"sv));
+    TRY(VirtualFileSystem::the().for_each_mount([&file_systems](auto& mount) -> ErrorOr<void> {
+        auto& fs = mount.guest_fs();
+        auto fs_object = TRY(file_systems.add_object());
+        TRY(fs_object.add("class_name"sv, fs.class_name()));
+        auto mount_point = TRY(mount.absolute_path());
+        TRY(fs_object.add("mount_point"sv, mount_point->view()));
+        TRY(fs_object.add("block_size"sv, static_cast<u64>(fs.logical_block_size())));
+        TRY(fs_object.add("dirty_blocks"sv, fs.dirty_block_count()));
+        TRY(fs_object.finish());
+        return {};
+    }));
+    TRY(file_systems.finish());
+    TRY(json.finish());
+    return {};
+}
+
+}
@@ -276,6 +276,21 @@ void VirtualFileSystem::sync_filesystems()
     }
 }
 
+void VirtualFileSystem::writeback_filesystems()
+{
+    Vector<NonnullRefPtr<FileSystem>, 32> file_systems;
+    m_file_systems_list.with([&](auto const& list) {
+        for (auto& fs : list)
+            file_systems.append(fs);
+    });
+
+    for (auto& fs : file_systems) {
+        auto result = fs->flush_expired_writes();
+        if (result.is_error())
+            dbgln("VirtualFileSystem: Failed to write back {}: {}", fs->class_name(), result.error());
+    }
+}
+
 void VirtualFileSystem::lock_all_filesystems()
 {
     Vector<NonnullRefPtr<FileSystem>, 32> file_systems;
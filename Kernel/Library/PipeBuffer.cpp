@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/BuiltinWrappers.h>
+#include <Kernel/Library/PipeBuffer.h>
+
+namespace Kernel {
+
+size_t PipeBuffer::round_up_capacity(size_t capacity)
+{
+    capacity = max(capacity, PAGE_SIZE);
+    if (is_power_of_two(capacity))
+        return capacity;
+    return static_cast<size_t>(1) << (sizeof(size_t) * 8 - count_leading_zeroes(capacity));
+}
+
+ErrorOr<NonnullOwnPtr<PipeBuffer>> PipeBuffer::try_create(StringView name, size_t capacity)
+{
+    capacity = round_up_capacity(capacity);
+    auto storage = TRY(KBuffer::try_create_with_size(name, capacity, Memory::Region::Access::ReadWrite));
+    return adopt_nonnull_own_or_enomem(new (nothrow) PipeBuffer(name, capacity, move(storage)));
+}
+
+PipeBuffer::PipeBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage)
+    : m_name(name)
+    , m_storage(move(storage))
+    , m_capacity(capacity)
+{
+}
+
+ErrorOr<size_t> PipeBuffer::write(UserOrKernelBuffer const& data, size_t size)
+{
+    if (!size)
+        return 0;
+    MutexLocker locker(m_lock);
+    bool was_empty = m_used_bytes == 0;
+
+    size_t bytes_to_write = min(size, space_for_writing());
+    size_t nwritten = 0;
+    // NOTE: At most two copies are needed, one up to the end of the ring and one from its start.
+    while (nwritten < bytes_to_write) {
+        auto offset = offset_in_ring(m_write_position);
+        auto chunk_size = min(bytes_to_write - nwritten, m_capacity - offset);
+        TRY(data.read(m_storage->data() + offset, nwritten, chunk_size));
+        m_write_position += chunk_size;
+        m_used_bytes += chunk_size;
+        nwritten += chunk_size;
+    }
+
+    if (m_unblock_callback && was_empty && nwritten > 0)
+        m_unblock_callback();
+    return nwritten;
+}
+
+ErrorOr<size_t> PipeBuffer::read(UserOrKernelBuffer& data, size_t size)
+{
+    if (!size)
+        return 0;
+    MutexLocker locker(m_lock);
+    bool writers_were_blocked = space_for_writing() < writer_wakeup_threshold();
+
+    size_t bytes_to_read = min(size, m_used_bytes);
+    size_t nread = 0;
+    while (nread < bytes_to_read) {
+        auto offset = offset_in_ring(m_read_position);
+        auto chunk_size = min(bytes_to_read - nread, m_capacity - offset);
+        TRY(data.write(m_storage->data() + offset, nread, chunk_size));
+        m_read_position += chunk_size;
+        m_used_bytes -= chunk_size;
+        nread += chunk_size;
+    }
+
+    if (m_unblock_callback && writers_were_blocked && space_for_writing() >= writer_wakeup_threshold())
+        m_unblock_callback();
+    return nread;
+}
+
+ErrorOr<size_t> PipeBuffer::try_resize(size_t requested_capacity)
+{
+    auto new_capacity = round_up_capacity(requested_capacity);
+
+    MutexLocker locker(m_lock);
+    if (new_capacity == m_capacity)
+        return m_capacity;
+    if (new_capacity < m_used_bytes)
+        return EBUSY;
+
+    auto new_storage = TRY(KBuffer::try_create_with_size(m_name, new_capacity, Memory::Region::Access::ReadWrite));
+    for (size_t copied = 0; copied < m_used_bytes;) {
+        auto offset = offset_in_ring(m_read_position + copied);
+        auto chunk_size = min(m_used_bytes - copied, m_capacity - offset);
+        memcpy(new_storage->data() + copied, m_storage->data() + offset, chunk_size);
+        copied += chunk_size;
+    }
+
+    bool writers_were_blocked = space_for_writing() < writer_wakeup_threshold();
+    m_storage = move(new_storage);
+    m_capacity = new_capacity;
+    m_read_position = 0;
+    m_write_position = m_used_bytes;
+
+    if (m_unblock_callback && writers_were_blocked && space_for_writing() >= writer_wakeup_threshold())
+        m_unblock_callback();
+    return m_capacity;
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Types.h>
+#include <Kernel/Library/KBuffer.h>
+#include <Kernel/Library/UserOrKernelBuffer.h>
+#include <Kernel/Locking/Mutex.h>
+#include <Kernel/Memory/MemoryManager.h>
+
+namespace Kernel {
+
+// A ring of whole pages backing a pipe or FIFO.
+// Unlike DoubleBuffer, the whole capacity is usable for buffered data, and the capacity can be changed
+// while the pipe is in use. To keep pipelines from waking up for every small transfer, the unblock
+// callback only fires when a reader could not have made progress before (the ring was empty), or
+// when at least a page of space has become available for a blocked writer.
+class PipeBuffer {
+public:
+    static constexpr size_t default_capacity = 64 * KiB;
+    static constexpr size_t max_unprivileged_capacity = 1 * MiB;
+    static constexpr size_t max_capacity = 16 * MiB;
+
+    static ErrorOr<NonnullOwnPtr<PipeBuffer>> try_create(StringView name, size_t capacity = default_capacity);
+
+    ErrorOr<size_t> write(UserOrKernelBuffer const&, size_t);
+    ErrorOr<size_t> read(UserOrKernelBuffer&, size_t);
+
+    // Rounds the requested capacity up to a power-of-two number of pages. Fails with EBUSY if the
+    // currently buffered data would not fit.
+    ErrorOr<size_t> try_resize(size_t requested_capacity);
+
+    bool is_empty() const { return m_used_bytes == 0; }
+    size_t capacity() const { return m_capacity; }
+    size_t space_for_writing() const { return m_capacity - m_used_bytes; }
+
+    // Writers are only considered unblocked once this much space is available.
+    size_t writer_wakeup_threshold() const { return min(PAGE_SIZE, m_capacity); }
+
+    void set_unblock_callback(Function<void()> callback)
+    {
+        VERIFY(!m_unblock_callback);
+        m_unblock_callback = move(callback);
+    }
+
+private:
+    PipeBuffer(StringView name, size_t capacity, NonnullOwnPtr<KBuffer> storage);
+
+    static size_t round_up_capacity(size_t);
+
+    size_t offset_in_ring(u64 position) const { return position & (m_capacity - 1); }
+
+    StringView m_name;
+    NonnullOwnPtr<KBuffer> m_storage;
+    Function<void()> m_unblock_callback;
+    size_t m_capacity { 0 };
+
+    // Free-running positions, so the ring never needs to be compacted.
+    u64 m_read_position { 0 };
+    u64 m_write_position { 0 };
+    size_t m_used_bytes { 0 };
+
+    mutable Mutex m_lock { "PipeBuffer"sv };
+};
+
+}
@@ -11,6 +11,7 @@
 #include <Kernel/Net/NetworkAdapter.h>
 #include <Kernel/Net/NetworkingManagement.h>
 #include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
@@ -25,6 +26,7 @@ void NetworkAdapter::send_packet(ReadonlyBytes packet)
 {
     m_packets_out++;
     m_bytes_out += packet.size();
+    Tracepoints::record(TracepointCategory::Network, Tracepoint::PacketTransmit, packet.size());
     send_raw(packet);
 }
 
@@ -74,6 +76,7 @@ void NetworkAdapter::did_receive(ReadonlyBytes payload)
     InterruptDisabler disabler;
     m_packets_in++;
     m_bytes_in += payload.size();
+    Tracepoints::record(TracepointCategory::Network, Tracepoint::PacketReceive, payload.size());
 
     if (m_packet_queue_size == max_packet_buffers) {
         // FIXME: Keep track of the number of dropped packets
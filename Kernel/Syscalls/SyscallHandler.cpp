@@ -15,6 +15,7 @@
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
 #include <Kernel/Tasks/ThreadTracer.h>
+#include <Kernel/Tasks/Tracepoints.h>
 
 namespace Kernel {
 
@@ -165,7 +166,9 @@ NEVER_INLINE void syscall_handler(TrapFrame* trap)
     FlatPtr arg4;
     regs.capture_syscall_params(function, arg1, arg2, arg3, arg4);
 
+    Tracepoints::record(TracepointCategory::Syscall, Tracepoint::SyscallEnter, function);
     auto result = Syscall::handle(regs, function, arg1, arg2, arg3, arg4);
+    Tracepoints::record(TracepointCategory::Syscall, Tracepoint::SyscallExit, function, result.is_error() ? static_cast<FlatPtr>(-result.error().code()) : result.value());
 
     if (result.is_error()) {
         regs.set_return_reg(-result.error().code());
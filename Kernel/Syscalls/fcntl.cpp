@@ -51,6 +51,18 @@ ErrorOr<FlatPtr> Process::sys$fcntl(int fd, int cmd, uintptr_t arg)
     case F_SETLKW:
         TRY(description->apply_flock(Process::current(), Userspace<flock const*>(arg), ShouldBlock::Yes));
         return 0;
+    case F_GETPIPE_SZ: {
+        auto* fifo = description->fifo();
+        if (!fifo)
+            return EBADF;
+        return fifo->buffer_size();
+    }
+    case F_SETPIPE_SZ: {
+        auto* fifo = description->fifo();
+        if (!fifo)
+            return EBADF;
+        return TRY(fifo->set_buffer_size(arg, *credentials()));
+    }
     default:
         return EINVAL;
     }
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Tasks/Coredump.h>
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
@@ -15,6 +17,8 @@ namespace Kernel {
 bool g_profiling_all_threads;
 PerformanceEventBuffer* g_global_perf_events;
 u64 g_profiling_event_mask;
+// Whether the session that profiles all threads holds a reference to the hardware performance counters.
+static bool s_profiling_all_threads_uses_hardware_counters;
 
 ErrorOr<FlatPtr> Process::sys$profiling_enable(pid_t pid, u64 event_mask)
 {
@@ -24,6 +28,26 @@ ErrorOr<FlatPtr> Process::sys$profiling_enable(pid_t pid, u64 event_mask)
     return profiling_enable(pid, event_mask);
 }
 
+// Returns whether a reference to the hardware performance counters was taken.
+static ErrorOr<bool> enable_hardware_counters_if_needed(u64 event_mask)
+{
+    if ((event_mask & PERF_EVENT_MASK_HARDWARE_COUNTERS) == 0)
+        return false;
+    // NOTE: Emulators and some CPUs don't expose usable counters. Userspace is expected
+    //       to fall back to timer-based sampling when it gets ENOTSUP here.
+    TRY(arch_enable_performance_counters(event_mask));
+    return true;
+}
+
+// Hands the reference to the hardware performance counters that a (re-)enabled profiling session took over to the
+// session, and drops the one it held before, if any.
+static void set_session_uses_hardware_counters(bool& session_uses_hardware_counters, bool uses_hardware_counters)
+{
+    if (session_uses_hardware_counters)
+        arch_disable_performance_counters();
+    session_uses_hardware_counters = uses_hardware_counters;
+}
+
 // NOTE: This second entrypoint exists to allow the kernel to invoke the syscall to enable boot profiling.
 ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
 {
@@ -33,6 +57,11 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         auto credentials = this->credentials();
         if (!credentials->is_superuser())
             return EPERM;
+        auto uses_hardware_counters = TRY(enable_hardware_counters_if_needed(event_mask));
+        ArmedScopeGuard release_hardware_counters([&] {
+            if (uses_hardware_counters)
+                arch_disable_performance_counters();
+        });
         ScopedCritical critical;
         g_profiling_event_mask = PERF_EVENT_PROCESS_CREATE | PERF_EVENT_THREAD_CREATE | PERF_EVENT_MMAP;
         if (g_global_perf_events) {
@@ -55,6 +84,8 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
             return {};
         }));
         g_profiling_event_mask = event_mask;
+        release_hardware_counters.disarm();
+        set_session_uses_hardware_counters(s_profiling_all_threads_uses_hardware_counters, uses_hardware_counters);
         return 0;
     }
 
@@ -67,6 +98,11 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
     auto profile_process_credentials = process->credentials();
     if (!credentials->is_superuser() && profile_process_credentials->uid() != credentials->euid())
         return EPERM;
+    auto uses_hardware_counters = TRY(enable_hardware_counters_if_needed(event_mask));
+    ArmedScopeGuard release_hardware_counters([&] {
+        if (uses_hardware_counters)
+            arch_disable_performance_counters();
+    });
     SpinlockLocker lock(g_profiling_lock);
     g_profiling_event_mask = PERF_EVENT_PROCESS_CREATE | PERF_EVENT_THREAD_CREATE | PERF_EVENT_MMAP;
     process->set_profiling(true);
@@ -79,6 +115,8 @@ ErrorOr<FlatPtr> Process::profiling_enable(pid_t pid, u64 event_mask)
         process->set_profiling(false);
         return ENOTSUP;
     }
+    release_hardware_counters.disarm();
+    set_session_uses_hardware_counters(process->m_profiling_uses_hardware_counters, uses_hardware_counters);
     return 0;
 }
 
@@ -91,6 +129,7 @@ ErrorOr<FlatPtr> Process::sys$profiling_disable(pid_t pid)
         auto credentials = this->credentials();
         if (!credentials->is_superuser())
             return EPERM;
+        set_session_uses_hardware_counters(s_profiling_all_threads_uses_hardware_counters, false);
         ScopedCritical critical;
         if (!TimeManagement::the().disable_profile_timer())
             return ENOTSUP;
@@ -108,6 +147,7 @@ ErrorOr<FlatPtr> Process::sys$profiling_disable(pid_t pid)
     SpinlockLocker lock(g_profiling_lock);
     if (!process->is_profiling())
         return EINVAL;
+    set_session_uses_hardware_counters(process->m_profiling_uses_hardware_counters, false);
     // FIXME: If we enabled the profile timer and it's not supported, how do we disable it now?
     if (!TimeManagement::the().disable_profile_timer())
         return ENOTSUP;
@@ -163,6 +163,12 @@ ErrorOr<void> PerformanceEventBuffer::append_with_ip_and_bp(ProcessID pid, Threa
     case PERF_EVENT_FILESYSTEM:
         event.data.filesystem = filesystem_event;
         break;
+    case PERF_EVENT_CPU_CYCLES:
+    case PERF_EVENT_INSTRUCTIONS:
+    case PERF_EVENT_CACHE_MISSES:
+    case PERF_EVENT_BRANCH_MISSES:
+        event.data.hardware_sample.period = arg1;
+        break;
     default:
         return EINVAL;
     }
@@ -337,6 +343,22 @@ ErrorOr<void> PerformanceEventBuffer::to_json_impl(Serializer& object) const
             }
             }
             break;
+        case PERF_EVENT_CPU_CYCLES:
+            TRY(event_object.add("type"sv, "cpu_cycles"sv));
+            TRY(event_object.add("period"sv, event.data.hardware_sample.period));
+            break;
+        case PERF_EVENT_INSTRUCTIONS:
+            TRY(event_object.add("type"sv, "instructions"sv));
+            TRY(event_object.add("period"sv, event.data.hardware_sample.period));
+            break;
+        case PERF_EVENT_CACHE_MISSES:
+            TRY(event_object.add("type"sv, "cache_misses"sv));
+            TRY(event_object.add("period"sv, event.data.hardware_sample.period));
+            break;
+        case PERF_EVENT_BRANCH_MISSES:
+            TRY(event_object.add("type"sv, "branch_misses"sv));
+            TRY(event_object.add("period"sv, event.data.hardware_sample.period));
+            break;
         }
         TRY(event_object.add("pid"sv, event.pid));
         TRY(event_object.add("tid"sv, event.tid));
@@ -68,6 +68,16 @@ public:
         }
     }
 
+    static void add_hardware_sample_event(Thread& current_thread, RegisterState const& regs, int type, u64 period)
+    {
+        if (current_thread.is_profiling_suppressed())
+            return;
+        if (auto* event_buffer = current_thread.process().current_perf_events_buffer()) {
+            [[maybe_unused]] auto rc = event_buffer->append_with_ip_and_bp(
+                current_thread.pid(), current_thread.tid(), regs, type, 0, period, 0, {});
+        }
+    }
+
     static void add_mmap_perf_event(Process& current_process, Memory::Region const& region)
     {
         if (auto* event_buffer = current_process.current_perf_events_buffer()) {
@@ -13,6 +13,7 @@
 #include <Kernel/API/POSIX/sys/limits.h>
 #include <Kernel/API/Syscall.h>
 #include <Kernel/Arch/PageDirectory.h>
+#include <Kernel/Arch/PerformanceCounters.h>
 #include <Kernel/Debug.h>
 #include <Kernel/Devices/DeviceManagement.h>
 #include <Kernel/Devices/Generic/NullDevice.h>
@@ -855,6 +856,11 @@ void Process::finalize()
         }
     }
 
+    if (m_profiling_uses_hardware_counters) {
+        arch_disable_performance_counters();
+        m_profiling_uses_hardware_counters = false;
+    }
+
     m_threads_for_coredump.clear();
 
     m_alarm_timer.with([&](auto& timer) {
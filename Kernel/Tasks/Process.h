@@ -927,6 +927,8 @@ private:
     bool const m_is_kernel_process;
     Atomic<State> m_state { State::Running };
     bool m_profiling { false };
+    // Whether the profiling session of this process holds a reference to the hardware performance counters.
+    bool m_profiling_uses_hardware_counters { false };
     Atomic<bool, AK::MemoryOrder::memory_order_relaxed> m_is_stopped { false };
     bool m_should_generate_coredump { false };
 
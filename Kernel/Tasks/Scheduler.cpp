@@ -16,6 +16,7 @@
 #include <Kernel/Tasks/PerformanceManager.h>
 #include <Kernel/Tasks/Process.h>
 #include <Kernel/Tasks/Scheduler.h>
+#include <Kernel/Tasks/Tracepoints.h>
 #include <Kernel/Time/TimeManagement.h>
 #include <Kernel/kstdio.h>
 
@@ -293,6 +294,7 @@ void Scheduler::context_switch(Thread* thread)
     thread->set_state(Thread::State::Running);
 
     PerformanceManager::add_context_switch_perf_event(*from_thread, *thread);
+    Tracepoints::record(TracepointCategory::Scheduler, Tracepoint::ContextSwitch, thread->pid().value(), thread->tid().value());
 
     proc.switch_context(from_thread, thread);
 
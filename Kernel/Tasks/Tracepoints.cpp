@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/JsonArraySerializer.h>
+#include <AK/JsonObjectSerializer.h>
+#include <Kernel/Arch/Processor.h>
+#include <Kernel/Interrupts/InterruptDisabler.h>
+#include <Kernel/Library/KBufferBuilder.h>
+#include <Kernel/Library/KString.h>
+#include <Kernel/Tasks/Thread.h>
+#include <Kernel/Tasks/Tracepoints.h>
+#include <Kernel/Time/TimeManagement.h>
+
+namespace Kernel {
+
+Atomic<u32> Tracepoints::s_enabled_categories { 0 };
+
+static Array<Atomic<TraceRing*>, MAX_CPU_COUNT> s_trace_rings {};
+
+static constexpr StringView tracepoint_name(Tracepoint tracepoint)
+{
+    switch (tracepoint) {
+#define __ENUMERATE_TRACEPOINT(type, name, category) \
+    case Tracepoint::type:                           \
+        return #name##sv;
+        ENUMERATE_TRACEPOINTS(__ENUMERATE_TRACEPOINT)
+#undef __ENUMERATE_TRACEPOINT
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static constexpr struct {
+    StringView name;
+    TracepointCategory category;
+} s_category_names[] = {
+    { "scheduler"sv, TracepointCategory::Scheduler },
+    { "page_fault"sv, TracepointCategory::PageFault },
+    { "syscall"sv, TracepointCategory::Syscall },
+    { "block_io"sv, TracepointCategory::BlockIO },
+    { "network"sv, TracepointCategory::Network },
+};
+
+ErrorOr<TracepointCategory> Tracepoints::parse_categories(StringView categories)
+{
+    auto result = TracepointCategory::None;
+    TRY(categories.for_each_split_view(',', SplitBehavior::Nothing, [&](StringView name) -> ErrorOr<void> {
+        name = name.trim_whitespace();
+        if (name == "all"sv) {
+            result |= TracepointCategory::All;
+            return {};
+        }
+        if (name == "none"sv)
+            return {};
+        for (auto const& entry : s_category_names) {
+            if (entry.name == name) {
+                result |= entry.category;
+                return {};
+            }
+        }
+        return EINVAL;
+    }));
+    return result;
+}
+
+ErrorOr<NonnullOwnPtr<KString>> Tracepoints::serialize_categories(TracepointCategory categories)
+{
+    if (categories == TracepointCategory::None)
+        return KString::try_create("none"sv);
+    auto builder = TRY(KBufferBuilder::try_create());
+    bool first = true;
+    for (auto const& entry : s_category_names) {
+        if (!has_flag(categories, entry.category))
+            continue;
+        if (!first)
+            TRY(builder.append(','));
+        TRY(builder.append(entry.name));
+        first = false;
+    }
+    auto buffer = builder.build();
+    if (!buffer)
+        return ENOMEM;
+    return KString::try_create(StringView { buffer->bytes() });
+}
+
+ErrorOr<void> Tracepoints::set_enabled_categories(TracepointCategory categories)
+{
+    if (categories != TracepointCategory::None) {
+        // NOTE: Rings are allocated on first use and never freed, so a producer that
+        //       observed a non-null ring pointer can keep using it without synchronization.
+        for (size_t cpu = 0; cpu < Processor::count(); ++cpu) {
+            if (s_trace_rings[cpu].load(AK::memory_order_acquire))
+                continue;
+            auto* ring = new (nothrow) TraceRing;
+            if (!ring)
+                return ENOMEM;
+            TraceRing* expected = nullptr;
+            if (!s_trace_rings[cpu].compare_exchange_strong(expected, ring, AK::memory_order_acq_rel))
+                delete ring;
+        }
+    }
+    s_enabled_categories.store(to_underlying(categories), AK::memory_order_relaxed);
+    return {};
+}
+
+void Tracepoints::record_slow(Tracepoint tracepoint, FlatPtr arg1, FlatPtr arg2)
+{
+    if (!TimeManagement::is_initialized())
+        return;
+
+    TraceEvent event;
+    event.tracepoint = tracepoint;
+    event.arg1 = arg1;
+    event.arg2 = arg2;
+    event.timestamp_ns = TimeManagement::the().monotonic_time(TimePrecision::Precise).nanoseconds();
+    if (auto* current_thread = Thread::current()) {
+        event.pid = current_thread->pid().value();
+        event.tid = current_thread->tid().value();
+    } else {
+        event.pid = 0;
+        event.tid = 0;
+    }
+
+    // NOTE: With interrupts disabled we are the only producer for this processor's ring.
+    InterruptDisabler disabler;
+    auto* ring = s_trace_rings[Processor::current_id()].load(AK::memory_order_acquire);
+    if (!ring)
+        return;
+    (void)ring->try_append(event);
+}
+
+ErrorOr<void> Tracepoints::drain_to_json(KBufferBuilder& builder)
+{
+    auto object = TRY(JsonObjectSerializer<>::try_create(builder));
+    auto categories = TRY(serialize_categories(enabled_categories()));
+    TRY(object.add("categories"sv, categories->view()));
+
+    u64 lost_events = 0;
+    auto events = TRY(object.add_array("events"sv));
+    for (size_t cpu = 0; cpu < Processor::count(); ++cpu) {
+        auto* ring = s_trace_rings[cpu].load(AK::memory_order_acquire);
+        if (!ring)
+            continue;
+        lost_events += ring->take_lost_events();
+        TRY(ring->drain([&](TraceEvent const& event) -> ErrorOr<void> {
+            auto event_object = TRY(events.add_object());
+            TRY(event_object.add("type"sv, tracepoint_name(event.tracepoint)));
+            TRY(event_object.add("cpu"sv, cpu));
+            TRY(event_object.add("timestamp"sv, event.timestamp_ns));
+            TRY(event_object.add("pid"sv, event.pid));
+            TRY(event_object.add("tid"sv, event.tid));
+            TRY(event_object.add("arg1"sv, static_cast<u64>(event.arg1)));
+            TRY(event_object.add("arg2"sv, static_cast<u64>(event.arg2)));
+            TRY(event_object.finish());
+            return {};
+        }));
+    }
+    TRY(events.finish());
+    TRY(object.add("lost_events"sv, lost_events));
+    TRY(object.finish());
+    return {};
+}
+
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/EnumBits.h>
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringView.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+class KBufferBuilder;
+class KString;
+
+enum class TracepointCategory : u32 {
+    None = 0,
+    Scheduler = 1 << 0,
+    PageFault = 1 << 1,
+    Syscall = 1 << 2,
+    BlockIO = 1 << 3,
+    Network = 1 << 4,
+    All = Scheduler | PageFault | Syscall | BlockIO | Network,
+};
+
+AK_ENUM_BITWISE_OPERATORS(TracepointCategory);
+
+#define ENUMERATE_TRACEPOINTS(T)                             \
+    T(ContextSwitch, context_switch, Scheduler)              \
+    T(PageFault, page_fault, PageFault)                      \
+    T(SyscallEnter, syscall_enter, Syscall)                  \
+    T(SyscallExit, syscall_exit, Syscall)                    \
+    T(BlockReadStart, block_read_start, BlockIO)             \
+    T(BlockWriteStart, block_write_start, BlockIO)           \
+    T(BlockRequestComplete, block_request_complete, BlockIO) \
+    T(PacketReceive, packet_receive, Network)                \
+    T(PacketTransmit, packet_transmit, Network)
+
+enum class Tracepoint : u8 {
+#define __ENUMERATE_TRACEPOINT(type, name, category) type,
+    ENUMERATE_TRACEPOINTS(__ENUMERATE_TRACEPOINT)
+#undef __ENUMERATE_TRACEPOINT
+};
+
+// NOTE: This is deliberately much smaller than a PerformanceEvent (no backtrace),
+//       so that tracepoints can stay enabled on hot paths without perturbing them.
+struct TraceEvent {
+    u64 timestamp_ns;
+    FlatPtr arg1;
+    FlatPtr arg2;
+    u32 pid;
+    u32 tid;
+    Tracepoint tracepoint;
+};
+
+// A single-producer, single-consumer ring of trace events.
+// Each processor owns one ring and is the only producer for it (with interrupts disabled),
+// while /sys/kernel/trace is the only consumer. Head and tail are free-running counters,
+// so neither side ever needs to take a lock.
+class TraceRing {
+    AK_MAKE_NONCOPYABLE(TraceRing);
+    AK_MAKE_NONMOVABLE(TraceRing);
+
+public:
+    static constexpr size_t capacity = 4096;
+    static_assert(is_power_of_two(capacity));
+
+    TraceRing() = default;
+
+    bool try_append(TraceEvent const& event)
+    {
+        auto head = m_head.load(AK::memory_order_relaxed);
+        auto tail = m_tail.load(AK::memory_order_acquire);
+        if (head - tail >= capacity) {
+            m_lost_events.fetch_add(1, AK::memory_order_relaxed);
+            return false;
+        }
+        m_events[head & (capacity - 1)] = event;
+        m_head.store(head + 1, AK::memory_order_release);
+        return true;
+    }
+
+    template<typename Callback>
+    ErrorOr<void> drain(Callback callback)
+    {
+        auto tail = m_tail.load(AK::memory_order_relaxed);
+        auto head = m_head.load(AK::memory_order_acquire);
+        ScopeGuard consume_events = [&] {
+            m_tail.store(tail, AK::memory_order_release);
+        };
+        for (; tail != head; ++tail)
+            TRY(callback(m_events[tail & (capacity - 1)]));
+        return {};
+    }
+
+    u64 take_lost_events() { return m_lost_events.exchange(0, AK::memory_order_relaxed); }
+
+private:
+    Atomic<u64> m_head { 0 };
+    Atomic<u64> m_tail { 0 };
+    Atomic<u64> m_lost_events { 0 };
+    TraceEvent m_events[capacity];
+};
+
+class Tracepoints {
+public:
+    ALWAYS_INLINE static bool is_enabled(TracepointCategory category)
+    {
+        return has_flag(static_cast<TracepointCategory>(s_enabled_categories.load(AK::memory_order_relaxed)), category);
+    }
+
+    ALWAYS_INLINE static void record(TracepointCategory category, Tracepoint tracepoint, FlatPtr arg1 = 0, FlatPtr arg2 = 0)
+    {
+        if (!is_enabled(category))
+            return;
+        record_slow(tracepoint, arg1, arg2);
+    }
+
+    static TracepointCategory enabled_categories() { return static_cast<TracepointCategory>(s_enabled_categories.load()); }
+    static ErrorOr<void> set_enabled_categories(TracepointCategory);
+
+    static ErrorOr<TracepointCategory> parse_categories(StringView);
+    static ErrorOr<NonnullOwnPtr<KString>> serialize_categories(TracepointCategory);
+
+    // Moves every pending event out of the per-processor rings into a JSON object.
+    static ErrorOr<void> drain_to_json(KBufferBuilder&);
+
+private:
+    static void record_slow(Tracepoint, FlatPtr arg1, FlatPtr arg2);
+
+    static Atomic<u32> s_enabled_categories;
+};
+
+}
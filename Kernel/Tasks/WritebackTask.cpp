@@ -0,0 +1,48 @@
+/*
+ * Copyright (c) 2020, Andreas Kling <kling@serenityos.org>
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Singleton.h>
+#include <Kernel/FileSystem/Inode.h>
+#include <Kernel/FileSystem/VirtualFileSystem.h>
+#include <Kernel/Sections.h>
+#include <Kernel/Tasks/Process.h>
+#include <Kernel/Tasks/WaitQueue.h>
+#include <Kernel/Tasks/WritebackTask.h>
+
+namespace Kernel {
+
+static Singleton<WaitQueue> s_writeback_wait_queue;
+static WritebackStatistics s_statistics;
+
+WritebackStatistics& WritebackTask::statistics()
+{
+    return s_statistics;
+}
+
+void WritebackTask::wake()
+{
+    s_writeback_wait_queue->wake_all();
+}
+
+UNMAP_AFTER_INIT void WritebackTask::spawn()
+{
+    MUST(Process::create_kernel_process("VFS Writeback Task"sv, [] {
+        dbgln("VFS WritebackTask is running");
+        while (!Process::current().is_dying()) {
+            Inode::sync_all();
+            VirtualFileSystem::the().writeback_filesystems();
+
+            auto timeout_time = interval;
+            auto timeout = Thread::BlockTimeout { false, &timeout_time };
+            [[maybe_unused]] auto result = s_writeback_wait_queue->wait_on(timeout, "WritebackTask"sv);
+        }
+        Process::current().sys$exit(0);
+        VERIFY_NOT_REACHED();
+    }));
+}
+
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace Kernel {
+
+struct WritebackStatistics {
+    Atomic<u64> blocks_written { 0 };
+    Atomic<u64> write_requests { 0 };
+    Atomic<u64> expired_writebacks { 0 };
+    Atomic<u64> background_writebacks { 0 };
+    Atomic<u64> throttled_writes { 0 };
+};
+
+// Periodically writes back dirty file system caches, oldest data first.
+// File systems can also wake it up early when they accumulate too much dirty data.
+class WritebackTask {
+public:
+    static constexpr Duration interval = Duration::from_seconds(1);
+    static constexpr Duration dirty_expire_time = Duration::from_seconds(5);
+
+    static void spawn();
+    static void wake();
+
+    static WritebackStatistics& statistics();
+};
+
+}
@@ -30,7 +30,7 @@ WebViewImplementationNative::WebViewImplementationNative(jobject thiz)
     // NOTE: m_java_instance's global ref is controlled by the JNI bindings
     create_client(WebView::EnableCallgrindProfiling::No);
 
-    on_ready_to_paint = [this]() {
+    on_ready_to_paint = [this](auto const&) {
         JavaEnvironment env(global_vm);
         env.get()->CallVoidMethod(m_java_instance, invalidate_layout_method);
     };
@@ -475,6 +475,9 @@
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Stacking Context Tree"
                                                 action:@selector(dumpStackingContextTree:)
                                          keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Rasterization Statistics"
+                                                action:@selector(dumpRasterizationStatistics:)
+                                         keyEquivalent:@""]];
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Style Sheets"
                                                 action:@selector(dumpStyleSheets:)
                                          keyEquivalent:@""]];
@@ -487,6 +490,9 @@
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Cookies"
                                                 action:@selector(dumpCookies:)
                                          keyEquivalent:@""]];
+    [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Script Timings"
+                                                action:@selector(dumpScriptTimings:)
+                                         keyEquivalent:@""]];
     [submenu addItem:[[NSMenuItem alloc] initWithTitle:@"Dump Local Storage"
                                                 action:@selector(dumpLocalStorage:)
                                          keyEquivalent:@""]];
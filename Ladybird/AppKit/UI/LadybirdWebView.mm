@@ -271,7 +271,7 @@ static void copy_data_to_clipboard(StringView data, NSPasteboardType pasteboard_
         [[self documentView] setFrameSize:NSMakeSize(content_size.width() * inverse_device_pixel_ratio, content_size.height() * inverse_device_pixel_ratio)];
     };
 
-    m_web_view_bridge->on_ready_to_paint = [self]() {
+    m_web_view_bridge->on_ready_to_paint = [self](auto const&) {
         [self setNeedsDisplay:YES];
     };
 
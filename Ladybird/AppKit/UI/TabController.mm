@@ -293,6 +293,11 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [self debugRequest:"dump-stacking-context-tree" argument:""];
 }
 
+- (void)dumpRasterizationStatistics:(id)sender
+{
+    [self debugRequest:"dump-rasterization-statistics" argument:""];
+}
+
 - (void)dumpStyleSheets:(id)sender
 {
     [self debugRequest:"dump-style-sheets" argument:""];
@@ -308,6 +313,11 @@ static NSString* const TOOLBAR_TAB_OVERVIEW_IDENTIFIER = @"ToolbarTabOverviewIde
     [self debugRequest:"dump-session-history" argument:""];
 }
 
+- (void)dumpScriptTimings:(id)sender
+{
+    [self debugRequest:"dump-script-timings" argument:""];
+}
+
 - (void)dumpLocalStorage:(id)sender
 {
     [self debugRequest:"dump-local-storage" argument:""];
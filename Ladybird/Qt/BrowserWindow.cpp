@@ -254,6 +254,13 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, WebView::Cook
         debug_request("dump-stacking-context-tree");
     });
 
+    auto* dump_rasterization_statistics_action = new QAction("Dump Rasteri&zation Statistics", this);
+    dump_rasterization_statistics_action->setIcon(load_icon_from_uri("resource://icons/16x16/layers.png"sv));
+    debug_menu->addAction(dump_rasterization_statistics_action);
+    QObject::connect(dump_rasterization_statistics_action, &QAction::triggered, this, [this] {
+        debug_request("dump-rasterization-statistics");
+    });
+
     auto* dump_style_sheets_action = new QAction("Dump &Style Sheets", this);
     dump_style_sheets_action->setIcon(load_icon_from_uri("resource://icons/16x16/filetype-css.png"sv));
     debug_menu->addAction(dump_style_sheets_action);
@@ -268,6 +275,13 @@ BrowserWindow::BrowserWindow(Vector<URL::URL> const& initial_urls, WebView::Cook
         debug_request("dump-all-resolved-styles");
     });
 
+    auto* dump_script_timings_action = new QAction("Dump Sc&ript Timings", this);
+    dump_script_timings_action->setIcon(load_icon_from_uri("resource://icons/16x16/filetype-javascript.png"sv));
+    debug_menu->addAction(dump_script_timings_action);
+    QObject::connect(dump_script_timings_action, &QAction::triggered, this, [this] {
+        debug_request("dump-script-timings");
+    });
+
     auto* dump_cookies_action = new QAction("Dump C&ookies", this);
     dump_cookies_action->setIcon(load_icon_from_uri("resource://icons/browser/cookie.png"sv));
     debug_menu->addAction(dump_cookies_action);
@@ -85,8 +85,11 @@ WebContentView::WebContentView(QWidget* window, WebContentOptions const& web_con
         horizontalScrollBar()->setPageStep(m_viewport_rect.width());
     };
 
-    on_ready_to_paint = [this]() {
-        viewport()->update();
+    on_ready_to_paint = [this](auto const& damage_rects) {
+        for (auto const& rect : damage_rects) {
+            QRectF logical_rect(rect.x() / m_device_pixel_ratio, rect.y() / m_device_pixel_ratio, rect.width() / m_device_pixel_ratio, rect.height() / m_device_pixel_ratio);
+            viewport()->update(logical_rect.toAlignedRect());
+        }
     };
 
     on_scroll_by_delta = [this](auto x_delta, auto y_delta) {
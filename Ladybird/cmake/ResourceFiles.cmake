@@ -27,6 +27,7 @@ set(16x16_ICONS
     filetype-folder-open.png
     filetype-html.png
     filetype-image.png
+    filetype-javascript.png
     filetype-sound.png
     filetype-video.png
     find.png
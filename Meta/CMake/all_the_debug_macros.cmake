@@ -72,6 +72,7 @@ set(HPET_COMPARATOR_DEBUG ON)
 set(HPET_DEBUG ON)
 set(HTML_SCRIPT_DEBUG ON)
 set(HTTPJOB_DEBUG ON)
+set(HTTP_CACHE_DEBUG ON)
 set(HUNKS_DEBUG ON)
 set(ICMP_DEBUG ON)
 set(ICO_DEBUG ON)
@@ -96,6 +97,7 @@ set(JOB_DEBUG ON)
 set(JPEG_DEBUG ON)
 set(JPEG2000_DEBUG ON)
 set(JS_BYTECODE_DEBUG ON)
+set(JS_INLINE_CACHE_DEBUG ON)
 set(JS_MODULE_DEBUG ON)
 set(KEYBOARD_DEBUG ON)
 set(KEYBOARD_SHORTCUTS_DEBUG ON)
@@ -7,6 +7,7 @@
 #include <LibTest/TestCase.h>
 
 #include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SIMDMath.h>
 
 // See the comment in <AK/SIMDMath.h>
@@ -34,3 +35,13 @@ TEST_CASE(exp_approximate)
     EXPECT(fabsf(result[2] - 1.82211880f) <= accuracy);
     EXPECT(fabsf(result[3] - 2.22554093f) <= accuracy);
 }
+
+TEST_CASE(maskbits_of_byte_comparison)
+{
+    using AK::SIMD::i8x16;
+    AK::SIMD::u8x16 v = { 'a', '<', 'b', 'c', 0, 'd', 'e', 0xc3, 0xbc, 'f', 'g', 'h', 'i', 'j', 'k', '<' };
+
+    EXPECT_EQ(AK::SIMD::maskbits(static_cast<i8x16>(v == '<')), 0b1000'0000'0000'0010u);
+    EXPECT_EQ(AK::SIMD::maskbits(static_cast<i8x16>(v == 0)), 0b0000'0000'0001'0000u);
+    EXPECT_EQ(AK::SIMD::maskbits(static_cast<i8x16>(v == 'z')), 0u);
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibTest/TestCase.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static constexpr int default_pipe_size = 64 * 1024;
+static constexpr int max_unprivileged_pipe_size = 1024 * 1024;
+
+TEST_CASE(pipe_size_defaults_and_growth)
+{
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    EXPECT_EQ(fcntl(fds[0], F_GETPIPE_SZ), default_pipe_size);
+
+    // Both ends share the same buffer.
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, 256 * 1024), 256 * 1024);
+    EXPECT_EQ(fcntl(fds[0], F_GETPIPE_SZ), 256 * 1024);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE(pipe_size_is_rounded_up)
+{
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    // Sizes are rounded up to a power-of-two number of pages, and never go below a page.
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, 100 * 1024), 128 * 1024);
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, 1), PAGE_SIZE);
+    EXPECT_EQ(fcntl(fds[0], F_GETPIPE_SZ), PAGE_SIZE);
+
+    errno = 0;
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE(pipe_cannot_shrink_below_buffered_data)
+{
+    int fds[2];
+    EXPECT_EQ(pipe(fds), 0);
+
+    Array<u8, 3 * PAGE_SIZE> data;
+    data.fill('x');
+    EXPECT_EQ(write(fds[1], data.data(), data.size()), static_cast<ssize_t>(data.size()));
+
+    errno = 0;
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, PAGE_SIZE), -1);
+    EXPECT_EQ(errno, EBUSY);
+    EXPECT_EQ(fcntl(fds[0], F_GETPIPE_SZ), default_pipe_size);
+
+    // Shrinking to a size that still holds everything keeps the data intact.
+    EXPECT_EQ(fcntl(fds[1], F_SETPIPE_SZ, 4 * PAGE_SIZE), 4 * PAGE_SIZE);
+    Array<u8, 3 * PAGE_SIZE> read_back;
+    EXPECT_EQ(read(fds[0], read_back.data(), read_back.size()), static_cast<ssize_t>(read_back.size()));
+    EXPECT_EQ(read_back, data);
+
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_CASE(pipe_size_unprivileged_limit)
+{
+    pid_t pid = fork();
+    EXPECT(pid >= 0);
+    if (pid == 0) {
+        // NOTE: Drop root privileges (if we have them), as the limit doesn't apply to the superuser.
+        if (geteuid() == 0 && setuid(100) < 0)
+            _exit(1);
+
+        int fds[2];
+        if (pipe(fds) < 0)
+            _exit(1);
+        if (fcntl(fds[1], F_SETPIPE_SZ, max_unprivileged_pipe_size) != max_unprivileged_pipe_size)
+            _exit(2);
+        errno = 0;
+        if (fcntl(fds[1], F_SETPIPE_SZ, 2 * max_unprivileged_pipe_size) != -1 || errno != EPERM)
+            _exit(3);
+        if (fcntl(fds[0], F_GETPIPE_SZ) != max_unprivileged_pipe_size)
+            _exit(4);
+        _exit(0);
+    }
+
+    int status = 0;
+    EXPECT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
@@ -10,6 +10,8 @@
 #include <LibGfx/Font/BitmapFont.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/OpenType/Glyf.h>
+#include <LibGfx/FontCascadeList.h>
+#include <LibGfx/TextShapingCache.h>
 #include <LibTest/TestCase.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -176,6 +178,56 @@ TEST_CASE(test_character_set_masking)
     EXPECT(masked_font->glyph_index(0xFFFD).value() == 0x1FD);
 }
 
+TEST_CASE(test_text_shaping_cache)
+{
+    init_font_database();
+    auto font = TRY_OR_FAIL(Gfx::BitmapFont::try_load_from_uri("resource://TestFont.font"sv));
+    auto font_list = Gfx::FontCascadeList::create();
+    font_list->add(font);
+
+    auto& cache = Gfx::TextShapingCache::the();
+    cache.clear();
+
+    Utf8View text { "Hello, friends!"sv };
+    Vector<Gfx::DrawGlyphOrEmoji> expected_glyphs;
+    float expected_width = 0;
+    Gfx::for_each_glyph_position(
+        { 0, 0 }, text, *font_list, [&](Gfx::DrawGlyphOrEmoji const& glyph_or_emoji) {
+            expected_glyphs.append(glyph_or_emoji);
+            return IterationDecision::Continue;
+        },
+        Gfx::IncludeLeftBearing::No, expected_width);
+
+    auto check_shaped_text = [&](Gfx::ShapedText const& shaped_text) {
+        EXPECT_EQ(shaped_text.width, expected_width);
+        EXPECT_EQ(shaped_text.glyphs.size(), expected_glyphs.size());
+        for (size_t i = 0; i < expected_glyphs.size(); ++i) {
+            auto const& glyph = shaped_text.glyphs[i].get<Gfx::DrawGlyph>();
+            auto const& expected_glyph = expected_glyphs[i].get<Gfx::DrawGlyph>();
+            EXPECT_EQ(glyph.position, expected_glyph.position);
+            EXPECT_EQ(glyph.code_point, expected_glyph.code_point);
+        }
+    };
+
+    check_shaped_text(cache.shape(text, *font_list));
+    EXPECT_EQ(cache.statistics().misses, 1u);
+
+    // NOTE: An equivalent font list (as every element gets its own) must hit the same entry.
+    auto other_font_list = Gfx::FontCascadeList::create();
+    other_font_list->add(font);
+    check_shaped_text(cache.shape(text, *other_font_list));
+    EXPECT_EQ(cache.statistics().hits, 1u);
+    EXPECT_EQ(cache.size(), 1u);
+
+    // A font list that picks fonts differently must not.
+    auto ranged_font_list = Gfx::FontCascadeList::create();
+    ranged_font_list->add(font, { { 'a', 'z' } });
+    ranged_font_list->add(font);
+    (void)cache.shape(text, *ranged_font_list);
+    EXPECT_EQ(cache.statistics().misses, 2u);
+    EXPECT_EQ(cache.size(), 2u);
+}
+
 TEST_CASE(resolve_glyph_path_containing_single_off_curve_point)
 {
     Vector<u8> glyph_data {
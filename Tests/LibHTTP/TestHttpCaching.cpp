@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibHTTP/Caching.h>
+#include <LibTest/TestCase.h>
+
+using ResponseHeaders = HashMap<ByteString, ByteString, CaseInsensitiveStringTraits>;
+
+static UnixDateTime date(StringView value)
+{
+    auto parsed_date = HTTP::parse_http_date(value);
+    VERIFY(parsed_date.has_value());
+    return *parsed_date;
+}
+
+TEST_CASE(parse_cache_control)
+{
+    auto cache_control = HTTP::parse_cache_control("public, max-age=3600, s-maxage=\"60\""sv);
+    EXPECT_EQ(cache_control.max_age, 3600);
+    EXPECT_EQ(cache_control.shared_max_age, 60);
+    EXPECT(!cache_control.no_store);
+    EXPECT(!cache_control.no_cache);
+    EXPECT(!cache_control.is_private);
+
+    cache_control = HTTP::parse_cache_control("No-Store,PRIVATE, no-cache=\"Set-Cookie\""sv);
+    EXPECT(cache_control.no_store);
+    EXPECT(cache_control.no_cache);
+    EXPECT(cache_control.is_private);
+    EXPECT(!cache_control.max_age.has_value());
+
+    // Negative ages count as zero, and invalid ones are ignored.
+    EXPECT_EQ(HTTP::parse_cache_control("max-age=-5"sv).max_age, 0);
+    EXPECT(!HTTP::parse_cache_control("max-age=soon"sv).max_age.has_value());
+    EXPECT(!HTTP::parse_cache_control("max-age"sv).max_age.has_value());
+}
+
+TEST_CASE(is_storable_response)
+{
+    ResponseHeaders headers;
+    headers.set("Cache-Control", "max-age=60");
+    EXPECT(HTTP::is_storable_response(200, headers));
+    EXPECT(HTTP::is_storable_response(404, headers));
+    EXPECT(!HTTP::is_storable_response(206, headers));
+    EXPECT(!HTTP::is_storable_response(500, headers));
+
+    // This is a private cache, so private responses can be stored.
+    headers.set("Cache-Control", "private, max-age=60");
+    EXPECT(HTTP::is_storable_response(200, headers));
+
+    headers.set("Cache-Control", "no-store, max-age=60");
+    EXPECT(!HTTP::is_storable_response(200, headers));
+
+    headers.set("Cache-Control", "max-age=60");
+    headers.set("Vary", "Accept-Encoding, *");
+    EXPECT(!HTTP::is_storable_response(200, headers));
+
+    // Responses that can neither be fresh nor be revalidated are not worth storing.
+    EXPECT(!HTTP::is_storable_response(200, {}));
+
+    ResponseHeaders validator_headers;
+    validator_headers.set("ETag", "\"abc\"");
+    EXPECT(HTTP::is_storable_response(200, validator_headers));
+}
+
+TEST_CASE(freshness_lifetime)
+{
+    auto response_time = date("Tue, 15 Oct 2024 12:00:00 GMT"sv);
+
+    ResponseHeaders headers;
+    headers.set("Cache-Control", "max-age=600");
+    headers.set("Expires", "Tue, 15 Oct 2024 13:00:00 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::from_seconds(600));
+
+    // s-maxage only applies to shared caches.
+    headers.set("Cache-Control", "s-maxage=60");
+    headers.set("Date", "Tue, 15 Oct 2024 12:00:00 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::from_seconds(60 * 60));
+
+    headers.set("Expires", "0");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::zero());
+
+    headers.set("Expires", "Tue, 15 Oct 2024 11:00:00 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::zero());
+}
+
+TEST_CASE(heuristic_freshness_lifetime)
+{
+    auto response_time = date("Tue, 15 Oct 2024 12:00:00 GMT"sv);
+
+    // 10% of the ten hours since the last modification.
+    ResponseHeaders headers;
+    headers.set("Date", "Tue, 15 Oct 2024 12:00:00 GMT");
+    headers.set("Last-Modified", "Tue, 15 Oct 2024 02:00:00 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::from_seconds(60 * 60));
+
+    // Without a Date header, the time the response was received is used.
+    headers.remove("Date");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time + Duration::from_seconds(10 * 60 * 60)), Duration::from_seconds(2 * 60 * 60));
+
+    headers.set("Date", "Tue, 15 Oct 2024 12:00:00 GMT");
+    headers.set("Last-Modified", "Wed, 16 Oct 2024 12:00:00 GMT");
+    EXPECT_EQ(HTTP::freshness_lifetime(headers, response_time), Duration::zero());
+
+    EXPECT_EQ(HTTP::freshness_lifetime({}, response_time), Duration::zero());
+}
+
+TEST_CASE(current_age)
+{
+    auto request_time = date("Tue, 15 Oct 2024 12:00:00 GMT"sv);
+    auto response_time = request_time + Duration::from_seconds(2);
+    auto now = response_time + Duration::from_seconds(100);
+
+    // Resident time plus the time the response took to arrive.
+    EXPECT_EQ(HTTP::current_age({}, request_time, response_time, now), Duration::from_seconds(102));
+
+    // The Age header is corrected by the response delay.
+    ResponseHeaders headers;
+    headers.set("Age", "30");
+    EXPECT_EQ(HTTP::current_age(headers, request_time, response_time, now), Duration::from_seconds(132));
+
+    // A Date header further in the past than the corrected Age is used instead.
+    headers.set("Date", "Tue, 15 Oct 2024 11:59:00 GMT");
+    EXPECT_EQ(HTTP::current_age(headers, request_time, response_time, now), Duration::from_seconds(162));
+
+    // A Date header in the future never makes the response younger.
+    headers.remove("Age");
+    headers.set("Date", "Tue, 15 Oct 2024 13:00:00 GMT");
+    EXPECT_EQ(HTTP::current_age(headers, request_time, response_time, now), Duration::from_seconds(102));
+
+    headers.set("Age", "-50");
+    EXPECT_EQ(HTTP::current_age(headers, request_time, response_time, now), Duration::from_seconds(102));
+}
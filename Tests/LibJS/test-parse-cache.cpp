@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/StringBuilder.h>
+#include <LibJS/AST.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Runtime/ECMAScriptFunctionObject.h>
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+static ByteString make_cacheable_source(StringView code)
+{
+    // NOTE: Only scripts of at least 4 KiB end up in the parse cache.
+    StringBuilder builder;
+    builder.append(code);
+    builder.append('\n');
+    while (builder.length() < 8 * KiB)
+        builder.append("// This comment makes the script big enough to be cached.\n"sv);
+    return builder.to_byte_string();
+}
+
+static JS::GCPtr<JS::Script> parse(StringView source, JS::Realm& realm, StringView filename, JS::Script::UseParseCache use_parse_cache = JS::Script::UseParseCache::Yes)
+{
+    auto script_or_error = JS::Script::parse(source, realm, filename, nullptr, 1, use_parse_cache);
+    if (script_or_error.is_error())
+        return nullptr;
+    return script_or_error.value();
+}
+
+static double run_and_get_number(JS::VM& vm, JS::Script& script)
+{
+    auto result = vm.bytecode_interpreter().run(script);
+    if (result.is_error() || !result.value().is_number())
+        return NAN;
+    return result.value().as_double();
+}
+
+static double global_number(JS::Realm& realm, char const* name)
+{
+    auto value = MUST(realm.global_object().get(JS::PropertyKey { name }));
+    return value.is_number() ? value.as_double() : NAN;
+}
+
+TEST_CASE(loading_the_same_script_again_is_a_cache_hit)
+{
+    auto vm = MUST(JS::VM::create());
+    auto source = make_cacheable_source("var counter = 0; function bump(by = 1) { counter += by; return counter; } bump(); bump(2);"sv);
+
+    auto first_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& first_realm = *first_context->realm;
+    auto first_script = parse(source, first_realm, "parse-cache-hit.js"sv);
+    EXPECT(first_script);
+    EXPECT_EQ(run_and_get_number(*vm, *first_script), 3.0);
+
+    auto second_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& second_realm = *second_context->realm;
+    auto second_script = parse(source, second_realm, "parse-cache-hit.js"sv);
+    EXPECT(second_script);
+
+    // A cache hit hands out the program that was parsed for the first realm.
+    EXPECT_EQ(&first_script->parse_node(), &second_script->parse_node());
+    EXPECT(second_script->parse_node().is_shared_between_realms());
+
+    // The script still runs against the globals of its own realm.
+    EXPECT_EQ(run_and_get_number(*vm, *second_script), 3.0);
+    EXPECT_EQ(global_number(first_realm, "counter"), 3.0);
+    EXPECT_EQ(global_number(second_realm, "counter"), 3.0);
+
+    EXPECT_EQ(run_and_get_number(*vm, *MUST(JS::Script::parse("bump(10);"sv, second_realm))), 13.0);
+    EXPECT_EQ(global_number(first_realm, "counter"), 3.0);
+
+    // The bytecode of functions in a shared program stays with the function objects of each realm.
+    auto bump = MUST(second_realm.global_object().get(JS::PropertyKey { "bump" }));
+    EXPECT(bump.is_function());
+    auto& bump_function = static_cast<JS::ECMAScriptFunctionObject&>(bump.as_function());
+    EXPECT(bump_function.bytecode_executable());
+    EXPECT(!bump_function.ecmascript_code().bytecode_executable());
+}
+
+TEST_CASE(scripts_are_only_shared_when_everything_matches)
+{
+    auto vm = MUST(JS::VM::create());
+    auto source = make_cacheable_source("var value = 42; value;"sv);
+
+    auto context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *context->realm;
+    auto script = parse(source, realm, "parse-cache-key.js"sv);
+    EXPECT(script);
+
+    auto script_with_other_filename = parse(source, realm, "parse-cache-other-key.js"sv);
+    EXPECT(script_with_other_filename);
+    EXPECT_NE(&script->parse_node(), &script_with_other_filename->parse_node());
+
+    auto script_without_cache = parse(source, realm, "parse-cache-key.js"sv, JS::Script::UseParseCache::No);
+    EXPECT(script_without_cache);
+    EXPECT_NE(&script->parse_node(), &script_without_cache->parse_node());
+    EXPECT(!script_without_cache->parse_node().is_shared_between_realms());
+
+    // Small scripts are cheap to parse, so they are never cached.
+    auto small_script = parse("1 + 1;"sv, realm, "parse-cache-small.js"sv);
+    auto small_script_again = parse("1 + 1;"sv, realm, "parse-cache-small.js"sv);
+    EXPECT(small_script && small_script_again);
+    EXPECT_NE(&small_script->parse_node(), &small_script_again->parse_node());
+
+    EXPECT_EQ(run_and_get_number(*vm, *script), 42.0);
+    EXPECT_EQ(run_and_get_number(*vm, *script_with_other_filename), 42.0);
+}
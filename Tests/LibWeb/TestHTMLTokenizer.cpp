@@ -8,6 +8,8 @@
 
 #include <LibCore/File.h>
 #include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <stdlib.h>
+#include <string.h>
 
 using Tokenizer = Web::HTML::HTMLTokenizer;
 using Token = Web::HTML::HTMLToken;
@@ -219,23 +221,128 @@ TEST_CASE(doctype)
     EXPECT_END_TAG_TOKEN(html, 23u, 27u);
 }
 
-// NOTE: This relies on the format of HTMLToken::to_string() staying the same.
-//       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
-TEST_CASE(regression)
+TEST_CASE(long_text_run)
 {
-    // This makes sure that the tests will run both on target and in Lagom.
-#ifdef AK_OS_SERENITY
-    StringView path = "/usr/Tests/LibWeb/tokenizer-test.html"sv;
-#else
-    StringView path = "tokenizer-test.html"sv;
-#endif
+    StringBuilder builder;
+    builder.append("<p>"sv);
+    for (size_t i = 0; i < 100; ++i)
+        builder.append("Text with\r\nlines, ümlauts and 🐞 bugs. "sv);
+    builder.append("</p>"sv);
+    auto tokens = run_tokenizer(builder.string_view());
+
+    StringBuilder text;
+    size_t line = 0;
+    size_t column = 3;
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(p, 1u, 2u);
+    while (current_token->is_character()) {
+        if (current_token->code_point() == '\n') {
+            ++line;
+            column = 0;
+        } else {
+            ++column;
+        }
+        EXPECT_EQ(current_token->start_position().line, line);
+        EXPECT_EQ(current_token->start_position().column, column);
+        text.append_code_point(current_token->code_point());
+        NEXT_TOKEN();
+    }
+    EXPECT_EQ(current_token->type(), Token::Type::EndTag);
+    EXPECT_EQ(current_token->start_position().line, 100u);
+    EXPECT_EQ(current_token->start_position().column, 29u);
+    NEXT_TOKEN();
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+
+    EXPECT_EQ(text.string_view(), builder.string_view().substring_view(3, builder.length() - 7).replace("\r\n"sv, "\n"sv, ReplaceMode::All));
+}
+
+TEST_CASE(attribute_value_with_special_characters)
+{
+    auto tokens = run_tokenizer("<p foo=\"ü&amp;\r\n🐞\" bar='a\0b'>"sv);
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_EQ(current_token->type(), Token::Type::StartTag);
+    NEXT_TOKEN();
+    EXPECT_TAG_TOKEN_ATTRIBUTE_COUNT(2);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(foo, "ü&\n🐞", 3u, 6u, 7u, 2u);
+    EXPECT_TAG_TOKEN_ATTRIBUTE(bar, "a\uFFFDb", 3u, 6u, 7u, 12u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+TEST_CASE(rcdata)
+{
+    Vector<Token> tokens;
+    Tokenizer tokenizer { "<title>Fish &amp; chips <b>ü</b></title>"sv, "UTF-8"sv };
+    while (true) {
+        auto maybe_token = tokenizer.next_token();
+        if (!maybe_token.has_value())
+            break;
+        if (maybe_token->is_start_tag() && maybe_token->tag_name() == "title"sv)
+            tokenizer.switch_to(Tokenizer::State::RCDATA);
+        tokens.append(maybe_token.release_value());
+    }
 
+    BEGIN_ENUMERATION(tokens);
+    EXPECT_START_TAG_TOKEN(title, 1u, 6u);
+    EXPECT_CHARACTER_TOKENS(Fish);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKEN('&');
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(chips);
+    EXPECT_CHARACTER_TOKEN(' ');
+    EXPECT_CHARACTER_TOKENS(<b>);
+    EXPECT_CHARACTER_TOKEN(0xFC);
+    EXPECT_CHARACTER_TOKENS(</b>);
+    EXPECT_END_TAG_TOKEN(title, 34u, 39u);
+    EXPECT_END_OF_FILE_TOKEN();
+    END_ENUMERATION();
+}
+
+static ByteString read_file(StringView path)
+{
     auto file = MUST(Core::File::open(path, Core::File::OpenMode::Read));
     auto file_size = MUST(file->size());
     auto content = MUST(ByteBuffer::create_uninitialized(file_size));
     MUST(file->read_until_filled(content.bytes()));
-    ByteString file_contents { content.bytes() };
-    auto tokens = run_tokenizer(file_contents);
+    return ByteString { content.bytes() };
+}
+
+static ByteString read_test_file()
+{
+    // This makes sure that the tests will run both on target and in Lagom.
+#ifdef AK_OS_SERENITY
+    return read_file("/usr/Tests/LibWeb/tokenizer-test.html"sv);
+#else
+    return read_file("tokenizer-test.html"sv);
+#endif
+}
+
+// NOTE: This relies on the format of HTMLToken::to_string() staying the same.
+//       If that changes, or something is added to the test HTML, the hash needs to be adjusted.
+TEST_CASE(regression)
+{
+    auto tokens = run_tokenizer(read_test_file());
     u32 hash = hash_tokens(tokens);
     EXPECT_EQ(hash, 3657343287u);
 }
+
+// NOTE: Set TOKENIZER_BENCHMARK_FILE to the path of a large real-world HTML file to measure with that instead.
+BENCHMARK_CASE(tokenize_large_document)
+{
+    ByteString input;
+    if (auto const* path = getenv("TOKENIZER_BENCHMARK_FILE")) {
+        input = read_file({ path, strlen(path) });
+    } else {
+        StringBuilder builder;
+        auto test_file = read_test_file();
+        for (size_t i = 0; i < 2000; ++i)
+            builder.append(test_file);
+        input = builder.to_byte_string();
+    }
+
+    for (size_t i = 0; i < 10; ++i) {
+        auto tokens = run_tokenizer(input);
+        EXPECT(!tokens.is_empty());
+    }
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/CommandExecutorCPU.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
+
+namespace Web::Painting {
+
+static constexpr Gfx::IntSize viewport_size { 800, 600 };
+
+static Color color_for_box(int index)
+{
+    return Color(index * 10, 255 - index * 10, 100);
+}
+
+static CommandList make_boxes_command_list(Optional<int> highlighted_box_index = {})
+{
+    CommandList command_list;
+    command_list.append(FillRect { { {}, viewport_size }, Color::White, {} }, {});
+    for (int i = 0; i < 20; ++i) {
+        auto color = i == highlighted_box_index ? Color::Magenta : color_for_box(i);
+        command_list.append(FillRect { { 20 + i * 37, 20 + i * 27, 50, 40 }, color, {} }, {});
+    }
+    return command_list;
+}
+
+static CommandList make_layer_command_list(int offset_x, float opacity)
+{
+    auto transform = Gfx::FloatMatrix4x4::identity();
+    transform.elements()[0][3] = offset_x;
+
+    CommandList command_list;
+    command_list.append(FillRect { { {}, viewport_size }, Color::White, {} }, {});
+    command_list.append(PushStackingContext { opacity, false, { 100, 100, 300, 300 }, {}, CSS::ImageRendering::Auto, { { 250, 250 }, transform } }, {});
+    for (int i = 0; i < 20; ++i)
+        command_list.append(FillRect { { 100 + i * 10, 100 + i * 7, 50, 40 }, color_for_box(i), {} }, {});
+    command_list.append(PopStackingContext {}, {});
+    return command_list;
+}
+
+static NonnullRefPtr<Gfx::Bitmap> create_target()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRx8888, viewport_size));
+    bitmap->fill(Color::Black);
+    return bitmap;
+}
+
+// Paints the command list in one go, which is what the tiled rasterizer has to produce.
+static NonnullRefPtr<Gfx::Bitmap> paint_fully(CommandList command_list)
+{
+    auto bitmap = create_target();
+    CommandExecutorCPU executor(*bitmap);
+    command_list.execute(executor);
+    return bitmap;
+}
+
+static size_t count_differing_pixels(Gfx::Bitmap const& a, Gfx::Bitmap const& b, int tolerance = 0)
+{
+    size_t count = 0;
+    for (int y = 0; y < a.height(); ++y) {
+        for (int x = 0; x < a.width(); ++x) {
+            auto pixel_a = a.get_pixel(x, y);
+            auto pixel_b = b.get_pixel(x, y);
+            if (abs(pixel_a.red() - pixel_b.red()) > tolerance || abs(pixel_a.green() - pixel_b.green()) > tolerance || abs(pixel_a.blue() - pixel_b.blue()) > tolerance)
+                ++count;
+        }
+    }
+    return count;
+}
+
+// NOTE: Compositing a layer rounds differently than painting its contents straight into the target.
+static size_t count_differing_composited_pixels(Gfx::Bitmap const& a, Gfx::Bitmap const& b)
+{
+    return count_differing_pixels(a, b, 1);
+}
+
+TEST_CASE(partial_repaint_matches_full_repaint)
+{
+    TiledRasterizer rasterizer;
+    auto target = create_target();
+
+    auto first_frame = make_boxes_command_list();
+    rasterizer.rasterize(first_frame, *target);
+    EXPECT_EQ(count_differing_pixels(*target, paint_fully(make_boxes_command_list())), 0u);
+
+    // Only the highlighted box is damaged, everything else has to stay as the first frame left it.
+    auto second_frame = make_boxes_command_list(7);
+    rasterizer.rasterize(second_frame, *target, Vector<Gfx::IntRect> { { 20 + 7 * 37, 20 + 7 * 27, 50, 40 } });
+    EXPECT_EQ(count_differing_pixels(*target, paint_fully(make_boxes_command_list(7))), 0u);
+    EXPECT(rasterizer.last_frame_statistics().undamaged_tile_count > 0);
+
+    // Undoing the change has to restore the first frame.
+    auto third_frame = make_boxes_command_list();
+    rasterizer.rasterize(third_frame, *target, Vector<Gfx::IntRect> { { 20 + 7 * 37, 20 + 7 * 27, 50, 40 } });
+    EXPECT_EQ(count_differing_pixels(*target, paint_fully(make_boxes_command_list())), 0u);
+}
+
+TEST_CASE(reused_compositing_layer_matches_full_repaint)
+{
+    TiledRasterizer rasterizer;
+    size_t reused_layer_count = 0;
+
+    for (int frame = 0; frame < 6; ++frame) {
+        // Move the layer around on every frame, and change its opacity once.
+        auto offset_x = frame * 13;
+        auto opacity = frame == 4 ? 0.3f : 0.5f;
+
+        auto target = create_target();
+        auto command_list = make_layer_command_list(offset_x, opacity);
+        rasterizer.rasterize(command_list, *target);
+        EXPECT_EQ(count_differing_composited_pixels(*target, paint_fully(make_layer_command_list(offset_x, opacity))), 0u);
+        reused_layer_count += rasterizer.last_frame_statistics().reused_compositing_layer_count;
+    }
+
+    EXPECT(reused_layer_count > 0);
+}
+
+}
@@ -0,0 +1 @@
+window.scriptAfterBlockingScriptDidRun = true;
@@ -366,6 +366,11 @@ void BrowserWindow::build_menus(StringView const man_file)
             active_tab().view().debug_request("dump-stacking-context-tree");
         },
         this));
+    debug_menu->add_action(GUI::Action::create(
+        "Dump Rasteri&zation Statistics", g_icon_bag.layers, [this](auto&) {
+            active_tab().view().debug_request("dump-rasterization-statistics");
+        },
+        this));
     debug_menu->add_action(GUI::Action::create(
         "Dump &Style Sheets", g_icon_bag.filetype_css, [this](auto&) {
             active_tab().view().debug_request("dump-style-sheets");
@@ -376,6 +381,11 @@ void BrowserWindow::build_menus(StringView const man_file)
             active_tab().view().debug_request("dump-all-resolved-styles");
         },
         this));
+    debug_menu->add_action(GUI::Action::create(
+        "Dump Sc&ript Timings", g_icon_bag.filetype_javascript, [this](auto&) {
+            active_tab().view().debug_request("dump-script-timings");
+        },
+        this));
     debug_menu->add_action(GUI::Action::create("Dump &History", { Mod_Ctrl, Key_H }, g_icon_bag.history, [this](auto&) {
         active_tab().view().debug_request("dump-session-history");
     }));
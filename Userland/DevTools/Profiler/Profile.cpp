@@ -32,6 +32,19 @@ static void sort_profile_nodes(Vector<NonnullRefPtr<ProfileNode>>& nodes)
         child->sort_children();
 }
 
+static Optional<HardwareCounter> hardware_counter_from_event_type(StringView type)
+{
+    if (type == "cpu_cycles"sv)
+        return HardwareCounter::CpuCycles;
+    if (type == "instructions"sv)
+        return HardwareCounter::Instructions;
+    if (type == "cache_misses"sv)
+        return HardwareCounter::CacheMisses;
+    if (type == "branch_misses"sv)
+        return HardwareCounter::BranchMisses;
+    return {};
+}
+
 Profile::Profile(Vector<Process> processes, Vector<Event> events)
     : m_processes(move(processes))
     , m_events(move(events))
@@ -121,7 +134,24 @@ void Profile::rebuild_tree()
             continue;
         }
 
-        m_filtered_event_indices.append(event_index);
+        // NOTE: Hardware counter samples are attributed to the same call tree, but they are weighted by their
+        //       sample period and kept out of the sample counts so that timer-based percentages stay meaningful.
+        auto const* hardware_sample = event.data.get_pointer<Event::HardwareSampleData>();
+        auto count_event = [&](ProfileNode& node) {
+            if (hardware_sample)
+                node.add_hardware_counter_sample(hardware_sample->counter, hardware_sample->period);
+            else
+                node.increment_event_count();
+        };
+        auto count_self = [&](ProfileNode& node, FlatPtr address) {
+            if (hardware_sample)
+                return;
+            node.add_event_address(address);
+            node.increment_self_count();
+        };
+
+        if (!hardware_sample)
+            m_filtered_event_indices.append(event_index);
 
         if (auto* malloc_data = event.data.get_pointer<Event::MallocData>(); malloc_data && !live_allocations.contains(malloc_data->ptr))
             continue;
@@ -146,7 +176,7 @@ void Profile::rebuild_tree()
         if (!m_show_top_functions) {
             ProfileNode* node = nullptr;
             auto& process_node = find_or_create_process_node(event.pid, event.serial);
-            process_node.increment_event_count();
+            count_event(process_node);
             for_each_frame([&](Frame const& frame, bool is_innermost_frame) {
                 auto const& object_name = frame.object_name;
                 auto const& symbol = frame.symbol;
@@ -161,16 +191,14 @@ void Profile::rebuild_tree()
                     node = &process_node;
                 node = &node->find_or_create_child(object_name, symbol, address, offset, event.timestamp, event.pid);
 
-                node->increment_event_count();
-                if (is_innermost_frame) {
-                    node->add_event_address(address);
-                    node->increment_self_count();
-                }
+                count_event(*node);
+                if (is_innermost_frame)
+                    count_self(*node, address);
                 return IterationDecision::Continue;
             });
         } else {
             auto& process_node = find_or_create_process_node(event.pid, event.serial);
-            process_node.increment_event_count();
+            count_event(process_node);
             for (size_t i = 0; i < event.frames.size(); ++i) {
                 ProfileNode* node = nullptr;
                 ProfileNode* root = nullptr;
@@ -195,15 +223,13 @@ void Profile::rebuild_tree()
 
                     if (!root->has_seen_event(event_index)) {
                         root->did_see_event(event_index);
-                        root->increment_event_count();
+                        count_event(*root);
                     } else if (node != root) {
-                        node->increment_event_count();
+                        count_event(*node);
                     }
 
-                    if (j == event.frames.size() - 1) {
-                        node->add_event_address(address);
-                        node->increment_self_count();
-                    }
+                    if (j == event.frames.size() - 1)
+                        count_self(*node, address);
                 }
             }
         }
@@ -321,6 +347,11 @@ ErrorOr<NonnullOwnPtr<Profile>> Profile::load_from_perfcore_file(StringView path
 
         if (type_string == "sample"sv) {
             event.data = Event::SampleData {};
+        } else if (auto counter = hardware_counter_from_event_type(type_string); counter.has_value()) {
+            event.data = Event::HardwareSampleData {
+                .counter = *counter,
+                .period = perf_event.get_u64("period"sv).value_or(1),
+            };
         } else if (type_string == "kmalloc"sv) {
             event.data = Event::MallocData {
                 .ptr = perf_event.get_addr("ptr"sv).value_or(0),
@@ -15,6 +15,7 @@
 #include "SamplesModel.h"
 #include "SignpostsModel.h"
 #include "SourceModel.h"
+#include <AK/Array.h>
 #include <AK/Bitmap.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/JsonArray.h>
@@ -33,6 +34,14 @@ namespace Profiler {
 extern Optional<MappedObject> g_kernel_debuginfo_object;
 extern OwnPtr<Debug::DebugInfo> g_kernel_debug_info;
 
+enum class HardwareCounter : u8 {
+    CpuCycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    __Count,
+};
+
 class ProfileNode : public RefCounted<ProfileNode> {
 public:
     static NonnullRefPtr<ProfileNode> create(Process const& process, DeprecatedFlyString const& object_name, ByteString symbol, FlatPtr address, u32 offset, u64 timestamp, pid_t pid)
@@ -94,6 +103,10 @@ public:
     void increment_event_count() { ++m_event_count; }
     void increment_self_count() { ++m_self_count; }
 
+    // Hardware counter samples are weighted by their sample period, so these are estimated event totals.
+    u64 hardware_counter_total(HardwareCounter counter) const { return m_hardware_counter_totals[to_underlying(counter)]; }
+    void add_hardware_counter_sample(HardwareCounter counter, u64 period) { m_hardware_counter_totals[to_underlying(counter)] += period; }
+
     void sort_children();
 
     HashMap<FlatPtr, size_t> const& events_per_address() const { return m_events_per_address; }
@@ -126,6 +139,7 @@ private:
     u32 m_event_count { 0 };
     u32 m_self_count { 0 };
     u64 m_timestamp { 0 };
+    Array<u64, to_underlying(HardwareCounter::__Count)> m_hardware_counter_totals {};
     Vector<NonnullRefPtr<ProfileNode>> m_children;
     HashMap<FlatPtr, size_t> m_events_per_address;
     Bitmap m_seen_events;
@@ -186,6 +200,11 @@ public:
         struct SampleData {
         };
 
+        struct HardwareSampleData {
+            HardwareCounter counter;
+            u64 period { 0 };
+        };
+
         struct MallocData {
             FlatPtr ptr {};
             size_t size {};
@@ -262,7 +281,7 @@ public:
             Variant<OpenEventData, CloseEventData, ReadvEventData, ReadEventData, PreadEventData> data;
         };
 
-        Variant<nullptr_t, SampleData, MallocData, FreeData, SignpostData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
+        Variant<nullptr_t, SampleData, HardwareSampleData, MallocData, FreeData, SignpostData, MmapData, MunmapData, ProcessCreateData, ProcessExecData, ThreadCreateData, FilesystemEventData> data { nullptr };
     };
 
     Vector<Event> const& events() const { return m_events; }
@@ -87,6 +87,16 @@ ErrorOr<String> ProfileModel::column_name(int column) const
         return "Stack Frame"_string;
     case Column::SymbolAddress:
         return "Symbol Address"_string;
+    case Column::CpuCycles:
+        return "Cycles"_string;
+    case Column::Instructions:
+        return "Instructions"_string;
+    case Column::InstructionsPerCycle:
+        return "IPC"_string;
+    case Column::CacheMisses:
+        return "Cache Misses"_string;
+    case Column::BranchMisses:
+        return "Branch Misses"_string;
     default:
         VERIFY_NOT_REACHED();
     }
@@ -98,6 +108,8 @@ GUI::Variant ProfileModel::data(GUI::ModelIndex const& index, GUI::ModelRole rol
     if (role == GUI::ModelRole::TextAlignment) {
         if (index.column() == Column::SampleCount || index.column() == Column::SelfCount)
             return Gfx::TextAlignment::CenterRight;
+        if (index.column() >= Column::CpuCycles)
+            return Gfx::TextAlignment::CenterRight;
     }
     if (role == GUI::ModelRole::Icon) {
         if (index.column() == Column::StackFrame) {
@@ -138,6 +150,29 @@ GUI::Variant ProfileModel::data(GUI::ModelIndex const& index, GUI::ModelRole rol
                 return "";
             return ByteString::formatted("{:p} (offset {:p})", node->address(), node->address() - library->base);
         }
+        // NOTE: Hardware counter columns are left blank rather than showing zero when the profile
+        //       was recorded without them (e.g. when running on a CPU without a usable PMU).
+        auto counter_total = [&](HardwareCounter counter) -> GUI::Variant {
+            auto total = node->hardware_counter_total(counter);
+            if (total == 0)
+                return "";
+            return total;
+        };
+        if (index.column() == Column::CpuCycles)
+            return counter_total(HardwareCounter::CpuCycles);
+        if (index.column() == Column::Instructions)
+            return counter_total(HardwareCounter::Instructions);
+        if (index.column() == Column::CacheMisses)
+            return counter_total(HardwareCounter::CacheMisses);
+        if (index.column() == Column::BranchMisses)
+            return counter_total(HardwareCounter::BranchMisses);
+        if (index.column() == Column::InstructionsPerCycle) {
+            auto cycles = node->hardware_counter_total(HardwareCounter::CpuCycles);
+            auto instructions = node->hardware_counter_total(HardwareCounter::Instructions);
+            if (cycles == 0 || instructions == 0)
+                return "";
+            return ByteString::formatted("{:.2}", static_cast<double>(instructions) / static_cast<double>(cycles));
+        }
         return {};
     }
     return {};
@@ -27,6 +27,11 @@ public:
         ObjectName,
         StackFrame,
         SymbolAddress,
+        CpuCycles,
+        Instructions,
+        InstructionsPerCycle,
+        CacheMisses,
+        BranchMisses,
         __Count
     };
 
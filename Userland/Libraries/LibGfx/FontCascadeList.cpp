@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashFunctions.h>
 #include <LibGfx/FontCascadeList.h>
 
 namespace Gfx {
@@ -51,4 +52,39 @@ bool FontCascadeList::equals(FontCascadeList const& other) const
     return true;
 }
 
+unsigned FontCascadeList::hash() const
+{
+    unsigned hash = 0;
+    for (auto const& entry : m_fonts) {
+        hash = pair_int_hash(hash, ptr_hash(entry.font.ptr()));
+        if (!entry.unicode_ranges.has_value())
+            continue;
+        for (auto const& range : *entry.unicode_ranges)
+            hash = pair_int_hash(hash, pair_int_hash(range.min_code_point(), range.max_code_point()));
+    }
+    return hash;
+}
+
+bool FontCascadeList::has_same_fonts_and_unicode_ranges(FontCascadeList const& other) const
+{
+    if (!equals(other))
+        return false;
+    for (size_t i = 0; i < m_fonts.size(); ++i) {
+        auto const& ranges = m_fonts[i].unicode_ranges;
+        auto const& other_ranges = other.m_fonts[i].unicode_ranges;
+        if (ranges.has_value() != other_ranges.has_value())
+            return false;
+        if (!ranges.has_value())
+            continue;
+        if (ranges->size() != other_ranges->size())
+            return false;
+        for (size_t j = 0; j < ranges->size(); ++j) {
+            if (ranges->at(j).min_code_point() != other_ranges->at(j).min_code_point()
+                || ranges->at(j).max_code_point() != other_ranges->at(j).max_code_point())
+                return false;
+        }
+    }
+    return true;
+}
+
 }
@@ -31,6 +31,11 @@ public:
 
     bool equals(FontCascadeList const& other) const;
 
+    // Unlike equals(), these also take the unicode ranges of the fonts into account, so two lists that compare equal
+    // pick the same font for every code point.
+    unsigned hash() const;
+    bool has_same_fonts_and_unicode_ranges(FontCascadeList const& other) const;
+
     struct Entry {
         NonnullRefPtr<Font> font;
         Optional<Vector<UnicodeRange>> unicode_ranges;
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/TextShapingCache.h>
+
+namespace Gfx {
+
+TextShapingCache& TextShapingCache::the()
+{
+    static TextShapingCache s_the;
+    return s_the;
+}
+
+static void shape_text(ShapedText& shaped_text, Utf8View text, FontCascadeList const& font_list)
+{
+    shaped_text.glyphs.clear_with_capacity();
+    for_each_glyph_position(
+        { 0, 0 }, text, font_list, [&](DrawGlyphOrEmoji const& glyph_or_emoji) {
+            shaped_text.glyphs.append(glyph_or_emoji);
+            return IterationDecision::Continue;
+        },
+        IncludeLeftBearing::No, shaped_text.width);
+}
+
+ShapedText const& TextShapingCache::shape(Utf8View text, FontCascadeList const& font_list)
+{
+    auto text_view = text.as_string();
+    if (text_view.length() > max_cached_text_length) {
+        shape_text(m_uncached_text, text, font_list);
+        return m_uncached_text;
+    }
+
+    auto hash = pair_int_hash(text_view.hash(), font_list.hash());
+    auto it = m_entries.find(hash, [&](auto& entry) {
+        return entry.key.text == text_view && entry.key.font_list->has_same_fonts_and_unicode_ranges(font_list);
+    });
+    if (it != m_entries.end()) {
+        ++m_statistics.hits;
+        return *it->value;
+    }
+    ++m_statistics.misses;
+
+    // NOTE: The set of words in use at any time is usually much smaller than the cache, so instead of keeping track of
+    //       which entries were used recently, we simply start over once the cache is full.
+    if (m_entries.size() >= max_entry_count)
+        m_entries.clear();
+
+    auto shaped_text = make<ShapedText>();
+    shape_text(*shaped_text, text, font_list);
+    auto& result = *shaped_text;
+    m_entries.set({ text_view, font_list, hash }, move(shaped_text));
+    return result;
+}
+
+void TextShapingCache::clear()
+{
+    m_entries.clear();
+    m_uncached_text = {};
+    m_statistics = {};
+}
+
+}
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Utf8View.h>
+#include <AK/Vector.h>
+#include <LibGfx/FontCascadeList.h>
+#include <LibGfx/TextLayout.h>
+
+namespace Gfx {
+
+struct ShapedText {
+    // Positioned relative to a baseline starting at (0, 0), as for_each_glyph_position() produces them.
+    Vector<DrawGlyphOrEmoji> glyphs;
+    float width { 0 };
+};
+
+// A process-wide cache of shaped runs of text, keyed by the text and the fonts used to shape it. Layout shapes every
+// word of a text node on every layout, and most of them are shaped the same way again and again, both within one
+// document and across all documents in the process.
+//
+// NOTE: This is not thread-safe, and should only be used from the main thread.
+class TextShapingCache {
+public:
+    // Longer runs are shaped without being cached, as they are unlikely to be seen again.
+    static constexpr size_t max_cached_text_length = 256;
+    static constexpr size_t max_entry_count = 16384;
+
+    static TextShapingCache& the();
+
+    // NOTE: The returned reference is only valid until the next call to shape().
+    ShapedText const& shape(Utf8View, FontCascadeList const&);
+
+    void clear();
+    size_t size() const { return m_entries.size(); }
+
+    struct Statistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+    Statistics const& statistics() const { return m_statistics; }
+
+private:
+    TextShapingCache() = default;
+
+    struct Key {
+        ByteString text;
+        NonnullRefPtr<FontCascadeList const> font_list;
+        unsigned hash { 0 };
+
+        bool operator==(Key const& other) const
+        {
+            return hash == other.hash && text == other.text && font_list->has_same_fonts_and_unicode_ranges(*other.font_list);
+        }
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return key.hash; }
+    };
+
+    HashMap<Key, NonnullOwnPtr<ShapedText>, KeyTraits> m_entries;
+    ShapedText m_uncached_text;
+    Statistics m_statistics;
+};
+
+}
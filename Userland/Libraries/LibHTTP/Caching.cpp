@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/DateTime.h>
+#include <LibHTTP/Caching.h>
+
+namespace HTTP {
+
+using ResponseHeaders = HashMap<ByteString, ByteString, CaseInsensitiveStringTraits>;
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-cache-control
+CacheControl parse_cache_control(StringView value)
+{
+    CacheControl cache_control;
+    for (auto directive : value.split_view(',')) {
+        directive = directive.trim_whitespace();
+
+        auto name = directive;
+        Optional<StringView> argument;
+        if (auto equals = directive.find('='); equals.has_value()) {
+            name = directive.substring_view(0, *equals).trim_whitespace();
+            argument = directive.substring_view(*equals + 1).trim_whitespace().trim("\""sv);
+        }
+
+        auto parse_seconds = [&]() -> Optional<i64> {
+            if (!argument.has_value())
+                return {};
+            if (auto seconds = argument->to_number<i64>(); seconds.has_value())
+                return max(*seconds, 0);
+            return {};
+        };
+
+        if (name.equals_ignoring_ascii_case("no-store"sv)) {
+            cache_control.no_store = true;
+        } else if (name.equals_ignoring_ascii_case("no-cache"sv)) {
+            // NOTE: A no-cache directive that lists field names is treated like a plain no-cache.
+            cache_control.no_cache = true;
+        } else if (name.equals_ignoring_ascii_case("private"sv)) {
+            cache_control.is_private = true;
+        } else if (name.equals_ignoring_ascii_case("max-age"sv)) {
+            if (auto max_age = parse_seconds(); max_age.has_value())
+                cache_control.max_age = max_age;
+        } else if (name.equals_ignoring_ascii_case("s-maxage"sv)) {
+            if (auto shared_max_age = parse_seconds(); shared_max_age.has_value())
+                cache_control.shared_max_age = shared_max_age;
+        }
+    }
+    return cache_control;
+}
+
+Optional<UnixDateTime> parse_http_date(StringView value)
+{
+    auto date_time = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, value);
+    if (!date_time.has_value())
+        return {};
+    return UnixDateTime::from_seconds_since_epoch(date_time->timestamp());
+}
+
+// https://www.rfc-editor.org/rfc/rfc9110.html#name-overview-of-status-codes
+bool is_heuristically_cacheable_status(u32 status_code)
+{
+    switch (status_code) {
+    case 200:
+    case 203:
+    case 204:
+    case 300:
+    case 301:
+    case 308:
+    case 404:
+    case 405:
+    case 410:
+    case 414:
+    case 501:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-storing-responses-in-caches
+bool is_storable_response(u32 status_code, ResponseHeaders const& response_headers)
+{
+    // NOTE: Only status codes that are cacheable by default are stored, even if other responses carry explicit
+    //       freshness information.
+    if (!is_heuristically_cacheable_status(status_code))
+        return false;
+
+    // NOTE: This is a private cache, so responses marked as private can be stored.
+    auto cache_control = parse_cache_control(response_headers.get("Cache-Control"sv).value_or({}));
+    if (cache_control.no_store)
+        return false;
+
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            if (name.trim_whitespace() == "*"sv)
+                return false;
+        }
+    }
+
+    // Only keep responses that can either be served as fresh or be revalidated later.
+    return cache_control.max_age.has_value()
+        || response_headers.contains("Expires"sv)
+        || response_headers.contains("Last-Modified"sv)
+        || response_headers.contains("ETag"sv);
+}
+
+static UnixDateTime date_of(ResponseHeaders const& response_headers, UnixDateTime response_time)
+{
+    if (auto date = response_headers.get("Date"sv); date.has_value()) {
+        if (auto parsed_date = parse_http_date(*date); parsed_date.has_value())
+            return *parsed_date;
+    }
+    return response_time;
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-calculating-freshness-lifet
+Duration freshness_lifetime(ResponseHeaders const& response_headers, UnixDateTime response_time)
+{
+    // NOTE: s-maxage is ignored, since it only applies to shared caches.
+    auto cache_control = parse_cache_control(response_headers.get("Cache-Control"sv).value_or({}));
+    if (cache_control.max_age.has_value())
+        return Duration::from_seconds(*cache_control.max_age);
+
+    auto date = date_of(response_headers, response_time);
+
+    if (auto expires = response_headers.get("Expires"sv); expires.has_value()) {
+        // NOTE: Invalid dates, like "0", represent a time in the past.
+        auto expiry_date = parse_http_date(*expires);
+        if (!expiry_date.has_value())
+            return Duration::zero();
+        return max(Duration::zero(), *expiry_date - date);
+    }
+
+    // https://www.rfc-editor.org/rfc/rfc9111.html#name-calculating-heuristic-fresh
+    // Like other caches, use 10% of the time since the response was last modified.
+    if (auto last_modified = response_headers.get("Last-Modified"sv); last_modified.has_value()) {
+        auto last_modified_date = parse_http_date(*last_modified);
+        if (last_modified_date.has_value() && *last_modified_date < date)
+            return Duration::from_milliseconds((date - *last_modified_date).to_milliseconds() / 10);
+    }
+
+    return Duration::zero();
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-calculating-age
+Duration current_age(ResponseHeaders const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now)
+{
+    auto age_value = Duration::from_seconds(max(response_headers.get("Age"sv).value_or({}).to_number<i64>().value_or(0), 0));
+
+    auto apparent_age = max(Duration::zero(), response_time - date_of(response_headers, response_time));
+    auto response_delay = response_time - request_time;
+    auto corrected_age_value = age_value + response_delay;
+    auto corrected_initial_age = max(apparent_age, corrected_age_value);
+
+    auto resident_time = now - response_time;
+    return corrected_initial_age + resident_time;
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+
+// Helpers for a private HTTP cache, as described by RFC 9111.
+namespace HTTP {
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-cache-control
+struct CacheControl {
+    bool no_store { false };
+    bool no_cache { false };
+    bool is_private { false };
+    Optional<i64> max_age;
+    // NOTE: s-maxage only applies to shared caches, it is parsed so that callers can tell it was there.
+    Optional<i64> shared_max_age;
+};
+
+CacheControl parse_cache_control(StringView);
+
+Optional<UnixDateTime> parse_http_date(StringView);
+
+bool is_heuristically_cacheable_status(u32 status_code);
+bool is_storable_response(u32 status_code, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers);
+
+// The response time is used in place of a missing or invalid Date header.
+Duration freshness_lifetime(HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers, UnixDateTime response_time);
+Duration current_age(HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers, UnixDateTime request_time, UnixDateTime response_time, UnixDateTime now);
+
+}
@@ -336,6 +336,9 @@ void Job::on_socket_connected()
                 // As the HTTP spec explicitly prohibits presence of Content-Length when the response code is 204.
                 if (m_code == 204)
                     return finish_up();
+                // Likewise, 304 (Not Modified) responses and responses to HEAD requests never have a body.
+                if (m_code == 304 || m_request.method() == HttpRequest::Method::HEAD)
+                    return finish_up();
 
                 break;
             }
@@ -307,6 +307,7 @@ public:
 
     [[nodiscard]] bool has_lexical_declarations() const { return !m_lexical_declarations.is_empty(); }
     [[nodiscard]] bool has_var_declarations() const { return !m_var_declarations.is_empty(); }
+    [[nodiscard]] bool has_functions_hoistable_with_annexB_extension() const { return !m_functions_hoistable_with_annexB_extension.is_empty(); }
 
     [[nodiscard]] size_t var_declaration_count() const { return m_var_declarations.size(); }
     [[nodiscard]] size_t lexical_declaration_count() const { return m_lexical_declarations.size(); }
@@ -551,10 +552,16 @@ public:
 
     ThrowCompletionOr<void> global_declaration_instantiation(VM&, GlobalEnvironment&) const;
 
+    // NOTE: Programs in the parse cache are shared by every realm that loads the same script, so the bytecode
+    //       of their functions is kept on the function objects instead of being stored on the AST.
+    bool is_shared_between_realms() const { return m_is_shared_between_realms; }
+    void set_shared_between_realms() { m_is_shared_between_realms = true; }
+
 private:
     virtual bool is_program() const override { return true; }
 
     bool m_is_strict_mode { false };
+    bool m_is_shared_between_realms { false };
     Type m_type { Type::Script };
 
     Vector<NonnullRefPtr<ImportStatement const>> m_imports;
@@ -36,6 +36,9 @@ public:
     void grow(size_t additional_size);
 
     void terminate(Badge<Generator>) { m_terminated = true; }
+
+    // Note: The rewriter takes care of moving or destroying the instructions of the old stream.
+    void replace_instruction_stream(Badge<InstructionStreamRewriter>, Vector<u8>&& buffer) { m_buffer = move(buffer); }
     bool is_terminated() const { return m_terminated; }
 
     String const& name() const { return m_name; }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Debug.h>
 #include <LibJS/Bytecode/CommonImplementations.h>
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Op.h>
@@ -103,6 +104,39 @@ ALWAYS_INLINE ThrowCompletionOr<NonnullGCPtr<Object>> base_object_for_get(VM& vm
     return throw_null_or_undefined_property_access(vm, base_value, base_identifier, property_identifier);
 }
 
+// Returns the empty value if the cache doesn't know about the shape of the object.
+ALWAYS_INLINE Value get_cached_property(Object const& object, PropertyLookupCache const& cache)
+{
+    auto const& shape = object.shape();
+    for (size_t i = 0; i < cache.entries.size(); ++i) {
+        auto const& entry = cache.entries[i];
+        if (&shape != entry.shape)
+            continue;
+
+        Value value;
+        if (!entry.prototype) {
+            value = object.get_direct(entry.property_offset.value());
+        } else {
+            if (!entry.prototype_chain_validity || !entry.prototype_chain_validity->is_valid())
+                return {};
+            value = entry.prototype->get_direct(entry.property_offset.value());
+            // NOTE: Accessors may be installed in place of a data property without changing the shape.
+            if (value.is_accessor())
+                return {};
+            if constexpr (JS_INLINE_CACHE_DEBUG)
+                ++g_inline_cache_statistics.get_by_id_prototype_chain_hits;
+        }
+
+        if constexpr (JS_INLINE_CACHE_DEBUG) {
+            ++g_inline_cache_statistics.get_by_id_hits;
+            if (i > 0)
+                ++g_inline_cache_statistics.get_by_id_polymorphic_hits;
+        }
+        return value;
+    }
+    return {};
+}
+
 inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString const&> const& base_identifier, DeprecatedFlyString const& property, Value base_value, Value this_value, PropertyLookupCache& cache)
 {
     if (base_value.is_string()) {
@@ -118,18 +152,33 @@ inline ThrowCompletionOr<Value> get_by_id(VM& vm, Optional<DeprecatedFlyString c
         return Value { base_obj->indexed_properties().array_like_size() };
     }
 
-    // OPTIMIZATION: If the shape of the object hasn't changed, we can use the cached property offset.
+    if (base_obj->shape().is_uncacheable_dictionary())
+        base_obj->record_uncached_lookup();
+
+    // OPTIMIZATION: If we've seen an object with this shape here before, we can use the cached property offset.
     auto& shape = base_obj->shape();
-    if (&shape == cache.shape) {
-        return base_obj->get_direct(cache.property_offset.value());
-    }
+    if (auto cached_value = get_cached_property(*base_obj, cache); !cached_value.is_empty())
+        return cached_value;
+
+    if constexpr (JS_INLINE_CACHE_DEBUG)
+        ++g_inline_cache_statistics.get_by_id_misses;
 
     CacheablePropertyMetadata cacheable_metadata;
     auto value = TRY(base_obj->internal_get(property, this_value, &cacheable_metadata));
 
     if (cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-        cache.shape = shape;
-        cache.property_offset = cacheable_metadata.property_offset.value();
+        auto& entry = cache.entry_for_update(shape);
+        entry = { .shape = shape, .property_offset = cacheable_metadata.property_offset.value() };
+    } else if (cacheable_metadata.type == CacheablePropertyMetadata::Type::InPrototypeChain && !shape.is_dictionary() && shape.prototype()) {
+        // NOTE: Dictionary shapes can change in place, which could shadow the property without us noticing.
+        auto validity = shape.prototype()->ensure_prototype_chain_validity();
+        auto& entry = cache.entry_for_update(shape);
+        entry = {
+            .shape = shape,
+            .property_offset = cacheable_metadata.property_offset.value(),
+            .prototype = cacheable_metadata.prototype,
+            .prototype_chain_validity = validity.ptr(),
+        };
     }
 
     return value;
@@ -280,17 +329,31 @@ inline ThrowCompletionOr<void> put_by_property_key(VM& vm, Value base, Value thi
         break;
     }
     case Op::PropertyKind::KeyValue: {
-        if (cache && cache->shape == &object->shape()) {
-            object->put_direct(*cache->property_offset, value);
-            return {};
+        if (cache) {
+            auto& shape = object->shape();
+            for (size_t i = 0; i < cache->entries.size(); ++i) {
+                auto const& entry = cache->entries[i];
+                if (&shape != entry.shape || entry.prototype)
+                    continue;
+                if constexpr (JS_INLINE_CACHE_DEBUG) {
+                    ++g_inline_cache_statistics.put_by_id_hits;
+                    if (i > 0)
+                        ++g_inline_cache_statistics.put_by_id_polymorphic_hits;
+                }
+                object->put_direct(*entry.property_offset, value);
+                return {};
+            }
+            if constexpr (JS_INLINE_CACHE_DEBUG)
+                ++g_inline_cache_statistics.put_by_id_misses;
         }
 
         CacheablePropertyMetadata cacheable_metadata;
         bool succeeded = TRY(object->internal_set(name, value, this_value, &cacheable_metadata));
 
         if (succeeded && cache && cacheable_metadata.type == CacheablePropertyMetadata::Type::OwnProperty) {
-            cache->shape = object->shape();
-            cache->property_offset = cacheable_metadata.property_offset.value();
+            auto& shape = object->shape();
+            auto& entry = cache->entry_for_update(shape);
+            entry = { .shape = shape, .property_offset = cacheable_metadata.property_offset.value() };
         }
 
         if (!succeeded && vm.in_strict_mode()) {
@@ -4,15 +4,60 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Debug.h>
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Bytecode/RegexTable.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/SourceCode.h>
 
 namespace JS::Bytecode {
 
 JS_DEFINE_ALLOCATOR(Executable);
 
+InlineCacheStatistics g_inline_cache_statistics;
+
+PropertyLookupCache::Entry& PropertyLookupCache::entry_for_update(Shape const& shape)
+{
+    for (auto& entry : entries) {
+        if (entry.shape == &shape)
+            return entry;
+    }
+    for (auto& entry : entries) {
+        if (!entry.shape)
+            return entry;
+    }
+
+    // The cache is full, so drop the oldest entry and put the new one in front.
+    if constexpr (JS_INLINE_CACHE_DEBUG)
+        ++g_inline_cache_statistics.evictions;
+    for (size_t i = entries.size() - 1; i > 0; --i)
+        entries[i] = move(entries[i - 1]);
+    entries[0] = {};
+    return entries[0];
+}
+
+static void dump_hit_rate(StringView name, u64 hits, u64 misses)
+{
+    auto total = hits + misses;
+    warnln("  {}: {} hits, {} misses ({}% hit rate)", name, hits, misses, total ? hits * 100 / total : 0);
+}
+
+void InlineCacheStatistics::dump() const
+{
+    if constexpr (!JS_INLINE_CACHE_DEBUG) {
+        warnln("Inline cache statistics are only collected when JS_INLINE_CACHE_DEBUG is enabled");
+        return;
+    }
+    warnln("\033[37;1mInline cache statistics\033[0m");
+    dump_hit_rate("GetById"sv, get_by_id_hits, get_by_id_misses);
+    warnln("    {} hits on a polymorphic entry, {} hits in the prototype chain", get_by_id_polymorphic_hits, get_by_id_prototype_chain_hits);
+    dump_hit_rate("PutById"sv, put_by_id_hits, put_by_id_misses);
+    warnln("    {} hits on a polymorphic entry", put_by_id_polymorphic_hits);
+    warnln("  {} entries evicted from full caches", evictions);
+}
+
 Executable::Executable(
     NonnullOwnPtr<IdentifierTable> identifier_table,
     NonnullOwnPtr<StringTable> string_table,
@@ -50,6 +95,19 @@ void Executable::dump() const
     warnln("");
 }
 
+JIT::NativeExecutable const* Executable::get_or_create_native_executable()
+{
+    if (m_did_try_jitting || !JIT::g_jit_enabled)
+        return m_native_executable.ptr();
+
+    if (++m_execution_count < JIT::Compiler::hotness_threshold)
+        return nullptr;
+
+    m_did_try_jitting = true;
+    m_native_executable = JIT::Compiler::compile(*this);
+    return m_native_executable.ptr();
+}
+
 void Executable::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
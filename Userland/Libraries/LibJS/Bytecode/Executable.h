@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/DeprecatedFlyString.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -19,17 +20,54 @@
 #include <LibJS/Heap/CellAllocator.h>
 #include <LibJS/Runtime/EnvironmentCoordinate.h>
 
+namespace JS::JIT {
+class NativeExecutable;
+}
+
 namespace JS::Bytecode {
 
 struct PropertyLookupCache {
+    static constexpr size_t max_number_of_shapes_to_remember = 4;
+
+    struct Entry {
+        WeakPtr<Shape> shape;
+        Optional<u32> property_offset;
+
+        // Set if the property was found in the prototype chain of the object, rather than on the object itself.
+        // NOTE: This is not visited, since the prototype is reachable through `shape` for as long as `prototype_chain_validity` is valid.
+        GCPtr<Object const> prototype {};
+        WeakPtr<PrototypeChainValidity> prototype_chain_validity {};
+    };
+
+    // Returns the entry to (re)fill for the given shape, evicting the oldest entry if the cache is full.
+    Entry& entry_for_update(Shape const&);
+
+    AK::Array<Entry, max_number_of_shapes_to_remember> entries;
+};
+
+struct GlobalVariableCache {
     WeakPtr<Shape> shape;
     Optional<u32> property_offset;
+    u64 environment_serial_number { 0 };
 };
 
-struct GlobalVariableCache : public PropertyLookupCache {
-    u64 environment_serial_number { 0 };
+// How well the property lookup caches are doing, as printed by `js --dump-inline-cache-stats`.
+// NOTE: These are plain globals touched by every cached property access, so they are only updated when JS_INLINE_CACHE_DEBUG is enabled.
+struct InlineCacheStatistics {
+    u64 get_by_id_hits { 0 };
+    u64 get_by_id_polymorphic_hits { 0 };
+    u64 get_by_id_prototype_chain_hits { 0 };
+    u64 get_by_id_misses { 0 };
+    u64 put_by_id_hits { 0 };
+    u64 put_by_id_polymorphic_hits { 0 };
+    u64 put_by_id_misses { 0 };
+    u64 evictions { 0 };
+
+    void dump() const;
 };
 
+extern InlineCacheStatistics g_inline_cache_statistics;
+
 using EnvironmentVariableCache = Optional<EnvironmentCoordinate>;
 
 struct SourceRecord {
@@ -83,8 +121,15 @@ public:
 
     void dump() const;
 
+    // Returns the JIT-compiled version of this executable, compiling it once it has become hot enough.
+    JIT::NativeExecutable const* get_or_create_native_executable();
+
 private:
     virtual void visit_edges(Visitor&) override;
+
+    OwnPtr<JIT::NativeExecutable> m_native_executable;
+    u32 m_execution_count { 0 };
+    bool m_did_try_jitting { false };
 };
 
 }
@@ -10,6 +10,7 @@
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Instruction.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Bytecode/Register.h>
 #include <LibJS/Runtime/VM.h>
 
@@ -86,6 +87,9 @@ CodeGenerationErrorOr<NonnullGCPtr<Executable>> Generator::generate(VM& vm, ASTN
         move(generator.m_root_basic_blocks),
         is_strict_mode);
 
+    if (g_optimize_bytecode)
+        optimization_pipeline().perform(*executable);
+
     return executable;
 }
 
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Forward.h>
+#include <AK/Function.h>
 #include <AK/Span.h>
 #include <LibJS/Bytecode/Executable.h>
 #include <LibJS/Forward.h>
@@ -137,6 +138,13 @@ public:
     ThrowCompletionOr<void> execute(Bytecode::Interpreter&) const;
     static void destroy(Instruction&);
 
+    void visit_labels(Function<void(Label&)> visitor);
+    void visit_operands(Function<void(Operand&)> visitor);
+
+    // Note: Instructions without labels or operands use these, everyone else shadows them.
+    void visit_labels_impl(Function<void(Label&)>) { }
+    void visit_operands_impl(Function<void(Operand&)>) { }
+
     // FIXME: Find a better way to organize this information
     void set_source_record(SourceRecord rec) { m_source_record = rec; }
     SourceRecord source_record() const { return m_source_record; }
@@ -15,6 +15,7 @@
 #include <LibJS/Bytecode/Interpreter.h>
 #include <LibJS/Bytecode/Label.h>
 #include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/BigInt.h>
@@ -491,7 +492,10 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable& executa
 
     vm().execution_context_stack().last()->executable = &executable;
 
-    run_bytecode();
+    if (auto const* native_executable = executable.get_or_create_native_executable(); native_executable && (!entry_point || entry_point == executable.basic_blocks.first()))
+        native_executable->run(*this, registers().data(), vm().running_execution_context().locals.data());
+    else
+        run_bytecode();
 
     dbgln_if(JS_BYTECODE_DEBUG, "Bytecode::Interpreter did run unit {:p}", &executable);
 
@@ -536,6 +540,16 @@ Interpreter::ValueAndFrame Interpreter::run_and_return_frame(Executable& executa
     return { return_value, nullptr };
 }
 
+ThrowCompletionOr<void> Interpreter::execute_instruction_out_of_line(BasicBlock const& block, Instruction const& instruction)
+{
+    // Note: Instructions may look at the current block and program counter (e.g. for source positions
+    //       in stack traces), so make them look just like they would inside the interpreter loop.
+    m_current_block = &block;
+    auto pc = InstructionStreamIterator { block.instruction_stream(), m_current_executable, static_cast<size_t>(reinterpret_cast<u8 const*>(&instruction) - block.data()) };
+    TemporaryChange temp_change { m_pc, Optional<InstructionStreamIterator&>(pc) };
+    return instruction.execute(*this);
+}
+
 void Interpreter::enter_unwind_context()
 {
     unwind_contexts().empend(
@@ -98,6 +98,9 @@ public:
     BasicBlock const& current_block() const { return *m_current_block; }
     Optional<InstructionStreamIterator const&> instruction_stream_iterator() const { return m_pc; }
 
+    // Used by JIT-compiled code to run instructions it has no fast path for.
+    ThrowCompletionOr<void> execute_instruction_out_of_line(BasicBlock const&, Instruction const&);
+
     void visit_edges(Cell::Visitor&);
 
     Span<Value> registers() { return m_current_call_frame; }
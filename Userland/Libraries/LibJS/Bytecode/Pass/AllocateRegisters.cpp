@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/QuickSort.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+struct RegisterUsage {
+    BasicBlock const* block { nullptr };
+    bool is_used_in_multiple_blocks { false };
+    bool is_defined_before_use { false };
+    size_t first_use { 0 };
+    size_t last_use { 0 };
+};
+
+struct RegisterRange {
+    u32 first { 0 };
+    u32 last { 0 };
+};
+
+void AllocateRegisters::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    auto& bytecode_executable = executable.executable;
+    auto register_count = bytecode_executable.number_of_registers;
+
+    // NewArray reads a contiguous range of registers, so those have to stay together and in order.
+    Vector<RegisterRange> pinned_ranges;
+    Vector<Optional<RegisterUsage>> usages;
+    usages.resize(register_count);
+
+    for (auto& block : bytecode_executable.basic_blocks) {
+        size_t position = 0;
+        for (auto* instruction : instructions_of(*block)) {
+            if (instruction->type() == Instruction::Type::NewArray) {
+                auto const& new_array = static_cast<Op::NewArray const&>(*instruction);
+                if (new_array.element_count() != 0)
+                    pinned_ranges.append({ new_array.start().index(), new_array.end().index() });
+            }
+
+            HashTable<u32> written_registers;
+            HashTable<u32> read_registers;
+            auto written_count = written_operand_count(*instruction).value_or(0);
+            size_t operand_index = 0;
+            instruction->visit_operands([&](Operand& operand) {
+                auto is_written = operand_index++ < written_count;
+                if (!operand.is_register())
+                    return;
+                if (is_written)
+                    written_registers.set(operand.index());
+                else
+                    read_registers.set(operand.index());
+            });
+
+            auto note_use = [&](u32 index) {
+                auto& usage = usages[index];
+                if (!usage.has_value()) {
+                    // Note: A register that is only ever used in one block, and written before anything reads it,
+                    //       does not carry a value across blocks. Those can share storage with each other.
+                    usage = RegisterUsage {
+                        .block = block.ptr(),
+                        .is_defined_before_use = !read_registers.contains(index),
+                        .first_use = position,
+                        .last_use = position,
+                    };
+                    return;
+                }
+                if (usage->block != block.ptr())
+                    usage->is_used_in_multiple_blocks = true;
+                usage->last_use = position;
+            };
+            for (auto index : written_registers)
+                note_use(index);
+            for (auto index : read_registers)
+                note_use(index);
+
+            ++position;
+        }
+    }
+
+    Vector<Optional<u32>> mapping;
+    mapping.resize(register_count);
+    for (u32 i = 0; i < Register::reserved_register_count && i < register_count; ++i)
+        mapping[i] = i;
+
+    u32 next_register = Register::reserved_register_count;
+
+    quick_sort(pinned_ranges, [](auto const& a, auto const& b) { return a.first < b.first; });
+    for (size_t i = 0; i < pinned_ranges.size();) {
+        auto range = pinned_ranges[i++];
+        while (i < pinned_ranges.size() && pinned_ranges[i].first <= range.last)
+            range.last = max(range.last, pinned_ranges[i++].last);
+        for (auto index = range.first; index <= range.last; ++index) {
+            if (!mapping[index].has_value())
+                mapping[index] = next_register++;
+        }
+    }
+
+    struct Interval {
+        u32 index { 0 };
+        size_t first_use { 0 };
+        size_t last_use { 0 };
+    };
+    HashMap<BasicBlock const*, Vector<Interval>> block_local_intervals;
+
+    for (u32 index = Register::reserved_register_count; index < register_count; ++index) {
+        auto const& usage = usages[index];
+        if (mapping[index].has_value() || !usage.has_value())
+            continue;
+        if (usage->is_used_in_multiple_blocks || !usage->is_defined_before_use) {
+            mapping[index] = next_register++;
+            continue;
+        }
+        block_local_intervals.ensure(usage->block).append({ index, usage->first_use, usage->last_use });
+    }
+
+    // Linear scan over each block. Storage for block-local registers is shared between all blocks.
+    auto shared_base = next_register;
+    size_t shared_count = 0;
+    for (auto& block : bytecode_executable.basic_blocks) {
+        auto it = block_local_intervals.find(block.ptr());
+        if (it == block_local_intervals.end())
+            continue;
+        auto& intervals = it->value;
+        quick_sort(intervals, [](auto const& a, auto const& b) { return a.first_use < b.first_use; });
+
+        Vector<Optional<size_t>> busy_until;
+        for (auto const& interval : intervals) {
+            Optional<size_t> free_slot;
+            for (size_t slot = 0; slot < busy_until.size(); ++slot) {
+                if (!busy_until[slot].has_value() || *busy_until[slot] < interval.first_use) {
+                    free_slot = slot;
+                    break;
+                }
+            }
+            if (!free_slot.has_value()) {
+                free_slot = busy_until.size();
+                busy_until.append({});
+            }
+            busy_until[*free_slot] = interval.last_use;
+            mapping[interval.index] = shared_base + *free_slot;
+        }
+        shared_count = max(shared_count, busy_until.size());
+    }
+
+    for (auto& block : bytecode_executable.basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            instruction->visit_operands([&](Operand& operand) {
+                if (operand.is_register())
+                    operand = Operand(Register(mapping[operand.index()].value()));
+            });
+        }
+    }
+
+    bytecode_executable.number_of_registers = shared_base + shared_count;
+
+    finished();
+}
+
+}
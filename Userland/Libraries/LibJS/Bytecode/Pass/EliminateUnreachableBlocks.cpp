@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void EliminateUnreachableBlocks::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    VERIFY(executable.cfg.has_value());
+
+    auto& basic_blocks = executable.executable.basic_blocks;
+
+    HashTable<BasicBlock const*> reachable_blocks;
+    Vector<BasicBlock const*> worklist;
+    worklist.append(basic_blocks.first().ptr());
+    while (!worklist.is_empty()) {
+        auto const* block = worklist.take_last();
+        if (reachable_blocks.set(block) != HashSetResult::InsertedNewEntry)
+            continue;
+        if (auto successors = executable.cfg->get(block); successors.has_value()) {
+            for (auto const* successor : *successors)
+                worklist.append(successor);
+        }
+    }
+
+    auto removed_any = basic_blocks.remove_all_matching([&](auto const& block) {
+        return !reachable_blocks.contains(block.ptr());
+    });
+
+    if (removed_any) {
+        executable.cfg.clear();
+        executable.inverted_cfg.clear();
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+#include <LibJS/Runtime/ValueInlines.h>
+
+namespace JS::Bytecode::Passes {
+
+static Operand add_constant(Executable& executable, Value value)
+{
+    for (size_t i = 0; i < executable.constants.size(); ++i) {
+        if (executable.constants[i] == value)
+            return Operand(Operand::Type::Constant, i);
+    }
+    executable.constants.append(value);
+    return Operand(Operand::Type::Constant, executable.constants.size() - 1);
+}
+
+static Optional<Value> constant_value(Executable const& executable, Operand operand)
+{
+    if (!operand.is_constant())
+        return {};
+    return executable.constants[operand.index()];
+}
+
+// Note: Only primitives that don't live on the heap are folded, since converting those to numbers or
+//       comparing them can neither throw, run user code, nor allocate.
+static Optional<Value> fold_binary_op(VM& vm, Instruction::Type type, Value lhs, Value rhs)
+{
+    if (lhs.is_cell() || rhs.is_cell())
+        return {};
+
+    switch (type) {
+#define __JS_ENUMERATE_FOLDABLE_BINARY_OP(OpTitleCase, op_snake_case) \
+    case Instruction::Type::OpTitleCase:                             \
+        return MUST(JS::op_snake_case(vm, lhs, rhs));
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__JS_ENUMERATE_FOLDABLE_BINARY_OP)
+        __JS_ENUMERATE_FOLDABLE_BINARY_OP(Div, div)
+        __JS_ENUMERATE_FOLDABLE_BINARY_OP(Exp, exp)
+        __JS_ENUMERATE_FOLDABLE_BINARY_OP(Mod, mod)
+#undef __JS_ENUMERATE_FOLDABLE_BINARY_OP
+    case Instruction::Type::LooselyEquals:
+        return Value(MUST(is_loosely_equal(vm, lhs, rhs)));
+    case Instruction::Type::LooselyInequals:
+        return Value(!MUST(is_loosely_equal(vm, lhs, rhs)));
+    case Instruction::Type::StrictlyEquals:
+        return Value(is_strictly_equal(lhs, rhs));
+    case Instruction::Type::StrictlyInequals:
+        return Value(!is_strictly_equal(lhs, rhs));
+    default:
+        return {};
+    }
+}
+
+static Optional<Value> fold_unary_op(VM& vm, Instruction::Type type, Value value)
+{
+    switch (type) {
+    case Instruction::Type::Not:
+        return Value(!value.to_boolean());
+    case Instruction::Type::BitwiseNot:
+        if (value.is_cell())
+            return {};
+        return MUST(bitwise_not(vm, value));
+    case Instruction::Type::UnaryMinus:
+        if (value.is_cell())
+            return {};
+        return MUST(unary_minus(vm, value));
+    case Instruction::Type::UnaryPlus:
+        if (value.is_cell())
+            return {};
+        return MUST(unary_plus(vm, value));
+    default:
+        return {};
+    }
+}
+
+static Optional<bool> fold_jump_condition(Instruction::Type type, Value condition)
+{
+    switch (type) {
+    case Instruction::Type::JumpIf:
+        return condition.to_boolean();
+    case Instruction::Type::JumpNullish:
+        return condition.is_nullish();
+    case Instruction::Type::JumpUndefined:
+        return condition.is_undefined();
+    default:
+        return {};
+    }
+}
+
+void FoldConstants::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    auto& bytecode_executable = executable.executable;
+    auto& vm = bytecode_executable.vm();
+    bool changed_control_flow = false;
+
+    for (auto& block : bytecode_executable.basic_blocks) {
+        InstructionStreamRewriter rewriter(*block);
+        for (auto* instruction : instructions_of(*block)) {
+            auto type = instruction->type();
+            switch (type) {
+#define __JS_ENUMERATE_BINARY_OP(OpTitleCase, op_snake_case)                                                      \
+    case Instruction::Type::OpTitleCase: {                                                                        \
+        auto const& op = static_cast<Op::OpTitleCase const&>(*instruction);                                       \
+        auto lhs = constant_value(bytecode_executable, op.lhs());                                                 \
+        auto rhs = constant_value(bytecode_executable, op.rhs());                                                 \
+        if (lhs.has_value() && rhs.has_value()) {                                                                 \
+            if (auto result = fold_binary_op(vm, type, *lhs, *rhs); result.has_value()) {                         \
+                auto dst = op.dst();                                                                              \
+                rewriter.replace<Op::Mov>(*instruction, dst, add_constant(bytecode_executable, *result));         \
+                continue;                                                                                         \
+            }                                                                                                     \
+        }                                                                                                         \
+        break;                                                                                                    \
+    }
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__JS_ENUMERATE_BINARY_OP)
+                JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__JS_ENUMERATE_BINARY_OP)
+#undef __JS_ENUMERATE_BINARY_OP
+
+#define __JS_ENUMERATE_UNARY_OP(OpTitleCase, op_snake_case)                                                       \
+    case Instruction::Type::OpTitleCase: {                                                                        \
+        auto const& op = static_cast<Op::OpTitleCase const&>(*instruction);                                       \
+        if (auto src = constant_value(bytecode_executable, op.src()); src.has_value()) {                          \
+            if (auto result = fold_unary_op(vm, type, *src); result.has_value()) {                                \
+                auto dst = op.dst();                                                                              \
+                rewriter.replace<Op::Mov>(*instruction, dst, add_constant(bytecode_executable, *result));         \
+                continue;                                                                                         \
+            }                                                                                                     \
+        }                                                                                                         \
+        break;                                                                                                    \
+    }
+                JS_ENUMERATE_COMMON_UNARY_OPS(__JS_ENUMERATE_UNARY_OP)
+#undef __JS_ENUMERATE_UNARY_OP
+
+            case Instruction::Type::JumpIf:
+            case Instruction::Type::JumpNullish:
+            case Instruction::Type::JumpUndefined: {
+                Optional<Value> condition;
+                instruction->visit_operands([&](Operand& operand) { condition = constant_value(bytecode_executable, operand); });
+                if (!condition.has_value())
+                    break;
+                auto const& jump = static_cast<Op::Jump const&>(*instruction);
+                auto target = *fold_jump_condition(type, *condition) ? *jump.true_target() : *jump.false_target();
+                rewriter.replace<Op::Jump>(*instruction, target);
+                changed_control_flow = true;
+                continue;
+            }
+            default:
+                break;
+            }
+            rewriter.keep(*instruction);
+        }
+        rewriter.finish();
+    }
+
+    if (changed_control_flow) {
+        executable.cfg.clear();
+        executable.inverted_cfg.clear();
+    }
+
+    finished();
+}
+
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+void GenerateCFG::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    executable.cfg = HashMap<BasicBlock const*, HashTable<BasicBlock const*>> {};
+    executable.inverted_cfg = HashMap<BasicBlock const*, HashTable<BasicBlock const*>> {};
+
+    for (auto& block : executable.executable.basic_blocks) {
+        auto& successors = executable.cfg->ensure(block.ptr());
+        auto add_edge = [&](BasicBlock const& target) {
+            successors.set(&target);
+            executable.inverted_cfg->ensure(&target).set(block.ptr());
+        };
+
+        // Note: Any instruction in a block may throw, so its handler and finalizer are successors as well.
+        if (auto const* handler = block->handler())
+            add_edge(*handler);
+        if (auto const* finalizer = block->finalizer())
+            add_edge(*finalizer);
+
+        for (auto* instruction : instructions_of(*block))
+            instruction->visit_labels([&](Label& label) { add_edge(label.block()); });
+    }
+
+    finished();
+}
+
+}
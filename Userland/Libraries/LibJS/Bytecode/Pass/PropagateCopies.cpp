@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Registers below reserved_register_count are read and written behind our back by the interpreter.
+static bool is_temporary_register(Operand operand)
+{
+    return operand.is_register() && operand.index() >= Register::reserved_register_count;
+}
+
+static void propagate_copies_in_block(BasicBlock& block)
+{
+    // Maps a temporary register to the operand it is currently a copy of.
+    HashMap<u32, Operand> copies;
+
+    auto invalidate = [&](Operand written) {
+        if (written.is_constant())
+            return;
+        if (written.is_register())
+            copies.remove(written.index());
+        copies.remove_all_matching([&](u32, Operand const& source) { return source == written; });
+    };
+
+    for (auto* instruction : instructions_of(block)) {
+        auto written_count = written_operand_count(*instruction);
+
+        if (!written_count.has_value()) {
+            // We don't know which operands this instruction reads or writes, so assume it writes all of them.
+            instruction->visit_operands([&](Operand& operand) { invalidate(operand); });
+            continue;
+        }
+
+        Vector<Operand, 1> written_operands;
+        size_t operand_index = 0;
+        instruction->visit_operands([&](Operand& operand) {
+            if (operand_index++ < *written_count) {
+                written_operands.append(operand);
+                return;
+            }
+            if (operand.is_register()) {
+                if (auto source = copies.get(operand.index()); source.has_value())
+                    operand = *source;
+            }
+        });
+
+        for (auto written : written_operands)
+            invalidate(written);
+
+        // SetLocal refers to its destination by index rather than through an operand.
+        if (instruction->type() == Instruction::Type::SetLocal)
+            invalidate(static_cast<Op::SetLocal const&>(*instruction).dst());
+
+        if (instruction->type() == Instruction::Type::Mov) {
+            auto const& mov = static_cast<Op::Mov const&>(*instruction);
+            if (is_temporary_register(mov.dst()) && mov.dst() != mov.src() && (mov.src().is_constant() || mov.src().is_local() || is_temporary_register(mov.src())))
+                copies.set(mov.dst().index(), mov.src());
+        }
+    }
+}
+
+void PropagateCopies::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks)
+        propagate_copies_in_block(*block);
+
+    // Now that reads have been redirected to the original values, many copies are never read anymore.
+    HashTable<u32> read_registers;
+    for (auto& block : executable.executable.basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            if (instruction->type() == Instruction::Type::NewArray) {
+                // NewArray implicitly reads every register in its element range.
+                auto const& new_array = static_cast<Op::NewArray const&>(*instruction);
+                if (new_array.element_count() != 0) {
+                    for (auto index = new_array.start().index(); index <= new_array.end().index(); ++index)
+                        read_registers.set(index);
+                }
+            }
+
+            bool is_mov = instruction->type() == Instruction::Type::Mov;
+            size_t operand_index = 0;
+            instruction->visit_operands([&](Operand& operand) {
+                if (is_mov && operand_index++ == 0)
+                    return;
+                if (operand.is_register())
+                    read_registers.set(operand.index());
+            });
+        }
+    }
+
+    for (auto& block : executable.executable.basic_blocks) {
+        InstructionStreamRewriter rewriter(*block);
+        for (auto* instruction : instructions_of(*block)) {
+            if (instruction->type() == Instruction::Type::Mov) {
+                auto const& mov = static_cast<Op::Mov const&>(*instruction);
+                if (mov.dst() == mov.src() || (is_temporary_register(mov.dst()) && !read_registers.contains(mov.dst().index()))) {
+                    rewriter.drop(*instruction);
+                    continue;
+                }
+            }
+            rewriter.keep(*instruction);
+        }
+        rewriter.finish();
+    }
+
+    finished();
+}
+
+}
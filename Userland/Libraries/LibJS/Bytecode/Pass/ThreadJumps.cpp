@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode::Passes {
+
+// Follows a chain of blocks that do nothing but jump somewhere else.
+static BasicBlock const& final_jump_target(BasicBlock const& block)
+{
+    HashTable<BasicBlock const*> seen;
+    auto const* current = &block;
+    while (!seen.contains(current)) {
+        seen.set(current);
+
+        InstructionStreamIterator it(current->instruction_stream());
+        if (it.at_end() || (*it).type() != Instruction::Type::Jump)
+            break;
+        current = &static_cast<Op::Jump const&>(*it).true_target()->block();
+    }
+    return *current;
+}
+
+void ThreadJumps::perform(PassPipelineExecutable& executable)
+{
+    started();
+
+    for (auto& block : executable.executable.basic_blocks) {
+        for (auto* instruction : instructions_of(*block)) {
+            instruction->visit_labels([](Label& label) {
+                label = Label { final_jump_target(label.block()) };
+            });
+        }
+    }
+
+    // The blocks we jumped over may have become unreachable, so any previous CFG is stale.
+    executable.cfg.clear();
+    executable.inverted_cfg.clear();
+
+    finished();
+}
+
+}
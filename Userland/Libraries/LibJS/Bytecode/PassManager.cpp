@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/Bytecode/PassManager.h>
+
+namespace JS::Bytecode {
+
+bool g_optimize_bytecode = false;
+
+PassManager& optimization_pipeline()
+{
+    static auto pass_manager = [] {
+        auto pass_manager = make<PassManager>();
+        pass_manager->add<Passes::PropagateCopies>();
+        pass_manager->add<Passes::FoldConstants>();
+        pass_manager->add<Passes::PropagateCopies>();
+        pass_manager->add<Passes::ThreadJumps>();
+        pass_manager->add<Passes::GenerateCFG>();
+        pass_manager->add<Passes::EliminateUnreachableBlocks>();
+        pass_manager->add<Passes::AllocateRegisters>();
+        return pass_manager;
+    }();
+    return *pass_manager;
+}
+
+void PassManager::perform(Executable& executable)
+{
+    PassPipelineExecutable pipeline_executable { executable };
+
+    if (!g_dump_bytecode) {
+        perform(pipeline_executable);
+        return;
+    }
+
+    auto blocks_before = executable.basic_blocks.size();
+    auto instructions_before = instruction_count(executable);
+    auto registers_before = executable.number_of_registers;
+
+    perform(pipeline_executable);
+
+    warnln("\033[37;1mOptimized bytecode\033[0m in {}us: {} -> {} blocks, {} -> {} instructions, {} -> {} registers",
+        elapsed(),
+        blocks_before, executable.basic_blocks.size(),
+        instructions_before, instruction_count(executable),
+        registers_before, executable.number_of_registers);
+    for (auto& pass : m_passes)
+        warnln("  {}: {}us", pass->name(), pass->elapsed());
+}
+
+void PassManager::perform(PassPipelineExecutable& executable)
+{
+    started();
+    for (auto& pass : m_passes)
+        pass->perform(executable);
+    finished();
+}
+
+void InstructionStreamRewriter::keep(Instruction const& instruction)
+{
+    auto slot_offset = m_buffer.size();
+    m_buffer.resize(slot_offset + instruction.length());
+    memcpy(m_buffer.data() + slot_offset, &instruction, instruction.length());
+}
+
+void InstructionStreamRewriter::drop(Instruction& instruction)
+{
+    Instruction::destroy(instruction);
+}
+
+void InstructionStreamRewriter::finish()
+{
+    m_block.replace_instruction_stream({}, move(m_buffer));
+}
+
+Vector<Instruction*> instructions_of(BasicBlock& block)
+{
+    Vector<Instruction*> instructions;
+    InstructionStreamIterator it(block.instruction_stream());
+    while (!it.at_end()) {
+        instructions.append(const_cast<Instruction*>(&*it));
+        ++it;
+    }
+    return instructions;
+}
+
+Optional<size_t> written_operand_count(Instruction const& instruction)
+{
+    switch (instruction.type()) {
+#define __BYTECODE_OP(OpTitleCase, ...) \
+    case Instruction::Type::OpTitleCase:
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITH_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_BINARY_OPS_WITHOUT_FAST_PATH(__BYTECODE_OP)
+        JS_ENUMERATE_COMMON_UNARY_OPS(__BYTECODE_OP)
+#undef __BYTECODE_OP
+    case Instruction::Type::Mov:
+    case Instruction::Type::GetById:
+    case Instruction::Type::GetByValue:
+    case Instruction::Type::Call:
+        return 1;
+    case Instruction::Type::SetLocal:
+    case Instruction::Type::SetVariable:
+    case Instruction::Type::PutById:
+    case Instruction::Type::PutByValue:
+    case Instruction::Type::JumpIf:
+    case Instruction::Type::JumpNullish:
+    case Instruction::Type::JumpUndefined:
+    case Instruction::Type::End:
+    case Instruction::Type::Return:
+    case Instruction::Type::Throw:
+    case Instruction::Type::ThrowIfNotObject:
+    case Instruction::Type::ThrowIfNullish:
+    case Instruction::Type::ThrowIfTDZ:
+        return 0;
+    default:
+        return {};
+    }
+}
+
+size_t instruction_count(Executable const& executable)
+{
+    size_t count = 0;
+    for (auto const& block : executable.basic_blocks) {
+        InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            ++count;
+            ++it;
+        }
+    }
+    return count;
+}
+
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Instruction.h>
+
+namespace JS::Bytecode {
+
+struct PassPipelineExecutable {
+    Executable& executable;
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> cfg {};
+    Optional<HashMap<BasicBlock const*, HashTable<BasicBlock const*>>> inverted_cfg {};
+};
+
+class Pass {
+public:
+    Pass() = default;
+    virtual ~Pass() = default;
+
+    virtual StringView name() const = 0;
+    virtual void perform(PassPipelineExecutable&) = 0;
+
+    void started() { m_timer.start(); }
+    void finished() { m_time_difference = m_timer.elapsed_time(); }
+
+    u64 elapsed() const { return m_time_difference.to_microseconds(); }
+
+protected:
+    Core::ElapsedTimer m_timer { Core::TimerType::Precise };
+    Duration m_time_difference {};
+};
+
+class PassManager : public Pass {
+public:
+    PassManager() = default;
+    ~PassManager() override = default;
+
+    template<typename PassT, typename... Args>
+    void add(Args&&... args) { m_passes.append(make<PassT>(forward<Args>(args)...)); }
+
+    virtual StringView name() const override { return "PassManager"sv; }
+
+    void perform(Executable&);
+    virtual void perform(PassPipelineExecutable&) override;
+
+private:
+    Vector<NonnullOwnPtr<Pass>> m_passes;
+};
+
+// Rebuilds the instruction stream of a block. Instructions are moved into the new stream with memcpy,
+// which is fine since all of them are trivially relocatable. Instructions that are not kept are destroyed.
+class InstructionStreamRewriter {
+public:
+    explicit InstructionStreamRewriter(BasicBlock& block)
+        : m_block(block)
+    {
+    }
+
+    void keep(Instruction const&);
+    void drop(Instruction&);
+    void finish();
+
+    template<typename OpType, typename... Args>
+    void replace(Instruction& instruction, Args&&... args)
+    {
+        auto source_record = instruction.source_record();
+        drop(instruction);
+        auto slot_offset = m_buffer.size();
+        m_buffer.resize(slot_offset + sizeof(OpType));
+        auto* op = new (m_buffer.data() + slot_offset) OpType(forward<Args>(args)...);
+        op->set_source_record(source_record);
+    }
+
+private:
+    BasicBlock& m_block;
+    Vector<u8> m_buffer;
+};
+
+size_t instruction_count(Executable const&);
+
+// Note: The instructions are collected up front, so callers are free to rewrite the block while walking them.
+Vector<Instruction*> instructions_of(BasicBlock&);
+
+// Returns how many of the operands (in visit_operands() order) are only written to by the instruction,
+// with all remaining operands only being read. Returns an empty Optional for instructions we don't know.
+Optional<size_t> written_operand_count(Instruction const&);
+
+namespace Passes {
+
+class GenerateCFG final : public Pass {
+public:
+    virtual StringView name() const override { return "GenerateCFG"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class ThreadJumps final : public Pass {
+public:
+    virtual StringView name() const override { return "ThreadJumps"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class EliminateUnreachableBlocks final : public Pass {
+public:
+    virtual StringView name() const override { return "EliminateUnreachableBlocks"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class PropagateCopies final : public Pass {
+public:
+    virtual StringView name() const override { return "PropagateCopies"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class FoldConstants final : public Pass {
+public:
+    virtual StringView name() const override { return "FoldConstants"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+class AllocateRegisters final : public Pass {
+public:
+    virtual StringView name() const override { return "AllocateRegisters"sv; }
+    virtual void perform(PassPipelineExecutable&) override;
+};
+
+}
+
+PassManager& optimization_pipeline();
+
+extern bool g_optimize_bytecode;
+
+}
@@ -203,6 +203,7 @@ class PromiseReaction;
 class PropertyAttributes;
 class PropertyDescriptor;
 class PropertyKey;
+class PrototypeChainValidity;
 class Realm;
 class Reference;
 class ScopeNode;
@@ -318,6 +319,7 @@ enum class Builtin;
 class Executable;
 class Generator;
 class Instruction;
+class InstructionStreamRewriter;
 class Interpreter;
 class Operand;
 class RegexTable;
@@ -108,15 +108,17 @@ static void add_possible_value(HashMap<FlatPtr, HeapRoot>& possible_pointers, Fl
     }
 }
 
-void Heap::find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address)
+Heap::LiveHeapBlocks Heap::gather_live_heap_blocks()
 {
-    min_address = explode_byte(0xff);
-    max_address = 0;
+    LiveHeapBlocks live_heap_blocks;
+    live_heap_blocks.min_address = explode_byte(0xff);
     for_each_block([&](auto& block) {
-        min_address = min(min_address, reinterpret_cast<FlatPtr>(&block));
-        max_address = max(max_address, reinterpret_cast<FlatPtr>(&block) + HeapBlockBase::block_size);
+        live_heap_blocks.blocks.set(&block);
+        live_heap_blocks.min_address = min(live_heap_blocks.min_address, reinterpret_cast<FlatPtr>(&block));
+        live_heap_blocks.max_address = max(live_heap_blocks.max_address, reinterpret_cast<FlatPtr>(&block) + HeapBlockBase::block_size);
         return IterationDecision::Continue;
     });
+    return live_heap_blocks;
 }
 
 template<typename Callback>
@@ -136,14 +138,9 @@ static void for_each_cell_among_possible_pointers(HashTable<HeapBlock*> const& a
 
 class GraphConstructorVisitor final : public Cell::Visitor {
 public:
-    explicit GraphConstructorVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
-        : m_heap(heap)
+    explicit GraphConstructorVisitor(Heap::LiveHeapBlocks const& live_heap_blocks, HashMap<Cell*, HeapRoot> const& roots)
+        : m_live_heap_blocks(live_heap_blocks)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
 
         for (auto& [root, root_origin] : roots) {
             auto& graph_node = m_graph.ensure(bit_cast<FlatPtr>(root));
@@ -171,9 +168,9 @@ public:
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_live_heap_blocks.min_address, m_live_heap_blocks.max_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_live_heap_blocks.blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (m_node_being_visited)
                 m_node_being_visited->edges.set(reinterpret_cast<FlatPtr>(&cell));
 
@@ -249,17 +246,15 @@ private:
     Vector<NonnullGCPtr<Cell>> m_work_queue;
     HashMap<FlatPtr, GraphNode> m_graph;
 
-    Heap& m_heap;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    Heap::LiveHeapBlocks const& m_live_heap_blocks;
 };
 
 AK::JsonObject Heap::dump_graph()
 {
+    auto live_heap_blocks = gather_live_heap_blocks();
     HashMap<Cell*, HeapRoot> roots;
-    gather_roots(roots);
-    GraphConstructorVisitor visitor(*this, roots);
+    gather_roots(roots, live_heap_blocks);
+    GraphConstructorVisitor visitor(live_heap_blocks, roots);
     vm().bytecode_interpreter().visit_edges(visitor);
     visitor.visit_all_cells();
     return visitor.dump();
@@ -275,27 +270,90 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
     perf_event(PERF_EVENT_SIGNPOST, gc_perf_string_id, global_gc_counter++);
 #endif
 
-    Core::ElapsedTimer collection_measurement_timer;
-    if (print_report)
-        collection_measurement_timer.start();
+    if (collection_type == CollectionType::CollectGarbage && m_gc_deferrals) {
+        m_should_gc_when_deferral_ends = true;
+        return;
+    }
+
+    Core::ElapsedTimer collection_measurement_timer { Core::TimerType::Precise };
+    collection_measurement_timer.start();
 
+    Core::ElapsedTimer phase_timer { Core::TimerType::Precise };
     if (collection_type == CollectionType::CollectGarbage) {
-        if (m_gc_deferrals) {
-            m_should_gc_when_deferral_ends = true;
-            return;
-        }
+        phase_timer.start();
+        auto live_heap_blocks = gather_live_heap_blocks();
         HashMap<Cell*, HeapRoot> roots;
-        gather_roots(roots);
-        mark_live_cells(roots);
+        gather_roots(roots, live_heap_blocks);
+        m_statistics.time_spent_gathering_roots += phase_timer.elapsed_time();
+
+        phase_timer.start();
+        mark_live_cells(roots, live_heap_blocks);
+        m_statistics.time_spent_marking += phase_timer.elapsed_time();
     }
+
+    phase_timer.start();
     finalize_unmarked_cells();
+    m_statistics.time_spent_finalizing += phase_timer.elapsed_time();
+
+    phase_timer.start();
     sweep_dead_cells(print_report, collection_measurement_timer);
+    m_statistics.time_spent_sweeping += phase_timer.elapsed_time();
+
+    m_statistics.record_pause(collection_measurement_timer.elapsed_time());
+}
+
+void Heap::CollectionStatistics::record_pause(Duration pause_time)
+{
+    ++collections;
+    total_pause_time += pause_time;
+    longest_pause_time = max(longest_pause_time, pause_time);
+
+    size_t bucket = 0;
+    for (auto milliseconds = pause_time.to_milliseconds(); milliseconds > 0 && bucket < pause_time_bucket_count - 1; milliseconds >>= 1)
+        ++bucket;
+    ++pause_time_histogram[bucket];
+}
+
+void Heap::CollectionStatistics::dump() const
+{
+    warnln("\033[37;1mGarbage collection statistics\033[0m");
+    warnln("  Collections: {}", collections);
+    warnln("  Total pause time: {} ms (longest: {} ms)", total_pause_time.to_milliseconds(), longest_pause_time.to_milliseconds());
+    warnln("  Time spent gathering roots: {} ms, marking: {} ms, finalizing: {} ms, sweeping: {} ms",
+        time_spent_gathering_roots.to_milliseconds(),
+        time_spent_marking.to_milliseconds(),
+        time_spent_finalizing.to_milliseconds(),
+        time_spent_sweeping.to_milliseconds());
+    warnln("  Pause time histogram:");
+    for (size_t i = 0; i < pause_time_bucket_count; ++i) {
+        if (i == pause_time_bucket_count - 1)
+            warnln("    >= {} ms: {}", 1 << (i - 1), pause_time_histogram[i]);
+        else
+            warnln("    < {} ms: {}", 1 << i, pause_time_histogram[i]);
+    }
+}
+
+AK::JsonObject Heap::CollectionStatistics::to_json() const
+{
+    AK::JsonObject object;
+    object.set("collections"sv, collections);
+    object.set("totalPauseTimeMs"sv, total_pause_time.to_milliseconds());
+    object.set("longestPauseTimeMs"sv, longest_pause_time.to_milliseconds());
+    object.set("gatheringRootsTimeMs"sv, time_spent_gathering_roots.to_milliseconds());
+    object.set("markingTimeMs"sv, time_spent_marking.to_milliseconds());
+    object.set("finalizingTimeMs"sv, time_spent_finalizing.to_milliseconds());
+    object.set("sweepingTimeMs"sv, time_spent_sweeping.to_milliseconds());
+    AK::JsonArray histogram;
+    for (auto count : pause_time_histogram)
+        histogram.must_append(count);
+    object.set("pauseTimeHistogram"sv, move(histogram));
+    return object;
 }
 
-void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots)
+void Heap::gather_roots(HashMap<Cell*, HeapRoot>& roots, LiveHeapBlocks const& live_heap_blocks)
 {
     vm().gather_roots(roots);
-    gather_conservative_roots(roots);
+    gather_conservative_roots(roots, live_heap_blocks);
 
     for (auto& handle : m_handles)
         roots.set(handle.cell(), HeapRoot { .type = HeapRoot::Type::Handle, .location = &handle.source_location() });
@@ -332,7 +390,7 @@ void Heap::gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, Fl
 }
 #endif
 
-NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots)
+NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot>& roots, LiveHeapBlocks const& live_heap_blocks)
 {
     FlatPtr dummy;
 
@@ -345,8 +403,8 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
     auto* raw_jmp_buf = reinterpret_cast<FlatPtr const*>(buf);
 
-    FlatPtr min_block_address, max_block_address;
-    find_min_and_max_block_addresses(min_block_address, max_block_address);
+    auto min_block_address = live_heap_blocks.min_address;
+    auto max_block_address = live_heap_blocks.max_address;
 
     for (size_t i = 0; i < ((size_t)sizeof(buf)) / sizeof(FlatPtr); ++i)
         add_possible_value(possible_pointers, raw_jmp_buf[i], HeapRoot { .type = HeapRoot::Type::RegisterPointer }, min_block_address, max_block_address);
@@ -377,13 +435,7 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
         }
     }
 
-    HashTable<HeapBlock*> all_live_heap_blocks;
-    for_each_block([&](auto& block) {
-        all_live_heap_blocks.set(&block);
-        return IterationDecision::Continue;
-    });
-
-    for_each_cell_among_possible_pointers(all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
+    for_each_cell_among_possible_pointers(live_heap_blocks.blocks, possible_pointers, [&](Cell* cell, FlatPtr possible_pointer) {
         if (cell->state() == Cell::State::Live) {
             dbgln_if(HEAP_DEBUG, "  ?-> {}", (void const*)cell);
             roots.set(cell, *possible_pointers.get(possible_pointer));
@@ -395,15 +447,9 @@ NO_SANITIZE_ADDRESS void Heap::gather_conservative_roots(HashMap<Cell*, HeapRoot
 
 class MarkingVisitor final : public Cell::Visitor {
 public:
-    explicit MarkingVisitor(Heap& heap, HashMap<Cell*, HeapRoot> const& roots)
-        : m_heap(heap)
+    explicit MarkingVisitor(Heap::LiveHeapBlocks const& live_heap_blocks, HashMap<Cell*, HeapRoot> const& roots)
+        : m_live_heap_blocks(live_heap_blocks)
     {
-        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
-        m_heap.for_each_block([&](auto& block) {
-            m_all_live_heap_blocks.set(&block);
-            return IterationDecision::Continue;
-        });
-
         for (auto* root : roots.keys()) {
             visit(root);
         }
@@ -425,9 +471,9 @@ public:
 
         auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
         for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
-            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_live_heap_blocks.min_address, m_live_heap_blocks.max_address);
 
-        for_each_cell_among_possible_pointers(m_all_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+        for_each_cell_among_possible_pointers(m_live_heap_blocks.blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
             if (cell->is_marked())
                 return;
             if (cell->state() != Cell::State::Live)
@@ -445,18 +491,15 @@ public:
     }
 
 private:
-    Heap& m_heap;
     Vector<NonnullGCPtr<Cell>> m_work_queue;
-    HashTable<HeapBlock*> m_all_live_heap_blocks;
-    FlatPtr m_min_block_address;
-    FlatPtr m_max_block_address;
+    Heap::LiveHeapBlocks const& m_live_heap_blocks;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots, LiveHeapBlocks const& live_heap_blocks)
 {
     dbgln_if(HEAP_DEBUG, "mark_live_cells:");
 
-    MarkingVisitor visitor(*this, roots);
+    MarkingVisitor visitor(live_heap_blocks, roots);
 
     vm().bytecode_interpreter().visit_edges(visitor);
 
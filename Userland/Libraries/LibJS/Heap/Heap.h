@@ -6,11 +6,13 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Badge.h>
 #include <AK/HashTable.h>
 #include <AK/IntrusiveList.h>
 #include <AK/Noncopyable.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
 #include <LibCore/Forward.h>
@@ -63,9 +65,32 @@ public:
         CollectEverything,
     };
 
+    // FIXME: Every collection is a full, stop-the-world mark and sweep of the whole heap. A nursery and incremental marking
+    //        both need a write barrier on every store of a GC pointer, and sweeping lazily or on another thread needs
+    //        WeakPtrs to dead cells (e.g. in shape transition tables) to be revoked before those cells are swept.
     void collect_garbage(CollectionType = CollectionType::CollectGarbage, bool print_report = false);
     AK::JsonObject dump_graph();
 
+    struct CollectionStatistics {
+        // Pause times are bucketed by powers of two in milliseconds: [0, 1), [1, 2), [2, 4), ..., [512, inf).
+        static constexpr size_t pause_time_bucket_count = 11;
+
+        u64 collections { 0 };
+        Duration total_pause_time;
+        Duration longest_pause_time;
+        Duration time_spent_gathering_roots;
+        Duration time_spent_marking;
+        Duration time_spent_finalizing;
+        Duration time_spent_sweeping;
+        AK::Array<u64, pause_time_bucket_count> pause_time_histogram {};
+
+        void record_pause(Duration);
+        void dump() const;
+        AK::JsonObject to_json() const;
+    };
+
+    CollectionStatistics const& statistics() const { return m_statistics; }
+
     bool should_collect_on_every_allocation() const { return m_should_collect_on_every_allocation; }
     void set_should_collect_on_every_allocation(bool b) { m_should_collect_on_every_allocation = b; }
 
@@ -88,6 +113,15 @@ public:
 
     void uproot_cell(Cell* cell);
 
+    template<typename Callback>
+    void for_each_live_cell(Callback callback)
+    {
+        for_each_block([&](auto& block) {
+            block.template for_each_cell_in_state<Cell::State::Live>(callback);
+            return IterationDecision::Continue;
+        });
+    }
+
 private:
     friend class MarkingVisitor;
     friend class GraphConstructorVisitor;
@@ -112,11 +146,18 @@ private:
 
     void will_allocate(size_t);
 
-    void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
-    void gather_roots(HashMap<Cell*, HeapRoot>&);
-    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&);
+    // A snapshot of all heap blocks, taken once per collection and shared between root gathering and marking.
+    struct LiveHeapBlocks {
+        HashTable<HeapBlock*> blocks;
+        FlatPtr min_address { 0 };
+        FlatPtr max_address { 0 };
+    };
+    LiveHeapBlocks gather_live_heap_blocks();
+
+    void gather_roots(HashMap<Cell*, HeapRoot>&, LiveHeapBlocks const&);
+    void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, LiveHeapBlocks const&);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address);
-    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells, LiveHeapBlocks const&);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
 
@@ -160,6 +201,8 @@ private:
     bool m_should_gc_when_deferral_ends { false };
 
     bool m_collecting_garbage { false };
+
+    CollectionStatistics m_statistics;
 };
 
 inline void Heap::did_create_handle(Badge<HandleImpl>, HandleImpl& impl)
@@ -0,0 +1,430 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Format.h>
+#include <AK/TemporaryChange.h>
+#include <LibJS/Bytecode/BasicBlock.h>
+#include <LibJS/Bytecode/CommonImplementations.h>
+#include <LibJS/Bytecode/Instruction.h>
+#include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/JIT/Compiler.h>
+#include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/Shape.h>
+#include <stdlib.h>
+
+namespace JS::JIT {
+
+bool g_jit_enabled = getenv("LIBJS_JIT") != nullptr;
+
+#ifdef JIT_ARCH_SUPPORTED
+
+using Operand = ::JIT::Assembler::Operand;
+using Condition = ::JIT::Assembler::Condition;
+
+static u64 cxx_execute_instruction(Bytecode::Interpreter& interpreter, Bytecode::BasicBlock const& block, Bytecode::Instruction const& instruction)
+{
+    // Note: A non-zero return value tells the native code to leave the executable, either because
+    //       an exception was thrown (and stored in the exception register), or because we returned.
+    auto result = interpreter.execute_instruction_out_of_line(block, instruction);
+    if (result.is_error()) [[unlikely]] {
+        interpreter.reg(Bytecode::Register::exception()) = *result.throw_completion().value();
+        return 1;
+    }
+    return interpreter.reg(Bytecode::Register::return_value()).is_empty() ? 0 : 1;
+}
+
+static u64 cxx_to_boolean(u64 encoded_value)
+{
+    return bit_cast<Value>(encoded_value).to_boolean();
+}
+
+static u64 cxx_get_by_id_cached(u64 encoded_base, Bytecode::PropertyLookupCache const& cache)
+{
+    // Returns the empty value when the cache misses, in which case the generic GetById runs instead.
+    auto base = bit_cast<Value>(encoded_base);
+    if (!base.is_object())
+        return Value().encoded();
+    return Bytecode::get_cached_property(base.as_object(), cache).encoded();
+}
+
+bool Compiler::can_compile(Bytecode::Executable const& bytecode_executable)
+{
+    // FIXME: Support unwind contexts and generators. For now, executables using them stay in the interpreter.
+    for (auto const& block : bytecode_executable.basic_blocks) {
+        if (block->handler() || block->finalizer())
+            return false;
+
+        Bytecode::InstructionStreamIterator it(block->instruction_stream());
+        while (!it.at_end()) {
+            switch ((*it).type()) {
+            case Bytecode::Instruction::Type::Await:
+            case Bytecode::Instruction::Type::Catch:
+            case Bytecode::Instruction::Type::ContinuePendingUnwind:
+            case Bytecode::Instruction::Type::EnterUnwindContext:
+            case Bytecode::Instruction::Type::LeaveUnwindContext:
+            case Bytecode::Instruction::Type::ScheduleJump:
+            case Bytecode::Instruction::Type::Yield:
+                return false;
+            default:
+                break;
+            }
+            ++it;
+        }
+    }
+    return true;
+}
+
+Compiler::Assembler::Label& Compiler::label_for(Bytecode::BasicBlock const& block)
+{
+    return m_block_labels[m_block_indices.get(&block).value()];
+}
+
+void Compiler::native_call(void* function_address)
+{
+    m_assembler.native_call(bit_cast<u64>(function_address));
+}
+
+void Compiler::load_vm_operand(Assembler::Reg dst, Bytecode::Operand operand)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(Operand::Register(dst), Operand::Mem64BaseAndOffset(REGISTER_ARRAY_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(Operand::Register(dst), Operand::Mem64BaseAndOffset(LOCALS_ARRAY_BASE, operand.index() * sizeof(Value)));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        m_assembler.mov(Operand::Register(dst), Operand::Imm(m_bytecode_executable.constants[operand.index()].encoded()));
+        return;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Compiler::store_vm_operand(Bytecode::Operand operand, Assembler::Reg src)
+{
+    switch (operand.type()) {
+    case Bytecode::Operand::Type::Register:
+        m_assembler.mov(Operand::Mem64BaseAndOffset(REGISTER_ARRAY_BASE, operand.index() * sizeof(Value)), Operand::Register(src));
+        return;
+    case Bytecode::Operand::Type::Local:
+        m_assembler.mov(Operand::Mem64BaseAndOffset(LOCALS_ARRAY_BASE, operand.index() * sizeof(Value)), Operand::Register(src));
+        return;
+    case Bytecode::Operand::Type::Constant:
+        break;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void Compiler::extract_tag(Assembler::Reg dst, Assembler::Reg src)
+{
+    m_assembler.mov(Operand::Register(dst), Operand::Register(src));
+    m_assembler.shift_right(Operand::Register(dst), Operand::Imm(TAG_SHIFT));
+}
+
+void Compiler::jump_if_not_int32(Assembler::Reg reg, Assembler::Label& label)
+{
+    extract_tag(GPR2, reg);
+    m_assembler.jump_if(Operand::Register(GPR2), Condition::NotEqualTo, Operand::Imm(INT32_TAG), label);
+}
+
+void Compiler::box_int32(Assembler::Reg reg)
+{
+    // Note: This expects the upper 32 bits of `reg` to be clear, which all 32-bit operations guarantee.
+    m_assembler.mov(Operand::Register(GPR2), Operand::Imm(SHIFTED_INT32_TAG));
+    m_assembler.bitwise_or(Operand::Register(reg), Operand::Register(GPR2));
+}
+
+void Compiler::jump_to_targets(Condition condition, Bytecode::Op::Jump const& op)
+{
+    m_assembler.jump_if(condition, label_for(op.true_target()->block()));
+    m_assembler.jump(label_for(op.false_target()->block()));
+}
+
+void Compiler::compile_generic(Bytecode::Instruction const& instruction)
+{
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(INTERPRETER));
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(bit_cast<FlatPtr>(m_current_block)));
+    m_assembler.mov(Operand::Register(ARG2), Operand::Imm(bit_cast<FlatPtr>(&instruction)));
+    native_call((void*)cxx_execute_instruction);
+    m_assembler.jump_if(Operand::Register(RET), Condition::NotEqualTo, Operand::Imm(0), m_exit_label);
+}
+
+void Compiler::compile_mov(Bytecode::Op::Mov const& op)
+{
+    load_vm_operand(GPR0, op.src());
+    store_vm_operand(op.dst(), GPR0);
+}
+
+void Compiler::compile_set_local(Bytecode::Op::SetLocal const& op)
+{
+    load_vm_operand(GPR0, op.src());
+    store_vm_operand(op.dst(), GPR0);
+}
+
+void Compiler::compile_end(Bytecode::Op::End const& op)
+{
+    load_vm_operand(GPR0, op.value());
+    store_vm_operand(Bytecode::Operand(Bytecode::Register::accumulator()), GPR0);
+    m_assembler.jump(m_exit_label);
+}
+
+void Compiler::compile_jump(Bytecode::Op::Jump const& op)
+{
+    m_assembler.jump(label_for(op.true_target()->block()));
+}
+
+void Compiler::compile_jump_if(Bytecode::Op::JumpIf const& op)
+{
+    load_vm_operand(GPR0, op.condition());
+
+    Assembler::Label not_boolean;
+    Assembler::Label not_int32;
+
+    // Booleans: The payload is 0 or 1.
+    extract_tag(GPR1, GPR0);
+    m_assembler.jump_if(Operand::Register(GPR1), Condition::NotEqualTo, Operand::Imm(BOOLEAN_TAG), not_boolean);
+    m_assembler.test(Operand::Register(GPR0), Operand::Imm(1));
+    jump_to_targets(Condition::NotEqualTo, op);
+
+    // Int32: Any non-zero payload is truthy.
+    not_boolean.link(m_assembler);
+    m_assembler.jump_if(Operand::Register(GPR1), Condition::NotEqualTo, Operand::Imm(INT32_TAG), not_int32);
+    m_assembler.mov32(Operand::Register(GPR0), Operand::Register(GPR0));
+    m_assembler.test(Operand::Register(GPR0), Operand::Register(GPR0));
+    jump_to_targets(Condition::NotEqualTo, op);
+
+    not_int32.link(m_assembler);
+    m_assembler.mov(Operand::Register(ARG0), Operand::Register(GPR0));
+    native_call((void*)cxx_to_boolean);
+    m_assembler.test(Operand::Register(RET), Operand::Register(RET));
+    jump_to_targets(Condition::NotEqualTo, op);
+}
+
+void Compiler::compile_jump_nullish(Bytecode::Op::JumpNullish const& op)
+{
+    load_vm_operand(GPR0, op.condition());
+    extract_tag(GPR0, GPR0);
+    m_assembler.bitwise_and(Operand::Register(GPR0), Operand::Imm(IS_NULLISH_EXTRACT_PATTERN));
+    m_assembler.cmp(Operand::Register(GPR0), Operand::Imm(IS_NULLISH_PATTERN));
+    jump_to_targets(Condition::EqualTo, op);
+}
+
+void Compiler::compile_jump_undefined(Bytecode::Op::JumpUndefined const& op)
+{
+    load_vm_operand(GPR0, op.condition());
+    extract_tag(GPR0, GPR0);
+    m_assembler.cmp(Operand::Register(GPR0), Operand::Imm(UNDEFINED_TAG));
+    jump_to_targets(Condition::EqualTo, op);
+}
+
+void Compiler::compile_int32_arithmetic(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, bool is_addition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label end;
+
+    load_vm_operand(GPR0, lhs);
+    load_vm_operand(GPR1, rhs);
+    jump_if_not_int32(GPR0, slow_case);
+    jump_if_not_int32(GPR1, slow_case);
+
+    // Note: On overflow, the operands are still untouched in memory, so the slow case can simply start over.
+    if (is_addition)
+        m_assembler.add32(Operand::Register(GPR0), Operand::Register(GPR1), slow_case);
+    else
+        m_assembler.sub32(Operand::Register(GPR0), Operand::Register(GPR1), slow_case);
+    box_int32(GPR0);
+    store_vm_operand(dst, GPR0);
+    m_assembler.jump(end);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    end.link(m_assembler);
+}
+
+void Compiler::compile_int32_comparison(Bytecode::Instruction const& instruction, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Condition condition)
+{
+    Assembler::Label slow_case;
+    Assembler::Label end;
+
+    load_vm_operand(GPR0, lhs);
+    load_vm_operand(GPR1, rhs);
+    jump_if_not_int32(GPR0, slow_case);
+    jump_if_not_int32(GPR1, slow_case);
+
+    m_assembler.sign_extend_32_to_64_bits(GPR0);
+    m_assembler.sign_extend_32_to_64_bits(GPR1);
+    m_assembler.cmp(Operand::Register(GPR0), Operand::Register(GPR1));
+    // Note: Loading a non-zero 64-bit immediate does not touch the flags.
+    m_assembler.mov(Operand::Register(GPR0), Operand::Imm(SHIFTED_BOOLEAN_TAG));
+    m_assembler.set_if(condition, Operand::Register(GPR0));
+    store_vm_operand(dst, GPR0);
+    m_assembler.jump(end);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    end.link(m_assembler);
+}
+
+void Compiler::compile_int32_step(Bytecode::Instruction const& instruction, Bytecode::Operand dst, bool is_increment)
+{
+    Assembler::Label slow_case;
+    Assembler::Label end;
+
+    load_vm_operand(GPR0, dst);
+    jump_if_not_int32(GPR0, slow_case);
+    if (is_increment)
+        m_assembler.inc32(Operand::Register(GPR0), slow_case);
+    else
+        m_assembler.dec32(Operand::Register(GPR0), slow_case);
+    box_int32(GPR0);
+    store_vm_operand(dst, GPR0);
+    m_assembler.jump(end);
+
+    slow_case.link(m_assembler);
+    compile_generic(instruction);
+    end.link(m_assembler);
+}
+
+void Compiler::compile_add(Bytecode::Op::Add const& op)
+{
+    compile_int32_arithmetic(op, op.dst(), op.lhs(), op.rhs(), true);
+}
+
+void Compiler::compile_sub(Bytecode::Op::Sub const& op)
+{
+    compile_int32_arithmetic(op, op.dst(), op.lhs(), op.rhs(), false);
+}
+
+void Compiler::compile_less_than(Bytecode::Op::LessThan const& op)
+{
+    compile_int32_comparison(op, op.dst(), op.lhs(), op.rhs(), Condition::SignedLessThan);
+}
+
+void Compiler::compile_less_than_equals(Bytecode::Op::LessThanEquals const& op)
+{
+    compile_int32_comparison(op, op.dst(), op.lhs(), op.rhs(), Condition::SignedLessThanOrEqualTo);
+}
+
+void Compiler::compile_greater_than(Bytecode::Op::GreaterThan const& op)
+{
+    compile_int32_comparison(op, op.dst(), op.lhs(), op.rhs(), Condition::SignedGreaterThan);
+}
+
+void Compiler::compile_greater_than_equals(Bytecode::Op::GreaterThanEquals const& op)
+{
+    compile_int32_comparison(op, op.dst(), op.lhs(), op.rhs(), Condition::SignedGreaterThanOrEqualTo);
+}
+
+void Compiler::compile_increment(Bytecode::Op::Increment const& op)
+{
+    compile_int32_step(op, op.dst(), true);
+}
+
+void Compiler::compile_decrement(Bytecode::Op::Decrement const& op)
+{
+    compile_int32_step(op, op.dst(), false);
+}
+
+void Compiler::compile_get_by_id(Bytecode::Op::GetById const& op)
+{
+    Assembler::Label slow_case;
+    Assembler::Label end;
+
+    load_vm_operand(ARG0, op.base());
+    m_assembler.mov(Operand::Register(ARG1), Operand::Imm(bit_cast<FlatPtr>(&m_bytecode_executable.property_lookup_caches[op.cache_index()])));
+    native_call((void*)cxx_get_by_id_cached);
+    m_assembler.mov(Operand::Register(GPR1), Operand::Imm(Value().encoded()));
+    m_assembler.jump_if(Operand::Register(RET), Condition::EqualTo, Operand::Register(GPR1), slow_case);
+    store_vm_operand(op.dst(), RET);
+    m_assembler.jump(end);
+
+    slow_case.link(m_assembler);
+    compile_generic(op);
+    end.link(m_assembler);
+}
+
+void Compiler::compile_block(Bytecode::BasicBlock const& block)
+{
+    m_current_block = &block;
+    label_for(block).link(m_assembler);
+
+    Bytecode::InstructionStreamIterator it(block.instruction_stream());
+    while (!it.at_end()) {
+        auto const& instruction = *it;
+        switch (instruction.type()) {
+#    define CASE_BYTECODE_OP(OpTitleCase, op_snake_case)                                        \
+    case Bytecode::Instruction::Type::OpTitleCase:                                              \
+        compile_##op_snake_case(static_cast<Bytecode::Op::OpTitleCase const&>(instruction)); \
+        break;
+            CASE_BYTECODE_OP(Mov, mov)
+            CASE_BYTECODE_OP(SetLocal, set_local)
+            CASE_BYTECODE_OP(End, end)
+            CASE_BYTECODE_OP(Jump, jump)
+            CASE_BYTECODE_OP(JumpIf, jump_if)
+            CASE_BYTECODE_OP(JumpNullish, jump_nullish)
+            CASE_BYTECODE_OP(JumpUndefined, jump_undefined)
+            CASE_BYTECODE_OP(Add, add)
+            CASE_BYTECODE_OP(Sub, sub)
+            CASE_BYTECODE_OP(LessThan, less_than)
+            CASE_BYTECODE_OP(LessThanEquals, less_than_equals)
+            CASE_BYTECODE_OP(GreaterThan, greater_than)
+            CASE_BYTECODE_OP(GreaterThanEquals, greater_than_equals)
+            CASE_BYTECODE_OP(Increment, increment)
+            CASE_BYTECODE_OP(Decrement, decrement)
+            CASE_BYTECODE_OP(GetById, get_by_id)
+#    undef CASE_BYTECODE_OP
+        default:
+            compile_generic(instruction);
+            break;
+        }
+        ++it;
+    }
+
+    // Falling off the end of a block ends execution, just like in the interpreter.
+    m_assembler.jump(m_exit_label);
+}
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable& bytecode_executable)
+{
+    if (!can_compile(bytecode_executable)) {
+        dbgln_if(JS_BYTECODE_DEBUG, "JIT: Not compiling executable \"{}\", it uses unsupported instructions", bytecode_executable.name);
+        return nullptr;
+    }
+
+    Compiler compiler { bytecode_executable };
+    auto& assembler = compiler.m_assembler;
+
+    compiler.m_block_labels.resize(bytecode_executable.basic_blocks.size());
+    for (size_t i = 0; i < bytecode_executable.basic_blocks.size(); ++i)
+        compiler.m_block_indices.set(bytecode_executable.basic_blocks[i].ptr(), i);
+
+    assembler.enter();
+    assembler.mov(Operand::Register(INTERPRETER), Operand::Register(ARG0));
+    assembler.mov(Operand::Register(REGISTER_ARRAY_BASE), Operand::Register(ARG1));
+    assembler.mov(Operand::Register(LOCALS_ARRAY_BASE), Operand::Register(ARG2));
+
+    for (auto const& block : bytecode_executable.basic_blocks)
+        compiler.compile_block(*block);
+
+    compiler.m_exit_label.link(assembler);
+    assembler.exit();
+
+    auto name = bytecode_executable.name.is_empty() ? "(anonymous)"sv : bytecode_executable.name.view();
+    dbgln_if(JS_BYTECODE_DEBUG, "JIT: Compiled executable \"{}\" to {} bytes of native code", name, compiler.m_output.size());
+    return NativeExecutable::create(compiler.m_output, name);
+}
+
+#else
+
+OwnPtr<NativeExecutable> Compiler::compile(Bytecode::Executable&)
+{
+    return nullptr;
+}
+
+#endif
+
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/OwnPtr.h>
+#include <AK/Vector.h>
+#include <LibJIT/Assembler.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Bytecode/Op.h>
+#include <LibJS/JIT/NativeExecutable.h>
+
+namespace JS::JIT {
+
+// Set via the LIBJS_JIT environment variable, or `js --jit`.
+extern bool g_jit_enabled;
+
+class Compiler {
+public:
+    // Executables are only compiled once they have been entered this many times.
+    static constexpr u32 hotness_threshold = 16;
+
+    static OwnPtr<NativeExecutable> compile(Bytecode::Executable&);
+
+#ifdef JIT_ARCH_SUPPORTED
+private:
+    using Assembler = ::JIT::Assembler;
+
+    // Native code is called as `void(Interpreter&, Value* registers, Value* locals)`.
+    static constexpr auto ARG0 = Assembler::Reg::RDI;
+    static constexpr auto ARG1 = Assembler::Reg::RSI;
+    static constexpr auto ARG2 = Assembler::Reg::RDX;
+    static constexpr auto RET = Assembler::Reg::RAX;
+    static constexpr auto GPR0 = Assembler::Reg::RAX;
+    static constexpr auto GPR1 = Assembler::Reg::RCX;
+    static constexpr auto GPR2 = Assembler::Reg::RDX;
+
+    // Note: These live in callee-saved registers so they survive calls into C++ helpers.
+    //       R12 and R13 are avoided as memory base registers, since they need a SIB byte
+    //       or a displacement that the assembler does not emit for them.
+    static constexpr auto INTERPRETER = Assembler::Reg::R12;
+    static constexpr auto REGISTER_ARRAY_BASE = Assembler::Reg::RBX;
+    static constexpr auto LOCALS_ARRAY_BASE = Assembler::Reg::R14;
+
+    explicit Compiler(Bytecode::Executable& bytecode_executable)
+        : m_bytecode_executable(bytecode_executable)
+    {
+    }
+
+    static bool can_compile(Bytecode::Executable const&);
+
+    void compile_block(Bytecode::BasicBlock const&);
+
+    void compile_mov(Bytecode::Op::Mov const&);
+    void compile_set_local(Bytecode::Op::SetLocal const&);
+    void compile_end(Bytecode::Op::End const&);
+    void compile_jump(Bytecode::Op::Jump const&);
+    void compile_jump_if(Bytecode::Op::JumpIf const&);
+    void compile_jump_nullish(Bytecode::Op::JumpNullish const&);
+    void compile_jump_undefined(Bytecode::Op::JumpUndefined const&);
+    void compile_add(Bytecode::Op::Add const&);
+    void compile_sub(Bytecode::Op::Sub const&);
+    void compile_less_than(Bytecode::Op::LessThan const&);
+    void compile_less_than_equals(Bytecode::Op::LessThanEquals const&);
+    void compile_greater_than(Bytecode::Op::GreaterThan const&);
+    void compile_greater_than_equals(Bytecode::Op::GreaterThanEquals const&);
+    void compile_increment(Bytecode::Op::Increment const&);
+    void compile_decrement(Bytecode::Op::Decrement const&);
+    void compile_get_by_id(Bytecode::Op::GetById const&);
+    void compile_generic(Bytecode::Instruction const&);
+
+    void compile_int32_arithmetic(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, bool is_addition);
+    void compile_int32_comparison(Bytecode::Instruction const&, Bytecode::Operand dst, Bytecode::Operand lhs, Bytecode::Operand rhs, Assembler::Condition);
+    void compile_int32_step(Bytecode::Instruction const&, Bytecode::Operand dst, bool is_increment);
+
+    void load_vm_operand(Assembler::Reg dst, Bytecode::Operand);
+    void store_vm_operand(Bytecode::Operand, Assembler::Reg src);
+    void extract_tag(Assembler::Reg dst, Assembler::Reg src);
+    void jump_if_not_int32(Assembler::Reg, Assembler::Label&);
+    void box_int32(Assembler::Reg);
+    void jump_to_targets(Assembler::Condition, Bytecode::Op::Jump const&);
+    void native_call(void* function_address);
+
+    Assembler::Label& label_for(Bytecode::BasicBlock const&);
+
+    Vector<u8> m_output;
+    Assembler m_assembler { m_output };
+    Assembler::Label m_exit_label;
+    Vector<Assembler::Label> m_block_labels;
+    HashMap<Bytecode::BasicBlock const*, size_t> m_block_indices;
+    Bytecode::BasicBlock const* m_current_block { nullptr };
+    Bytecode::Executable& m_bytecode_executable;
+#endif
+};
+
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Format.h>
+#include <LibJIT/GDB.h>
+#include <LibJS/JIT/NativeExecutable.h>
+#include <sys/mman.h>
+
+namespace JS::JIT {
+
+OwnPtr<NativeExecutable> NativeExecutable::create(ReadonlyBytes code, StringView name)
+{
+    // Note: The code is written while the mapping is still writable, and only then flipped to
+    //       executable, so that no JIT mapping is ever writable and executable at the same time.
+    auto* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        dbgln("NativeExecutable: Failed to allocate {} bytes of executable memory", code.size());
+        return nullptr;
+    }
+    memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) < 0) {
+        dbgln("NativeExecutable: Failed to make JIT code executable");
+        munmap(memory, code.size());
+        return nullptr;
+    }
+
+    auto gdb_object = ::JIT::GDB::build_gdb_image({ memory, code.size() }, "LibJS JIT"sv, name);
+    if (gdb_object.has_value())
+        ::JIT::GDB::register_into_gdb(gdb_object->span());
+
+    return adopt_own(*new NativeExecutable(memory, code.size(), move(gdb_object)));
+}
+
+NativeExecutable::NativeExecutable(void* code, size_t size, Optional<FixedArray<u8>> gdb_object)
+    : m_code(code)
+    , m_size(size)
+    , m_gdb_object(move(gdb_object))
+{
+}
+
+NativeExecutable::~NativeExecutable()
+{
+    if (m_gdb_object.has_value())
+        ::JIT::GDB::unregister_from_gdb(m_gdb_object->span());
+    munmap(m_code, m_size);
+}
+
+void NativeExecutable::run(Bytecode::Interpreter& interpreter, Value* registers, Value* locals) const
+{
+    using EntryPoint = void (*)(Bytecode::Interpreter&, Value*, Value*);
+    bit_cast<EntryPoint>(m_code)(interpreter, registers, locals);
+}
+
+}
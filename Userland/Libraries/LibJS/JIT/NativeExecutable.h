@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FixedArray.h>
+#include <AK/Noncopyable.h>
+#include <AK/OwnPtr.h>
+#include <AK/Types.h>
+#include <LibJS/Bytecode/Interpreter.h>
+
+namespace JS::JIT {
+
+class NativeExecutable {
+    AK_MAKE_NONCOPYABLE(NativeExecutable);
+    AK_MAKE_NONMOVABLE(NativeExecutable);
+
+public:
+    static OwnPtr<NativeExecutable> create(ReadonlyBytes code, StringView name);
+    ~NativeExecutable();
+
+    void run(Bytecode::Interpreter&, Value* registers, Value* locals) const;
+
+    size_t code_size() const { return m_size; }
+
+private:
+    NativeExecutable(void* code, size_t size, Optional<FixedArray<u8>> gdb_object);
+
+    void* m_code { nullptr };
+    size_t m_size { 0 };
+    Optional<FixedArray<u8>> m_gdb_object;
+};
+
+}
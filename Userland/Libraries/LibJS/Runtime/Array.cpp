@@ -178,12 +178,32 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+SimpleIndexedPropertyStorage const* simple_indexed_property_storage_for_fast_access(Object const& object)
+{
+    if (object.may_interfere_with_indexed_property_access())
+        return nullptr;
+    auto const* storage = object.indexed_properties().storage();
+    if (!storage || !storage->is_simple_storage())
+        return nullptr;
+    return static_cast<SimpleIndexedPropertyStorage const*>(storage);
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
 {
     // 1. Let items be a new empty List.
     auto items = MarkedVector<Value> { vm.heap() };
 
+    // OPTIMIZATION: Packed arrays don't have holes, and HasProperty and Get can't have any side effects on them,
+    //               so we can copy the elements directly.
+    if (auto const* storage = simple_indexed_property_storage_for_fast_access(object); storage && storage->is_packed() && storage->array_like_size() >= length) {
+        items.ensure_capacity(length);
+        for (size_t k = 0; k < length; ++k)
+            items.unchecked_append(storage->elements()[k]);
+        TRY(array_merge_sort(vm, sort_compare, items));
+        return items;
+    }
+
     // 2. Let k be 0.
     // 3. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
@@ -231,6 +251,19 @@ ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM& vm, Object co
     return items;
 }
 
+static StringView int32_to_decimal_string(i32 value, AK::Array<char, 11>& buffer)
+{
+    auto magnitude = value < 0 ? -static_cast<u32>(value) : static_cast<u32>(value);
+    size_t start = buffer.size();
+    do {
+        buffer[--start] = '0' + (magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (value < 0)
+        buffer[--start] = '-';
+    return { buffer.data() + start, buffer.size() - start };
+}
+
 // 23.1.3.30.2 CompareArrayElements ( x, y, comparefn ), https://tc39.es/ecma262/#sec-comparearrayelements
 ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, FunctionObject* comparefn)
 {
@@ -260,6 +293,13 @@ ThrowCompletionOr<double> compare_array_elements(VM& vm, Value x, Value y, Funct
         return value_number.as_double();
     }
 
+    // OPTIMIZATION: Comparing the decimal representations of two int32s doesn't require allocating any strings.
+    if (x.is_int32() && y.is_int32()) {
+        AK::Array<char, 11> x_buffer;
+        AK::Array<char, 11> y_buffer;
+        return int32_to_decimal_string(x.as_i32(), x_buffer).compare(int32_to_decimal_string(y.as_i32(), y_buffer));
+    }
+
     // 5. Let xString be ? ToString(x).
     auto x_string = PrimitiveString::create(vm, TRY(x.to_byte_string(vm)));
 
@@ -66,4 +66,8 @@ enum class Holes {
 ThrowCompletionOr<MarkedVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
+// Returns the simple indexed property storage of the object if its elements can be read directly, i.e. without
+// going through [[HasProperty]] and [[Get]], as long as they are within [0, array_like_size()) and not holes.
+SimpleIndexedPropertyStorage const* simple_indexed_property_storage_for_fast_access(Object const&);
+
 }
@@ -31,6 +31,36 @@ JS_DEFINE_ALLOCATOR(ArrayPrototype);
 
 static HashTable<NonnullGCPtr<Object>> s_array_join_seen_objects;
 
+// OPTIMIZATION: Reads an element without going through [[HasProperty]] and [[Get]]. Returns an empty value if the
+//               element has to be looked up the slow way, e.g. because it's a hole that the prototype chain may fill.
+static Value fast_get_own_element(Object const& object, size_t index)
+{
+    auto const* storage = simple_indexed_property_storage_for_fast_access(object);
+    if (!storage || index >= storage->array_like_size())
+        return {};
+    return storage->elements()[index];
+}
+
+// OPTIMIZATION: Appending to an array can skip [[Set]] if no setter or read-only property can be hit on the way, that
+//               is if the array itself accepts new elements and there are no indexed properties on its prototype chain.
+static bool can_append_elements_directly(Object const& object, size_t length)
+{
+    if (!is<Array>(object) || !static_cast<Array const&>(object).length_is_writable())
+        return false;
+    if (object.may_interfere_with_indexed_property_access() || !MUST(object.is_extensible()))
+        return false;
+    auto const* storage = object.indexed_properties().storage();
+    if (storage && !storage->is_simple_storage())
+        return false;
+    if (object.indexed_properties().array_like_size() != length)
+        return false;
+    for (auto const* prototype = object.prototype(); prototype; prototype = prototype->prototype()) {
+        if (prototype->may_interfere_with_indexed_property_access() || !prototype->indexed_properties().is_empty())
+            return false;
+    }
+    return true;
+}
+
 ArrayPrototype::ArrayPrototype(Realm& realm)
     : Array(realm.intrinsics().object_prototype())
 {
@@ -697,6 +727,12 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::for_each)
     // 4. Let k be 0.
     // 5. Repeat, while k < len,
     for (size_t k = 0; k < length; ++k) {
+        // NOTE: The callback may change the array in any way, so this has to be checked on every iteration.
+        if (auto k_value = fast_get_own_element(object, k); !k_value.is_empty()) {
+            TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            continue;
+        }
+
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
@@ -742,6 +778,19 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::includes)
             from_index = from_argument;
     }
     auto value_to_find = vm.argument(0);
+
+    // OPTIMIZATION: Nothing in here can run user code, so a packed array can be searched directly.
+    if (auto const* storage = simple_indexed_property_storage_for_fast_access(this_object); storage && storage->is_packed() && storage->array_like_size() >= length) {
+        auto elements = storage->elements().span().slice(from_index, length - from_index);
+        if (storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::Int32) {
+            if (!value_to_find.is_number())
+                return Value(false);
+            if (value_to_find.is_int32())
+                return Value(any_of(elements, [&](auto element) { return element.as_i32() == value_to_find.as_i32(); }));
+        }
+        return Value(any_of(elements, [&](auto element) { return same_value_zero(element, value_to_find); }));
+    }
+
     for (u64 i = from_index; i < length; ++i) {
         auto element = TRY(this_object->get(i));
         if (same_value_zero(element, value_to_find))
@@ -795,6 +844,27 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::index_of)
         k = max(length + n, 0);
     }
 
+    // OPTIMIZATION: Nothing in here can run user code, so a packed array can be searched directly.
+    if (auto const* storage = simple_indexed_property_storage_for_fast_access(object); storage && storage->is_packed() && storage->array_like_size() >= length) {
+        auto const& elements = storage->elements();
+        if (storage->element_kind() == SimpleIndexedPropertyStorage::ElementKind::Int32) {
+            if (!search_element.is_number())
+                return Value(-1);
+            if (search_element.is_int32()) {
+                for (; k < length; ++k) {
+                    if (elements[k].as_i32() == search_element.as_i32())
+                        return Value(k);
+                }
+                return Value(-1);
+            }
+        }
+        for (; k < length; ++k) {
+            if (is_strictly_equal(search_element, elements[k]))
+                return Value(k);
+        }
+        return Value(-1);
+    }
+
     // 10. Repeat, while k < len,
     for (; k < length; ++k) {
         auto property_key = PropertyKey { k };
@@ -958,6 +1028,13 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::map)
         // a. Let Pk be ! ToString(𝔽(k)).
         auto property_key = PropertyKey { k };
 
+        // NOTE: The callback may change the array in any way, so this has to be checked on every iteration.
+        if (auto k_value = fast_get_own_element(object, k); !k_value.is_empty()) {
+            auto mapped_value = TRY(call(vm, callback_function.as_function(), this_arg, k_value, Value(k), object));
+            TRY(array->create_data_property_or_throw(property_key, mapped_value));
+            continue;
+        }
+
         // b. Let kPresent be ? HasProperty(O, Pk).
         auto k_present = TRY(object->has_property(property_key));
 
@@ -1005,6 +1082,11 @@ JS_DEFINE_NATIVE_FUNCTION(ArrayPrototype::push)
     auto new_length = length + argument_count;
     if (new_length > MAX_ARRAY_LIKE_INDEX)
         return vm.throw_completion<TypeError>(ErrorType::ArrayMaxSize);
+    if (can_append_elements_directly(this_object, length)) {
+        for (size_t i = 0; i < argument_count; ++i)
+            this_object->indexed_properties().append(vm.argument(i));
+        return Value(new_length);
+    }
     for (size_t i = 0; i < argument_count; ++i)
         TRY(this_object->set(length + i, vm.argument(i), Object::ShouldThrowExceptions::Yes));
     auto new_length_value = Value(new_length);
@@ -28,6 +28,7 @@
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/PromiseConstructor.h>
 #include <LibJS/Runtime/Value.h>
+#include <LibJS/Script.h>
 
 namespace JS {
 
@@ -1177,6 +1178,13 @@ template void async_block_start(VM&, SafeFunction<Completion()> const& async_bod
 template void async_function_start(VM&, PromiseCapability const&, SafeFunction<Completion()> const& async_function_body);
 
 // 10.2.1.4 OrdinaryCallEvaluateBody ( F, argumentsList ), https://tc39.es/ecma262/#sec-ordinarycallevaluatebody
+static bool may_store_bytecode_on_ast(ScriptOrModule const& script_or_module)
+{
+    if (auto const* script = script_or_module.get_pointer<NonnullGCPtr<Script>>())
+        return !(*script)->parse_node().is_shared_between_realms();
+    return true;
+}
+
 // 15.8.4 Runtime Semantics: EvaluateAsyncFunctionBody, https://tc39.es/ecma262/#sec-runtime-semantics-evaluatefunctionbody
 Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
 {
@@ -1197,7 +1205,8 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
                 continue;
             if (parameter.bytecode_executable.is_null()) {
                 auto executable = TRY(Bytecode::compile(vm, *parameter.default_value, {}, FunctionKind::Normal, ByteString::formatted("default parameter #{} for {}", default_parameter_index++, m_name)));
-                const_cast<FunctionParameter&>(parameter).bytecode_executable = executable;
+                if (may_store_bytecode_on_ast(m_script_or_module))
+                    const_cast<FunctionParameter&>(parameter).bytecode_executable = executable;
                 m_default_parameter_bytecode_executables.append(move(executable));
             } else {
                 m_default_parameter_bytecode_executables.append(*parameter.bytecode_executable);
@@ -1217,9 +1226,13 @@ Completion ECMAScriptFunctionObject::ordinary_call_evaluate_body()
     }
 
     if (!m_bytecode_executable) {
-        if (!m_ecmascript_code->bytecode_executable())
-            const_cast<Statement&>(*m_ecmascript_code).set_bytecode_executable(TRY(Bytecode::compile(vm, *m_ecmascript_code, m_formal_parameters, m_kind, m_name)));
-        m_bytecode_executable = m_ecmascript_code->bytecode_executable();
+        if (m_ecmascript_code->bytecode_executable()) {
+            m_bytecode_executable = m_ecmascript_code->bytecode_executable();
+        } else {
+            m_bytecode_executable = TRY(Bytecode::compile(vm, *m_ecmascript_code, m_formal_parameters, m_kind, m_name));
+            if (may_store_bytecode_on_ast(m_script_or_module))
+                const_cast<Statement&>(*m_ecmascript_code).set_bytecode_executable(m_bytecode_executable);
+        }
     }
 
     if (m_kind == FunctionKind::Async) {
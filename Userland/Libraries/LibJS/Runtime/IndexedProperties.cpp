@@ -18,6 +18,12 @@ SimpleIndexedPropertyStorage::SimpleIndexedPropertyStorage(Vector<Value>&& initi
     , m_array_size(initial_values.size())
     , m_packed_elements(move(initial_values))
 {
+    for (auto value : m_packed_elements) {
+        if (value.is_empty())
+            m_is_packed = false;
+        else
+            update_element_kind(value);
+    }
 }
 
 bool SimpleIndexedPropertyStorage::has_index(u32 index) const
@@ -50,15 +56,22 @@ void SimpleIndexedPropertyStorage::put(u32 index, Value value, PropertyAttribute
     VERIFY(attributes == default_attributes);
 
     if (index >= m_array_size) {
+        if (index > m_array_size)
+            m_is_packed = false;
         m_array_size = index + 1;
         grow_storage_if_needed();
     }
+    if (value.is_empty())
+        m_is_packed = false;
+    else
+        update_element_kind(value);
     m_packed_elements[index] = value;
 }
 
 void SimpleIndexedPropertyStorage::remove(u32 index)
 {
     VERIFY(index < m_array_size);
+    m_is_packed = false;
     m_packed_elements[index] = {};
 }
 
@@ -78,6 +91,8 @@ ValueAndAttributes SimpleIndexedPropertyStorage::take_last()
 
 bool SimpleIndexedPropertyStorage::set_array_like_size(size_t new_size)
 {
+    if (new_size > m_array_size)
+        m_is_packed = false;
     m_array_size = new_size;
     m_packed_elements.resize_and_keep_capacity(new_size);
     return true;
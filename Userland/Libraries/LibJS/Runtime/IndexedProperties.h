@@ -74,13 +74,38 @@ public:
 
     Vector<Value> const& elements() const { return m_packed_elements; }
 
+    // What all elements of the storage have in common, similar to elements kinds in other engines.
+    // Kinds only ever become more general (Int32 -> Double -> Any), and a storage never goes back to
+    // being packed after it got a hole. This keeps the bookkeeping on stores down to a couple of branches.
+    enum class ElementKind : u8 {
+        Int32,
+        Double,
+        Any,
+    };
+    ElementKind element_kind() const { return m_element_kind; }
+
+    // True if there are no holes in [0, array_like_size()).
+    bool is_packed() const { return m_is_packed; }
+
 private:
     friend GenericIndexedPropertyStorage;
 
     void grow_storage_if_needed();
 
+    ALWAYS_INLINE void update_element_kind(Value value)
+    {
+        if (m_element_kind == ElementKind::Any || value.is_int32())
+            return;
+        if (value.is_number())
+            m_element_kind = ElementKind::Double;
+        else
+            m_element_kind = ElementKind::Any;
+    }
+
     size_t m_array_size { 0 };
     Vector<Value> m_packed_elements;
+    ElementKind m_element_kind { ElementKind::Int32 };
+    bool m_is_packed { true };
 };
 
 class GenericIndexedPropertyStorage final : public IndexedPropertyStorage {
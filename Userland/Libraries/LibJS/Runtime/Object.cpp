@@ -893,13 +893,21 @@ ThrowCompletionOr<Value> Object::internal_get(PropertyKey const& property_key, V
             return js_undefined();
 
         // c. Return ? parent.[[Get]](P, Receiver).
-        return parent->internal_get(property_key, receiver);
+        // Non-standard: Pass the request for cacheable metadata along, so that hits in the prototype chain can be cached too.
+        auto value = TRY(parent->internal_get(property_key, receiver, cacheable_metadata));
+        if (cacheable_metadata && may_have_own_properties_outside_of_shape()) {
+            *cacheable_metadata = {};
+        } else if (cacheable_metadata && cacheable_metadata->type == CacheablePropertyMetadata::Type::OwnProperty) {
+            cacheable_metadata->type = CacheablePropertyMetadata::Type::InPrototypeChain;
+            cacheable_metadata->prototype = parent;
+        }
+        return value;
     }
 
     // 3. If IsDataDescriptor(desc) is true, return desc.[[Value]].
     if (descriptor->is_data_descriptor()) {
         // Non-standard: If the caller has requested cacheable metadata and the property is an own property, fill it in.
-        if (cacheable_metadata && descriptor->property_offset.has_value() && shape().is_cacheable()) {
+        if (cacheable_metadata && descriptor->property_offset.has_value() && shape().is_cacheable() && !may_have_own_properties_outside_of_shape()) {
             *cacheable_metadata = CacheablePropertyMetadata {
                 .type = CacheablePropertyMetadata::Type::OwnProperty,
                 .property_offset = descriptor->property_offset.value(),
@@ -1220,6 +1228,8 @@ void Object::storage_delete(PropertyKey const& property_key)
     auto metadata = shape().lookup(property_key.to_string_or_symbol());
     VERIFY(metadata.has_value());
 
+    m_shape->invalidate_prototype_chain();
+
     if (m_shape->is_cacheable_dictionary()) {
         m_shape = m_shape->create_uncacheable_dictionary_transition();
     }
@@ -1236,9 +1246,36 @@ void Object::set_prototype(Object* new_prototype)
 {
     if (prototype() == new_prototype)
         return;
+    m_shape->invalidate_prototype_chain();
     m_shape = shape().create_prototype_transition(new_prototype);
 }
 
+NonnullGCPtr<PrototypeChainValidity> Object::ensure_prototype_chain_validity()
+{
+    // NOTE: Prototype shapes are unique to their object, so changes to this object won't go unnoticed
+    //       by being hidden behind a transition that other objects share.
+    if (!m_shape->is_prototype_shape())
+        m_shape = m_shape->create_prototype_shape();
+
+    if (auto validity = m_shape->prototype_chain_validity(); validity && validity->is_valid())
+        return *validity;
+
+    auto validity = heap().allocate_without_realm<PrototypeChainValidity>();
+    if (auto* prototype = this->prototype())
+        prototype->ensure_prototype_chain_validity()->add_dependent(*validity);
+    m_shape->set_prototype_chain_validity(validity);
+    return validity;
+}
+
+void Object::record_uncached_lookup()
+{
+    VERIFY(m_shape->is_uncacheable_dictionary());
+    if (!m_shape->record_uncached_lookup())
+        return;
+    m_shape->invalidate_prototype_chain();
+    m_shape = m_shape->create_cacheable_dictionary_transition();
+}
+
 void Object::define_native_accessor(Realm& realm, PropertyKey const& property_key, Function<ThrowCompletionOr<Value>(VM&)> getter, Function<ThrowCompletionOr<Value>(VM&)> setter, PropertyAttributes attribute)
 {
     FunctionObject* getter_function = nullptr;
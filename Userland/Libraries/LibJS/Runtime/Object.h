@@ -46,9 +46,11 @@ struct CacheablePropertyMetadata {
     enum class Type {
         NotCacheable,
         OwnProperty,
+        InPrototypeChain,
     };
     Type type { Type::NotCacheable };
     Optional<u32> property_offset;
+    GCPtr<Object const> prototype {};
 };
 
 class Object : public Cell {
@@ -149,6 +151,11 @@ public:
     //       might not hold when property access behaves differently.
     bool may_interfere_with_indexed_property_access() const { return m_may_interfere_with_indexed_property_access; }
 
+    // NOTE: Any subclass of Object whose [[GetOwnProperty]] can find properties that aren't stored in its shape,
+    //       and that shadow the properties in its shape or prototype chain, must return true for this. Such a
+    //       property can appear without the shape changing, so property lookups on this object can't be cached.
+    virtual bool may_have_own_properties_outside_of_shape() const { return false; }
+
     ThrowCompletionOr<bool> ordinary_set_with_own_descriptor(PropertyKey const&, Value, Value, Optional<PropertyDescriptor>, CacheablePropertyMetadata* = nullptr);
 
     // 10.4.7 Immutable Prototype Exotic Objects, https://tc39.es/ecma262/#sec-immutable-prototype-exotic-objects
@@ -216,6 +223,14 @@ public:
 
     void set_prototype(Object*);
 
+    // Returns the validity cell for the prototype chain starting at this object. This gives the object
+    // a prototype shape if it doesn't have one yet, so that later changes to it can be detected.
+    NonnullGCPtr<PrototypeChainValidity> ensure_prototype_chain_validity();
+
+    // Called by inline caches that can't cache lookups on this object, because it has an uncacheable dictionary shape.
+    // If that keeps happening without properties being deleted, the object gets a cacheable shape again.
+    void record_uncached_lookup();
+
     [[nodiscard]] bool has_magical_length_property() const { return m_has_magical_length_property; }
 
     [[nodiscard]] bool is_typed_array() const { return m_is_typed_array; }
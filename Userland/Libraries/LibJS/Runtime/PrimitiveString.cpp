@@ -26,6 +26,12 @@ PrimitiveString::PrimitiveString(PrimitiveString& lhs, PrimitiveString& rhs)
     , m_lhs(&lhs)
     , m_rhs(&rhs)
 {
+    if (auto lhs_is_ascii = lhs.is_ascii_if_known(), rhs_is_ascii = rhs.is_ascii_if_known(); lhs_is_ascii.has_value() && rhs_is_ascii.has_value())
+        m_is_ascii = *lhs_is_ascii && *rhs_is_ascii;
+
+    // NOTE: Joining surrogate halves in UTF-8 doesn't change the UTF-16 length, so we can simply add them up.
+    if (auto lhs_length = lhs.length_in_utf16_code_units_if_known(), rhs_length = rhs.length_in_utf16_code_units_if_known(); lhs_length.has_value() && rhs_length.has_value())
+        m_length_in_utf16_code_units = *lhs_length + *rhs_length;
 }
 
 PrimitiveString::PrimitiveString(String string)
@@ -136,19 +142,75 @@ Utf16View PrimitiveString::utf16_string_view() const
     return m_utf16_string->view();
 }
 
+Optional<bool> PrimitiveString::is_ascii_if_known() const
+{
+    if (m_is_ascii.has_value() || m_is_rope)
+        return m_is_ascii;
+
+    // NOTE: This is linear in the length of the string, but only ever happens once per string.
+    if (has_utf8_string())
+        m_is_ascii = all_of(m_utf8_string->bytes(), [](auto byte) { return AK::is_ascii(byte); });
+    else if (has_byte_string())
+        m_is_ascii = all_of(m_byte_string->bytes(), [](auto byte) { return AK::is_ascii(byte); });
+    else if (has_utf16_string())
+        m_is_ascii = all_of(m_utf16_string->string(), [](auto code_unit) { return AK::is_ascii(code_unit); });
+    else
+        VERIFY_NOT_REACHED();
+    return m_is_ascii;
+}
+
+bool PrimitiveString::is_ascii() const
+{
+    if (m_is_ascii.has_value())
+        return *m_is_ascii;
+
+    resolve_rope_if_needed(EncodingPreference::UTF8);
+    return is_ascii_if_known().value();
+}
+
+Optional<size_t> PrimitiveString::length_in_utf16_code_units_if_known() const
+{
+    if (m_length_in_utf16_code_units.has_value() || m_is_rope)
+        return m_length_in_utf16_code_units;
+
+    if (has_utf16_string())
+        m_length_in_utf16_code_units = m_utf16_string->length_in_code_units();
+    else if (is_ascii_if_known().value())
+        m_length_in_utf16_code_units = has_utf8_string() ? m_utf8_string->bytes().size() : m_byte_string->length();
+    return m_length_in_utf16_code_units;
+}
+
+size_t PrimitiveString::length_in_utf16_code_units() const
+{
+    if (auto length = length_in_utf16_code_units_if_known(); length.has_value())
+        return *length;
+
+    m_length_in_utf16_code_units = utf16_string().length_in_code_units();
+    return *m_length_in_utf16_code_units;
+}
+
 ThrowCompletionOr<Optional<Value>> PrimitiveString::get(VM& vm, PropertyKey const& property_key) const
 {
     if (property_key.is_symbol())
         return Optional<Value> {};
     if (property_key.is_string()) {
         if (property_key.as_string() == vm.names.length.as_string()) {
-            auto length = utf16_string().length_in_code_units();
+            auto length = length_in_utf16_code_units();
             return Value(static_cast<double>(length));
         }
     }
     auto index = canonical_numeric_index_string(property_key, CanonicalIndexMode::IgnoreNumericRoundtrip);
     if (!index.is_index())
         return Optional<Value> {};
+
+    // OPTIMIZATION: Each byte of an ASCII string is a code unit, so there's no need to convert it to UTF-16.
+    if (is_ascii() && !has_utf16_string()) {
+        auto bytes = has_utf8_string() ? m_utf8_string->bytes_as_string_view() : m_byte_string->view();
+        if (bytes.length() <= index.as_index())
+            return Optional<Value> {};
+        return Value(&vm.single_ascii_character_string(static_cast<u8>(bytes[index.as_index()])));
+    }
+
     auto str = utf16_string_view();
     auto length = str.length_in_code_units();
     if (length <= index.as_index())
@@ -163,7 +225,7 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, Utf16String string
 
     if (string.length_in_code_units() == 1) {
         u16 code_unit = string.code_unit_at(0);
-        if (is_ascii(code_unit))
+        if (AK::is_ascii(code_unit))
             return vm.single_ascii_character_string(static_cast<u8>(code_unit));
     }
 
@@ -177,7 +239,7 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, String string)
 
     if (auto bytes = string.bytes_as_string_view(); bytes.length() == 1) {
         auto ch = static_cast<u8>(bytes[0]);
-        if (is_ascii(ch))
+        if (AK::is_ascii(ch))
             return vm.single_ascii_character_string(ch);
     }
 
@@ -207,7 +269,7 @@ NonnullGCPtr<PrimitiveString> PrimitiveString::create(VM& vm, ByteString string)
 
     if (string.length() == 1) {
         auto ch = static_cast<u8>(string.characters()[0]);
-        if (is_ascii(ch))
+        if (AK::is_ascii(ch))
             return vm.single_ascii_character_string(ch);
     }
 
@@ -270,23 +332,75 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
         pieces.append(current);
     }
 
+    auto finish_resolving = [&] {
+        m_is_rope = false;
+        m_lhs = nullptr;
+        m_rhs = nullptr;
+    };
+
+    // OPTIMIZATION: If all pieces are ASCII, we can copy them into a buffer of the final size without any conversions,
+    //               and don't have to worry about surrogate pairs being spread across pieces.
+    if (all_of(pieces, [](auto const* piece) { return piece->is_ascii_if_known() == true; })) {
+        size_t length = 0;
+        for (auto const* current : pieces)
+            length += current->length_in_utf16_code_units_if_known().value();
+
+        if (preference == EncodingPreference::UTF16) {
+            Utf16Data code_units;
+            code_units.ensure_capacity(length);
+            for (auto const* current : pieces) {
+                if (current->has_utf16_string()) {
+                    code_units.extend(current->m_utf16_string->string());
+                    continue;
+                }
+                auto bytes = current->has_utf8_string() ? current->m_utf8_string->bytes_as_string_view() : current->m_byte_string->view();
+                for (auto byte : bytes)
+                    code_units.unchecked_append(static_cast<u8>(byte));
+            }
+            m_utf16_string = Utf16String::create(move(code_units));
+        } else {
+            StringBuilder builder(length);
+            for (auto const* current : pieces) {
+                if (current->has_utf8_string()) {
+                    builder.append(current->m_utf8_string->bytes_as_string_view());
+                } else if (current->has_byte_string()) {
+                    builder.append(current->m_byte_string->view());
+                } else {
+                    for (auto code_unit : current->m_utf16_string->string())
+                        builder.append(static_cast<char>(code_unit));
+                }
+            }
+            m_utf8_string = builder.to_string_without_validation();
+        }
+
+        m_is_ascii = true;
+        m_length_in_utf16_code_units = length;
+        finish_resolving();
+        return;
+    }
+
     if (preference == EncodingPreference::UTF16) {
         // The caller wants a UTF-16 string, so we can simply concatenate all the pieces
         // into a UTF-16 code unit buffer and create a Utf16String from it.
 
         Utf16Data code_units;
+        if (m_length_in_utf16_code_units.has_value())
+            code_units.ensure_capacity(*m_length_in_utf16_code_units);
         for (auto const* current : pieces)
             code_units.extend(current->utf16_string().string());
 
         m_utf16_string = Utf16String::create(move(code_units));
-        m_is_rope = false;
-        m_lhs = nullptr;
-        m_rhs = nullptr;
+        finish_resolving();
         return;
     }
 
     // Now that we have all the pieces, we can concatenate them using a StringBuilder.
-    StringBuilder builder;
+    // NOTE: The UTF-8 length of the result is at most the sum of the lengths of the pieces, since joining
+    //       surrogate halves only ever makes it shorter.
+    size_t utf8_length = 0;
+    for (auto const* current : pieces)
+        utf8_length += current->utf8_string_view().length();
+    StringBuilder builder(utf8_length);
 
     // We keep track of the previous piece in order to handle surrogate pairs spread across two pieces.
     PrimitiveString const* previous = nullptr;
@@ -348,9 +462,7 @@ void PrimitiveString::resolve_rope_if_needed(EncodingPreference preference) cons
 
     // NOTE: We've already produced valid UTF-8 above, so there's no need for additional validation.
     m_utf8_string = builder.to_string_without_validation();
-    m_is_rope = false;
-    m_lhs = nullptr;
-    m_rhs = nullptr;
+    finish_resolving();
 }
 
 }
@@ -51,6 +51,12 @@ public:
     [[nodiscard]] Utf16View utf16_string_view() const;
     bool has_utf16_string() const { return m_utf16_string.has_value(); }
 
+    // True if the string only consists of ASCII characters. In that case, its UTF-8 encoding has one byte per UTF-16
+    // code unit, and a lot of things (e.g. length and indexed access) can be answered without converting to UTF-16.
+    [[nodiscard]] bool is_ascii() const;
+
+    [[nodiscard]] size_t length_in_utf16_code_units() const;
+
     ThrowCompletionOr<Optional<Value>> get(VM&, PropertyKey const&) const;
 
 private:
@@ -67,8 +73,17 @@ private:
     };
     void resolve_rope_if_needed(EncodingPreference) const;
 
+    // NOTE: Unlike is_ascii(), these never resolve a rope, and are only computed for flat strings if that's cheap.
+    Optional<bool> is_ascii_if_known() const;
+    Optional<size_t> length_in_utf16_code_units_if_known() const;
+
     mutable bool m_is_rope { false };
 
+    // Both of these are carried over when creating a rope from strings that know them, so e.g. the length of a
+    // string built by repeated concatenation can be queried without flattening it.
+    mutable Optional<bool> m_is_ascii;
+    mutable Optional<size_t> m_length_in_utf16_code_units;
+
     mutable GCPtr<PrimitiveString> m_lhs;
     mutable GCPtr<PrimitiveString> m_rhs;
 
@@ -5,12 +5,78 @@
  */
 
 #include <LibJS/Heap/DeferGC.h>
+#include <LibJS/Heap/Heap.h>
+#include <LibJS/Heap/HeapBlock.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
 
 namespace JS {
 
 JS_DEFINE_ALLOCATOR(Shape);
+JS_DEFINE_ALLOCATOR(PrototypeChainValidity);
+
+void PrototypeChainValidity::invalidate()
+{
+    if (!m_valid)
+        return;
+    m_valid = false;
+    auto dependents = move(m_dependents);
+    for (auto& dependent : dependents) {
+        if (dependent)
+            dependent->invalidate();
+    }
+}
+
+void PrototypeChainValidity::add_dependent(PrototypeChainValidity& dependent)
+{
+    VERIFY(m_valid);
+    // Prune dependents that have been invalidated or collected in the meantime, so this doesn't grow without bound.
+    m_dependents.remove_all_matching([](auto& it) { return !it || !it->is_valid(); });
+    m_dependents.append(dependent);
+}
+
+NonnullRefPtr<PropertyTable> PropertyTable::copy_first(u32 count) const
+{
+    auto table = create();
+    table->m_properties.ensure_capacity(count);
+    for (auto const& it : m_properties) {
+        if (table->m_properties.size() == count)
+            break;
+        table->m_properties.set(it.key, it.value);
+    }
+    return table;
+}
+
+size_t PropertyTable::approximate_size_in_bytes() const
+{
+    // NOTE: Every bucket of an ordered hash table has a previous and next pointer and a state next to the entry.
+    static constexpr size_t bucket_size = sizeof(StringOrSymbol) + sizeof(PropertyMetadata) + 2 * sizeof(void*) + sizeof(u8);
+    return sizeof(PropertyTable) + m_properties.capacity() * bucket_size;
+}
+
+Vector<StringOrSymbol> PropertyTableView::keys() const
+{
+    Vector<StringOrSymbol> keys;
+    keys.ensure_capacity(m_count);
+    for (auto const& it : *this)
+        keys.unchecked_append(it.key);
+    return keys;
+}
+
+NonnullGCPtr<Shape> Shape::create_prototype_shape()
+{
+    auto new_shape = create_cacheable_dictionary_transition();
+    new_shape->m_prototype_shape = true;
+    return new_shape;
+}
+
+void Shape::invalidate_prototype_chain()
+{
+    if (!m_prototype_chain_validity)
+        return;
+    m_prototype_chain_validity->invalidate();
+    m_prototype_chain_validity = nullptr;
+}
 
 NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
 {
@@ -19,9 +85,9 @@ NonnullGCPtr<Shape> Shape::create_cacheable_dictionary_transition()
     new_shape->m_cacheable = true;
     new_shape->m_prototype = m_prototype;
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    // NOTE: Dictionaries change their table in place, so they always get one of their own.
+    new_shape->m_property_table = m_property_table->copy_first(m_property_count);
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
@@ -29,15 +95,25 @@ NonnullGCPtr<Shape> Shape::create_uncacheable_dictionary_transition()
 {
     auto new_shape = heap().allocate_without_realm<Shape>(m_realm);
     new_shape->m_dictionary = true;
-    new_shape->m_cacheable = true;
+    new_shape->m_cacheable = false;
     new_shape->m_prototype = m_prototype;
     ensure_property_table();
-    new_shape->ensure_property_table();
-    (*new_shape->m_property_table) = *m_property_table;
-    new_shape->m_property_count = new_shape->m_property_table->size();
+    // NOTE: Dictionaries change their table in place, so they always get one of their own.
+    new_shape->m_property_table = m_property_table->copy_first(m_property_count);
+    new_shape->m_property_count = m_property_count;
     return new_shape;
 }
 
+// Transitions are only pruned when looked up again, so a shape with lots of transitions that died would keep
+// their entries around. Sweep the whole map whenever it doubled in size, which keeps this amortized constant.
+template<typename Map>
+static void prune_stale_transitions_if_needed(Map& transitions)
+{
+    if (transitions.size() < 8 || !is_power_of_two(transitions.size()))
+        return;
+    transitions.remove_all_matching([](auto&, auto& shape) { return !shape; });
+}
+
 Shape* Shape::get_or_prune_cached_forward_transition(TransitionKey const& key)
 {
     if (!m_forward_transitions)
@@ -91,6 +167,7 @@ Shape* Shape::create_put_transition(StringOrSymbol const& property_key, Property
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, attributes, TransitionType::Put);
     if (!m_forward_transitions)
         m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
+    prune_stale_transitions_if_needed(*m_forward_transitions);
     m_forward_transitions->set(key, new_shape.ptr());
     return new_shape;
 }
@@ -103,6 +180,7 @@ Shape* Shape::create_configure_transition(StringOrSymbol const& property_key, Pr
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, attributes, TransitionType::Configure);
     if (!m_forward_transitions)
         m_forward_transitions = make<HashMap<TransitionKey, WeakPtr<Shape>>>();
+    prune_stale_transitions_if_needed(*m_forward_transitions);
     m_forward_transitions->set(key, new_shape.ptr());
     return new_shape;
 }
@@ -114,6 +192,7 @@ Shape* Shape::create_prototype_transition(Object* new_prototype)
     auto new_shape = heap().allocate_without_realm<Shape>(*this, new_prototype);
     if (!m_prototype_transitions)
         m_prototype_transitions = make<HashMap<GCPtr<Object>, WeakPtr<Shape>>>();
+    prune_stale_transitions_if_needed(*m_prototype_transitions);
     m_prototype_transitions->set(new_prototype, new_shape.ptr());
     return new_shape;
 }
@@ -160,6 +239,7 @@ void Shape::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_realm);
     visitor.visit(m_prototype);
     visitor.visit(m_previous);
+    visitor.visit(m_prototype_chain_validity);
     m_property_key.visit_edges(visitor);
 
     // NOTE: We don't need to mark the keys in the property table, since they are guaranteed
@@ -184,59 +264,84 @@ Optional<PropertyMetadata> Shape::lookup(StringOrSymbol const& property_key) con
 {
     if (m_property_count == 0)
         return {};
-    auto property = property_table().get(property_key);
-    if (!property.has_value())
+    ensure_property_table();
+    auto property = m_property_table->properties().get(property_key);
+    // NOTE: A shared table may contain properties added by later shapes of the transition chain.
+    if (!property.has_value() || property->offset >= m_property_count)
         return {};
     return property;
 }
 
-FLATTEN OrderedHashMap<StringOrSymbol, PropertyMetadata> const& Shape::property_table() const
+FLATTEN PropertyTableView Shape::property_table() const
 {
     ensure_property_table();
-    return *m_property_table;
+    return { *m_property_table, m_property_count };
 }
 
 void Shape::ensure_property_table() const
 {
     if (m_property_table)
         return;
-    m_property_table = make<OrderedHashMap<StringOrSymbol, PropertyMetadata>>();
-
-    u32 next_offset = 0;
 
     Vector<Shape const&, 64> transition_chain;
     transition_chain.append(*this);
-    for (auto shape = m_previous; shape; shape = shape->m_previous) {
-        if (shape->m_property_table) {
-            *m_property_table = *shape->m_property_table;
-            next_offset = shape->m_property_count;
-            break;
-        }
+    for (auto shape = m_previous; shape && !shape->m_property_table; shape = shape->m_previous)
         transition_chain.append(*shape);
-    }
 
+    // Materialize the tables from the oldest shape in the chain to this one, so that put and prototype transitions
+    // can share the table of their previous shape.
     for (auto const& shape : transition_chain.in_reverse()) {
-        if (!shape.m_property_key.is_valid()) {
-            // Ignore prototype transitions as they don't affect the key map.
+        if (!shape.m_previous) {
+            shape.m_property_table = PropertyTable::create();
             continue;
         }
+
+        auto& previous_table = *shape.m_previous->m_property_table;
+        auto previous_count = shape.m_previous->m_property_count;
+
+        if (shape.m_transition_type == TransitionType::Prototype) {
+            // Prototype transitions don't change the properties at all.
+            shape.m_property_table = previous_table;
+            continue;
+        }
+
         if (shape.m_transition_type == TransitionType::Put) {
-            m_property_table->set(shape.m_property_key, { next_offset++, shape.m_attributes });
-        } else if (shape.m_transition_type == TransitionType::Configure) {
-            auto it = m_property_table->find(shape.m_property_key);
-            VERIFY(it != m_property_table->end());
+            auto& properties = previous_table.properties();
+            if (properties.size() == previous_count) {
+                properties.set(shape.m_property_key, { previous_count, shape.m_attributes });
+                shape.m_property_table = previous_table;
+                continue;
+            }
+            // If another shape with the same transition extended the table before (e.g. because this shape was
+            // garbage collected and is now being recreated), we can share its entry.
+            if (auto existing = properties.get(shape.m_property_key); existing.has_value() && existing->offset == previous_count && existing->attributes == shape.m_attributes) {
+                shape.m_property_table = previous_table;
+                continue;
+            }
+            shape.m_property_table = previous_table.copy_first(previous_count);
+            shape.m_property_table->properties().set(shape.m_property_key, { previous_count, shape.m_attributes });
+            continue;
+        }
+
+        auto table = previous_table.copy_first(previous_count);
+        auto& properties = table->properties();
+        if (shape.m_transition_type == TransitionType::Configure) {
+            auto it = properties.find(shape.m_property_key);
+            VERIFY(it != properties.end());
             it->value.attributes = shape.m_attributes;
         } else if (shape.m_transition_type == TransitionType::Delete) {
-            auto remove_it = m_property_table->find(shape.m_property_key);
-            VERIFY(remove_it != m_property_table->end());
+            auto remove_it = properties.find(shape.m_property_key);
+            VERIFY(remove_it != properties.end());
             auto removed_offset = remove_it->value.offset;
-            m_property_table->remove(remove_it);
-            for (auto& it : *m_property_table) {
+            properties.remove(remove_it);
+            for (auto& it : properties) {
                 if (it.value.offset > removed_offset)
                     --it.value.offset;
             }
-            --next_offset;
+        } else {
+            VERIFY_NOT_REACHED();
         }
+        shape.m_property_table = move(table);
     }
 }
 
@@ -247,6 +352,7 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
     auto new_shape = heap().allocate_without_realm<Shape>(*this, property_key, TransitionType::Delete);
     if (!m_delete_transitions)
         m_delete_transitions = make<HashMap<StringOrSymbol, WeakPtr<Shape>>>();
+    prune_stale_transitions_if_needed(*m_delete_transitions);
     m_delete_transitions->set(property_key, new_shape.ptr());
     return new_shape;
 }
@@ -254,8 +360,12 @@ NonnullGCPtr<Shape> Shape::create_delete_transition(StringOrSymbol const& proper
 void Shape::add_property_without_transition(StringOrSymbol const& property_key, PropertyAttributes attributes)
 {
     VERIFY(property_key.is_valid());
+    invalidate_prototype_chain();
     ensure_property_table();
-    if (m_property_table->set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
+    // NOTE: Non-dictionary shapes only get properties added like this while they're being set up, before any
+    //       other shape could share their table.
+    VERIFY(m_property_table->properties().size() == m_property_count);
+    if (m_property_table->properties().set(property_key, { m_property_count, attributes }) == AK::HashSetResult::InsertedNewEntry) {
         VERIFY(m_property_count < NumericLimits<u32>::max());
         ++m_property_count;
     }
@@ -271,23 +381,66 @@ void Shape::set_property_attributes_without_transition(StringOrSymbol const& pro
 {
     VERIFY(is_dictionary());
     VERIFY(m_property_table);
-    auto it = m_property_table->find(property_key);
-    VERIFY(it != m_property_table->end());
+    auto it = m_property_table->properties().find(property_key);
+    VERIFY(it != m_property_table->properties().end());
+    invalidate_prototype_chain();
     it->value.attributes = attributes;
-    m_property_table->set(property_key, it->value);
 }
 
 void Shape::remove_property_without_transition(StringOrSymbol const& property_key, u32 offset)
 {
     VERIFY(is_uncacheable_dictionary());
     VERIFY(m_property_table);
-    if (m_property_table->remove(property_key))
+    invalidate_prototype_chain();
+    m_uncached_lookups = 0;
+    if (m_property_table->properties().remove(property_key))
         --m_property_count;
-    for (auto& it : *m_property_table) {
+    for (auto& it : m_property_table->properties()) {
         VERIFY(it.value.offset != offset);
         if (it.value.offset > offset)
             --it.value.offset;
     }
 }
 
+bool Shape::record_uncached_lookup()
+{
+    static constexpr u8 lookups_before_becoming_cacheable = 8;
+    VERIFY(is_uncacheable_dictionary());
+    return ++m_uncached_lookups == lookups_before_becoming_cacheable;
+}
+
+HashMap<Realm const*, Shape::MemoryStatistics> Shape::gather_memory_statistics(Heap& heap)
+{
+    HashMap<Realm const*, MemoryStatistics> statistics;
+    HashTable<PropertyTable const*> seen_property_tables;
+
+    auto transition_table_size = []<typename K, typename V>(OwnPtr<HashMap<K, V>> const& transitions) -> size_t {
+        if (!transitions)
+            return 0;
+        return transitions->capacity() * (sizeof(K) + sizeof(V) + sizeof(u8));
+    };
+
+    heap.for_each_live_cell([&](Cell* cell) {
+        if (!is<Shape>(*cell))
+            return;
+        auto const& shape = static_cast<Shape const&>(*cell);
+        auto& realm_statistics = statistics.ensure(&shape.realm());
+
+        ++realm_statistics.shape_count;
+        if (shape.is_dictionary())
+            ++realm_statistics.dictionary_shape_count;
+        realm_statistics.shape_bytes += sizeof(Shape);
+        realm_statistics.transition_table_bytes += transition_table_size(shape.m_forward_transitions);
+        realm_statistics.transition_table_bytes += transition_table_size(shape.m_prototype_transitions);
+        realm_statistics.transition_table_bytes += transition_table_size(shape.m_delete_transitions);
+
+        if (shape.m_property_table && seen_property_tables.set(shape.m_property_table.ptr()) == AK::HashSetResult::InsertedNewEntry) {
+            ++realm_statistics.property_table_count;
+            realm_statistics.property_table_bytes += shape.m_property_table->approximate_size_in_bytes();
+        }
+    });
+
+    return statistics;
+}
+
 }
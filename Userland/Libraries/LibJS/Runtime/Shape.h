@@ -8,7 +8,10 @@
 
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/StringView.h>
+#include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <AK/Weakable.h>
 #include <LibJS/Forward.h>
@@ -24,6 +27,73 @@ struct PropertyMetadata {
     PropertyAttributes attributes { 0 };
 };
 
+// Property tables are shared along chains of put (and prototype) transitions: the first shape of a chain that needs
+// a table appends its property to the table of the previous shape and adopts it, as long as no other shape has done
+// so before. Since properties are always appended in offset order, the first property_count() entries of a (possibly
+// shared) table are exactly the properties of a shape, and the entry at position N has offset N.
+class PropertyTable : public RefCounted<PropertyTable> {
+public:
+    using Map = OrderedHashMap<StringOrSymbol, PropertyMetadata>;
+
+    static NonnullRefPtr<PropertyTable> create() { return adopt_ref(*new PropertyTable); }
+    NonnullRefPtr<PropertyTable> copy_first(u32 count) const;
+
+    Map& properties() { return m_properties; }
+    Map const& properties() const { return m_properties; }
+
+    size_t approximate_size_in_bytes() const;
+
+private:
+    PropertyTable() = default;
+
+    Map m_properties;
+};
+
+// The properties of one shape, i.e. the first N entries of its property table.
+class PropertyTableView {
+public:
+    class Iterator {
+    public:
+        Iterator(PropertyTable::Map::ConstIteratorType it, size_t remaining)
+            : m_it(move(it))
+            , m_remaining(remaining)
+        {
+        }
+
+        auto const& operator*() const { return *m_it; }
+        auto const* operator->() const { return &*m_it; }
+
+        Iterator& operator++()
+        {
+            ++m_it;
+            --m_remaining;
+            return *this;
+        }
+
+        bool operator==(Iterator const& other) const { return m_remaining == other.m_remaining; }
+
+    private:
+        mutable PropertyTable::Map::ConstIteratorType m_it;
+        size_t m_remaining { 0 };
+    };
+
+    PropertyTableView(PropertyTable const& table, size_t count)
+        : m_table(table)
+        , m_count(count)
+    {
+    }
+
+    Iterator begin() const { return { m_table.properties().begin(), m_count }; }
+    Iterator end() const { return { m_table.properties().end(), 0 }; }
+
+    size_t size() const { return m_count; }
+    Vector<StringOrSymbol> keys() const;
+
+private:
+    PropertyTable const& m_table;
+    size_t m_count { 0 };
+};
+
 struct TransitionKey {
     StringOrSymbol property_key;
     PropertyAttributes attributes { 0 };
@@ -34,6 +104,31 @@ struct TransitionKey {
     }
 };
 
+// A validity cell for the prototype chain starting at some prototype object. It is invalidated as soon as the
+// shape of that object, or of any object further up its prototype chain, changes in a way that could affect
+// property lookups. Inline caches that found a property in the prototype chain hold on to one of these.
+class PrototypeChainValidity final
+    : public Cell
+    , public Weakable<PrototypeChainValidity> {
+    JS_CELL(PrototypeChainValidity, Cell);
+    JS_DECLARE_ALLOCATOR(PrototypeChainValidity);
+
+public:
+    virtual ~PrototypeChainValidity() override = default;
+
+    [[nodiscard]] bool is_valid() const { return m_valid; }
+
+    void invalidate();
+    void add_dependent(PrototypeChainValidity&);
+
+private:
+    PrototypeChainValidity() = default;
+
+    // Validity cells of the objects that have this cell's object as their prototype.
+    Vector<WeakPtr<PrototypeChainValidity>> m_dependents;
+    bool m_valid { true };
+};
+
 class Shape final
     : public Cell
     , public Weakable<Shape> {
@@ -59,6 +154,7 @@ public:
     [[nodiscard]] NonnullGCPtr<Shape> create_delete_transition(StringOrSymbol const&);
     [[nodiscard]] NonnullGCPtr<Shape> create_cacheable_dictionary_transition();
     [[nodiscard]] NonnullGCPtr<Shape> create_uncacheable_dictionary_transition();
+    [[nodiscard]] NonnullGCPtr<Shape> create_prototype_shape();
 
     void add_property_without_transition(StringOrSymbol const&, PropertyAttributes);
     void add_property_without_transition(PropertyKey const&, PropertyAttributes);
@@ -71,21 +167,48 @@ public:
     [[nodiscard]] bool is_cacheable_dictionary() const { return m_dictionary && m_cacheable; }
     [[nodiscard]] bool is_uncacheable_dictionary() const { return m_dictionary && !m_cacheable; }
 
+    // Objects that are used as prototypes by inline caches get a unique (dictionary) shape of their own,
+    // which carries the validity cell for their prototype chain.
+    [[nodiscard]] bool is_prototype_shape() const { return m_prototype_shape; }
+    GCPtr<PrototypeChainValidity> prototype_chain_validity() const { return m_prototype_chain_validity; }
+    void set_prototype_chain_validity(GCPtr<PrototypeChainValidity> validity) { m_prototype_chain_validity = validity; }
+    void invalidate_prototype_chain();
+
     Realm& realm() const { return m_realm; }
 
     Object* prototype() { return m_prototype; }
     Object const* prototype() const { return m_prototype; }
 
     Optional<PropertyMetadata> lookup(StringOrSymbol const&) const;
-    OrderedHashMap<StringOrSymbol, PropertyMetadata> const& property_table() const;
+    PropertyTableView property_table() const;
     u32 property_count() const { return m_property_count; }
 
+    // Uncacheable dictionaries are changed in place when properties are deleted from them. Returns true once
+    // such a shape has been looked up often enough without deletions that it's worth making cacheable again.
+    bool record_uncached_lookup();
+
+    struct MemoryStatistics {
+        size_t shape_count { 0 };
+        size_t dictionary_shape_count { 0 };
+        size_t shape_bytes { 0 };
+        size_t property_table_count { 0 };
+        size_t property_table_bytes { 0 };
+        size_t transition_table_bytes { 0 };
+    };
+    // Breaks down the memory used by the shapes on the heap by the realm they belong to. Shared property tables
+    // are only counted once, for the realm of the first shape using them that we come across.
+    static HashMap<Realm const*, MemoryStatistics> gather_memory_statistics(Heap&);
+
     struct Property {
         StringOrSymbol key;
         PropertyMetadata value;
     };
 
-    void set_prototype_without_transition(Object* new_prototype) { m_prototype = new_prototype; }
+    void set_prototype_without_transition(Object* new_prototype)
+    {
+        invalidate_prototype_chain();
+        m_prototype = new_prototype;
+    }
 
 private:
     explicit Shape(Realm&);
@@ -103,7 +226,7 @@ private:
 
     NonnullGCPtr<Realm> m_realm;
 
-    mutable OwnPtr<OrderedHashMap<StringOrSymbol, PropertyMetadata>> m_property_table;
+    mutable RefPtr<PropertyTable> m_property_table;
 
     OwnPtr<HashMap<TransitionKey, WeakPtr<Shape>>> m_forward_transitions;
     OwnPtr<HashMap<GCPtr<Object>, WeakPtr<Shape>>> m_prototype_transitions;
@@ -111,6 +234,7 @@ private:
     GCPtr<Shape> m_previous;
     StringOrSymbol m_property_key;
     GCPtr<Object> m_prototype;
+    GCPtr<PrototypeChainValidity> m_prototype_chain_validity;
     u32 m_property_count { 0 };
 
     PropertyAttributes m_attributes { 0 };
@@ -118,6 +242,8 @@ private:
 
     bool m_dictionary { false };
     bool m_cacheable { true };
+    bool m_prototype_shape { false };
+    u8 m_uncached_lookups { 0 };
 };
 
 }
@@ -48,6 +48,18 @@ static ThrowCompletionOr<Utf16String> utf16_string_from(VM& vm)
     return TRY(this_value.to_utf16_string(vm));
 }
 
+// OPTIMIZATION: If the this value is an ASCII string, its UTF-8 bytes can be indexed just like its UTF-16 code units.
+static Optional<StringView> ascii_string_view_from_this_value(VM& vm)
+{
+    auto this_value = vm.this_value();
+    if (!this_value.is_string())
+        return {};
+    auto const& string = this_value.as_string();
+    if (string.has_utf16_string() || !string.is_ascii())
+        return {};
+    return string.utf8_string_view();
+}
+
 // 22.1.3.21.1 SplitMatch ( S, q, R ), https://tc39.es/ecma262/#sec-splitmatch
 // FIXME: This no longer exists in the spec!
 static Optional<size_t> split_match(Utf16View const& haystack, size_t start, Utf16View const& needle)
@@ -283,6 +295,13 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::at)
 // 22.1.3.2 String.prototype.charAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charat
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
 {
+    if (auto ascii_string = ascii_string_view_from_this_value(vm); ascii_string.has_value()) {
+        auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
+        if (position < 0 || position >= ascii_string->length())
+            return PrimitiveString::create(vm, String {});
+        return PrimitiveString::create(vm, ascii_string->substring_view(position, 1));
+    }
+
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
     auto string = TRY(utf16_string_from(vm));
@@ -302,6 +321,13 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_at)
 // 22.1.3.3 String.prototype.charCodeAt ( pos ), https://tc39.es/ecma262/#sec-string.prototype.charcodeat
 JS_DEFINE_NATIVE_FUNCTION(StringPrototype::char_code_at)
 {
+    if (auto ascii_string = ascii_string_view_from_this_value(vm); ascii_string.has_value()) {
+        auto position = TRY(vm.argument(0).to_integer_or_infinity(vm));
+        if (position < 0 || position >= ascii_string->length())
+            return js_nan();
+        return Value(static_cast<u8>((*ascii_string)[position]));
+    }
+
     // 1. Let O be ? RequireObjectCoercible(this value).
     // 2. Let S be ? ToString(O).
     auto string = TRY(utf16_string_from(vm));
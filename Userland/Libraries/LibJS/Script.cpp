@@ -14,9 +14,80 @@ namespace JS {
 
 JS_DEFINE_ALLOCATOR(Script);
 
+// Keeps the programs of recently parsed scripts around, so that loading the same script again (e.g. the same bundle
+// on every page of a site) doesn't have to parse it again.
+// NOTE: The AST doesn't depend on the realm it was parsed for, so this is shared by all realms of the process.
+//       Cached programs are marked as shared, which keeps the bytecode of their functions off the AST. Otherwise
+//       the cache would keep every executable generated for them alive, and hand them to other realms.
+class ParseCache {
+public:
+    // Small scripts are cheap to parse, so only caching big ones keeps the cache from being churned by inline scripts.
+    static constexpr size_t minimum_source_length = 4 * KiB;
+    // NOTE: The budget is in source bytes. The AST of a script takes up several times as much memory as its source.
+    static constexpr size_t maximum_total_source_length = 16 * MiB;
+
+    static ParseCache& the()
+    {
+        static ParseCache cache;
+        return cache;
+    }
+
+    RefPtr<Program> find(StringView source_text, StringView filename, size_t line_number_offset)
+    {
+        auto hash = source_text.hash();
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            auto& entry = m_entries[i];
+            if (entry.hash != hash || entry.line_number_offset != line_number_offset || entry.filename != filename)
+                continue;
+            if (entry.program->source_code().code().bytes_as_string_view() != source_text)
+                continue;
+            // Move the entry to the back, so the least recently used one is always at the front.
+            auto program = entry.program;
+            m_entries.append(m_entries.take(i));
+            return program;
+        }
+        return nullptr;
+    }
+
+    void add(StringView source_text, StringView filename, size_t line_number_offset, NonnullRefPtr<Program> program)
+    {
+        if (source_text.length() < minimum_source_length || source_text.length() > maximum_total_source_length)
+            return;
+
+        // NOTE: Annex B function hoisting in the global scope depends on the declarations of the global environment
+        //       the program runs in, and the outcome is recorded on the FunctionDeclaration nodes.
+        if (program->has_functions_hoistable_with_annexB_extension())
+            return;
+
+        m_total_source_length += source_text.length();
+        while (m_total_source_length > maximum_total_source_length)
+            m_total_source_length -= m_entries.take_first().source_length;
+
+        program->set_shared_between_realms();
+        m_entries.append({ source_text.hash(), source_text.length(), filename, line_number_offset, move(program) });
+    }
+
+private:
+    struct Entry {
+        u32 hash { 0 };
+        size_t source_length { 0 };
+        ByteString filename;
+        size_t line_number_offset { 0 };
+        NonnullRefPtr<Program> program;
+    };
+
+    Vector<Entry> m_entries;
+    size_t m_total_source_length { 0 };
+};
+
 // 16.1.5 ParseScript ( sourceText, realm, hostDefined ), https://tc39.es/ecma262/#sec-parse-script
-Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset)
+Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView source_text, Realm& realm, StringView filename, HostDefined* host_defined, size_t line_number_offset, UseParseCache use_parse_cache)
 {
+    if (use_parse_cache == UseParseCache::Yes) {
+        if (auto program = ParseCache::the().find(source_text, filename, line_number_offset))
+            return realm.heap().allocate_without_realm<Script>(realm, filename, program.release_nonnull(), host_defined);
+    }
+
     // 1. Let script be ParseText(sourceText, Script).
     auto parser = Parser(Lexer(source_text, filename, line_number_offset));
     auto script = parser.parse_program();
@@ -25,6 +96,9 @@ Result<NonnullGCPtr<Script>, Vector<ParserError>> Script::parse(StringView sourc
     if (parser.has_errors())
         return parser.errors();
 
+    if (use_parse_cache == UseParseCache::Yes)
+        ParseCache::the().add(source_text, filename, line_number_offset, script);
+
     // 3. Return Script Record { [[Realm]]: realm, [[ECMAScriptCode]]: script, [[HostDefined]]: hostDefined }.
     return realm.heap().allocate_without_realm<Script>(realm, filename, move(script), host_defined);
 }
@@ -26,8 +26,13 @@ public:
         virtual void visit_host_defined_self(Cell::Visitor&) = 0;
     };
 
+    enum class UseParseCache {
+        No,
+        Yes,
+    };
+
     virtual ~Script() override;
-    static Result<NonnullGCPtr<Script>, Vector<ParserError>> parse(StringView source_text, Realm&, StringView filename = {}, HostDefined* = nullptr, size_t line_number_offset = 1);
+    static Result<NonnullGCPtr<Script>, Vector<ParserError>> parse(StringView source_text, Realm&, StringView filename = {}, HostDefined* = nullptr, size_t line_number_offset = 1, UseParseCache = UseParseCache::No);
 
     Realm& realm() { return *m_realm; }
     Program const& parse_node() const { return *m_parse_node; }
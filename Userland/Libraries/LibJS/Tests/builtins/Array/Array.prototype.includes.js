@@ -17,6 +17,18 @@ test("basic functionality", () => {
     expect(array.includes("friends", 100)).toBeFalse();
 });
 
+test("arrays of numbers", () => {
+    var array = [3, -1, 2];
+
+    expect(array.includes(-1)).toBeTrue();
+    expect(array.includes(2.0)).toBeTrue();
+    expect(array.includes(2.5)).toBeFalse();
+    expect(array.includes("3")).toBeFalse();
+    expect([1.5, NaN].includes(NaN)).toBeTrue();
+    expect([0].includes(-0)).toBeTrue();
+    expect([1, , 3].includes(undefined)).toBeTrue();
+});
+
 test("is unscopable", () => {
     expect(Array.prototype[Symbol.unscopables].includes).toBeTrue();
     const array = [];
@@ -23,3 +23,17 @@ test("basic functionality", () => {
     expect([].indexOf()).toBe(-1);
     expect([undefined].indexOf()).toBe(0);
 });
+
+test("arrays of integers", () => {
+    var array = [3, -1, 2, 3];
+
+    expect(array.indexOf(3)).toBe(0);
+    expect(array.indexOf(3, 1)).toBe(3);
+    expect(array.indexOf(-1)).toBe(1);
+    expect(array.indexOf(2.0)).toBe(2);
+    expect(array.indexOf(2.5)).toBe(-1);
+    expect(array.indexOf("3")).toBe(-1);
+    expect(array.indexOf(NaN)).toBe(-1);
+    expect([0].indexOf(-0)).toBe(0);
+    expect([1, , 3].indexOf(undefined)).toBe(-1);
+});
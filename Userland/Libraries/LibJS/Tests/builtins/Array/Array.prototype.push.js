@@ -21,3 +21,27 @@ describe("normal behavior", () => {
         expect(a).toEqual(["hello", "friends", 1, 2, 3]);
     });
 });
+
+describe("elements on the prototype chain", () => {
+    test("setter on Array.prototype is called", () => {
+        var pushed;
+        Object.defineProperty(Array.prototype, "1", {
+            set(value) {
+                pushed = value;
+            },
+            configurable: true,
+        });
+        var a = ["hello"];
+        expect(a.push("friends")).toBe(2);
+        expect(pushed).toBe("friends");
+        expect(a.hasOwnProperty(1)).toBeFalse();
+        delete Array.prototype[1];
+    });
+
+    test("non-extensible array", () => {
+        var a = [1];
+        Object.preventExtensions(a);
+        expect(() => a.push(2)).toThrow(TypeError);
+        expect(a).toEqual([1]);
+    });
+});
@@ -115,6 +115,11 @@ describe("Array.prototype.sort", () => {
         expect(arr[2].other_property == 2);
     });
 
+    test("integers at the edges of the int32 range", () => {
+        var arr = [2147483647, -2147483648, 10, -10, 0, 9];
+        expect(arr.sort()).toEqual([-10, -2147483648, 0, 10, 2147483647, 9]);
+    });
+
     test("that it makes no unnecessary calls to compare function", () => {
         expectNoCallCompareFunction = function (a, b) {
             expect().fail();
@@ -0,0 +1,59 @@
+// NOTE: These are meant to be run with `test-js -p`, which lets registers that only live inside one block share slots.
+
+test("Many temporaries in one expression", () => {
+    const a = 1,
+        b = 2,
+        c = 3,
+        d = 4;
+    expect((a + b) * (c + d) - (a * b + c * d) / (a + d)).toBe(21 - 14 / 5);
+    expect([a + b, b + c, c + d, d + a, a * b * c * d]).toEqual([3, 5, 7, 5, 24]);
+    expect(`${a + b}-${c * d}-${a + b + c + d}`).toBe("3-12-10");
+});
+
+test("Temporaries live across blocks", () => {
+    function f(flag) {
+        const object = { value: 1 };
+        const result = object.value + (flag ? object.value * 10 : object.value * 100);
+        return result;
+    }
+    expect(f(true)).toBe(11);
+    expect(f(false)).toBe(101);
+
+    const values = [1, 2, 3];
+    expect(values.map(v => (v > 1 ? v * 2 : v) + (v < 3 ? 1 : 0))).toEqual([2, 5, 6]);
+});
+
+test("Temporaries live across loops and short-circuiting", () => {
+    let total = 0;
+    for (let i = 0; i < 10; ++i) total += (i % 2 && i) || -i;
+    expect(total).toBe(-20 + 25);
+
+    const object = { a: { b: null } };
+    expect(object.a?.b?.c ?? "default").toBe("default");
+    expect(object.x?.y ?? object.a.b ?? "fallback").toBe("fallback");
+});
+
+test("Temporaries across calls and generators", () => {
+    function* counter() {
+        let sum = 0;
+        for (let i = 0; i < 3; ++i) sum += (yield i) + i;
+        return sum;
+    }
+    const generator = counter();
+    expect(generator.next().value).toBe(0);
+    expect(generator.next(10).value).toBe(1);
+    expect(generator.next(20).value).toBe(2);
+    expect(generator.next(30)).toEqual({ value: 63, done: true });
+});
+
+test("Temporaries across await", () => {
+    let result;
+    async function f() {
+        const a = 1 + (await 2);
+        const b = (await 3) * a;
+        result = [a, b];
+    }
+    f();
+    runQueuedPromiseJobs();
+    expect(result).toEqual([3, 9]);
+});
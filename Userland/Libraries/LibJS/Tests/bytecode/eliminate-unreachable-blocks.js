@@ -0,0 +1,75 @@
+// NOTE: These are meant to be run with `test-js -p`, which drops the blocks that can no longer be reached.
+
+test("Code after return, break and continue", () => {
+    function f() {
+        return 1;
+        return 2;
+    }
+    expect(f()).toBe(1);
+
+    let sum = 0;
+    for (let i = 0; i < 3; ++i) {
+        sum += i;
+        continue;
+        sum += 100;
+    }
+    expect(sum).toBe(3);
+
+    while (true) {
+        break;
+        sum = -1;
+    }
+    expect(sum).toBe(3);
+});
+
+test("Dead branches of constant conditions", () => {
+    function f() {
+        if (false) {
+            return "dead";
+        }
+        while (0) {
+            return "also dead";
+        }
+        return "live";
+    }
+    expect(f()).toBe("live");
+});
+
+test("Function declarations in unreachable code are still hoisted", () => {
+    function f() {
+        return g();
+        function g() {
+            return "hoisted";
+        }
+    }
+    expect(f()).toBe("hoisted");
+
+    function h() {
+        if (false) {
+            var x = 1;
+        }
+        return x;
+    }
+    expect(h()).toBeUndefined();
+});
+
+test("Unreachable code after throw", () => {
+    function f() {
+        throw new Error("thrown");
+        return "unreachable";
+    }
+    expect(f).toThrowWithMessage(Error, "thrown");
+});
+
+test("Handlers stay reachable", () => {
+    function f() {
+        try {
+            throw 1;
+        } catch (e) {
+            return e + 1;
+        } finally {
+            // Reached from both the try and the catch block.
+        }
+    }
+    expect(f()).toBe(2);
+});
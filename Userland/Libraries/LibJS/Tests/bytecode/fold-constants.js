@@ -0,0 +1,78 @@
+// NOTE: These are meant to be run with `test-js -p`, which folds the constant expressions below at compile time.
+
+test("Arithmetic on constants", () => {
+    expect(1 + 2).toBe(3);
+    expect(7 - 10).toBe(-3);
+    expect(6 * 7).toBe(42);
+    expect(1 / 0).toBe(Infinity);
+    expect(-1 / 0).toBe(-Infinity);
+    expect(0 / 0).toBeNaN();
+    expect(2 ** 10).toBe(1024);
+    expect(-7 % 3).toBe(-1);
+    expect(5.5 % 2).toBe(1.5);
+});
+
+test("Negative zero survives folding", () => {
+    expect(Object.is(-0 * 1, -0)).toBeTrue();
+    expect(Object.is(0 * -1, -0)).toBeTrue();
+    expect(Object.is(-0 + 0, 0)).toBeTrue();
+    expect(Object.is(-(0), -0)).toBeTrue();
+    expect(Object.is(1 / -Infinity, -0)).toBeTrue();
+});
+
+test("Bitwise operations and shifts on constants", () => {
+    expect(0xf0 | 0x0f).toBe(0xff);
+    expect(0xff & 0x0f).toBe(0x0f);
+    expect(0xff ^ 0x0f).toBe(0xf0);
+    expect(~5).toBe(-6);
+    expect(1 << 31).toBe(-2147483648);
+    expect(-1 >> 28).toBe(-1);
+    expect(-1 >>> 28).toBe(15);
+});
+
+test("Mixed primitive types", () => {
+    expect(true + 1).toBe(2);
+    expect(null + 1).toBe(1);
+    expect(undefined + 1).toBeNaN();
+    expect(+true).toBe(1);
+    expect(-null).toBe(-0);
+    expect(!0).toBeTrue();
+    expect(!NaN).toBeTrue();
+    expect(!1).toBeFalse();
+});
+
+test("Comparisons of constants", () => {
+    expect(1 < 2).toBeTrue();
+    expect(2 <= 1).toBeFalse();
+    expect(NaN < NaN).toBeFalse();
+    expect(NaN == NaN).toBeFalse();
+    expect(NaN != NaN).toBeTrue();
+    expect(null == undefined).toBeTrue();
+    expect(null === undefined).toBeFalse();
+    expect(0 === -0).toBeTrue();
+    expect(1 !== 1).toBeFalse();
+});
+
+test("Operations on strings and other heap values are not folded incorrectly", () => {
+    expect("a" + "b").toBe("ab");
+    expect("1" + 2).toBe("12");
+    expect("3" * "4").toBe(12);
+    expect("a" < "b").toBeTrue();
+    expect("10" == 10).toBeTrue();
+    expect(1n + 2n).toBe(3n);
+    expect(() => 1n + 1).toThrow(TypeError);
+});
+
+test("Conditional jumps on constants", () => {
+    let taken = [];
+    if (true) taken.push("true");
+    if (0) taken.push("0");
+    if ("") taken.push("empty string");
+    if (null ?? true) taken.push("nullish");
+    while (false) taken.push("loop");
+    expect(taken).toEqual(["true", "nullish"]);
+
+    expect(undefined ?? "fallback").toBe("fallback");
+    expect(0 ?? "fallback").toBe(0);
+    expect(false ? "yes" : "no").toBe("no");
+});
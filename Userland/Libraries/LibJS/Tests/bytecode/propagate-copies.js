@@ -0,0 +1,79 @@
+// NOTE: These are meant to be run with `test-js -p`, which forwards copied values into the instructions that read them.
+
+test("Copies of locals are not forwarded past a reassignment", () => {
+    let a = 1;
+    let b = a;
+    a = 2;
+    expect(b).toBe(1);
+    expect(a).toBe(2);
+
+    let c = b;
+    b = c + 1;
+    expect(c).toBe(1);
+    expect(b).toBe(2);
+});
+
+test("Swapping through a temporary", () => {
+    let a = "a";
+    let b = "b";
+    let t = a;
+    a = b;
+    b = t;
+    expect(a).toBe("b");
+    expect(b).toBe("a");
+
+    [a, b] = [b, a];
+    expect(a).toBe("a");
+    expect(b).toBe("b");
+});
+
+test("Copies are invalidated by calls that modify captured variables", () => {
+    let x = 1;
+    const copy = x;
+    function bump() {
+        x = 10;
+    }
+    bump();
+    expect(x).toBe(10);
+    expect(copy).toBe(1);
+});
+
+test("Copies are invalidated by update expressions and compound assignments", () => {
+    let i = 0;
+    let before = i;
+    let post = i++;
+    let pre = ++i;
+    expect(before).toBe(0);
+    expect(post).toBe(0);
+    expect(pre).toBe(2);
+    expect(i).toBe(2);
+
+    let j = i;
+    j += 5;
+    expect(i).toBe(2);
+    expect(j).toBe(7);
+});
+
+test("Copies across loop iterations", () => {
+    let previous = -1;
+    let current = 0;
+    const seen = [];
+    for (let i = 0; i < 4; ++i) {
+        seen.push(previous);
+        previous = current;
+        current = i;
+    }
+    expect(seen).toEqual([-1, 0, 0, 1]);
+});
+
+test("Copies with exceptions in between", () => {
+    let value = "before";
+    let copy = value;
+    try {
+        value = "inside";
+        throw new Error();
+    } catch {
+        copy = value;
+    }
+    expect(copy).toBe("inside");
+});
@@ -0,0 +1,68 @@
+// NOTE: These are meant to be run with `test-js -p`, which retargets jumps through blocks that only jump onward.
+
+test("Nested loops with break and continue", () => {
+    const visited = [];
+    outer: for (let i = 0; i < 4; ++i) {
+        for (let j = 0; j < 4; ++j) {
+            if (j === 1) continue;
+            if (j === 3) continue outer;
+            if (i === 2) break outer;
+            visited.push(`${i}${j}`);
+        }
+    }
+    expect(visited).toEqual(["00", "02", "10", "12"]);
+});
+
+test("Empty branches and loop bodies", () => {
+    let count = 0;
+    for (let i = 0; i < 5; ++i) {
+        if (i % 2) {
+        } else {
+        }
+        ++count;
+    }
+    for (let i = 0; i < 3; ++i) {}
+    while (count++ < 10) {}
+    expect(count).toBe(11);
+});
+
+test("Chains of else-if", () => {
+    function classify(n) {
+        if (n < 0) {
+            return "negative";
+        } else if (n === 0) {
+        } else if (n < 10) {
+            return "small";
+        } else {
+        }
+        return "other";
+    }
+    expect(classify(-1)).toBe("negative");
+    expect(classify(0)).toBe("other");
+    expect(classify(5)).toBe("small");
+    expect(classify(50)).toBe("other");
+});
+
+test("Infinite loop exited by a return", () => {
+    function find(values, wanted) {
+        let i = 0;
+        for (;;) {
+            if (values[i] === wanted) return i;
+            ++i;
+        }
+    }
+    expect(find([3, 4, 5], 5)).toBe(2);
+});
+
+test("Jumps through finally blocks", () => {
+    const order = [];
+    for (let i = 0; i < 3; ++i) {
+        try {
+            if (i === 1) continue;
+            order.push(i);
+        } finally {
+            order.push("finally");
+        }
+    }
+    expect(order).toEqual([0, "finally", "finally", 2, "finally"]);
+});
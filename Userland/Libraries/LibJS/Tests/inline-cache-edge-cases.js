@@ -16,3 +16,102 @@ test("Inline cache invalidated by deleting property from unique shape", () => {
     expect(first).toBe(2);
     expect(second).toBeUndefined();
 });
+
+test("Polymorphic inline cache returns the property for each shape", () => {
+    function ic(o) {
+        return o.x;
+    }
+
+    const objects = [
+        { x: 1 },
+        { a: 0, x: 2 },
+        { a: 0, b: 0, x: 3 },
+        { a: 0, b: 0, c: 0, x: 4 },
+        { a: 0, b: 0, c: 0, d: 0, x: 5 },
+    ];
+    for (let i = 0; i < 3; ++i) {
+        for (let j = 0; j < objects.length; ++j) {
+            expect(ic(objects[j])).toBe(j + 1);
+        }
+    }
+});
+
+test("Inline cache invalidated by adding a shadowing property to an intermediate prototype", () => {
+    const grandparent = { foo: "grandparent" };
+    const parent = Object.create(grandparent);
+    const child = Object.create(parent);
+
+    function ic(o) {
+        return o.foo;
+    }
+
+    expect(ic(child)).toBe("grandparent");
+    expect(ic(child)).toBe("grandparent");
+    parent.foo = "parent";
+    expect(ic(child)).toBe("parent");
+    delete parent.foo;
+    expect(ic(child)).toBe("grandparent");
+});
+
+test("Inline cache invalidated by changing the prototype of a prototype", () => {
+    const a = { foo: "a" };
+    const b = { foo: "b" };
+    const parent = Object.create(a);
+    const child = Object.create(parent);
+
+    function ic(o) {
+        return o.foo;
+    }
+
+    expect(ic(child)).toBe("a");
+    Object.setPrototypeOf(parent, b);
+    expect(ic(child)).toBe("b");
+});
+
+test("Inline cache sees a prototype property being replaced with an accessor", () => {
+    const parent = { foo: 1 };
+    const child = Object.create(parent);
+
+    function ic(o) {
+        return o.foo;
+    }
+
+    expect(ic(child)).toBe(1);
+    Object.defineProperty(parent, "foo", { get: () => 2 });
+    expect(ic(child)).toBe(2);
+});
+
+test("Inline cache on an object that had properties deleted after becoming a dictionary", () => {
+    const o = {};
+    for (let i = 0; i < 100; ++i) o[`p${i}`] = i;
+
+    function ic(o) {
+        return o.p99;
+    }
+
+    delete o.p0;
+    for (let i = 0; i < 20; ++i) expect(ic(o)).toBe(99);
+
+    delete o.p1;
+    expect(ic(o)).toBe(99);
+    o.p99 = "changed";
+    for (let i = 0; i < 20; ++i) expect(ic(o)).toBe("changed");
+
+    delete o.p99;
+    expect(ic(o)).toBeUndefined();
+});
+
+test("Objects sharing part of a transition chain see only their own properties", () => {
+    const a = { x: 1, y: 2 };
+    const b = { x: 3, z: 4 };
+    const c = { x: 5, y: 6, w: 7 };
+
+    expect(Object.keys(a)).toEqual(["x", "y"]);
+    expect(Object.keys(b)).toEqual(["x", "z"]);
+    expect(Object.keys(c)).toEqual(["x", "y", "w"]);
+    expect(a.z).toBeUndefined();
+    expect(a.w).toBeUndefined();
+    expect(b.y).toBeUndefined();
+    expect(c.z).toBeUndefined();
+    expect(c.w).toBe(7);
+});
@@ -0,0 +1,70 @@
+// NOTE: Executables are only JIT-compiled once they have been entered often enough (and when the JIT is enabled),
+//       so every function below is called many times before anything is checked.
+const iterations = 100;
+
+test("exception thrown by a throw statement in hot code", () => {
+    function thrower(value) {
+        if (value > 50) throw new Error(`value ${value} is too large`);
+        return value;
+    }
+
+    let sum = 0;
+    for (let i = 0; i < iterations; ++i) {
+        try {
+            sum += thrower(i);
+        } catch (e) {
+            expect(e).toBeInstanceOf(Error);
+            expect(e.message).toBe(`value ${i} is too large`);
+        }
+    }
+    expect(sum).toBe(1275);
+});
+
+test("exception thrown by a failing operation in hot code", () => {
+    function callProperty(object) {
+        return object.method();
+    }
+
+    let caught = 0;
+    for (let i = 0; i < iterations; ++i) {
+        const object = i % 2 === 0 ? { method: () => i } : {};
+        try {
+            expect(callProperty(object)).toBe(i);
+        } catch (e) {
+            expect(e).toBeInstanceOf(TypeError);
+            ++caught;
+        }
+    }
+    expect(caught).toBe(iterations / 2);
+});
+
+test("exception propagates through several hot frames", () => {
+    function inner(value) {
+        if (value % 3 === 0) throw value;
+        return value;
+    }
+
+    function outer(value) {
+        return inner(value) + 1;
+    }
+
+    const thrown = [];
+    for (let i = 0; i < iterations; ++i) {
+        try {
+            outer(i);
+        } catch (e) {
+            thrown.push(e);
+        }
+    }
+    expect(thrown).toHaveLength(34);
+    expect(thrown[1]).toBe(3);
+});
+
+test("toThrow sees the exception of a hot function", () => {
+    function throwsReferenceError() {
+        return thisVariableDoesNotExist;
+    }
+
+    for (let i = 0; i < iterations; ++i)
+        expect(throwsReferenceError).toThrowWithMessage(ReferenceError, "'thisVariableDoesNotExist' is not defined");
+});
@@ -28,3 +28,24 @@ test("adding strings with dangling surrogates", () => {
     expect("\ud834a" + "\udf06").toBe("\ud834a\udf06");
     expect("\ud834" + "a\udf06").toBe("\ud834a\udf06");
 });
+
+test("length and indexed access of strings built in a loop", () => {
+    let string = "";
+    for (let i = 0; i < 100; ++i) {
+        string += i % 10;
+        expect(string).toHaveLength(i + 1);
+    }
+    expect(string[99]).toBe("9");
+    expect(string.charCodeAt(98)).toBe(56);
+    expect(string.charAt(100)).toBe("");
+
+    let mixed = "";
+    for (let i = 0; i < 10; ++i) {
+        mixed += "a";
+        mixed += "\ud834";
+        mixed += "\udf06";
+    }
+    expect(mixed).toHaveLength(30);
+    expect(mixed[1]).toBe("\ud834");
+    expect(mixed.charCodeAt(2)).toBe(0xdf06);
+});
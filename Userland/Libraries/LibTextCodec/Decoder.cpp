@@ -271,6 +271,10 @@ ErrorOr<String> UTF8Decoder::to_utf8(StringView input)
         bomless_input = input.substring_view(3);
     }
 
+    // OPTIMIZATION: Valid UTF-8 can be used as is, there's no need to decode and re-encode every code point.
+    if (Utf8View(bomless_input).validate())
+        return String::from_utf8_without_validation(bomless_input.bytes());
+
     return Decoder::to_utf8(bomless_input);
 }
 
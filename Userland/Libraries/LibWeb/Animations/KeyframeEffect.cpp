@@ -940,8 +940,12 @@ void KeyframeEffect::update_style_properties()
     if (target->layout_node())
         target->layout_node()->apply_style(*style);
 
-    if (invalidation.relayout)
-        document.set_needs_layout();
+    if (invalidation.relayout) {
+        if (auto* layout_node = target->layout_node())
+            layout_node->set_needs_layout();
+        else
+            document.set_needs_layout();
+    }
     if (invalidation.rebuild_layout_tree)
         document.invalidate_layout();
     if (invalidation.repaint)
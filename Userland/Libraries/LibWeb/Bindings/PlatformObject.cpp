@@ -225,6 +225,16 @@ JS::ThrowCompletionOr<Optional<JS::PropertyDescriptor>> PlatformObject::internal
     }
 }
 
+bool PlatformObject::may_have_own_properties_outside_of_shape() const
+{
+    // NOTE: Named properties only shadow properties of the prototype chain with [LegacyOverrideBuiltIns]. Otherwise,
+    //       they aren't visible if the prototype chain has a property with the same name.
+    return m_legacy_platform_object_flags.has_value()
+        && !m_legacy_platform_object_flags->has_global_interface_extended_attribute
+        && m_legacy_platform_object_flags->supports_named_properties
+        && m_legacy_platform_object_flags->has_legacy_override_built_ins_interface_extended_attribute;
+}
+
 // https://webidl.spec.whatwg.org/#legacy-platform-object-set
 JS::ThrowCompletionOr<bool> PlatformObject::internal_set(JS::PropertyKey const& property_name, JS::Value value, JS::Value receiver, JS::CacheablePropertyMetadata* metadata)
 {
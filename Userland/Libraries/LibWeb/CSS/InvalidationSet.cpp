@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/CSS/InvalidationSet.h>
+#include <LibWeb/CSS/Selector.h>
+#include <LibWeb/DOM/Attr.h>
+#include <LibWeb/DOM/Element.h>
+
+namespace Web::CSS {
+
+void InvalidationSet::include(InvalidationSet const& other)
+{
+    invalidate_self |= other.invalidate_self;
+    invalidate_whole_subtree |= other.invalidate_whole_subtree;
+    invalidate_siblings |= other.invalidate_siblings;
+
+    // NOTE: Once the whole subtree is invalidated, there's no point in keeping track of individual features.
+    if (invalidate_whole_subtree) {
+        descendant_classes.clear();
+        descendant_ids.clear();
+        descendant_tag_names.clear();
+        descendant_attribute_names.clear();
+        return;
+    }
+
+    for (auto const& name : other.descendant_classes)
+        descendant_classes.set(name);
+    for (auto const& name : other.descendant_ids)
+        descendant_ids.set(name);
+    for (auto const& name : other.descendant_tag_names)
+        descendant_tag_names.set(name);
+    for (auto const& name : other.descendant_attribute_names)
+        descendant_attribute_names.set(name);
+}
+
+bool InvalidationSet::has_descendant_features() const
+{
+    return !descendant_classes.is_empty() || !descendant_ids.is_empty() || !descendant_tag_names.is_empty() || !descendant_attribute_names.is_empty();
+}
+
+bool InvalidationSet::matches_descendant(DOM::Element const& element) const
+{
+    if (invalidate_whole_subtree)
+        return true;
+    if (!descendant_tag_names.is_empty() && descendant_tag_names.contains(element.local_name()))
+        return true;
+    if (!descendant_ids.is_empty() && element.id().has_value() && descendant_ids.contains(element.id().value()))
+        return true;
+    if (!descendant_classes.is_empty()) {
+        for (auto const& class_name : element.class_names()) {
+            if (descendant_classes.contains(class_name))
+                return true;
+        }
+    }
+    if (!descendant_attribute_names.is_empty()) {
+        bool has_attribute = false;
+        element.for_each_attribute([&](DOM::Attr const& attribute) {
+            if (descendant_attribute_names.contains(attribute.local_name()))
+                has_attribute = true;
+        });
+        if (has_attribute)
+            return true;
+    }
+    return false;
+}
+
+// Where an element that a compound selector is matched against sits, relative to the element that is being styled.
+enum class InvalidationScope {
+    Self,
+    Ancestor,
+    Sibling,
+};
+
+static void add_to_invalidation_set(InvalidationSet& set, InvalidationScope scope, InvalidationSet const& descendant_invalidation)
+{
+    switch (scope) {
+    case InvalidationScope::Self:
+        set.invalidate_self = true;
+        break;
+    case InvalidationScope::Ancestor:
+        set.include(descendant_invalidation);
+        break;
+    case InvalidationScope::Sibling:
+        set.invalidate_siblings = true;
+        break;
+    }
+}
+
+// Finds one class, id, tag name or attribute that every element matching the compound selector must have.
+static bool add_identifying_feature(Selector::CompoundSelector const& compound_selector, InvalidationSet& set)
+{
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::Id) {
+            set.descendant_ids.set(simple_selector.name());
+            return true;
+        }
+    }
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::Class) {
+            set.descendant_classes.set(simple_selector.name());
+            return true;
+        }
+    }
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::TagName) {
+            set.descendant_tag_names.set(simple_selector.qualified_name().name.lowercase_name);
+            return true;
+        }
+    }
+    for (auto const& simple_selector : compound_selector.simple_selectors) {
+        if (simple_selector.type == Selector::SimpleSelector::Type::Attribute) {
+            set.descendant_attribute_names.set(simple_selector.attribute().qualified_name.name.lowercase_name);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void add_compound_selectors(InvalidationSetMap& map, Selector const& selector, InvalidationScope outer_scope, InvalidationSet const& descendant_invalidation)
+{
+    auto const& compound_selectors = selector.compound_selectors();
+    bool is_left_of_sibling_combinator = false;
+    for (size_t i = compound_selectors.size(); i > 0; --i) {
+        auto const& compound_selector = compound_selectors[i - 1];
+
+        auto scope = i == compound_selectors.size() ? InvalidationScope::Self : InvalidationScope::Ancestor;
+        if (is_left_of_sibling_combinator)
+            scope = InvalidationScope::Sibling;
+        scope = max(scope, outer_scope);
+
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            switch (simple_selector.type) {
+            case Selector::SimpleSelector::Type::Class:
+                add_to_invalidation_set(map.by_class.ensure(simple_selector.name()), scope, descendant_invalidation);
+                break;
+            case Selector::SimpleSelector::Type::Id:
+                add_to_invalidation_set(map.by_id.ensure(simple_selector.name()), scope, descendant_invalidation);
+                break;
+            case Selector::SimpleSelector::Type::Attribute:
+                add_to_invalidation_set(map.by_attribute_name.ensure(simple_selector.attribute().qualified_name.name.lowercase_name), scope, descendant_invalidation);
+                break;
+            case Selector::SimpleSelector::Type::PseudoClass: {
+                auto const& pseudo_class = simple_selector.pseudo_class();
+                switch (pseudo_class.type) {
+                case PseudoClass::Is:
+                case PseudoClass::Where:
+                case PseudoClass::Not:
+                    for (auto const& argument : pseudo_class.argument_selector_list)
+                        add_compound_selectors(map, argument, scope, descendant_invalidation);
+                    break;
+                case PseudoClass::NthChild:
+                case PseudoClass::NthLastChild:
+                    // NOTE: The "of S" selectors are matched against the siblings of the element.
+                    for (auto const& argument : pseudo_class.argument_selector_list)
+                        add_compound_selectors(map, argument, InvalidationScope::Sibling, descendant_invalidation);
+                    break;
+                default:
+                    break;
+                }
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        if (compound_selector.combinator == Selector::Combinator::NextSibling
+            || compound_selector.combinator == Selector::Combinator::SubsequentSibling
+            || compound_selector.combinator == Selector::Combinator::Column)
+            is_left_of_sibling_combinator = true;
+    }
+}
+
+void InvalidationSetMap::add_selector(Selector const& selector)
+{
+    // A change to an ancestor can only affect the descendants that could be matched by the selector.
+    InvalidationSet descendant_invalidation;
+    if (!add_identifying_feature(selector.compound_selectors().last(), descendant_invalidation))
+        descendant_invalidation.invalidate_whole_subtree = true;
+
+    add_compound_selectors(*this, selector, InvalidationScope::Self, descendant_invalidation);
+}
+
+}
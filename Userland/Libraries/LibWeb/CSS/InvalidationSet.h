@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/HashTable.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::CSS {
+
+// Describes which elements could have their style affected by a change to one class, id or attribute of an element,
+// according to the selectors that use it.
+struct InvalidationSet {
+    // The element that changed.
+    bool invalidate_self { false };
+
+    // All descendants of the element. Otherwise, only the descendants that have one of the descendant_* features.
+    bool invalidate_whole_subtree { false };
+
+    // The siblings of the element, and their descendants.
+    bool invalidate_siblings { false };
+
+    HashTable<FlyString> descendant_classes;
+    HashTable<FlyString> descendant_ids;
+    HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> descendant_tag_names;
+    HashTable<FlyString, AK::ASCIICaseInsensitiveFlyStringTraits> descendant_attribute_names;
+
+    void include(InvalidationSet const&);
+
+    [[nodiscard]] bool has_descendant_features() const;
+    [[nodiscard]] bool is_empty() const { return !invalidate_self && !invalidate_whole_subtree && !invalidate_siblings && !has_descendant_features(); }
+
+    // Whether the element is one of the descendants that have to be restyled.
+    [[nodiscard]] bool matches_descendant(DOM::Element const&) const;
+};
+
+// The invalidation sets for all classes, ids and attributes used by some set of selectors.
+struct InvalidationSetMap {
+    HashMap<FlyString, InvalidationSet> by_class;
+    HashMap<FlyString, InvalidationSet> by_id;
+    HashMap<FlyString, InvalidationSet, AK::ASCIICaseInsensitiveFlyStringTraits> by_attribute_name;
+
+    void add_selector(Selector const&);
+};
+
+}
@@ -801,4 +801,9 @@ bool can_use_fast_matches(CSS::Selector const& selector)
     return true;
 }
 
+bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoClassSelector const& pseudo_class, DOM::Element const& element)
+{
+    return matches_pseudo_class(pseudo_class, {}, element, {});
+}
+
 }
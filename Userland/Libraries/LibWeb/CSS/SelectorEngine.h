@@ -16,4 +16,7 @@ bool matches(CSS::Selector const&, Optional<CSS::CSSStyleSheet const&> style_she
 [[nodiscard]] bool fast_matches(CSS::Selector const&, Optional<CSS::CSSStyleSheet const&> style_sheet_for_rule, DOM::Element const&);
 [[nodiscard]] bool can_use_fast_matches(CSS::Selector const&);
 
+// Matches a single pseudo-class against the element, outside of the context of any style sheet or scope.
+[[nodiscard]] bool matches_pseudo_class(CSS::Selector::SimpleSelector::PseudoClassSelector const&, DOM::Element const&);
+
 }
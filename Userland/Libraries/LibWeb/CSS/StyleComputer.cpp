@@ -7,6 +7,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <AK/Error.h>
@@ -65,7 +66,9 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/DOM/ShadowRoot.h>
+#include <LibWeb/HTML/FormAssociatedElement.h>
 #include <LibWeb/HTML/HTMLBRElement.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
@@ -2333,6 +2336,14 @@ RefPtr<StyleProperties> StyleComputer::compute_pseudo_element_style_if_needed(DO
     return compute_style_impl(element, move(pseudo_element), ComputeStyleMode::CreatePseudoElementStyleIfNeeded);
 }
 
+static bool has_animation_name(StyleProperties const& style)
+{
+    auto animation_name = style.maybe_null_property(PropertyID::AnimationName);
+    if (animation_name.is_null())
+        return false;
+    return !animation_name->is_identifier() || animation_name->as_identifier().id() != ValueID::None;
+}
+
 RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element, Optional<CSS::Selector::PseudoElement::Type> pseudo_element, ComputeStyleMode mode) const
 {
     build_rule_cache_if_needed();
@@ -2351,6 +2362,14 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
         return style;
     }
 
+    // OPTIMIZATION: Siblings that no selector can tell apart, e.g. the rows of a table, end up with the same style.
+    //               Instead of running the cascade again, we copy the style of a recently styled one.
+    bool const can_use_style_sharing = m_style_sharing_enabled && mode == ComputeStyleMode::Normal && !pseudo_element.has_value() && is_eligible_for_style_sharing(element);
+    if (can_use_style_sharing) {
+        if (auto style = find_shareable_style(element))
+            return style;
+    }
+
     auto style = StyleProperties::create();
     // 1. Perform the cascade. This produces the "specified style"
     bool did_match_any_pseudo_element_rules = false;
@@ -2380,6 +2399,11 @@ RefPtr<StyleProperties> StyleComputer::compute_style_impl(DOM::Element& element,
     // 8. Let the element adjust computed style
     element.adjust_computed_style(style);
 
+    // NOTE: The CSSAnimation for animation-name is created while cascading, which an element that shares this style
+    //       would skip. So animated elements can't give their style to others.
+    if (can_use_style_sharing && !has_animation_name(style))
+        add_style_sharing_candidate(element);
+
     return style;
 }
 
@@ -2390,6 +2414,41 @@ void StyleComputer::build_rule_cache_if_needed() const
     const_cast<StyleComputer&>(*this).build_rule_cache();
 }
 
+static void collect_style_sharing_features(Selector const& selector, Vector<Selector::SimpleSelector::PseudoClassSelector const*>& pseudo_classes, bool& has_sibling_combinators)
+{
+    for (auto const& compound_selector : selector.compound_selectors()) {
+        // NOTE: These compare an element to its siblings, which by definition differ between siblings.
+        if (compound_selector.combinator == Selector::Combinator::NextSibling
+            || compound_selector.combinator == Selector::Combinator::SubsequentSibling
+            || compound_selector.combinator == Selector::Combinator::Column)
+            has_sibling_combinators = true;
+
+        for (auto const& simple_selector : compound_selector.simple_selectors) {
+            if (simple_selector.type != Selector::SimpleSelector::Type::PseudoClass)
+                continue;
+            auto const& pseudo_class = simple_selector.pseudo_class();
+
+            // :is(), :where() and :not() can only tell elements apart by what their arguments can tell them apart by.
+            if (pseudo_class.type == PseudoClass::Is || pseudo_class.type == PseudoClass::Where || pseudo_class.type == PseudoClass::Not) {
+                for (auto const& argument : pseudo_class.argument_selector_list)
+                    collect_style_sharing_features(argument, pseudo_classes, has_sibling_combinators);
+                continue;
+            }
+
+            bool const has_arguments = !pseudo_class.argument_selector_list.is_empty()
+                || !pseudo_class.languages.is_empty()
+                || pseudo_class.identifier.has_value()
+                || pseudo_class.type == PseudoClass::NthChild
+                || pseudo_class.type == PseudoClass::NthLastChild
+                || pseudo_class.type == PseudoClass::NthOfType
+                || pseudo_class.type == PseudoClass::NthLastOfType;
+            if (!has_arguments && any_of(pseudo_classes, [&](auto const* other) { return other->type == pseudo_class.type; }))
+                continue;
+            pseudo_classes.append(&pseudo_class);
+        }
+    }
+}
+
 NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_cascade_origin(CascadeOrigin cascade_origin)
 {
     auto rule_cache = make<RuleCache>();
@@ -2422,6 +2481,9 @@ NonnullOwnPtr<StyleComputer::RuleCache> StyleComputer::make_rule_cache_for_casca
                     SelectorEngine::can_use_fast_matches(selector),
                 };
 
+                collect_style_sharing_features(selector, rule_cache->pseudo_classes_for_style_sharing, rule_cache->has_sibling_combinators);
+                rule_cache->invalidation_sets.add_selector(selector);
+
                 for (auto const& simple_selector : selector.compound_selectors().last().simple_selectors) {
                     if (!matching_rule.contains_pseudo_element) {
                         if (simple_selector.type == CSS::Selector::SimpleSelector::Type::PseudoElement) {
@@ -2552,6 +2614,10 @@ void StyleComputer::build_rule_cache()
 
 void StyleComputer::invalidate_rule_cache()
 {
+    // NOTE: The styles of the candidates were computed with the old rules.
+    m_style_sharing_candidates.clear();
+    m_style_shared_from.clear();
+
     m_author_rule_cache = nullptr;
 
     // NOTE: We could be smarter about keeping the user rule cache, and style sheet.
@@ -2691,4 +2757,131 @@ void StyleComputer::pop_ancestor(DOM::Element const& element)
     });
 }
 
+void StyleComputer::collect_invalidation_set_for_class(FlyString const& class_name, InvalidationSet& invalidation_set) const
+{
+    build_rule_cache_if_needed();
+    for (auto const* rule_cache : { m_user_agent_rule_cache.ptr(), m_user_rule_cache.ptr(), m_author_rule_cache.ptr() }) {
+        if (auto it = rule_cache->invalidation_sets.by_class.find(class_name); it != rule_cache->invalidation_sets.by_class.end())
+            invalidation_set.include(it->value);
+    }
+}
+
+void StyleComputer::collect_invalidation_set_for_id(FlyString const& id, InvalidationSet& invalidation_set) const
+{
+    build_rule_cache_if_needed();
+    for (auto const* rule_cache : { m_user_agent_rule_cache.ptr(), m_user_rule_cache.ptr(), m_author_rule_cache.ptr() }) {
+        if (auto it = rule_cache->invalidation_sets.by_id.find(id); it != rule_cache->invalidation_sets.by_id.end())
+            invalidation_set.include(it->value);
+    }
+}
+
+void StyleComputer::collect_invalidation_set_for_attribute(FlyString const& attribute_name, InvalidationSet& invalidation_set) const
+{
+    build_rule_cache_if_needed();
+    for (auto const* rule_cache : { m_user_agent_rule_cache.ptr(), m_user_rule_cache.ptr(), m_author_rule_cache.ptr() }) {
+        if (auto it = rule_cache->invalidation_sets.by_attribute_name.find(attribute_name); it != rule_cache->invalidation_sets.by_attribute_name.end())
+            invalidation_set.include(it->value);
+    }
+}
+
+void StyleComputer::begin_style_sharing()
+{
+    m_style_sharing_enabled = true;
+}
+
+void StyleComputer::end_style_sharing()
+{
+    m_style_sharing_enabled = false;
+    m_style_sharing_candidates.clear();
+    m_style_shared_from.clear();
+}
+
+bool StyleComputer::is_eligible_for_style_sharing(DOM::Element const& element) const
+{
+    if (m_user_agent_rule_cache->has_sibling_combinators || m_user_rule_cache->has_sibling_combinators || m_author_rule_cache->has_sibling_combinators)
+        return false;
+
+    if (!element.is_html_element() || !element.parent())
+        return false;
+
+    // NOTE: The style of these depends on more than their name, their attributes and the pseudo-classes they match.
+    if (element.inline_style() || element.shadow_root_internal())
+        return false;
+    if (element.has_associated_animations() || element.cached_animation_name_animation())
+        return false;
+    if (element.is_navigable_container() || element.is_html_embed_element() || element.is_html_object_element())
+        return false;
+    if (dynamic_cast<HTML::FormAssociatedElement const*>(&element))
+        return false;
+
+    return true;
+}
+
+bool StyleComputer::can_share_style_with(DOM::Element const& element, DOM::Element const& candidate) const
+{
+    // Siblings are styled in the same context. So are the children of elements that got their style from each other.
+    if (element.parent() != candidate.parent()) {
+        auto shared_from = m_style_shared_from.get(element.parent());
+        if (!shared_from.has_value() || *shared_from != candidate.parent())
+            return false;
+    }
+
+    if (!candidate.computed_css_values())
+        return false;
+
+    // NOTE: The style of an animated candidate contains its animated values, which must not leak to the element.
+    if (candidate.has_associated_animations() || candidate.cached_animation_name_animation())
+        return false;
+    if (has_animation_name(*candidate.computed_css_values()) || !candidate.computed_css_values()->animated_property_values().is_empty())
+        return false;
+
+    if (element.local_name() != candidate.local_name() || element.namespace_uri() != candidate.namespace_uri())
+        return false;
+
+    if (element.attribute_list_size() != candidate.attribute_list_size())
+        return false;
+    for (size_t i = 0; i < element.attribute_list_size(); ++i) {
+        auto const& attribute = *element.attributes()->item(i);
+        auto const& candidate_attribute = *candidate.attributes()->item(i);
+        if (attribute.local_name() != candidate_attribute.local_name()
+            || attribute.namespace_uri() != candidate_attribute.namespace_uri()
+            || attribute.value() != candidate_attribute.value())
+            return false;
+    }
+
+    for (auto const* rule_cache : { m_user_agent_rule_cache.ptr(), m_user_rule_cache.ptr(), m_author_rule_cache.ptr() }) {
+        for (auto const* pseudo_class : rule_cache->pseudo_classes_for_style_sharing) {
+            if (SelectorEngine::matches_pseudo_class(*pseudo_class, element) != SelectorEngine::matches_pseudo_class(*pseudo_class, candidate))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+RefPtr<StyleProperties> StyleComputer::find_shareable_style(DOM::Element& element) const
+{
+    for (size_t i = m_style_sharing_candidates.size(); i > 0; --i) {
+        JS::NonnullGCPtr candidate = m_style_sharing_candidates[i - 1];
+        if (!can_share_style_with(element, candidate))
+            continue;
+
+        ++m_style_sharing_statistics.hits;
+        element.set_custom_properties({}, candidate->custom_properties({}));
+        m_style_shared_from.set(&element, candidate.ptr());
+        add_style_sharing_candidate(element);
+        return candidate->computed_css_values()->clone();
+    }
+
+    ++m_style_sharing_statistics.misses;
+    return nullptr;
+}
+
+void StyleComputer::add_style_sharing_candidate(DOM::Element const& element) const
+{
+    if (m_style_sharing_candidates.size() == max_style_sharing_candidates)
+        m_style_sharing_candidates.remove(0);
+    m_style_sharing_candidates.append(element);
+}
+
 }
@@ -14,6 +14,7 @@
 #include <LibWeb/CSS/CSSFontFaceRule.h>
 #include <LibWeb/CSS/CSSKeyframesRule.h>
 #include <LibWeb/CSS/CSSStyleDeclaration.h>
+#include <LibWeb/CSS/InvalidationSet.h>
 #include <LibWeb/CSS/Selector.h>
 #include <LibWeb/CSS/StyleProperties.h>
 #include <LibWeb/Forward.h>
@@ -122,6 +123,17 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // While style sharing is enabled, elements that no selector can tell apart from a recently styled sibling (or
+    // cousin) get a copy of its computed style instead of going through the cascade again.
+    void begin_style_sharing();
+    void end_style_sharing();
+
+    struct StyleSharingStatistics {
+        size_t hits { 0 };
+        size_t misses { 0 };
+    };
+    StyleSharingStatistics const& style_sharing_statistics() const { return m_style_sharing_statistics; }
+
     NonnullRefPtr<StyleProperties> create_document_style() const;
 
     NonnullRefPtr<StyleProperties> compute_style(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type> = {}) const;
@@ -131,6 +143,11 @@ public:
 
     void invalidate_rule_cache();
 
+    // Adds what has to be restyled when an element gains or loses the class, id or attribute to the invalidation set.
+    void collect_invalidation_set_for_class(FlyString const&, InvalidationSet&) const;
+    void collect_invalidation_set_for_id(FlyString const&, InvalidationSet&) const;
+    void collect_invalidation_set_for_attribute(FlyString const&, InvalidationSet&) const;
+
     Gfx::Font const& initial_font() const;
 
     void did_load_font(FlyString const& family_name);
@@ -158,6 +175,11 @@ private:
 
     [[nodiscard]] bool should_reject_with_ancestor_filter(Selector const&) const;
 
+    [[nodiscard]] bool is_eligible_for_style_sharing(DOM::Element const&) const;
+    [[nodiscard]] bool can_share_style_with(DOM::Element const&, DOM::Element const& candidate) const;
+    RefPtr<StyleProperties> find_shareable_style(DOM::Element&) const;
+    void add_style_sharing_candidate(DOM::Element const&) const;
+
     RefPtr<StyleProperties> compute_style_impl(DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, ComputeStyleMode) const;
     void compute_cascaded_values(StyleProperties&, DOM::Element&, Optional<CSS::Selector::PseudoElement::Type>, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
     static RefPtr<Gfx::FontCascadeList const> find_matching_font_weight_ascending(Vector<MatchingFontCandidate> const& candidates, int target_weight, float font_size_in_pt, bool inclusive);
@@ -204,6 +226,13 @@ private:
         Vector<MatchingRule> other_rules;
 
         HashMap<FlyString, NonnullRefPtr<Animations::KeyframeEffect::KeyFrameSet>> rules_by_animation_keyframes;
+
+        // The pseudo-classes used by any of the selectors. Elements with the same name and attributes can only share
+        // their style if they agree on all of these.
+        Vector<Selector::SimpleSelector::PseudoClassSelector const*> pseudo_classes_for_style_sharing;
+        bool has_sibling_combinators { false };
+
+        InvalidationSetMap invalidation_sets;
     };
 
     NonnullOwnPtr<RuleCache> make_rule_cache_for_cascade_origin(CascadeOrigin);
@@ -224,6 +253,14 @@ private:
     CSSPixelRect m_viewport_rect;
 
     CountingBloomFilter<u8, 14> m_ancestor_filter;
+
+    static constexpr size_t max_style_sharing_candidates = 16;
+    bool m_style_sharing_enabled { false };
+    mutable Vector<JS::NonnullGCPtr<DOM::Element const>, max_style_sharing_candidates> m_style_sharing_candidates;
+    // Elements that got their style from another element during this style update, which makes their children
+    // candidates for each other.
+    mutable HashMap<DOM::Node const*, DOM::Node const*> m_style_shared_from;
+    mutable StyleSharingStatistics m_style_sharing_statistics;
 };
 
 }
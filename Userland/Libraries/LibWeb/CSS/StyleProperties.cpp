@@ -34,6 +34,17 @@
 
 namespace Web::CSS {
 
+NonnullRefPtr<StyleProperties> StyleProperties::clone() const
+{
+    auto clone = create();
+    clone->m_property_values = m_property_values;
+    clone->m_animated_property_values = m_animated_property_values;
+    clone->m_math_depth = m_math_depth;
+    clone->m_font_list = m_font_list;
+    clone->m_line_height = m_line_height;
+    return clone;
+}
+
 bool StyleProperties::is_property_important(CSS::PropertyID property_id) const
 {
     return m_property_values[to_underlying(property_id)].style && m_property_values[to_underlying(property_id)].important == Important::Yes;
@@ -104,6 +104,7 @@
 #include <LibWeb/Layout/BlockFormattingContext.h>
 #include <LibWeb/Layout/TreeBuilder.h>
 #include <LibWeb/Layout/Viewport.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Namespace.h>
 #include <LibWeb/Page/Page.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
@@ -411,6 +412,7 @@ WebIDL::ExceptionOr<void> Document::populate_with_html_head_and_body()
 void Document::finalize()
 {
     Base::finalize();
+    discard_unused_speculative_loads();
     page().client().page_did_destroy_document(*this);
 }
 
@@ -420,6 +422,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_page);
     visitor.visit(m_window);
     visitor.visit(m_layout_root);
+    visitor.visit(m_layout_boundaries_needing_layout);
     visitor.visit(m_style_sheets);
     visitor.visit(m_hovered_node);
     visitor.visit(m_inspected_node);
@@ -892,6 +895,7 @@ WebIDL::ExceptionOr<void> Document::set_title(String const& title)
 void Document::tear_down_layout_tree()
 {
     m_layout_root = nullptr;
+    m_layout_boundaries_needing_layout.clear();
     m_paintable = nullptr;
 }
 
@@ -990,12 +994,120 @@ URL::URL Document::parse_url(StringView url) const
 
 void Document::set_needs_layout()
 {
+    // NOTE: We don't know what changed, so none of the intrinsic sizes cached by earlier layouts can be trusted.
+    m_needs_to_discard_cached_intrinsic_sizes = true;
+
     if (m_needs_layout)
         return;
     m_needs_layout = true;
     schedule_layout_update();
 }
 
+void Document::set_needs_layout_of_subtree(Badge<Layout::Node>, Layout::Box* layout_boundary)
+{
+    if (m_needs_layout)
+        return;
+    if (!layout_boundary) {
+        m_needs_layout = true;
+        m_layout_boundaries_needing_layout.clear();
+    } else {
+        m_layout_boundaries_needing_layout.append(*layout_boundary);
+    }
+    schedule_layout_update();
+}
+
+// Returns the layout boundaries that need layout, or an empty Optional if the whole document has to be laid out.
+static Optional<Vector<JS::NonnullGCPtr<Layout::Box>>> layout_boundaries_to_lay_out_on_their_own(Layout::Viewport& layout_root, Vector<JS::NonnullGCPtr<Layout::Box>> const& layout_boundaries)
+{
+    Vector<JS::NonnullGCPtr<Layout::Box>> result;
+    for (auto const& layout_boundary : layout_boundaries) {
+        // NOTE: A boundary that needs layout itself may have changed size, which would affect the layout around it.
+        if (!layout_root.is_inclusive_ancestor_of(*layout_boundary) || layout_boundary->needs_layout() || !layout_boundary->is_layout_boundary())
+            return {};
+
+        bool is_nested_in_other_boundary = false;
+        for (auto const& other : layout_boundaries) {
+            if (other.ptr() != layout_boundary.ptr() && other->is_ancestor_of(*layout_boundary)) {
+                is_nested_in_other_boundary = true;
+                break;
+            }
+        }
+        if (is_nested_in_other_boundary || result.contains_slow(layout_boundary))
+            continue;
+
+        // Absolutely positioned boxes whose containing block is outside of the boundary are laid out by an ancestor.
+        bool has_escaping_out_of_flow_descendant = false;
+        layout_boundary->for_each_in_subtree_of_type<Layout::Box>([&](Layout::Box const& box) {
+            auto const* containing_block = box.containing_block();
+            if (box.is_absolutely_positioned() && (!containing_block || !layout_boundary->is_inclusive_ancestor_of(*containing_block))) {
+                has_escaping_out_of_flow_descendant = true;
+                return IterationDecision::Break;
+            }
+            return IterationDecision::Continue;
+        });
+        if (has_escaping_out_of_flow_descendant)
+            return {};
+
+        result.append(layout_boundary);
+    }
+    return result;
+}
+
+// Lays out the subtree of a layout boundary, keeping the size and position it got from the last layout.
+static void lay_out_subtree_of_layout_boundary(Layout::Viewport& layout_root, Layout::Box& layout_boundary)
+{
+    Layout::LayoutState layout_state;
+
+    {
+        Layout::BlockFormattingContext root_formatting_context(layout_state, layout_root, nullptr);
+
+        auto const& containing_block = *layout_boundary.containing_block();
+        auto const& containing_block_paintable_box = *containing_block.paintable_box();
+        auto& containing_block_state = layout_state.get_mutable(containing_block);
+        containing_block_state.set_content_width(containing_block_paintable_box.content_width());
+        containing_block_state.set_content_height(containing_block_paintable_box.content_height());
+
+        auto const& paintable_box = *layout_boundary.paintable_box();
+        auto const& box_model = layout_boundary.box_model();
+        auto& box_state = layout_state.get_mutable(layout_boundary);
+        box_state.margin_top = box_model.margin.top;
+        box_state.margin_right = box_model.margin.right;
+        box_state.margin_bottom = box_model.margin.bottom;
+        box_state.margin_left = box_model.margin.left;
+        box_state.border_top = box_model.border.top;
+        box_state.border_right = box_model.border.right;
+        box_state.border_bottom = box_model.border.bottom;
+        box_state.border_left = box_model.border.left;
+        box_state.padding_top = box_model.padding.top;
+        box_state.padding_right = box_model.padding.right;
+        box_state.padding_bottom = box_model.padding.bottom;
+        box_state.padding_left = box_model.padding.left;
+        box_state.inset_top = box_model.inset.top;
+        box_state.inset_right = box_model.inset.right;
+        box_state.inset_bottom = box_model.inset.bottom;
+        box_state.inset_left = box_model.inset.left;
+        box_state.set_content_width(paintable_box.content_width());
+        box_state.set_content_height(paintable_box.content_height());
+
+        // NOTE: The committed offset includes the relative position inset, which commit() will apply again.
+        auto offset = paintable_box.offset();
+        if (layout_boundary.computed_values().position() == CSS::Positioning::Relative)
+            offset.translate_by(-box_model.inset.left, -box_model.inset.top);
+        box_state.offset = offset;
+
+        auto formatting_context = root_formatting_context.create_independent_formatting_context_if_needed(layout_state, layout_boundary);
+        VERIFY(formatting_context);
+
+        auto available_space = Layout::AvailableSpace(
+            Layout::AvailableSize::make_definite(containing_block_state.content_width()),
+            Layout::AvailableSize::make_definite(containing_block_state.content_height()));
+        formatting_context->run(layout_boundary, Layout::LayoutMode::Normal, box_state.available_inner_space_or_constraints_from(available_space));
+        formatting_context->parent_context_did_dimension_child_root_box();
+    }
+
+    layout_state.commit(layout_boundary);
+}
+
 void Document::invalidate_layout()
 {
     tear_down_layout_tree();
@@ -1047,7 +1159,7 @@ void Document::update_layout()
 
     update_style();
 
-    if (!m_needs_layout && m_layout_root)
+    if (!m_needs_layout && m_layout_boundaries_needing_layout.is_empty() && m_layout_root)
         return;
 
     // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
@@ -1059,6 +1171,9 @@ void Document::update_layout()
 
     auto viewport_rect = this->viewport_rect();
 
+    bool needs_full_layout = m_needs_layout;
+    auto layout_boundaries = move(m_layout_boundaries_needing_layout);
+
     if (!m_layout_root) {
         Layout::TreeBuilder tree_builder;
         m_layout_root = verify_cast<Layout::Viewport>(*tree_builder.build(*this));
@@ -1066,6 +1181,33 @@ void Document::update_layout()
         if (auto* document_element = this->document_element()) {
             propagate_overflow_to_viewport(*document_element, *m_layout_root);
         }
+        needs_full_layout = true;
+    }
+
+    // OPTIMIZATION: If all the changes are contained in layout boundaries, we only lay out their subtrees.
+    if (!needs_full_layout) {
+        if (auto layout_boundaries_to_lay_out = layout_boundaries_to_lay_out_on_their_own(*m_layout_root, layout_boundaries); layout_boundaries_to_lay_out.has_value()) {
+            for (auto& layout_boundary : *layout_boundaries_to_lay_out) {
+                lay_out_subtree_of_layout_boundary(*m_layout_root, *layout_boundary);
+                layout_boundary->for_each_in_inclusive_subtree([](Layout::Node& node) {
+                    node.clear_needs_layout();
+                    return IterationDecision::Continue;
+                });
+                ++m_layout_statistics.subtree_layouts;
+            }
+            // NOTE: The stacking contexts refer to the paintables we just replaced.
+            invalidate_stacking_context_tree();
+            did_layout(*navigable);
+            return;
+        }
+    }
+
+    if (m_needs_to_discard_cached_intrinsic_sizes) {
+        m_layout_root->for_each_in_inclusive_subtree_of_type<Layout::Box>([](Layout::Box& box) {
+            box.discard_cached_intrinsic_sizes();
+            return IterationDecision::Continue;
+        });
+        m_needs_to_discard_cached_intrinsic_sizes = false;
     }
 
     Layout::LayoutState layout_state;
@@ -1094,13 +1236,24 @@ void Document::update_layout()
 
     layout_state.commit(*m_layout_root);
 
+    m_layout_root->for_each_in_inclusive_subtree([](Layout::Node& node) {
+        node.clear_needs_layout();
+        return IterationDecision::Continue;
+    });
+    ++m_layout_statistics.full_layouts;
+
+    did_layout(*navigable);
+}
+
+void Document::did_layout(HTML::Navigable& navigable)
+{
     // Broadcast the current viewport rect to any new paintables, so they know whether they're visible or not.
     inform_all_viewport_clients_about_the_current_viewport_rect();
 
-    navigable->set_needs_display();
+    navigable.set_needs_display();
     set_needs_to_resolve_paint_only_properties();
 
-    if (navigable->is_traversable()) {
+    if (navigable.is_traversable()) {
         // NOTE: The assignment of scroll frames only needs to occur for traversables because they take care of all
         //       nested navigable documents.
         paintable()->assign_scroll_frames();
@@ -1114,7 +1267,7 @@ void Document::update_layout()
     m_needs_layout = false;
 }
 
-[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer)
+[[nodiscard]] static CSS::RequiredInvalidationAfterStyleChange update_style_recursively(Node& node, CSS::StyleComputer& style_computer, bool needs_inherited_style_update, size_t& restyled_element_count)
 {
     bool const needs_full_style_update = node.document().needs_full_style_update();
     CSS::RequiredInvalidationAfterStyleChange invalidation;
@@ -1127,17 +1280,29 @@ void Document::update_layout()
     //       We will still recompute style for the children, though.
     bool is_display_none = false;
 
+    // NOTE: When the style of an element changes, its children have to be restyled as well, since they may inherit from it.
+    //       Nodes without a style of their own (documents and shadow roots) pass on whatever their parent asked for.
+    bool children_need_inherited_style_update = needs_inherited_style_update;
+
     if (is<Element>(node)) {
-        invalidation |= static_cast<Element&>(node).recompute_style();
-        is_display_none = static_cast<Element&>(node).computed_css_values()->display().is_none();
+        auto& element = static_cast<Element&>(node);
+        children_need_inherited_style_update = false;
+        // OPTIMIZATION: Elements that are only on the path to a descendant that needs a style update keep their style.
+        if (needs_full_style_update || needs_inherited_style_update || element.needs_style_update() || !element.computed_css_values()) {
+            auto element_invalidation = element.recompute_style();
+            ++restyled_element_count;
+            children_need_inherited_style_update = !element_invalidation.is_none();
+            invalidation |= element_invalidation;
+        }
+        is_display_none = element.computed_css_values()->display().is_none();
     }
     node.set_needs_style_update(false);
 
-    if (needs_full_style_update || node.child_needs_style_update()) {
+    if (needs_full_style_update || children_need_inherited_style_update || node.child_needs_style_update()) {
         if (node.is_element()) {
             if (auto* shadow_root = static_cast<DOM::Element&>(node).shadow_root_internal()) {
-                if (needs_full_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update()) {
-                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer);
+                if (needs_full_style_update || children_need_inherited_style_update || shadow_root->needs_style_update() || shadow_root->child_needs_style_update()) {
+                    auto subtree_invalidation = update_style_recursively(*shadow_root, style_computer, children_need_inherited_style_update, restyled_element_count);
                     if (!is_display_none)
                         invalidation |= subtree_invalidation;
                 }
@@ -1145,8 +1310,8 @@ void Document::update_layout()
         }
 
         node.for_each_child([&](auto& child) {
-            if (needs_full_style_update || child.needs_style_update() || child.child_needs_style_update()) {
-                auto subtree_invalidation = update_style_recursively(child, style_computer);
+            if (needs_full_style_update || children_need_inherited_style_update || child.needs_style_update() || child.child_needs_style_update()) {
+                auto subtree_invalidation = update_style_recursively(child, style_computer, children_need_inherited_style_update, restyled_element_count);
                 if (!is_display_none)
                     invalidation |= subtree_invalidation;
             }
@@ -1187,12 +1352,14 @@ void Document::update_style()
 
     style_computer().reset_ancestor_filter();
 
-    auto invalidation = update_style_recursively(*this, style_computer());
+    m_restyled_element_count_in_last_style_update = 0;
+    style_computer().begin_style_sharing();
+    auto invalidation = update_style_recursively(*this, style_computer(), false, m_restyled_element_count_in_last_style_update);
+    style_computer().end_style_sharing();
+    // NOTE: Elements whose style change requires relayout have already marked their layout nodes as needing layout.
     if (invalidation.rebuild_layout_tree) {
         invalidate_layout();
     } else {
-        if (invalidation.relayout)
-            set_needs_layout();
         if (invalidation.rebuild_stacking_context_tree)
             invalidate_stacking_context_tree();
     }
@@ -1731,6 +1898,30 @@ Vector<JS::Handle<HTML::HTMLScriptElement>> Document::take_scripts_to_execute_in
     return handles;
 }
 
+void Document::record_script_timing(ScriptTiming timing)
+{
+    if (m_script_timings.size() == max_script_timings) {
+        m_script_timings.remove(0);
+        ++m_dropped_script_timing_count;
+    }
+    m_script_timings.append(move(timing));
+}
+
+void Document::dump_script_timings() const
+{
+    Duration total_parse_duration;
+    Duration total_run_duration;
+    dbgln("Script timings for {} ({} script(s))", url(), m_script_timings.size());
+    if (m_dropped_script_timing_count > 0)
+        dbgln("  ({} earlier script(s) not shown)", m_dropped_script_timing_count);
+    for (auto const& timing : m_script_timings) {
+        dbgln("  {}: parsed in {}ms, ran in {}ms", timing.filename, timing.parse_duration.to_milliseconds(), timing.run_duration.to_milliseconds());
+        total_parse_duration += timing.parse_duration;
+        total_run_duration += timing.run_duration;
+    }
+    dbgln("  Total: parsed in {}ms, ran in {}ms", total_parse_duration.to_milliseconds(), total_run_duration.to_milliseconds());
+}
+
 // https://dom.spec.whatwg.org/#dom-document-importnode
 WebIDL::ExceptionOr<JS::NonnullGCPtr<Node>> Document::import_node(JS::NonnullGCPtr<Node> node, bool deep)
 {
@@ -1849,17 +2040,29 @@ void Document::set_focused_element(Element* element)
     if (m_focused_element.ptr() == element)
         return;
 
-    if (m_focused_element) {
+    if (m_focused_element)
         m_focused_element->did_lose_focus();
-        m_focused_element->set_needs_style_update(true);
-    }
 
+    JS::GCPtr<Element> old_focused_element = move(m_focused_element);
     m_focused_element = element;
 
-    if (m_focused_element) {
+    if (m_focused_element)
         m_focused_element->did_receive_focus();
-        m_focused_element->set_needs_style_update(true);
-    }
+
+    // NOTE: :focus-within matches the inclusive ancestors of the focused element, so their style changes along with it.
+    //       From the common ancestor of the old and the new focused element upwards, nothing changes, unless the
+    //       common ancestor is one of the two elements and therefore gains or loses :focus.
+    auto* common_ancestor = find_common_ancestor(old_focused_element, m_focused_element);
+    auto invalidate_style_of_inclusive_ancestors = [&](Node* node) {
+        for (; node && node != common_ancestor; node = node->parent_or_shadow_host()) {
+            if (node->is_element())
+                node->set_needs_style_update(true);
+        }
+    };
+    invalidate_style_of_inclusive_ancestors(old_focused_element);
+    invalidate_style_of_inclusive_ancestors(m_focused_element);
+    if (common_ancestor && (common_ancestor == old_focused_element || common_ancestor == m_focused_element))
+        common_ancestor->set_needs_style_update(true);
 
     if (paintable())
         paintable()->set_needs_display();
@@ -2234,6 +2437,34 @@ bool Document::is_completely_loaded() const
 }
 
 // https://html.spec.whatwg.org/multipage/browsing-the-web.html#completely-finish-loading
+Document::SpeculativeLoadStatistics Document::speculative_load_statistics() const
+{
+    auto statistics = m_speculative_load_statistics;
+    for (auto const& speculative_load : m_speculative_loads) {
+        ++statistics.loads;
+        if (speculative_load->was_used())
+            ++statistics.hits;
+    }
+    return statistics;
+}
+
+void Document::did_start_speculative_load(Badge<HTML::SpeculativeHTMLParser>, NonnullRefPtr<SpeculativeLoad> speculative_load)
+{
+    m_speculative_loads.append(move(speculative_load));
+}
+
+void Document::discard_unused_speculative_loads()
+{
+    for (auto& speculative_load : m_speculative_loads) {
+        ++m_speculative_load_statistics.loads;
+        if (speculative_load->was_used())
+            ++m_speculative_load_statistics.hits;
+        else
+            ResourceLoader::the().discard_speculative_load(*speculative_load);
+    }
+    m_speculative_loads.clear();
+}
+
 void Document::completely_finish_loading()
 {
     if (!navigable())
@@ -2773,6 +3004,11 @@ void Document::invalidate_stacking_context_tree()
 {
     if (auto* paintable_box = this->paintable_box())
         paintable_box->invalidate_stacking_context();
+
+    // NOTE: Changes to the stacking context tree (e.g. transforms or z-index) move things around in ways that
+    //       damage rects can't describe, so the whole viewport has to be repainted.
+    if (auto navigable = this->navigable())
+        navigable->set_needs_display();
 }
 
 void Document::check_favicon_after_loading_link_resource()
@@ -12,6 +12,7 @@
 #include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <AK/WeakPtr.h>
 #include <LibCore/DateTime.h>
@@ -229,6 +230,16 @@ public:
 
     void set_needs_layout();
 
+    // Called by layout nodes that need layout. Unlike set_needs_layout(), this keeps the intrinsic sizes cached by
+    // earlier layouts, and only lays out the subtree of the given layout boundary if there is one.
+    void set_needs_layout_of_subtree(Badge<Layout::Node>, Layout::Box* layout_boundary);
+
+    struct LayoutStatistics {
+        u64 full_layouts { 0 };
+        u64 subtree_layouts { 0 };
+    };
+    LayoutStatistics const& layout_statistics() const { return m_layout_statistics; }
+
     void invalidate_layout();
     void invalidate_stacking_context_tree();
 
@@ -295,6 +306,17 @@ public:
     Vector<JS::Handle<HTML::HTMLScriptElement>> take_scripts_to_execute_in_order_as_soon_as_possible(Badge<HTML::HTMLParser>);
     Vector<JS::NonnullGCPtr<HTML::HTMLScriptElement>>& scripts_to_execute_in_order_as_soon_as_possible() { return m_scripts_to_execute_in_order_as_soon_as_possible; }
 
+    // How long each script of this document took to parse and run, shown by the "Dump Script Timings" debug action.
+    // NOTE: Only the most recent scripts are kept, so pages that keep running scripts don't grow this forever.
+    static constexpr size_t max_script_timings = 256;
+    struct ScriptTiming {
+        ByteString filename;
+        Duration parse_duration;
+        Duration run_duration;
+    };
+    void record_script_timing(ScriptTiming);
+    void dump_script_timings() const;
+
     QuirksMode mode() const { return m_quirks_mode; }
     bool in_quirks_mode() const { return m_quirks_mode == QuirksMode::Yes; }
     void set_quirks_mode(QuirksMode mode) { m_quirks_mode = mode; }
@@ -467,6 +489,8 @@ public:
     bool needs_full_style_update() const { return m_needs_full_style_update; }
     void set_needs_full_style_update(bool b) { m_needs_full_style_update = b; }
 
+    size_t restyled_element_count_in_last_style_update() const { return m_restyled_element_count_in_last_style_update; }
+
     bool has_active_favicon() const { return m_active_favicon; }
     void check_favicon_after_loading_link_resource();
 
@@ -532,6 +556,16 @@ public:
     DocumentLoadTimingInfo const& load_timing_info() const { return m_load_timing_info; }
     void set_load_timing_info(DocumentLoadTimingInfo const& load_timing_info) { m_load_timing_info = load_timing_info; }
 
+    // Subresources that the speculative HTML parser started loading for this document, and how many of them were
+    // actually used by a regular load.
+    struct SpeculativeLoadStatistics {
+        u64 loads { 0 };
+        u64 hits { 0 };
+    };
+    SpeculativeLoadStatistics speculative_load_statistics() const;
+    void did_start_speculative_load(Badge<HTML::SpeculativeHTMLParser>, NonnullRefPtr<SpeculativeLoad>);
+    void discard_unused_speculative_loads();
+
     // https://html.spec.whatwg.org/multipage/dom.html#previous-document-unload-timing
     DocumentUnloadTimingInfo& previous_document_unload_timing() { return m_previous_document_unload_timing; }
     DocumentUnloadTimingInfo const& previous_document_unload_timing() const { return m_previous_document_unload_timing; }
@@ -667,6 +701,7 @@ private:
     virtual JS::GCPtr<EventTarget> global_event_handlers_to_event_target(FlyString const&) final { return *this; }
 
     void tear_down_layout_tree();
+    void did_layout(HTML::Navigable&);
 
     void run_unloading_cleanup_steps();
 
@@ -714,6 +749,9 @@ private:
     // https://html.spec.whatwg.org/multipage/scripting.html#set-of-scripts-that-will-execute-as-soon-as-possible
     Vector<JS::NonnullGCPtr<HTML::HTMLScriptElement>> m_scripts_to_execute_as_soon_as_possible;
 
+    Vector<ScriptTiming> m_script_timings;
+    size_t m_dropped_script_timing_count { 0 };
+
     QuirksMode m_quirks_mode { QuirksMode::No };
 
     // https://dom.spec.whatwg.org/#concept-document-type
@@ -776,8 +814,12 @@ private:
     Vector<WeakPtr<CSS::MediaQueryList>> m_media_query_lists;
 
     bool m_needs_layout { false };
+    bool m_needs_to_discard_cached_intrinsic_sizes { false };
+    Vector<JS::NonnullGCPtr<Layout::Box>> m_layout_boundaries_needing_layout;
+    LayoutStatistics m_layout_statistics;
 
     bool m_needs_full_style_update { false };
+    size_t m_restyled_element_count_in_last_style_update { 0 };
 
     bool m_needs_animated_style_update { false };
 
@@ -827,6 +869,10 @@ private:
     // https://html.spec.whatwg.org/multipage/dom.html#load-timing-info
     DocumentLoadTimingInfo m_load_timing_info;
 
+    Vector<NonnullRefPtr<SpeculativeLoad>> m_speculative_loads;
+    // Statistics for the speculative loads that were already discarded.
+    SpeculativeLoadStatistics m_speculative_load_statistics;
+
     // https://html.spec.whatwg.org/multipage/dom.html#previous-document-unload-timing
     DocumentUnloadTimingInfo m_previous_document_unload_timing;
 
@@ -12,6 +12,7 @@
 #include <LibWeb/Bindings/ElementPrototype.h>
 #include <LibWeb/Bindings/ExceptionOrUtils.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
+#include <LibWeb/CSS/InvalidationSet.h>
 #include <LibWeb/CSS/Parser/Parser.h>
 #include <LibWeb/CSS/PropertyID.h>
 #include <LibWeb/CSS/ResolvedCSSStyleDeclaration.h>
@@ -47,6 +48,8 @@
 #include <LibWeb/HTML/HTMLSelectElement.h>
 #include <LibWeb/HTML/HTMLStyleElement.h>
 #include <LibWeb/HTML/HTMLTableElement.h>
+#include <LibWeb/HTML/HTMLTableRowElement.h>
+#include <LibWeb/HTML/HTMLTableSectionElement.h>
 #include <LibWeb/HTML/HTMLTextAreaElement.h>
 #include <LibWeb/HTML/Numbers.h>
 #include <LibWeb/HTML/Parser/HTMLParser.h>
@@ -445,7 +448,7 @@ void Element::run_attribute_change_steps(FlyString const& local_name, Optional<S
 
     // AD-HOC: Run our own internal attribute change handler.
     attribute_changed(local_name, value);
-    invalidate_style_after_attribute_change(local_name);
+    invalidate_style_after_attribute_change(local_name, old_value);
 
     document().bump_dom_tree_version();
 }
@@ -522,13 +525,32 @@ static CSS::RequiredInvalidationAfterStyleChange compute_required_invalidation(C
     return invalidation;
 }
 
+static bool custom_properties_are_identical(HashMap<FlyString, CSS::StyleProperty> const& a, HashMap<FlyString, CSS::StyleProperty> const& b)
+{
+    if (a.size() != b.size())
+        return false;
+    for (auto const& it : a) {
+        auto other = b.get(it.key);
+        if (!other.has_value() || other->value.ptr() != it.value.value.ptr() || other->important != it.value.important)
+            return false;
+    }
+    return true;
+}
+
 CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
 {
     set_needs_style_update(false);
     VERIFY(parent());
 
+    // NOTE: Custom properties are looked up through the ancestors when resolving var(), so any change to them
+    //       has to restyle the whole subtree. Most elements have none, which makes this copy cheap.
+    auto old_custom_properties = custom_properties({});
+
     auto new_computed_css_values = document().style_computer().compute_style(*this);
 
+    if (!custom_properties_are_identical(old_custom_properties, custom_properties({})))
+        invalidate_style();
+
     // Tables must not inherit -libweb-* values for text-align.
     // FIXME: Find the spec for this.
     if (is<HTML::HTMLTableElement>(*this)) {
@@ -546,6 +568,11 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (invalidation.is_none())
         return invalidation;
 
+    // NOTE: Font-relative lengths like rem are resolved against the root element, so its descendants
+    //       have to be restyled even when they don't inherit anything from it.
+    if (m_computed_css_values && document().document_element() == this)
+        invalidate_style();
+
     m_computed_css_values = move(new_computed_css_values);
     computed_css_values_changed();
 
@@ -555,6 +582,8 @@ CSS::RequiredInvalidationAfterStyleChange Element::recompute_style()
     if (!invalidation.rebuild_layout_tree && layout_node()) {
         // If we're keeping the layout tree, we can just apply the new style to the existing layout tree.
         layout_node()->apply_style(*m_computed_css_values);
+        if (invalidation.relayout)
+            layout_node()->set_needs_layout();
         if (invalidation.repaint && paintable())
             paintable()->set_needs_display();
     }
@@ -1766,13 +1795,107 @@ ErrorOr<void> Element::scroll_into_view(Optional<Variant<bool, ScrollIntoViewOpt
     // FIXME: 8. Optionally perform some other action that brings the element to the user’s attention.
 }
 
-void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name)
+// Attributes that can change which pseudo-classes match this element or its descendants.
+static bool attribute_affects_pseudo_class_state(FlyString const& attribute_name)
+{
+    return attribute_name.is_one_of(
+        HTML::AttributeNames::checked,
+        HTML::AttributeNames::contenteditable,
+        HTML::AttributeNames::dir,
+        HTML::AttributeNames::disabled,
+        HTML::AttributeNames::href,
+        HTML::AttributeNames::lang,
+        HTML::AttributeNames::multiple,
+        HTML::AttributeNames::open,
+        HTML::AttributeNames::placeholder,
+        HTML::AttributeNames::readonly,
+        HTML::AttributeNames::required,
+        HTML::AttributeNames::selected,
+        HTML::AttributeNames::type,
+        HTML::AttributeNames::value);
+}
+
+static void invalidate_style_of_matching_descendants(ParentNode& root, CSS::InvalidationSet const& invalidation_set)
+{
+    root.for_each_in_subtree_of_type<Element>([&](Element& element) {
+        if (invalidation_set.matches_descendant(element))
+            element.set_needs_style_update(true);
+        if (auto* shadow_root = element.shadow_root_internal())
+            invalidate_style_of_matching_descendants(*shadow_root, invalidation_set);
+        return IterationDecision::Continue;
+    });
+}
+
+void Element::invalidate_style_after_attribute_change(FlyString const& attribute_name, Optional<String> const& old_value)
 {
-    // FIXME: Only invalidate if the attribute can actually affect style.
-    (void)attribute_name;
+    // NOTE: If the whole document is going to be restyled anyway, there's nothing to narrow down.
+    if (document().needs_full_style_update())
+        return;
 
+    // NOTE: Classes and ids match case-insensitively in quirks mode, which the invalidation sets don't account for.
     // FIXME: This will need to become smarter when we implement the :has() selector.
-    invalidate_style();
+    if (document().in_quirks_mode() || attribute_affects_pseudo_class_state(attribute_name)) {
+        invalidate_style();
+        return;
+    }
+
+    // NOTE: The presentational hints of these elements are inherited by (or applied to) their descendants.
+    if (is<HTML::HTMLTableElement>(*this) || is<HTML::HTMLTableSectionElement>(*this) || is<HTML::HTMLTableRowElement>(*this)
+        || is<HTML::HTMLBodyElement>(*this) || is<HTML::HTMLHtmlElement>(*this)) {
+        if (attribute_name != HTML::AttributeNames::class_ && attribute_name != HTML::AttributeNames::id) {
+            invalidate_style();
+            return;
+        }
+    }
+
+    auto& style_computer = document().style_computer();
+
+    CSS::InvalidationSet invalidation_set;
+
+    // NOTE: Any attribute may be a presentational hint, so this element is always restyled.
+    invalidation_set.invalidate_self = true;
+    style_computer.collect_invalidation_set_for_attribute(attribute_name, invalidation_set);
+
+    if (attribute_name == HTML::AttributeNames::class_) {
+        // Only the classes that were added or removed matter.
+        auto old_classes = old_value.value_or(String {}).bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace);
+        for (auto const& old_class : old_classes) {
+            auto old_class_name = MUST(FlyString::from_utf8(old_class));
+            if (!m_classes.contains_slow(old_class_name))
+                style_computer.collect_invalidation_set_for_class(old_class_name, invalidation_set);
+        }
+        for (auto const& new_class_name : m_classes) {
+            if (!old_classes.contains_slow(new_class_name.bytes_as_string_view()))
+                style_computer.collect_invalidation_set_for_class(new_class_name, invalidation_set);
+        }
+    } else if (attribute_name == HTML::AttributeNames::id) {
+        if (old_value.has_value())
+            style_computer.collect_invalidation_set_for_id(MUST(FlyString::from_utf8(old_value->bytes_as_string_view())), invalidation_set);
+        if (m_id.has_value())
+            style_computer.collect_invalidation_set_for_id(*m_id, invalidation_set);
+    }
+
+    if (invalidation_set.invalidate_whole_subtree) {
+        invalidate_style();
+        return;
+    }
+
+    if (invalidation_set.invalidate_siblings) {
+        if (auto* parent = parent_or_shadow_host())
+            parent->invalidate_style();
+        else
+            invalidate_style();
+        return;
+    }
+
+    if (invalidation_set.invalidate_self)
+        set_needs_style_update(true);
+
+    if (invalidation_set.has_descendant_features()) {
+        invalidate_style_of_matching_descendants(*this, invalidation_set);
+        if (auto* shadow_root = shadow_root_internal())
+            invalidate_style_of_matching_descendants(*shadow_root, invalidation_set);
+    }
 }
 
 // https://www.w3.org/TR/wai-aria-1.2/#tree_exclusion
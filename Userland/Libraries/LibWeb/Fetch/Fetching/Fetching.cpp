@@ -1737,6 +1737,8 @@ WebIDL::ExceptionOr<JS::NonnullGCPtr<PendingResponse>> nonstandard_resource_load
     LoadRequest load_request;
     load_request.set_url(request->current_url());
     load_request.set_page(page);
+    if (auto client = request->client(); client && is<HTML::Window>(client->global_object()))
+        load_request.set_document(static_cast<HTML::Window&>(client->global_object()).associated_document());
     load_request.set_method(ByteString::copy(request->method()));
     for (auto const& header : *request->header_list())
         load_request.set_header(ByteString::copy(header.name), ByteString::copy(header.value));
@@ -19,6 +19,7 @@ class PageClient;
 class PaintContext;
 class Resource;
 class ResourceLoader;
+class SpeculativeLoad;
 class XMLDocumentBuilder;
 }
 
@@ -203,6 +204,7 @@ enum class PropertyID;
 enum class ValueID;
 
 struct BackgroundLayerData;
+struct InvalidationSet;
 }
 
 namespace Web::CSS::Parser {
@@ -451,6 +453,7 @@ class PluginArray;
 class PromiseRejectionEvent;
 class SelectedFile;
 class SharedImageRequest;
+class SpeculativeHTMLParser;
 class Storage;
 class SubmitEvent;
 class TextMetrics;
@@ -555,6 +558,7 @@ namespace Web::Painting {
 class AudioPaintable;
 class ButtonPaintable;
 class CheckBoxPaintable;
+class CommandList;
 class LabelablePaintable;
 class MediaPaintable;
 class Paintable;
@@ -562,6 +566,7 @@ class PaintableBox;
 class PaintableWithLines;
 class StackingContext;
 class TextPaintable;
+class TiledRasterizer;
 class VideoPaintable;
 class ViewportPaintable;
 
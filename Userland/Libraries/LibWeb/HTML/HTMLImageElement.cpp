@@ -610,7 +610,10 @@ void HTMLImageElement::add_callbacks_to_image_request(JS::NonnullGCPtr<ImageRequ
                     dispatch_event(DOM::Event::create(realm(), HTML::EventNames::load));
 
                 set_needs_style_update(true);
-                document().set_needs_layout();
+                if (auto* layout_node = this->layout_node())
+                    layout_node->set_needs_layout();
+                else
+                    document().set_needs_layout();
 
                 if (image_data->is_animated() && image_data->frame_count() > 1) {
                     m_current_frame_index = 0;
@@ -745,7 +748,10 @@ void HTMLImageElement::react_to_changes_in_the_environment()
             image_request->prepare_for_presentation(*this);
             // FIXME: This is ad-hoc, updating the layout here should probably be handled by prepare_for_presentation().
             set_needs_style_update(true);
-            document().set_needs_layout();
+            if (auto* layout_node = this->layout_node())
+                layout_node->set_needs_layout();
+            else
+                document().set_needs_layout();
 
             // 7. Fire an event named load at the img element.
             dispatch_event(DOM::Event::create(realm(), HTML::EventNames::load));
@@ -118,6 +118,7 @@ void Navigable::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_current_session_history_entry);
     visitor.visit(m_active_session_history_entry);
     visitor.visit(m_container);
+    visitor.visit(m_damaged_paintables);
 }
 
 void Navigable::set_delaying_load_events(bool value)
@@ -1992,6 +1993,7 @@ void Navigable::set_viewport_rect(CSSPixelRect const& rect)
             document->set_needs_layout();
         }
         did_change = true;
+        add_full_damage();
         m_needs_repaint = true;
     }
 
@@ -1999,6 +2001,7 @@ void Navigable::set_viewport_rect(CSSPixelRect const& rect)
         m_viewport_scroll_offset = rect.location();
         scroll_offset_did_change();
         did_change = true;
+        add_full_damage();
         m_needs_repaint = true;
     }
 
@@ -2042,14 +2045,89 @@ void Navigable::set_size(CSSPixelSize size)
 
 void Navigable::set_needs_display()
 {
-    set_needs_display(viewport_rect());
+    add_full_damage();
+    schedule_repaint();
 }
 
-void Navigable::set_needs_display(CSSPixelRect const&)
+void Navigable::set_needs_display(CSSPixelRect const& rect)
 {
-    // FIXME: Ignore updates outside the visible viewport rect.
-    //        This requires accounting for fixed-position elements in the input rect, which we don't do yet.
+    add_damage(rect);
+    schedule_repaint();
+}
+
+void Navigable::set_needs_display(Painting::Paintable const& paintable)
+{
+    auto rect = paintable.absolute_damage_rect();
+    if (!rect.has_value()) {
+        set_needs_display();
+        return;
+    }
+    if (is_traversable() && !m_has_full_damage)
+        m_damaged_paintables.append(paintable);
+    set_needs_display(*rect);
+}
+
+void Navigable::add_damage(CSSPixelRect const& rect)
+{
+    if (!is_traversable() || m_has_full_damage || rect.is_empty())
+        return;
 
+    for (auto& damage_rect : m_damage_rects) {
+        if (damage_rect.intersects(rect)) {
+            damage_rect = damage_rect.united(rect);
+            return;
+        }
+    }
+
+    if (m_damage_rects.size() < max_damage_rect_count) {
+        m_damage_rects.append(rect);
+        return;
+    }
+
+    // NOTE: Lots of scattered damage gets merged into a single rect, as repainting every piece separately
+    //       would cost more than repainting the area between them.
+    auto bounding_rect = rect;
+    for (auto const& damage_rect : m_damage_rects)
+        bounding_rect = bounding_rect.united(damage_rect);
+    m_damage_rects.clear_with_capacity();
+    m_damage_rects.append(bounding_rect);
+}
+
+void Navigable::add_full_damage()
+{
+    m_has_full_damage = true;
+    m_damage_rects.clear();
+    m_damaged_paintables.clear();
+}
+
+Optional<Vector<CSSPixelRect>> Navigable::take_damage()
+{
+    auto damaged_paintables = move(m_damaged_paintables);
+    for (auto const& paintable : damaged_paintables) {
+        auto rect = paintable->absolute_damage_rect();
+        if (!rect.has_value()) {
+            add_full_damage();
+            break;
+        }
+        add_damage(*rect);
+    }
+
+    if (exchange(m_has_full_damage, false))
+        return {};
+
+    auto viewport_rect = this->viewport_rect();
+    Vector<CSSPixelRect> damage;
+    for (auto rect : m_damage_rects) {
+        rect.intersect(viewport_rect);
+        if (!rect.is_empty())
+            damage.append(rect.translated(-viewport_rect.location()));
+    }
+    m_damage_rects.clear_with_capacity();
+    return damage;
+}
+
+void Navigable::schedule_repaint()
+{
     m_needs_repaint = true;
 
     if (is<TraversableNavigable>(*this)) {
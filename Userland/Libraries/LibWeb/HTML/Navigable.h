@@ -166,6 +166,12 @@ public:
 
     void set_needs_display();
     void set_needs_display(CSSPixelRect const&);
+    void set_needs_display(Painting::Paintable const&);
+
+    // Returns the parts of the viewport (in CSS pixels relative to the viewport) that changed since the damage was
+    // last taken, or an empty Optional if all of it has to be repainted.
+    // NOTE: Damage is only tracked for traversables, as nested navigables damage their container instead.
+    Optional<Vector<CSSPixelRect>> take_damage();
 
     void set_is_popup(TokenizedFeature::Popup is_popup) { m_is_popup = is_popup; }
 
@@ -197,6 +203,10 @@ protected:
 private:
     void scroll_offset_did_change();
 
+    void add_damage(CSSPixelRect const&);
+    void add_full_damage();
+    void schedule_repaint();
+
     void inform_the_navigation_api_about_aborting_navigation();
 
     // https://html.spec.whatwg.org/multipage/document-sequences.html#nav-id
@@ -226,6 +236,14 @@ private:
     CSSPixelPoint m_viewport_scroll_offset;
 
     bool m_needs_repaint { false };
+
+    static constexpr size_t max_damage_rect_count = 8;
+    Vector<CSSPixelRect> m_damage_rects;
+    bool m_has_full_damage { true };
+
+    // NOTE: The area a paintable paints into may change once its paint-only properties are resolved,
+    //       so the damage rects of these paintables are computed once more when the damage is taken.
+    Vector<JS::NonnullGCPtr<Painting::Paintable const>> m_damaged_paintables;
 };
 
 HashTable<Navigable*>& all_navigables();
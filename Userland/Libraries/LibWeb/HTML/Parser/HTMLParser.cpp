@@ -259,7 +259,8 @@ void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTM
     if (parser && parser->m_parsing_fragment)
         return;
 
-    // FIXME: 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    // 1. If the active speculative HTML parser is not null, then stop the speculative HTML parser and return.
+    // NOTE: Our speculative HTML parser runs to completion as soon as it's started, so it's never active here.
 
     // 2. Set the insertion point to undefined.
     if (parser)
@@ -357,6 +358,10 @@ void HTMLParser::the_end(JS::NonnullGCPtr<DOM::Document> document, JS::GCPtr<HTM
         // 12. Completely finish loading the Document.
         document->completely_finish_loading();
 
+        // NOTE: Everything that delays the load event has been loaded by now, so whatever the speculative HTML parser
+        //       preloaded that wasn't used yet most likely won't be. Don't let it linger in the resource loader.
+        document->discard_unused_speculative_loads();
+
         // FIXME: 13. Queue the navigation timing entry for the Document.
     }));
 
@@ -2826,7 +2831,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     // 2. Set the pending parsing-blocking script to null.
                     auto the_script = document().take_pending_parsing_blocking_script({});
 
-                    // FIXME: 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    // 3. Start the speculative HTML parser for this instance of the HTML parser.
+                    m_speculative_parser.start(*m_document, m_tokenizer, m_scripting_enabled);
 
                     // 4. Block the tokenizer for this instance of the HTML parser, such that the event loop will not run tasks that invoke the tokenizer.
                     m_tokenizer.set_blocked(true);
@@ -2845,7 +2851,8 @@ void HTMLParser::handle_text(HTMLToken& token)
                     if (m_aborted)
                         return;
 
-                    // FIXME: 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // 7. Stop the speculative HTML parser for this instance of the HTML parser.
+                    // NOTE: The speculative HTML parser has already finished, see SpeculativeHTMLParser::start().
 
                     // 8. Unblock the tokenizer for this instance of the HTML parser, such that tasks that invoke the tokenizer can again be run.
                     m_tokenizer.set_blocked(false);
@@ -4752,7 +4759,9 @@ void HTMLParser::abort()
     // 1. Throw away any pending content in the input stream, and discard any future content that would have been added to it.
     m_tokenizer.abort();
 
-    // FIXME: 2. Stop the speculative HTML parser for this HTML parser.
+    // 2. Stop the speculative HTML parser for this HTML parser.
+    // NOTE: There's nothing to stop, but nothing it preloaded is going to be used anymore either.
+    m_document->discard_unused_speculative_loads();
 
     // 3. Update the current document readiness to "interactive".
     m_document->update_readiness(DocumentReadyState::Interactive);
@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BuiltinWrappers.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
 #include <AK/GenericShorthands.h>
+#include <AK/SIMDExtras.h>
 #include <AK/SourceLocation.h>
 #include <LibTextCodec/Decoder.h>
 #include <LibWeb/HTML/Parser/Entities.h>
@@ -245,6 +247,107 @@ Optional<u32> HTMLTokenizer::peek_code_point(size_t offset) const
     return *it;
 }
 
+// Character tokens for runs of text are queued up all at once, so this keeps the queue from growing too large.
+// NOTE: The limit is in bytes, which also bounds the number of code points (and thus character tokens) in a run.
+static constexpr size_t max_character_run_length_in_bytes = 256;
+
+// Returns the length of the longest prefix of the input that contains neither of the given ASCII characters, nor a
+// NULL or CARRIAGE RETURN, which every state has to treat specially.
+static size_t length_of_run_without(StringView input, char first_stop_character, char second_stop_character)
+{
+    auto const* bytes = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
+    auto first = static_cast<u8>(first_stop_character);
+    auto second = static_cast<u8>(second_stop_character);
+    size_t offset = 0;
+
+    // OPTIMIZATION: Compare 16 bytes at a time. All bytes of a multi-byte UTF-8 sequence have the high bit set, so an
+    //               ASCII character can't be found in the middle of one.
+    using AK::SIMD::u8x16;
+    for (; offset + sizeof(u8x16) <= input.length(); offset += sizeof(u8x16)) {
+        u8x16 chunk;
+        __builtin_memcpy(&chunk, bytes + offset, sizeof(chunk));
+        auto stop_characters = (chunk == first) | (chunk == second) | (chunk == 0) | (chunk == '\r');
+        if (auto mask = AK::SIMD::maskbits(static_cast<AK::SIMD::i8x16>(stop_characters)); mask != 0)
+            return offset + count_trailing_zeroes(mask);
+    }
+
+    for (; offset < input.length(); ++offset) {
+        auto byte = bytes[offset];
+        if (byte == first || byte == second || byte == 0 || byte == '\r')
+            break;
+    }
+    return offset;
+}
+
+StringView HTMLTokenizer::consume_run_of_characters_without(char first_stop_character, char second_stop_character, size_t max_length_in_bytes)
+{
+    // NOTE: The run must not extend past the insertion point, where tokenization may have to stop.
+    if (m_insertion_point.defined)
+        return {};
+
+    auto offset = m_utf8_view.byte_offset_of(m_utf8_iterator);
+    auto input = m_decoded_input.substring_view(offset);
+    auto length = length_of_run_without(input.substring_view(0, min(input.length(), max_length_in_bytes)), first_stop_character, second_stop_character);
+
+    // Don't cut a multi-byte code point in half if the run was cut short.
+    while (length > 0 && length < input.length() && (static_cast<u8>(input[length]) & 0xc0) == 0x80)
+        --length;
+    if (length == 0)
+        return {};
+
+    auto last_code_point_offset = length - 1;
+    while (last_code_point_offset > 0 && (static_cast<u8>(input[last_code_point_offset]) & 0xc0) == 0x80)
+        --last_code_point_offset;
+
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset + last_code_point_offset);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(offset + length);
+    return input.substring_view(0, length);
+}
+
+void HTMLTokenizer::advance_source_position_past(StringView run)
+{
+    if (run.is_empty() || m_source_positions.is_empty())
+        return;
+
+    auto position = m_source_positions.last();
+    for (auto byte : run.bytes()) {
+        if (byte == '\n') {
+            position.column = 0;
+            position.line++;
+        } else if ((byte & 0xc0) != 0x80) {
+            position.column++;
+        }
+    }
+    position.byte_offset += run.length();
+    m_source_positions.append(position);
+}
+
+void HTMLTokenizer::queue_character_tokens_for(StringView run)
+{
+    if (run.is_empty())
+        return;
+
+    // NOTE: Every character token starts where it would have if the run had been consumed one character at a time.
+    auto position = m_source_positions.is_empty() ? HTMLToken::Position {} : m_source_positions.last();
+    Utf8View view { run };
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        auto code_point = *it;
+        if (code_point == '\n') {
+            position.column = 0;
+            position.line++;
+        } else {
+            position.column++;
+        }
+        position.byte_offset += it.underlying_code_point_length_in_bytes();
+
+        auto token = HTMLToken::make_character(code_point);
+        token.set_start_position({}, position);
+        m_queued_tokens.enqueue(move(token));
+    }
+    if (!m_source_positions.is_empty())
+        m_source_positions.append(position);
+}
+
 HTMLToken::Position HTMLTokenizer::nth_last_position(size_t n)
 {
     if (n + 1 > m_source_positions.size()) {
@@ -297,7 +400,13 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    // OPTIMIZATION: The characters up to the next '&' or '<' are all emitted as they are, so queue up
+                    //               their character tokens right away instead of going through this state for each.
+                    create_new_token(HTMLToken::Type::Character);
+                    m_current_token.set_code_point(current_input_character.value());
+                    m_queued_tokens.enqueue(move(m_current_token));
+                    queue_character_tokens_for(consume_run_of_characters_without('&', '<', max_character_run_length_in_bytes));
+                    return m_queued_tokens.dequeue();
                 }
             }
             END_STATE
@@ -1269,6 +1378,11 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    // OPTIMIZATION: The characters up to the closing quote or the next '&' are all appended as they
+                    //               are, so append them all at once.
+                    auto run = consume_run_of_characters_without('"', '&');
+                    m_current_builder.append(run);
+                    advance_source_position_past(run);
                     continue;
                 }
             }
@@ -1301,6 +1415,10 @@ _StartOfFunction:
                 ANYTHING_ELSE
                 {
                     m_current_builder.append_code_point(current_input_character.value());
+                    // OPTIMIZATION: See the double-quoted attribute value state.
+                    auto run = consume_run_of_characters_without('\'', '&');
+                    m_current_builder.append(run);
+                    advance_source_position_past(run);
                     continue;
                 }
             }
@@ -1907,7 +2025,12 @@ _StartOfFunction:
                 }
                 ANYTHING_ELSE
                 {
-                    EMIT_CURRENT_CHARACTER;
+                    // OPTIMIZATION: See the data state.
+                    create_new_token(HTMLToken::Type::Character);
+                    m_current_token.set_code_point(current_input_character.value());
+                    m_queued_tokens.enqueue(move(m_current_token));
+                    queue_character_tokens_for(consume_run_of_characters_without('&', '<', max_character_run_length_in_bytes));
+                    return m_queued_tokens.dequeue();
                 }
             }
             END_STATE
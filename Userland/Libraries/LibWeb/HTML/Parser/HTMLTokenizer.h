@@ -129,6 +129,8 @@ public:
     bool is_blocked() const { return m_blocked; }
 
     ByteString source() const { return m_decoded_input; }
+    // The part of the input that the tokenizer hasn't consumed yet.
+    StringView unparsed_input() const { return m_decoded_input.substring_view(m_utf8_view.byte_offset_of(m_utf8_iterator)); }
 
     void insert_input_at_insertion_point(StringView input);
     void insert_eof();
@@ -155,6 +157,13 @@ private:
     void skip(size_t count);
     Optional<u32> next_code_point();
     Optional<u32> peek_code_point(size_t offset) const;
+
+    // Fast paths for states that treat all but a few input characters alike. These consume the run of input characters
+    // up to the next NULL, CARRIAGE RETURN or one of the given characters in one go, instead of one by one.
+    StringView consume_run_of_characters_without(char, char, size_t max_length_in_bytes = NumericLimits<size_t>::max());
+    void advance_source_position_past(StringView run);
+    void queue_character_tokens_for(StringView run);
+
     bool consume_next_if_match(StringView, CaseSensitivity = CaseSensitivity::CaseSensitive);
     void create_new_token(HTMLToken::Type);
     bool current_end_tag_token_is_appropriate() const;
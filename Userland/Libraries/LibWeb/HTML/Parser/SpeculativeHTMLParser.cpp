@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/Fetch/Infrastructure/URL.h>
+#include <LibWeb/HTML/AttributeNames.h>
+#include <LibWeb/HTML/Parser/HTMLTokenizer.h>
+#include <LibWeb/HTML/Parser/SpeculativeHTMLParser.h>
+#include <LibWeb/HTML/TagNames.h>
+#include <LibWeb/Infra/CharacterTypes.h>
+#include <LibWeb/Infra/Strings.h>
+#include <LibWeb/Loader/LoadRequest.h>
+#include <LibWeb/Loader/ResourceLoader.h>
+#include <LibWeb/MimeSniff/MimeType.h>
+
+namespace Web::HTML {
+
+// Whether a script element with these attributes would be a classic script, see step 8 and 9 of
+// https://html.spec.whatwg.org/multipage/scripting.html#prepare-the-script-element
+static bool is_classic_script(HTMLToken const& token)
+{
+    if (token.has_attribute(AttributeNames::nomodule))
+        return false;
+
+    auto type = token.attribute(AttributeNames::type);
+    auto language = token.attribute(AttributeNames::language);
+    if (type.has_value())
+        return type->is_empty() || MimeSniff::is_javascript_mime_type_essence_match(MUST(type->trim(Infra::ASCII_WHITESPACE)));
+    if (language.has_value() && !language->is_empty())
+        return MimeSniff::is_javascript_mime_type_essence_match(MUST(String::formatted("text/{}", *language)));
+    return true;
+}
+
+// NOTE: Elements with a crossorigin attribute are fetched in CORS mode, and possibly without credentials. A preload would
+//       be made with the document's cookies instead, so it could never be used by the element.
+static bool is_cors_request(HTMLToken const& token)
+{
+    return token.has_attribute(AttributeNames::crossorigin);
+}
+
+static bool is_stylesheet_link(HTMLToken const& token)
+{
+    auto rel = token.attribute(AttributeNames::rel);
+    if (!rel.has_value())
+        return false;
+
+    bool is_stylesheet = false;
+    bool is_alternate = false;
+    for (auto keyword : rel->bytes_as_string_view().split_view_if(Infra::is_ascii_whitespace)) {
+        if (keyword.equals_ignoring_ascii_case("stylesheet"sv))
+            is_stylesheet = true;
+        else if (keyword.equals_ignoring_ascii_case("alternate"sv))
+            is_alternate = true;
+    }
+    return is_stylesheet && !is_alternate;
+}
+
+// https://html.spec.whatwg.org/multipage/urls-and-fetching.html#will-lazy-load-element-steps
+static bool is_lazy_image(HTMLToken const& token, bool scripting_enabled)
+{
+    // NOTE: Lazy loading is disabled along with scripting.
+    if (!scripting_enabled)
+        return false;
+    auto loading = token.attribute(AttributeNames::loading);
+    return loading.has_value() && loading->equals_ignoring_ascii_case("lazy"sv);
+}
+
+void SpeculativeHTMLParser::start(DOM::Document& document, HTMLTokenizer const& parser_tokenizer, bool scripting_enabled)
+{
+    auto input_length = parser_tokenizer.source().length();
+    if (m_scanned_input_length == input_length)
+        return;
+    m_scanned_input_length = input_length;
+
+    HTMLTokenizer tokenizer { parser_tokenizer.unparsed_input(), "UTF-8"sv };
+    auto base_url = document.base_url();
+    bool found_base_url = false;
+    size_t picture_nesting_depth = 0;
+
+    for (;;) {
+        auto token = tokenizer.next_token();
+        if (!token.has_value() || token->is_end_of_file())
+            break;
+        if (token->is_end_tag() && token->tag_name() == TagNames::picture && picture_nesting_depth > 0)
+            --picture_nesting_depth;
+        if (!token->is_start_tag())
+            continue;
+
+        // NOTE: There is no tree builder to switch the tokenizer to the right state for the contents of these elements,
+        //       so we have to do it ourselves. Otherwise, markup in scripts and text would be mistaken for tags.
+        auto const& tag_name = token->tag_name();
+        if (tag_name == TagNames::script) {
+            tokenizer.switch_to(HTMLTokenizer::State::ScriptData);
+            if (auto src = token->attribute(AttributeNames::src); src.has_value() && is_classic_script(*token) && !is_cors_request(*token))
+                preload(document, base_url, *src);
+        } else if (tag_name.is_one_of(TagNames::style, TagNames::xmp, TagNames::iframe, TagNames::noembed, TagNames::noframes)
+            || (tag_name == TagNames::noscript && scripting_enabled)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RAWTEXT);
+        } else if (tag_name.is_one_of(TagNames::textarea, TagNames::title)) {
+            tokenizer.switch_to(HTMLTokenizer::State::RCDATA);
+        } else if (tag_name == TagNames::plaintext) {
+            tokenizer.switch_to(HTMLTokenizer::State::PLAINTEXT);
+        } else if (tag_name == TagNames::base) {
+            // NOTE: Only the first base element with an href attribute counts, see
+            //       https://html.spec.whatwg.org/multipage/semantics.html#frozen-base-url
+            if (auto href = token->attribute(AttributeNames::href); href.has_value() && !found_base_url) {
+                found_base_url = true;
+                if (auto url = base_url.complete_url(*href); url.is_valid())
+                    base_url = move(url);
+            }
+        } else if (tag_name == TagNames::link) {
+            if (auto href = token->attribute(AttributeNames::href); href.has_value() && is_stylesheet_link(*token) && !is_cors_request(*token))
+                preload(document, base_url, *href);
+        } else if (tag_name == TagNames::picture) {
+            ++picture_nesting_depth;
+        } else if (tag_name == TagNames::img) {
+            // FIXME: Pick a candidate from srcset and from the sources of a picture element like the image element would.
+            if (picture_nesting_depth > 0 || token->has_attribute(AttributeNames::srcset))
+                continue;
+            // NOTE: Lazy images only start loading once they're near the viewport, so preloading them would defeat the point.
+            if (is_lazy_image(*token, scripting_enabled))
+                continue;
+            if (auto src = token->attribute(AttributeNames::src); src.has_value() && !is_cors_request(*token))
+                preload(document, base_url, *src);
+        }
+    }
+}
+
+void SpeculativeHTMLParser::preload(DOM::Document& document, URL::URL const& base_url, String const& url_string)
+{
+    auto url = base_url.complete_url(MUST(url_string.trim(Infra::ASCII_WHITESPACE)));
+    if (!url.is_valid())
+        return;
+
+    auto key = url.serialize(URL::ExcludeFragment::Yes);
+    if (m_preloaded_urls.set(key) != HashSetResult::InsertedNewEntry)
+        return;
+
+    // NOTE: Like the fetch of the element would, this only sends cookies over HTTP(S).
+    auto request = Fetch::Infrastructure::is_http_or_https_scheme(url.scheme()) ? LoadRequest::create_for_url_on_page(url, &document.page()) : LoadRequest {};
+    request.set_url(url);
+    request.set_page(document.page());
+    request.set_document(document);
+    auto speculative_load = ResourceLoader::the().load_speculatively(request);
+    if (!speculative_load)
+        return;
+
+    dbgln_if(HTML_PARSER_DEBUG, "SpeculativeHTMLParser: Preloading {}", url);
+    document.did_start_speculative_load({}, speculative_load.release_nonnull());
+}
+
+}
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/HashTable.h>
+#include <AK/Optional.h>
+#include <LibURL/URL.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::HTML {
+
+class HTMLTokenizer;
+
+// https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parsing
+// While the HTML parser is blocked on a script, this makes a pass over the input it hasn't reached yet and starts
+// loading the scripts, style sheets and images found there, so they're already on their way by the time the parser
+// gets to them. Nothing is parsed into the document; the input is only tokenized.
+class SpeculativeHTMLParser {
+public:
+    // NOTE: The pass runs to completion right away, so there's never a speculative parser that needs to be stopped.
+    void start(DOM::Document&, HTMLTokenizer const&, bool scripting_enabled);
+
+private:
+    void preload(DOM::Document&, URL::URL const& base_url, String const& url);
+
+    HashTable<ByteString> m_preloaded_urls;
+
+    // The length of the parser's input when it was last scanned. The input only changes if a script inserts more of it
+    // with document.write(), so there's nothing new to find until then.
+    Optional<size_t> m_scanned_input_length;
+};
+
+}
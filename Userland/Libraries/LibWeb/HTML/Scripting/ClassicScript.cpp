@@ -49,8 +49,11 @@ JS::NonnullGCPtr<ClassicScript> ClassicScript::create(ByteString filename, Strin
     script->set_error_to_rethrow(JS::js_null());
 
     // 10. Let result be ParseScript(source, settings's Realm, script).
+    // FIXME: Parse async and defer scripts on a worker thread. The AST is full of DeprecatedFlyStrings, whose table
+    //        is not thread-safe, and whose StringImpls are not atomically reference counted.
     auto parse_timer = Core::ElapsedTimer::start_new();
-    auto result = JS::Script::parse(source, environment_settings_object.realm(), script->filename(), script, source_line_number);
+    auto result = JS::Script::parse(source, environment_settings_object.realm(), script->filename(), script, source_line_number, JS::Script::UseParseCache::Yes);
+    script->set_parse_duration(parse_timer.elapsed_time());
     dbgln_if(HTML_SCRIPT_DEBUG, "ClassicScript: Parsed {} in {}ms", script->filename(), parse_timer.elapsed());
 
     // 11. If result is a list of errors, then:
@@ -100,6 +103,7 @@ JS::Completion ClassicScript::run(RethrowErrors rethrow_errors, JS::GCPtr<JS::En
 
         // FIXME: If ScriptEvaluation does not complete because the user agent has aborted the running script, leave evaluationStatus as null.
 
+        record_timing(timer.elapsed_time());
         dbgln_if(HTML_SCRIPT_DEBUG, "ClassicScript: Finished running script {}, Duration: {}ms", filename(), timer.elapsed());
     }
 
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/ElapsedTimer.h>
 #include <LibJS/Runtime/ModuleRequest.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Fetching.h>
@@ -54,7 +55,10 @@ WebIDL::ExceptionOr<JS::GCPtr<JavaScriptModuleScript>> JavaScriptModuleScript::c
     script->set_error_to_rethrow(JS::js_null());
 
     // 7. Let result be ParseModule(source, settings's Realm, script).
+    // FIXME: Parse module scripts on a worker thread too, see ClassicScript::create().
+    auto parse_timer = Core::ElapsedTimer::start_new();
     auto result = JS::SourceTextModule::parse(source, settings_object.realm(), filename.view(), script);
+    script->set_parse_duration(parse_timer.elapsed_time());
 
     // 8. If result is a list of errors, then:
     if (result.is_error()) {
@@ -154,7 +158,9 @@ JS::Promise* JavaScriptModuleScript::run(PreventErrorReporting)
         vm().push_execution_context(*module_execution_context);
 
         // 2. Set evaluationPromise to record.Evaluate().
+        auto timer = Core::ElapsedTimer::start_new();
         auto elevation_promise_or_error = record->evaluate(vm());
+        record_timing(timer.elapsed_time());
 
         // NOTE: This step will recursively evaluate all of the module's dependencies.
         // If Evaluate fails to complete as a result of the user agent aborting the running script,
@@ -4,8 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTML/Scripting/Script.h>
+#include <LibWeb/HTML/Window.h>
 
 namespace Web::HTML {
 
@@ -20,6 +22,15 @@ Script::Script(URL::URL base_url, ByteString filename, EnvironmentSettingsObject
 
 Script::~Script() = default;
 
+void Script::record_timing(Duration run_duration)
+{
+    // NOTE: Scripts of workers don't have a document to record their timings with.
+    auto& global_object = m_settings_object->global_object();
+    if (!is<Window>(global_object))
+        return;
+    static_cast<Window&>(global_object).associated_document().record_script_timing({ m_filename, m_parse_duration, run_duration });
+}
+
 void Script::visit_host_defined_self(JS::Cell::Visitor& visitor)
 {
     visitor.visit(*this);
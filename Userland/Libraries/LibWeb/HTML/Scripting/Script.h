@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Time.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibJS/Script.h>
 #include <LibURL/URL.h>
@@ -34,6 +35,12 @@ public:
     [[nodiscard]] JS::Value parse_error() const { return m_parse_error; }
     void set_parse_error(JS::Value value) { m_parse_error = value; }
 
+    Duration parse_duration() const { return m_parse_duration; }
+    void set_parse_duration(Duration duration) { m_parse_duration = duration; }
+
+    // Records how long this script took to parse and run with the document it runs in, for debugging purposes.
+    void record_timing(Duration run_duration);
+
 protected:
     Script(URL::URL base_url, ByteString filename, EnvironmentSettingsObject& environment_settings_object);
 
@@ -51,6 +58,8 @@ private:
 
     // https://html.spec.whatwg.org/multipage/webappapis.html#concept-script-error-to-rethrow
     JS::Value m_error_to_rethrow;
+
+    Duration m_parse_duration;
 };
 
 }
@@ -4,9 +4,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/JsonObject.h>
+#include <LibGfx/TextShapingCache.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Bindings/InternalsPrototype.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/CSS/StyleComputer.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/Event.h>
 #include <LibWeb/DOM/EventTarget.h>
@@ -45,6 +48,53 @@ void Internals::gc()
     vm().heap().collect_garbage();
 }
 
+String Internals::gc_statistics()
+{
+    return MUST(String::from_byte_string(vm().heap().statistics().to_json().to_byte_string()));
+}
+
+String Internals::style_sharing_statistics()
+{
+    auto const& statistics = global_object().associated_document().style_computer().style_sharing_statistics();
+    JsonObject object;
+    object.set("hits"sv, statistics.hits);
+    object.set("misses"sv, statistics.misses);
+    return MUST(String::from_byte_string(object.to_byte_string()));
+}
+
+u32 Internals::restyled_element_count()
+{
+    return global_object().associated_document().restyled_element_count_in_last_style_update();
+}
+
+String Internals::layout_statistics()
+{
+    auto const& statistics = global_object().associated_document().layout_statistics();
+    JsonObject object;
+    object.set("fullLayouts"sv, statistics.full_layouts);
+    object.set("subtreeLayouts"sv, statistics.subtree_layouts);
+    return MUST(String::from_byte_string(object.to_byte_string()));
+}
+
+String Internals::speculative_load_statistics()
+{
+    auto statistics = global_object().associated_document().speculative_load_statistics();
+    JsonObject object;
+    object.set("loads"sv, statistics.loads);
+    object.set("hits"sv, statistics.hits);
+    return MUST(String::from_byte_string(object.to_byte_string()));
+}
+
+String Internals::text_shaping_cache_statistics()
+{
+    auto const& cache = Gfx::TextShapingCache::the();
+    JsonObject object;
+    object.set("entries"sv, cache.size());
+    object.set("hits"sv, cache.statistics().hits);
+    object.set("misses"sv, cache.statistics().misses);
+    return MUST(String::from_byte_string(object.to_byte_string()));
+}
+
 JS::Object* Internals::hit_test(double x, double y)
 {
     auto* active_document = global_object().browsing_context()->top_level_browsing_context()->active_document();
@@ -21,6 +21,12 @@ public:
     void signal_text_test_is_done();
 
     void gc();
+    String gc_statistics();
+    String style_sharing_statistics();
+    u32 restyled_element_count();
+    String layout_statistics();
+    String speculative_load_statistics();
+    String text_shaping_cache_statistics();
     JS::Object* hit_test(double x, double y);
 
     void send_text(HTML::HTMLElement&, String const&);
@@ -54,6 +54,56 @@ bool Box::is_scroll_container() const
         || overflow_value_makes_box_a_scroll_container(computed_values().overflow_y());
 }
 
+bool Box::is_layout_boundary() const
+{
+    // NOTE: We need the size and position from an earlier layout to lay out the subtree on its own.
+    if (!paintable_box())
+        return false;
+
+    auto const& computed_values = this->computed_values();
+
+    // The contents must not overflow into the surrounding layout.
+    if (computed_values.overflow_x() == CSS::Overflow::Visible || computed_values.overflow_y() == CSS::Overflow::Visible)
+        return false;
+
+    // The size must not depend on the contents.
+    if (!computed_values.width().is_length() || !computed_values.height().is_length())
+        return false;
+    if (!(computed_values.min_width().is_auto() || computed_values.min_width().is_length()) || !(computed_values.max_width().is_none() || computed_values.max_width().is_length()))
+        return false;
+    if (!(computed_values.min_height().is_auto() || computed_values.min_height().is_length()) || !(computed_values.max_height().is_none() || computed_values.max_height().is_length()))
+        return false;
+
+    // NOTE: The parent formatting context lays out list item markers and builds table wrappers, so these can't be laid out on their own.
+    if (is_list_item_box() || is_table_wrapper())
+        return false;
+
+    auto formatting_context_type = FormattingContext::formatting_context_type_created_by_box(*this);
+    if (!formatting_context_type.has_value())
+        return false;
+    if (formatting_context_type != FormattingContext::Type::Block && formatting_context_type != FormattingContext::Type::Flex && formatting_context_type != FormattingContext::Type::Grid)
+        return false;
+
+    // NOTE: Flex, grid and table layout, as well as inline-level boxes, may size or align the box based on its contents
+    //       (e.g. its baseline), so we only allow boundaries that are nested in plain block flow all the way up.
+    if (!display().is_block_outside())
+        return false;
+    for (auto const* ancestor = parent(); ancestor && !ancestor->is_viewport(); ancestor = ancestor->parent()) {
+        auto ancestor_display = ancestor->display();
+        if (!ancestor_display.is_block_outside() || !(ancestor_display.is_flow_inside() || ancestor_display.is_flow_root_inside()))
+            return false;
+    }
+
+    return true;
+}
+
+IntrinsicSizes& Box::cached_intrinsic_sizes() const
+{
+    if (!m_cached_intrinsic_sizes)
+        m_cached_intrinsic_sizes = make<IntrinsicSizes>();
+    return *m_cached_intrinsic_sizes;
+}
+
 bool Box::is_user_scrollable() const
 {
     // FIXME: Support horizontal scroll as well (overflow-x)
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/HashMap.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Rect.h>
 #include <LibJS/Heap/Cell.h>
@@ -18,6 +19,20 @@ struct LineBoxFragmentCoordinate {
     size_t fragment_index { 0 };
 };
 
+// The intrinsic sizes of a box only depend on its subtree and the size of its containing block,
+// so they are kept across layouts until something inside the box needs layout.
+struct IntrinsicSizes {
+    Optional<CSSPixels> min_content_width;
+    Optional<CSSPixels> max_content_width;
+
+    HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
+    HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
+
+    // The size of the containing block these were computed against. Empty if indefinite.
+    Optional<CSSPixels> containing_block_width;
+    Optional<CSSPixels> containing_block_height;
+};
+
 class Box : public NodeWithStyleAndBoxModelMetrics {
     JS_CELL(Box, NodeWithStyleAndBoxModelMetrics);
 
@@ -54,6 +69,13 @@ public:
 
     bool is_user_scrollable() const;
 
+    // A layout boundary is a box whose size and position don't depend on its contents,
+    // which allows us to lay out its subtree on its own after something inside it changes.
+    bool is_layout_boundary() const;
+
+    IntrinsicSizes& cached_intrinsic_sizes() const;
+    void discard_cached_intrinsic_sizes() { m_cached_intrinsic_sizes = nullptr; }
+
 protected:
     Box(DOM::Document&, DOM::Node*, NonnullRefPtr<CSS::StyleProperties>);
     Box(DOM::Document&, DOM::Node*, NonnullOwnPtr<CSS::ComputedValues>);
@@ -64,6 +86,8 @@ private:
     Optional<CSSPixels> m_natural_width;
     Optional<CSSPixels> m_natural_height;
     Optional<CSSPixelFraction> m_natural_aspect_ratio;
+
+    mutable OwnPtr<IntrinsicSizes> m_cached_intrinsic_sizes;
 };
 
 template<>
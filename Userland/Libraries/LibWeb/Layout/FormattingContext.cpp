@@ -1439,9 +1439,7 @@ CSSPixels FormattingContext::calculate_min_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = m_state.intrinsic_sizes_for(box);
     if (cache.min_content_width.has_value())
         return *cache.min_content_width;
 
@@ -1477,9 +1475,7 @@ CSSPixels FormattingContext::calculate_max_content_width(Layout::Box const& box)
     if (box.has_natural_width())
         return *box.natural_width();
 
-    auto& root_state = m_state.m_root;
-
-    auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+    auto& cache = m_state.intrinsic_sizes_for(box);
     if (cache.max_content_width.has_value())
         return *cache.max_content_width;
 
@@ -1521,8 +1517,7 @@ CSSPixels FormattingContext::calculate_min_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = m_state.intrinsic_sizes_for(box);
         return &cache.min_content_height.ensure(width);
     };
 
@@ -1565,8 +1560,7 @@ CSSPixels FormattingContext::calculate_max_content_height(Layout::Box const& box
         return *box.natural_height();
 
     auto get_cache_slot = [&]() -> Optional<CSSPixels>* {
-        auto& root_state = m_state.m_root;
-        auto& cache = *root_state.intrinsic_sizes.ensure(&box, [] { return adopt_own(*new LayoutState::IntrinsicSizes); });
+        auto& cache = m_state.intrinsic_sizes_for(box);
         return &cache.max_content_height.ensure(width);
     };
 
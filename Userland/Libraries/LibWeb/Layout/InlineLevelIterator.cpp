@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibGfx/TextShapingCache.h>
 #include <LibWeb/Layout/BreakNode.h>
 #include <LibWeb/Layout/InlineFormattingContext.h>
 #include <LibWeb/Layout/InlineLevelIterator.h>
@@ -187,14 +188,11 @@ Optional<InlineLevelIterator::Item> InlineLevelIterator::next_without_lookahead(
             };
         }
 
-        Vector<Gfx::DrawGlyphOrEmoji> glyph_run;
-        float glyph_run_width = 0;
-        Gfx::for_each_glyph_position(
-            { 0, 0 }, chunk.view, text_node.computed_values().font_list(), [&](Gfx::DrawGlyphOrEmoji const& glyph_or_emoji) {
-                glyph_run.append(glyph_or_emoji);
-                return IterationDecision::Continue;
-            },
-            Gfx::IncludeLeftBearing::No, glyph_run_width);
+        // OPTIMIZATION: The same words get shaped over and over again, both across relayouts and across text nodes,
+        //               so we let the process-wide shaping cache remember the result.
+        auto const& shaped_text = Gfx::TextShapingCache::the().shape(chunk.view, text_node.computed_values().font_list());
+        Vector<Gfx::DrawGlyphOrEmoji> glyph_run = shaped_text.glyphs;
+        float glyph_run_width = shaped_text.width;
 
         if (!m_text_node_context->is_last_chunk)
             glyph_run_width += text_node.first_available_font().glyph_spacing();
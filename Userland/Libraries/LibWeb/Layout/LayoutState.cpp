@@ -71,6 +71,34 @@ LayoutState::UsedValues const& LayoutState::get(NodeWithStyle const& node) const
     return *new_used_values_ptr;
 }
 
+IntrinsicSizes& LayoutState::intrinsic_sizes_for(Box const& box) const
+{
+    auto& cache = box.cached_intrinsic_sizes();
+    if (m_root.boxes_with_validated_intrinsic_sizes.contains(&box))
+        return cache;
+
+    Optional<CSSPixels> containing_block_width;
+    Optional<CSSPixels> containing_block_height;
+    if (auto const* containing_block = box.containing_block()) {
+        auto const& containing_block_used_values = get(*containing_block);
+        if (containing_block_used_values.has_definite_width())
+            containing_block_width = containing_block_used_values.content_width();
+        if (containing_block_used_values.has_definite_height())
+            containing_block_height = containing_block_used_values.content_height();
+    }
+
+    // NOTE: Intrinsic sizes may resolve percentages against the containing block, so the ones cached by an earlier
+    //       layout are only valid if it still has the same size.
+    if (cache.containing_block_width != containing_block_width || cache.containing_block_height != containing_block_height) {
+        cache = {};
+        cache.containing_block_width = containing_block_width;
+        cache.containing_block_height = containing_block_height;
+    }
+
+    m_root.boxes_with_validated_intrinsic_sizes.set(&box);
+    return cache;
+}
+
 // https://www.w3.org/TR/css-overflow-3/#scrollable-overflow
 static CSSPixelRect measure_scrollable_overflow(Box const& box)
 {
@@ -203,17 +231,36 @@ void LayoutState::commit(Box& root)
     // Only the top-level LayoutState should ever be committed.
     VERIFY(!m_parent);
 
+    // NOTE: When laying out the subtree of a layout boundary, the state also has used values for the ancestors of
+    //       the boundary, which we only needed to lay it out. Their paintables are left alone.
+    bool const is_subtree_commit = !root.is_viewport();
+    auto is_in_committed_subtree = [&](Node const& node) {
+        return !is_subtree_commit || root.is_inclusive_ancestor_of(node);
+    };
+
+    JS::GCPtr<Painting::Paintable> old_root_paintable;
+    JS::GCPtr<Painting::Paintable> root_paintable_parent;
+    if (is_subtree_commit) {
+        old_root_paintable = root.paintable();
+        VERIFY(old_root_paintable);
+        root_paintable_parent = old_root_paintable->parent();
+    }
+
     // NOTE: In case this is a relayout of an existing tree, we start by detaching the old paint tree
     //       from the layout tree. This is done to ensure that we don't end up with any old-tree pointers
     //       when text paintables shift around in the tree.
     root.for_each_in_inclusive_subtree([&](Layout::Node& node) {
         node.set_paintable(nullptr);
+        if (is_subtree_commit && node.dom_node())
+            node.dom_node()->set_paintable(nullptr);
         return IterationDecision::Continue;
     });
-    root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
-        node.set_paintable(nullptr);
-        return IterationDecision::Continue;
-    });
+    if (!is_subtree_commit) {
+        root.document().for_each_shadow_including_inclusive_descendant([&](DOM::Node& node) {
+            node.set_paintable(nullptr);
+            return IterationDecision::Continue;
+        });
+    }
 
     HashTable<Layout::TextNode*> text_nodes;
 
@@ -223,6 +270,9 @@ void LayoutState::commit(Box& root)
         auto& used_values = *it.value;
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
+        if (!is_in_committed_subtree(node))
+            continue;
+
         if (is<NodeWithStyleAndBoxModelMetrics>(node)) {
             // Transfer box model metrics.
             auto& box_model = static_cast<NodeWithStyleAndBoxModelMetrics&>(node).box_model();
@@ -276,7 +326,7 @@ void LayoutState::commit(Box& root)
         auto& used_values = *it.value;
         auto& node = const_cast<NodeWithStyle&>(used_values.node());
 
-        if (!node.is_box())
+        if (!node.is_box() || !is_in_committed_subtree(node))
             continue;
 
         auto& paintable = static_cast<Painting::PaintableBox&>(*node.paintable());
@@ -346,6 +396,13 @@ void LayoutState::commit(Box& root)
         text_paintable.set_text_decoration_thickness(css_line_thickness);
     }
 
+    if (is_subtree_commit) {
+        // Put the new paintable of the root where the old one was in the paint tree.
+        auto& new_root_paintable = *root.paintable();
+        root_paintable_parent->insert_before(new_root_paintable, old_root_paintable);
+        root_paintable_parent->remove_child(*old_root_paintable);
+    }
+
     build_paint_tree(root);
 
     resolve_relative_positions();
@@ -353,7 +410,7 @@ void LayoutState::commit(Box& root)
     // Measure overflow in scroll containers.
     for (auto& it : used_values_per_layout_node) {
         auto& used_values = *it.value;
-        if (!used_values.node().is_box())
+        if (!used_values.node().is_box() || !is_in_committed_subtree(used_values.node()))
             continue;
         auto const& box = static_cast<Layout::Box const&>(used_values.node());
         measure_scrollable_overflow(box);
@@ -168,6 +168,7 @@ struct LayoutState {
     };
 
     // Commits the used values produced by layout and builds a paintable tree.
+    // If the root is not the viewport, only the paintables of the root's subtree are replaced.
     void commit(Box& root);
 
     // NOTE: get_mutable() will CoW the UsedValues if it's inherited from an ancestor state;
@@ -180,15 +181,11 @@ struct LayoutState {
 
     // We cache intrinsic sizes once determined, as they will not change over the course of a full layout.
     // This avoids computing them several times while performing flex layout.
-    struct IntrinsicSizes {
-        Optional<CSSPixels> min_content_width;
-        Optional<CSSPixels> max_content_width;
+    // The cache lives in the box itself, so that later layouts can reuse it as long as the box's containing block
+    // has the same size when it's first consulted.
+    IntrinsicSizes& intrinsic_sizes_for(Box const&) const;
 
-        HashMap<CSSPixels, Optional<CSSPixels>> min_content_height;
-        HashMap<CSSPixels, Optional<CSSPixels>> max_content_height;
-    };
-
-    HashMap<JS::GCPtr<NodeWithStyle const>, NonnullOwnPtr<IntrinsicSizes>> mutable intrinsic_sizes;
+    HashTable<JS::GCPtr<Box const>> mutable boxes_with_validated_intrinsic_sizes;
 
     LayoutState const* m_parent { nullptr };
     LayoutState const& m_root;
@@ -975,6 +975,30 @@ void NodeWithStyle::transfer_table_box_computed_values_to_wrapper_computed_value
     reset_table_box_computed_values_used_by_wrapper_to_init_values();
 }
 
+void Node::set_needs_layout()
+{
+    if (m_needs_layout)
+        return;
+    m_needs_layout = true;
+
+    if (is<Box>(*this))
+        static_cast<Box&>(*this).discard_cached_intrinsic_sizes();
+
+    // NOTE: The intrinsic sizes of every box up to the nearest layout boundary may depend on this node.
+    //       Boxes outside of it don't, since the size of a layout boundary doesn't depend on its contents.
+    for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
+        if (!is<Box>(*ancestor))
+            continue;
+        auto& box = static_cast<Box&>(*ancestor);
+        box.discard_cached_intrinsic_sizes();
+        if (box.is_layout_boundary()) {
+            document().set_needs_layout_of_subtree({}, &box);
+            return;
+        }
+    }
+    document().set_needs_layout_of_subtree({}, nullptr);
+}
+
 void Node::set_paintable(JS::GCPtr<Painting::Paintable> paintable)
 {
     m_paintable = move(paintable);
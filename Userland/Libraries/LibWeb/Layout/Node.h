@@ -164,6 +164,11 @@ public:
     u32 initial_quote_nesting_level() const { return m_initial_quote_nesting_level; }
     void set_initial_quote_nesting_level(u32 value) { m_initial_quote_nesting_level = value; }
 
+    // Marks this node as needing layout, and schedules a layout of the nearest layout boundary that contains it.
+    void set_needs_layout();
+    void clear_needs_layout() { m_needs_layout = false; }
+    bool needs_layout() const { return m_needs_layout; }
+
 protected:
     Node(DOM::Document&, DOM::Node*);
 
@@ -186,6 +191,8 @@ private:
     bool m_is_flex_item { false };
     bool m_is_grid_item { false };
 
+    bool m_needs_layout { false };
+
     GeneratedFor m_generated_for { GeneratedFor::NotGenerated };
 
     u32 m_initial_quote_nesting_level { 0 };
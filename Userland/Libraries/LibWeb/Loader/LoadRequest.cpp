@@ -6,6 +6,7 @@
 
 #include "LoadRequest.h"
 #include <LibWeb/Cookie/Cookie.h>
+#include <LibWeb/DOM/Document.h>
 #include <LibWeb/Page/Page.h>
 
 namespace Web {
@@ -25,4 +26,14 @@ LoadRequest LoadRequest::create_for_url_on_page(const URL::URL& url, Page* page)
     return request;
 }
 
+DOM::Document* LoadRequest::document() const
+{
+    return m_document.ptr();
+}
+
+void LoadRequest::set_document(DOM::Document& document)
+{
+    m_document = document;
+}
+
 }
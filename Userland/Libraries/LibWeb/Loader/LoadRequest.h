@@ -46,6 +46,11 @@ public:
     JS::GCPtr<Page> page() { return m_page.ptr(); }
     void set_page(Page& page) { m_page = page; }
 
+    // The document that the resource is loaded for, if any. Speculative loads are only taken over by loads for the
+    // document they were started for.
+    DOM::Document* document() const;
+    void set_document(DOM::Document&);
+
     unsigned hash() const
     {
         auto body_hash = string_hash((char const*)m_body.data(), m_body.size());
@@ -80,6 +85,7 @@ private:
     ByteBuffer m_body;
     Core::ElapsedTimer m_load_timer;
     JS::Handle<Page> m_page;
+    JS::Handle<DOM::Document> m_document;
     bool m_main_resource { false };
 };
 
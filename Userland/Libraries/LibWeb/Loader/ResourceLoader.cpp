@@ -307,6 +307,21 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         return;
     }
 
+    if (auto speculative_load = take_over_speculative_load(request)) {
+        dbgln_if(SPAM_DEBUG, "ResourceLoader: Taking over speculative load of: \"{}\"", url_for_logging);
+        speculative_load->deliver(
+            [log_success, request, success_callback = move(success_callback)](ReadonlyBytes payload, auto const& response_headers, auto status_code) {
+                log_success(request);
+                success_callback(payload, response_headers, status_code);
+            },
+            [log_failure, request, error_callback = move(error_callback)](ByteString const& error, auto status_code, ReadonlyBytes payload, auto const& response_headers) {
+                log_failure(request, error);
+                if (error_callback)
+                    error_callback(error, status_code, payload, response_headers);
+            });
+        return;
+    }
+
     if (url.scheme() == "file") {
         if (request.page())
             m_page = request.page();
@@ -461,6 +476,157 @@ void ResourceLoader::load(LoadRequest& request, SuccessCallback success_callback
         error_callback(not_implemented_error, {}, {}, {});
 }
 
+static ByteString speculative_load_key(URL::URL const& url)
+{
+    return url.serialize(URL::ExcludeFragment::Yes);
+}
+
+static bool can_be_loaded_speculatively(LoadRequest const& request)
+{
+    auto const& scheme = request.url().scheme();
+    if (scheme != "http"sv && scheme != "https"sv && scheme != "file"sv)
+        return false;
+    return request.document() && request.method() == "GET"sv && request.body().is_empty();
+}
+
+// These only describe what kind of resource is expected and where the request comes from. The speculative parser
+// can't know the exact values that the fetch of an element would use, and they don't change who the request is made
+// for, so they are ignored when matching a load with a speculative load.
+static bool is_header_ignored_for_speculative_loads(StringView name)
+{
+    for (auto ignored_name : { "Accept"sv, "Accept-Encoding"sv, "Accept-Language"sv, "Referer"sv, "User-Agent"sv }) {
+        if (name.equals_ignoring_ascii_case(ignored_name))
+            return true;
+    }
+    return false;
+}
+
+RefPtr<SpeculativeLoad> ResourceLoader::load_speculatively(LoadRequest& request)
+{
+    if (!can_be_loaded_speculatively(request))
+        return nullptr;
+
+    auto key = speculative_load_key(request.url());
+    if (auto existing_loads = m_speculative_loads.get(key); existing_loads.has_value()) {
+        for (auto const& existing_load : *existing_loads) {
+            if (existing_load->can_be_taken_over_by(request))
+                return existing_load;
+        }
+    }
+
+    auto speculative_load = adopt_ref(*new SpeculativeLoad(request));
+
+    // NOTE: This has to happen before the speculative load is registered, so it doesn't take over itself.
+    load(
+        request,
+        [speculative_load](ReadonlyBytes payload, auto const& response_headers, auto status_code) {
+            speculative_load->did_finish({}, payload, response_headers, status_code);
+        },
+        [speculative_load](ByteString const& error, auto status_code, ReadonlyBytes payload, auto const& response_headers) {
+            speculative_load->did_finish(error, payload, response_headers, status_code);
+        });
+
+    m_speculative_loads.ensure(move(key)).append(speculative_load);
+    return speculative_load;
+}
+
+RefPtr<SpeculativeLoad> ResourceLoader::take_over_speculative_load(LoadRequest const& request)
+{
+    if (m_speculative_loads.is_empty() || !can_be_loaded_speculatively(request))
+        return nullptr;
+
+    auto it = m_speculative_loads.find(speculative_load_key(request.url()));
+    if (it == m_speculative_loads.end())
+        return nullptr;
+
+    auto& speculative_loads = it->value;
+    auto index = speculative_loads.find_first_index_if([&](auto const& speculative_load) { return speculative_load->can_be_taken_over_by(request); });
+    if (!index.has_value())
+        return nullptr;
+
+    auto speculative_load = speculative_loads.take(*index);
+    if (speculative_loads.is_empty())
+        m_speculative_loads.remove(it);
+
+    speculative_load->m_was_used = true;
+    return speculative_load;
+}
+
+void ResourceLoader::discard_speculative_load(SpeculativeLoad& speculative_load)
+{
+    auto it = m_speculative_loads.find(speculative_load_key(speculative_load.url()));
+    if (it == m_speculative_loads.end())
+        return;
+
+    it->value.remove_first_matching([&](auto const& other) { return other.ptr() == &speculative_load; });
+    if (it->value.is_empty())
+        m_speculative_loads.remove(it);
+}
+
+SpeculativeLoad::SpeculativeLoad(LoadRequest const& request)
+    : m_url(request.url())
+    , m_document(request.document())
+    , m_method(request.method())
+{
+    for (auto const& [name, value] : request.headers()) {
+        if (!is_header_ignored_for_speculative_loads(name))
+            m_request_headers.set(name, value);
+    }
+}
+
+// NOTE: The load has to be for the same document, and it has to be made with the same credentials and headers.
+//       Otherwise, it could get a response that it isn't supposed to see, e.g. one that was fetched with cookies.
+bool SpeculativeLoad::can_be_taken_over_by(LoadRequest const& request) const
+{
+    if (request.document() != m_document || request.method() != m_method || !request.body().is_empty())
+        return false;
+
+    size_t header_count = 0;
+    for (auto const& [name, value] : request.headers()) {
+        if (is_header_ignored_for_speculative_loads(name))
+            continue;
+        auto our_value = m_request_headers.get(name);
+        if (!our_value.has_value() || *our_value != value)
+            return false;
+        ++header_count;
+    }
+    return header_count == m_request_headers.size();
+}
+
+void SpeculativeLoad::did_finish(Optional<ByteString> error, ReadonlyBytes payload, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code)
+{
+    m_is_finished = true;
+    m_error = move(error);
+    m_payload = MUST(ByteBuffer::copy(payload));
+    m_response_headers = response_headers;
+    m_status_code = status_code;
+
+    if (m_success_callback) {
+        auto success_callback = move(m_success_callback);
+        auto error_callback = move(m_error_callback);
+        deliver(move(success_callback), move(error_callback));
+    }
+}
+
+void SpeculativeLoad::deliver(ResourceLoader::SuccessCallback success_callback, ResourceLoader::ErrorCallback error_callback)
+{
+    if (!m_is_finished) {
+        m_success_callback = move(success_callback);
+        m_error_callback = move(error_callback);
+        return;
+    }
+
+    // NOTE: Callers of load() don't expect their callbacks to be invoked before it returns.
+    Platform::EventLoopPlugin::the().deferred_invoke([self = NonnullRefPtr { *this }, success_callback = move(success_callback), error_callback = move(error_callback)] {
+        if (self->m_error.has_value()) {
+            if (error_callback)
+                error_callback(*self->m_error, self->m_status_code, self->m_payload, self->m_response_headers);
+            return;
+        }
+        success_callback(self->m_payload, self->m_response_headers, self->m_status_code);
+    });
+}
+
 bool ResourceLoader::is_port_blocked(int port)
 {
     int ports[] { 1, 7, 9, 11, 13, 15, 17, 19, 20, 21, 22, 23, 25, 37, 42,
@@ -478,6 +644,7 @@ void ResourceLoader::clear_cache()
 {
     dbgln_if(CACHE_DEBUG, "Clearing {} items from ResourceLoader cache", s_resource_cache.size());
     s_resource_cache.clear();
+    m_speculative_loads.clear();
 }
 
 void ResourceLoader::evict_from_cache(LoadRequest const& request)
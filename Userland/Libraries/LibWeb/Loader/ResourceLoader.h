@@ -122,6 +122,13 @@ public:
 
     void load(LoadRequest&, SuccessCallback success_callback, ErrorCallback error_callback = nullptr, Optional<u32> timeout = {}, TimeoutCallback timeout_callback = nullptr);
 
+    // Starts loading the given HTTP(S) or file URL for the request's document before anyone has asked for it. The first
+    // regular load of the same URL for the same document, with the same credentials and headers, takes over the
+    // speculative load instead of starting a new request. Returns null if the request can't be loaded this way.
+    RefPtr<SpeculativeLoad> load_speculatively(LoadRequest&);
+    // Forgets about a speculative load that nobody took over, so it doesn't get used by a later load.
+    void discard_speculative_load(SpeculativeLoad&);
+
     ResourceLoaderConnector& connector() { return *m_connector; }
 
     void prefetch_dns(URL::URL const&);
@@ -146,8 +153,13 @@ private:
 
     static bool is_port_blocked(int port);
 
+    RefPtr<SpeculativeLoad> take_over_speculative_load(LoadRequest const&);
+
     int m_pending_loads { 0 };
 
+    // Keyed by the URL without its fragment.
+    HashMap<ByteString, Vector<NonnullRefPtr<SpeculativeLoad>>> m_speculative_loads;
+
     HashTable<NonnullRefPtr<ResourceLoaderConnectorRequest>> m_active_requests;
     NonnullRefPtr<ResourceLoaderConnector> m_connector;
     String m_user_agent;
@@ -155,4 +167,42 @@ private:
     Optional<JS::GCPtr<Page>> m_page {};
 };
 
+class SpeculativeLoad : public RefCounted<SpeculativeLoad> {
+public:
+    URL::URL const& url() const { return m_url; }
+
+    // Whether a regular load took over this speculative load.
+    bool was_used() const { return m_was_used; }
+    bool is_finished() const { return m_is_finished; }
+
+private:
+    friend class ResourceLoader;
+
+    explicit SpeculativeLoad(LoadRequest const&);
+
+    bool can_be_taken_over_by(LoadRequest const&) const;
+
+    void did_finish(Optional<ByteString> error, ReadonlyBytes payload, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers, Optional<u32> status_code);
+    void deliver(ResourceLoader::SuccessCallback, ResourceLoader::ErrorCallback);
+
+    URL::URL m_url;
+    // NOTE: The document is only used to tell apart the loads of different documents. It discards its speculative
+    //       loads before it goes away.
+    DOM::Document const* m_document { nullptr };
+    ByteString m_method;
+    HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_request_headers;
+
+    bool m_was_used { false };
+    bool m_is_finished { false };
+
+    Optional<ByteString> m_error;
+    ByteBuffer m_payload;
+    HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_response_headers;
+    Optional<u32> m_status_code;
+
+    // The callbacks of the regular load, if it took over before the speculative load finished.
+    ResourceLoader::SuccessCallback m_success_callback;
+    ResourceLoader::ErrorCallback m_error_callback;
+};
+
 }
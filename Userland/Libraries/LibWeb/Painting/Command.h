@@ -118,6 +118,9 @@ struct PushStackingContext {
     CSS::ImageRendering image_rendering;
     StackingContextTransform transform;
     Optional<StackingContextMask> mask = {};
+    // Set while rasterizing if the contents of the stacking context are already in a compositing layer, which then
+    // only has to be composited in their place. The layer is owned by the rasterizer.
+    Gfx::Bitmap const* composited_contents { nullptr };
 
     void translate_by(Gfx::IntPoint const& offset)
     {
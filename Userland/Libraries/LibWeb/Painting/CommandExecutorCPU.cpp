@@ -16,12 +16,19 @@
 namespace Web::Painting {
 
 CommandExecutorCPU::CommandExecutorCPU(Gfx::Bitmap& bitmap)
+    : CommandExecutorCPU(bitmap, {})
+{
+}
+
+CommandExecutorCPU::CommandExecutorCPU(Gfx::Bitmap& bitmap, Gfx::IntPoint bitmap_origin)
     : m_target_bitmap(bitmap)
+    , m_bitmap_origin(bitmap_origin)
 {
     stacking_contexts.append({ .painter = AK::make<Gfx::Painter>(bitmap),
         .opacity = 1.0f,
         .destination = {},
         .scaling_mode = {} });
+    painter().translate(-bitmap_origin);
 }
 
 CommandResult CommandExecutorCPU::draw_glyph_run(Vector<Gfx::DrawGlyphOrEmoji> const& glyph_run, Color const& color, Gfx::FloatPoint translation, double scale)
@@ -126,11 +133,31 @@ CommandResult CommandExecutorCPU::clear_clip_rect()
 
 CommandResult CommandExecutorCPU::push_stacking_context(
     float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation,
-    CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask)
+    CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask, Gfx::Bitmap const* composited_contents)
 {
     painter().save();
-    if (is_fixed_position)
+    if (is_fixed_position) {
         painter().translate(-painter().translation());
+        // NOTE: The painter of the target bitmap starts out translated by the origin of the bitmap, so keep that.
+        if (&painter() == &*stacking_contexts.first().painter)
+            painter().translate(-m_bitmap_origin);
+    }
+
+    if (composited_contents) {
+        // NOTE: The contents have already been rasterized into a compositing layer (without anything below them),
+        //       so all that's left to do is to draw it at its destination and skip the commands of the contents.
+        auto affine_transform = Gfx::extract_2d_affine_transform(transform.matrix);
+        auto source_rect = source_paintable_rect.to_type<float>().translated(-transform.origin);
+        auto destination_rect = affine_transform.map(source_rect).translated(transform.origin).to_rounded<int>().translated(post_transform_translation);
+        if (destination_rect.size() == composited_contents->size()) {
+            painter().blit(destination_rect.location(), *composited_contents, composited_contents->rect(), opacity);
+        } else {
+            auto scaling_mode = CSS::to_gfx_scaling_mode(image_rendering, destination_rect, destination_rect);
+            painter().draw_scaled_bitmap(destination_rect, *composited_contents, composited_contents->rect(), opacity, scaling_mode);
+        }
+        painter().restore();
+        return CommandResult::SkipStackingContext;
+    }
 
     if (mask.has_value()) {
         // TODO: Support masks and other stacking context features at the same time.
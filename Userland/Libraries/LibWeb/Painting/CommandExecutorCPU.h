@@ -20,7 +20,7 @@ public:
     CommandResult draw_scaled_immutable_bitmap(Gfx::IntRect const& dst_rect, Gfx::ImmutableBitmap const&, Gfx::IntRect const& src_rect, Gfx::Painter::ScalingMode scaling_mode, Vector<Gfx::Path> const& clip_paths = {}) override;
     CommandResult set_clip_rect(Gfx::IntRect const& rect) override;
     CommandResult clear_clip_rect() override;
-    CommandResult push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask) override;
+    CommandResult push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask, Gfx::Bitmap const* composited_contents) override;
     CommandResult pop_stacking_context() override;
     CommandResult paint_linear_gradient(Gfx::IntRect const&, Web::Painting::LinearGradientData const&, Vector<Gfx::Path> const& clip_paths = {}) override;
     CommandResult paint_outer_box_shadow(PaintOuterBoxShadowParams const&) override;
@@ -54,8 +54,12 @@ public:
 
     CommandExecutorCPU(Gfx::Bitmap& bitmap);
 
+    // Paints the part of the command list that starts at bitmap_origin into the bitmap. Used to rasterize tiles.
+    CommandExecutorCPU(Gfx::Bitmap& bitmap, Gfx::IntPoint bitmap_origin);
+
 private:
     Gfx::Bitmap& m_target_bitmap;
+    Gfx::IntPoint m_bitmap_origin;
     Vector<RefPtr<BorderRadiusCornerClipper>> m_corner_clippers;
 
     struct StackingContext {
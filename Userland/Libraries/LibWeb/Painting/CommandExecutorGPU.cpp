@@ -100,7 +100,7 @@ CommandResult CommandExecutorGPU::clear_clip_rect()
     return CommandResult::Continue;
 }
 
-CommandResult CommandExecutorGPU::push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering, StackingContextTransform transform, Optional<StackingContextMask>)
+CommandResult CommandExecutorGPU::push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering, StackingContextTransform transform, Optional<StackingContextMask>, Gfx::Bitmap const*)
 {
     if (source_paintable_rect.is_empty())
         return CommandResult::SkipStackingContext;
@@ -39,45 +39,13 @@ void CommandList::apply_scroll_offsets(Vector<Gfx::IntPoint> const& offsets_by_f
     }
 }
 
-void CommandList::execute(CommandExecutor& executor)
+template<typename CommandAt>
+static void execute_commands(CommandExecutor& executor, size_t command_count, CommandAt command_at)
 {
-    executor.prepare_to_execute();
-
-    if (executor.needs_prepare_glyphs_texture()) {
-        HashMap<Gfx::Font const*, HashTable<u32>> unique_glyphs;
-        for (auto& command_with_scroll_id : m_commands) {
-            auto& command = command_with_scroll_id.command;
-            if (command.has<DrawGlyphRun>()) {
-                auto scale = command.get<DrawGlyphRun>().scale;
-                for (auto const& glyph_or_emoji : command.get<DrawGlyphRun>().glyph_run->glyphs()) {
-                    if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
-                        auto const& glyph = glyph_or_emoji.get<Gfx::DrawGlyph>();
-                        auto const& font = *glyph.font->with_size(glyph.font->point_size() * static_cast<float>(scale));
-                        unique_glyphs.ensure(&font, [] { return HashTable<u32> {}; }).set(glyph.code_point);
-                    }
-                }
-            }
-        }
-        executor.prepare_glyph_texture(unique_glyphs);
-    }
-
-    if (executor.needs_update_immutable_bitmap_texture_cache()) {
-        HashMap<u32, Gfx::ImmutableBitmap const*> immutable_bitmaps;
-        for (auto const& command_with_scroll_id : m_commands) {
-            auto& command = command_with_scroll_id.command;
-            if (command.has<DrawScaledImmutableBitmap>()) {
-                auto const& immutable_bitmap = command.get<DrawScaledImmutableBitmap>().bitmap;
-                immutable_bitmaps.set(immutable_bitmap->id(), immutable_bitmap.ptr());
-            }
-        }
-        executor.update_immutable_bitmap_texture_cache(immutable_bitmaps);
-    }
-
     HashTable<u32> skipped_sample_corner_commands;
     size_t next_command_index = 0;
-    while (next_command_index < m_commands.size()) {
-        auto& command_with_scroll_id = m_commands[next_command_index++];
-        auto& command = command_with_scroll_id.command;
+    while (next_command_index < command_count) {
+        Command const& command = command_at(next_command_index++);
         auto bounding_rect = command_bounding_rectangle(command);
         if (bounding_rect.has_value() && (bounding_rect->is_empty() || executor.would_be_fully_clipped_by_painter(*bounding_rect))) {
             if (command.has<SampleUnderCorners>()) {
@@ -116,7 +84,7 @@ void CommandList::execute(CommandExecutor& executor)
                 return executor.push_stacking_context(command.opacity, command.is_fixed_position,
                     command.source_paintable_rect,
                     command.post_transform_translation,
-                    command.image_rendering, command.transform, command.mask);
+                    command.image_rendering, command.transform, command.mask, command.composited_contents);
             },
             [&](PopStackingContext const&) {
                 return executor.pop_stacking_context();
@@ -214,10 +182,11 @@ void CommandList::execute(CommandExecutor& executor)
 
         if (result == CommandResult::SkipStackingContext) {
             auto stacking_context_nesting_level = 1;
-            while (next_command_index < m_commands.size()) {
-                if (m_commands[next_command_index].command.has<PushStackingContext>()) {
+            while (next_command_index < command_count) {
+                Command const& next_command = command_at(next_command_index);
+                if (next_command.has<PushStackingContext>()) {
                     stacking_context_nesting_level++;
-                } else if (m_commands[next_command_index].command.has<PopStackingContext>()) {
+                } else if (next_command.has<PopStackingContext>()) {
                     stacking_context_nesting_level--;
                 }
 
@@ -230,4 +199,52 @@ void CommandList::execute(CommandExecutor& executor)
     }
 }
 
+void CommandList::execute(CommandExecutor& executor)
+{
+    executor.prepare_to_execute();
+
+    if (executor.needs_prepare_glyphs_texture()) {
+        HashMap<Gfx::Font const*, HashTable<u32>> unique_glyphs;
+        for (auto& command_with_scroll_id : m_commands) {
+            auto& command = command_with_scroll_id.command;
+            if (command.has<DrawGlyphRun>()) {
+                auto scale = command.get<DrawGlyphRun>().scale;
+                for (auto const& glyph_or_emoji : command.get<DrawGlyphRun>().glyph_run->glyphs()) {
+                    if (glyph_or_emoji.has<Gfx::DrawGlyph>()) {
+                        auto const& glyph = glyph_or_emoji.get<Gfx::DrawGlyph>();
+                        auto const& font = *glyph.font->with_size(glyph.font->point_size() * static_cast<float>(scale));
+                        unique_glyphs.ensure(&font, [] { return HashTable<u32> {}; }).set(glyph.code_point);
+                    }
+                }
+            }
+        }
+        executor.prepare_glyph_texture(unique_glyphs);
+    }
+
+    if (executor.needs_update_immutable_bitmap_texture_cache()) {
+        HashMap<u32, Gfx::ImmutableBitmap const*> immutable_bitmaps;
+        for (auto const& command_with_scroll_id : m_commands) {
+            auto& command = command_with_scroll_id.command;
+            if (command.has<DrawScaledImmutableBitmap>()) {
+                auto const& immutable_bitmap = command.get<DrawScaledImmutableBitmap>().bitmap;
+                immutable_bitmaps.set(immutable_bitmap->id(), immutable_bitmap.ptr());
+            }
+        }
+        executor.update_immutable_bitmap_texture_cache(immutable_bitmaps);
+    }
+
+    execute_commands(executor, m_commands.size(), [&](size_t index) -> Command const& {
+        return m_commands[index].command;
+    });
+}
+
+void CommandList::execute(CommandExecutor& executor, ReadonlySpan<size_t> command_indices)
+{
+    executor.prepare_to_execute();
+
+    execute_commands(executor, command_indices.size(), [&](size_t index) -> Command const& {
+        return m_commands[command_indices[index]].command;
+    });
+}
+
 }
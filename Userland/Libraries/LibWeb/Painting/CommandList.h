@@ -54,7 +54,7 @@ public:
     virtual CommandResult draw_scaled_immutable_bitmap(Gfx::IntRect const& dst_rect, Gfx::ImmutableBitmap const&, Gfx::IntRect const& src_rect, Gfx::Painter::ScalingMode scaling_mode, Vector<Gfx::Path> const& clip_paths = {}) = 0;
     virtual CommandResult set_clip_rect(Gfx::IntRect const& rect) = 0;
     virtual CommandResult clear_clip_rect() = 0;
-    virtual CommandResult push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask) = 0;
+    virtual CommandResult push_stacking_context(float opacity, bool is_fixed_position, Gfx::IntRect const& source_paintable_rect, Gfx::IntPoint post_transform_translation, CSS::ImageRendering image_rendering, StackingContextTransform transform, Optional<StackingContextMask> mask, Gfx::Bitmap const* composited_contents) = 0;
     virtual CommandResult pop_stacking_context() = 0;
     virtual CommandResult paint_linear_gradient(Gfx::IntRect const&, LinearGradientData const&, Vector<Gfx::Path> const& clip_paths = {}) = 0;
     virtual CommandResult paint_radial_gradient(Gfx::IntRect const& rect, RadialGradientData const&, Gfx::IntPoint const& center, Gfx::IntSize const& size, Vector<Gfx::Path> const& clip_paths = {}) = 0;
@@ -98,6 +98,14 @@ public:
     void apply_scroll_offsets(Vector<Gfx::IntPoint> const& offsets_by_frame_id);
     void execute(CommandExecutor&);
 
+    // Executes only the commands with the given indices, in the given order. The executor must not need
+    // any preparation beyond prepare_to_execute().
+    void execute(CommandExecutor&, ReadonlySpan<size_t> command_indices);
+
+    size_t command_count() const { return m_commands.size(); }
+    Command const& command_at(size_t index) const { return m_commands[index].command; }
+    Command& command_at(size_t index) { return m_commands[index].command; }
+
 private:
     struct CommandWithScrollFrame {
         Optional<i32> scroll_frame_id;
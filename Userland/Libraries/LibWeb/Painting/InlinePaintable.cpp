@@ -256,4 +256,20 @@ CSSPixelRect InlinePaintable::bounding_rect() const
     return bounding_rect;
 }
 
+Optional<CSSPixelRect> InlinePaintable::absolute_damage_rect() const
+{
+    auto rect = Paintable::absolute_damage_rect();
+    if (!rect.has_value())
+        return {};
+
+    auto inline_rect = bounding_rect();
+    for (auto const& shadow : box_shadow_data()) {
+        if (shadow.placement == ShadowPlacement::Inner)
+            continue;
+        auto inflate = shadow.spread_distance + shadow.blur_radius;
+        inline_rect = inline_rect.united(inline_rect.inflated(inflate, inflate, inflate, inflate).translated(shadow.offset_x, shadow.offset_y));
+    }
+    return rect->united(inflated_by_outline(inline_rect, outline_data(), outline_offset()));
+}
+
 }
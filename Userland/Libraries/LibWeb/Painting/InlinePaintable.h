@@ -28,6 +28,7 @@ public:
     auto const& box_model() const { return layout_node().box_model(); }
 
     CSSPixelRect bounding_rect() const;
+    virtual Optional<CSSPixelRect> absolute_damage_rect() const override;
     Vector<PaintableFragment> const& fragments() const { return m_fragments; }
     Vector<PaintableFragment>& fragments() { return m_fragments; }
 
@@ -9,6 +9,7 @@
 #include <LibWeb/Painting/Paintable.h>
 #include <LibWeb/Painting/PaintableBox.h>
 #include <LibWeb/Painting/StackingContext.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
 
 namespace Web::Painting {
 
@@ -129,25 +130,47 @@ void Paintable::invalidate_stacking_context()
 
 void Paintable::set_needs_display() const
 {
-    auto* containing_block = this->containing_block();
-    if (!containing_block)
-        return;
-    auto navigable = this->navigable();
-    if (!navigable)
-        return;
-
-    if (is<Painting::InlinePaintable>(*this)) {
-        auto const& fragments = static_cast<Painting::InlinePaintable const*>(this)->fragments();
-        for (auto const& fragment : fragments)
-            navigable->set_needs_display(fragment.absolute_rect());
-    }
+    if (auto navigable = this->navigable())
+        navigable->set_needs_display(*this);
+}
+
+Optional<CSSPixelRect> Paintable::absolute_damage_rect() const
+{
+    if (!paints_at_absolute_position())
+        return {};
 
-    if (!is<Painting::PaintableWithLines>(*containing_block))
-        return;
+    // NOTE: Paintables that aren't boxes (e.g. text) paint into the fragments of their containing block.
+    //       If there are none to go by, we can't tell where this paintable ends up.
+    auto* containing_block = this->containing_block();
+    if (!containing_block || !is<Painting::PaintableWithLines>(*containing_block))
+        return {};
+    CSSPixelRect rect;
     static_cast<Painting::PaintableWithLines const&>(*containing_block).for_each_fragment([&](auto& fragment) {
-        navigable->set_needs_display(fragment.absolute_rect());
+        rect = rect.united(fragment.absolute_damage_rect());
         return IterationDecision::Continue;
     });
+    return rect;
+}
+
+// Whether this paintable ends up at its absolute position within the viewport's scrollable area, i.e. it's not
+// moved around by fixed positioning, CSS transforms or a scrolled ancestor, and isn't filtered by an ancestor.
+bool Paintable::paints_at_absolute_position() const
+{
+    for (auto const* paintable = this; paintable; paintable = paintable->parent()) {
+        if (is<ViewportPaintable>(*paintable))
+            return paintable != this;
+        if (paintable->is_fixed_position())
+            return false;
+        if (!paintable->computed_values().transformations().is_empty())
+            return false;
+        // NOTE: Filters read pixels outside of the area that changed, so repainting just that area would filter stale content.
+        if (!paintable->computed_values().backdrop_filter().is_none())
+            return false;
+        if (paintable != this && paintable->is_paintable_box() && !static_cast<PaintableBox const&>(*paintable).scroll_offset().is_zero())
+            return false;
+    }
+    // NOTE: This paintable is not part of a paintable tree (anymore), so we can't tell where it ends up.
+    return false;
 }
 
 CSSPixelPoint Paintable::box_type_agnostic_position() const
@@ -179,7 +179,11 @@ public:
 
     JS::GCPtr<HTML::Navigable> navigable() const;
 
-    virtual void set_needs_display() const;
+    void set_needs_display() const;
+
+    // Returns the area this paintable paints into, in the coordinate space of its navigable. Returns an empty Optional
+    // if that area can't be described by such a rect, e.g. because the paintable is transformed or scrolled.
+    virtual Optional<CSSPixelRect> absolute_damage_rect() const;
 
     PaintableBox* containing_block() const
     {
@@ -223,6 +227,8 @@ protected:
 
     virtual void visit_edges(Cell::Visitor&) override;
 
+    bool paints_at_absolute_position() const;
+
 private:
     JS::GCPtr<DOM::Node> m_dom_node;
     JS::NonnullGCPtr<Layout::Node const> m_layout_node;
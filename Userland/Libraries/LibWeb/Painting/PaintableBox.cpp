@@ -954,10 +954,30 @@ TraversalDecision PaintableWithLines::hit_test(CSSPixelPoint position, HitTestTy
     return TraversalDecision::Continue;
 }
 
-void PaintableBox::set_needs_display() const
+Optional<CSSPixelRect> PaintableBox::absolute_damage_rect() const
 {
-    if (auto navigable = this->navigable())
-        navigable->set_needs_display(absolute_rect());
+    if (!paints_at_absolute_position())
+        return {};
+
+    // NOTE: The cached paint rect is not updated when paint-only properties like box-shadow change, so it's computed afresh.
+    auto rect = inflated_by_outline(compute_absolute_paint_rect(), outline_data(), outline_offset());
+
+    // NOTE: Text shadows and decorations of our own fragments may extend past the box.
+    if (is<PaintableWithLines>(*this)) {
+        static_cast<PaintableWithLines const&>(*this).for_each_fragment([&](auto& fragment) {
+            rect = rect.united(fragment.absolute_damage_rect());
+            return IterationDecision::Continue;
+        });
+    }
+    return rect;
+}
+
+CSSPixelRect inflated_by_outline(CSSPixelRect const& rect, Optional<BordersData> const& outline_data, CSSPixels outline_offset)
+{
+    if (!outline_data.has_value())
+        return rect;
+    auto offset = max(outline_offset, CSSPixels(0));
+    return rect.inflated(outline_data->top.width + offset, outline_data->right.width + offset, outline_data->bottom.width + offset, outline_data->left.width + offset);
 }
 
 }
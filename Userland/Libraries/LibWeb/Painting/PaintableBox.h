@@ -128,7 +128,7 @@ public:
     DOM::Node const* dom_node() const { return layout_box().dom_node(); }
     DOM::Node* dom_node() { return layout_box().dom_node(); }
 
-    virtual void set_needs_display() const override;
+    virtual Optional<CSSPixelRect> absolute_damage_rect() const override;
 
     virtual void apply_scroll_offset(PaintContext&, PaintPhase) const override;
     virtual void reset_scroll_offset(PaintContext&, PaintPhase) const override;
@@ -314,6 +314,8 @@ private:
     Vector<PaintableFragment> m_fragments;
 };
 
+CSSPixelRect inflated_by_outline(CSSPixelRect const&, Optional<BordersData> const& outline_data, CSSPixels outline_offset);
+
 void paint_text_decoration(PaintContext&, TextPaintable const&, PaintableFragment const&);
 void paint_cursor_if_needed(PaintContext&, TextPaintable const&, PaintableFragment const&);
 void paint_text_fragment(PaintContext&, TextPaintable const&, PaintableFragment const&, PaintPhase);
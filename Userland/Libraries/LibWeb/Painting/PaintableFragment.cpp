@@ -32,6 +32,31 @@ CSSPixelRect const PaintableFragment::absolute_rect() const
     return rect;
 }
 
+CSSPixelRect PaintableFragment::absolute_damage_rect() const
+{
+    auto fragment_rect = absolute_rect();
+    auto rect = fragment_rect;
+
+    auto const& paintable = this->paintable();
+    if (is<TextPaintable>(paintable) && !paintable.computed_values().text_decoration_line().is_empty()) {
+        // NOTE: See paint_text_decoration(). Overlines are drawn one glyph height above the baseline, underlines just
+        //       below it, and double or wavy lines take up to twice the line thickness.
+        auto& font = layout_node().first_available_font();
+        auto glyph_height = CSSPixels::nearest_value_for(font.pixel_size());
+        auto line_extent = static_cast<TextPaintable const&>(paintable).text_decoration_thickness() * 2 + 2;
+        auto top = min(fragment_rect.top(), fragment_rect.top() + baseline() - glyph_height) - line_extent;
+        auto bottom = max(fragment_rect.bottom(), fragment_rect.top() + baseline() + 2) + line_extent;
+        rect = rect.united({ fragment_rect.left(), top, fragment_rect.width(), bottom - top });
+    }
+
+    for (auto const& shadow : shadows()) {
+        // NOTE: See paint_text_shadow(), which leaves room for twice the blur radius around the shadow.
+        auto inflate = shadow.blur_radius * 2 + max(shadow.spread_distance, CSSPixels(0));
+        rect = rect.united(fragment_rect.inflated(inflate, inflate, inflate, inflate).translated(shadow.offset_x, shadow.offset_y));
+    }
+    return rect;
+}
+
 int PaintableFragment::text_index_at(CSSPixels x) const
 {
     if (!is<TextPaintable>(paintable()))
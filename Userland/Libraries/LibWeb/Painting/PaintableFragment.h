@@ -38,6 +38,9 @@ public:
 
     CSSPixelRect const absolute_rect() const;
 
+    // The area this fragment paints into, including text shadows and text decorations that extend past it.
+    CSSPixelRect absolute_damage_rect() const;
+
     Gfx::GlyphRun const& glyph_run() const { return *m_glyph_run; }
 
     CSSPixelRect selection_rect(Gfx::Font const&) const;
@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/BitCast.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibGfx/Painter.h>
+#include <LibThreading/WorkerThread.h>
+#include <LibWeb/Painting/CommandExecutorCPU.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
+
+namespace Web::Painting {
+
+static constexpr unsigned max_worker_thread_count = 7;
+static constexpr i64 max_compositing_layer_area = 2048 * 2048;
+static constexpr i64 max_compositing_layer_area_per_frame = 4 * max_compositing_layer_area;
+
+TiledRasterizer::TiledRasterizer() = default;
+TiledRasterizer::~TiledRasterizer() = default;
+
+class FingerprintBuilder {
+public:
+    FingerprintBuilder() = default;
+
+    // Positions in the target are hashed relative to the origin, so the same commands painted somewhere else (e.g.
+    // after scrolling) end up with the same fingerprint.
+    explicit FingerprintBuilder(Gfx::IntPoint origin)
+        : m_origin(origin)
+    {
+    }
+
+    template<typename T>
+    void add(T value)
+    {
+        if constexpr (IsEnum<T>)
+            add_bits(to_underlying(value));
+        else if constexpr (IsSame<T, float>)
+            add_bits(bit_cast<u32>(value));
+        else if constexpr (IsSame<T, double>)
+            add_bits(bit_cast<u64>(value));
+        else if constexpr (IsPointer<T>)
+            add_bits(bit_cast<FlatPtr>(value));
+        else
+            add_bits(static_cast<u64>(value));
+    }
+
+    void add(Color color) { add_bits(color.value()); }
+    void add(Gfx::IntPoint point) { add_bits((static_cast<u64>(static_cast<u32>(point.x())) << 32) | static_cast<u32>(point.y())); }
+    void add(Gfx::FloatPoint point)
+    {
+        add(point.x());
+        add(point.y());
+    }
+    void add(Gfx::IntRect const& rect)
+    {
+        add(rect.location());
+        add(Gfx::IntPoint { rect.width(), rect.height() });
+    }
+    void add(Gfx::AntiAliasingPainter::CornerRadius const& radius) { add(Gfx::IntPoint { radius.horizontal_radius, radius.vertical_radius }); }
+    void add(CornerRadii const& corner_radii)
+    {
+        add(corner_radii.top_left);
+        add(corner_radii.top_right);
+        add(corner_radii.bottom_right);
+        add(corner_radii.bottom_left);
+    }
+    void add(BorderDataDevicePixels const& border)
+    {
+        add(border.color);
+        add(border.line_style);
+        add(border.width.value());
+    }
+    void add(ColorStopData const& color_stops)
+    {
+        for (auto const& color_stop : color_stops.list) {
+            add(color_stop.color);
+            add(color_stop.position);
+            add(color_stop.transition_hint.value_or(AK::NaN<float>));
+        }
+        add(color_stops.repeat_length.value_or(AK::NaN<float>));
+    }
+    // NOTE: Fonts are hashed by what they look like rather than by their address, as a font may be freed and another
+    //       one allocated at the same address between two frames.
+    void add(Gfx::Font const& font)
+    {
+        add(font.family().hash());
+        add(font.pixel_size());
+        add(font.weight());
+        add(font.slope());
+        add(font.width());
+    }
+    void add(ReadonlySpan<Gfx::DrawGlyphOrEmoji> glyphs)
+    {
+        // All glyphs of a run usually share one font, so only hash it again when it changes.
+        Gfx::Font const* previous_font = nullptr;
+        auto add_font = [&](Gfx::Font const& font) {
+            if (&font == previous_font)
+                return;
+            add(font);
+            previous_font = &font;
+        };
+        for (auto const& glyph_or_emoji : glyphs) {
+            glyph_or_emoji.visit(
+                [&](Gfx::DrawGlyph const& glyph) {
+                    add(glyph.position);
+                    add(glyph.code_point);
+                    add_font(glyph.font);
+                },
+                [&](Gfx::DrawEmoji const& emoji) {
+                    add(emoji.position);
+                    add(emoji.emoji);
+                    add_font(emoji.font);
+                });
+        }
+    }
+
+    void add_position(Gfx::IntPoint point) { add(point - m_origin); }
+    void add_position(Gfx::FloatPoint point) { add(point - m_origin.to_type<float>()); }
+    void add_position(Gfx::IntRect const& rect) { add(rect.translated(-m_origin)); }
+
+    u64 value() const { return m_value; }
+
+private:
+    void add_bits(u64 bits)
+    {
+        m_value ^= bits + 0x9e3779b97f4a7c15ULL + (m_value << 6) + (m_value >> 2);
+    }
+
+    Gfx::IntPoint m_origin;
+    u64 m_value { 0 };
+};
+
+// Returns a hash of everything that affects the pixels the command paints, or an empty Optional if we can't tell.
+static Optional<u64> command_fingerprint(Command const& command, Gfx::IntPoint origin = {})
+{
+    FingerprintBuilder builder { origin };
+    builder.add(command.index());
+
+    auto has_fingerprint = command.visit(
+        [&](DrawGlyphRun const& command) {
+            builder.add(command.glyph_run->glyphs().span());
+            builder.add(command.color);
+            builder.add_position(command.rect);
+            builder.add_position(command.translation);
+            builder.add(command.scale);
+            return true;
+        },
+        [&](DrawText const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.raw_text.hash());
+            builder.add(command.alignment);
+            builder.add(command.color);
+            builder.add(command.elision);
+            builder.add(command.wrapping);
+            builder.add(command.font.has_value());
+            if (command.font.has_value())
+                builder.add(**command.font);
+            return true;
+        },
+        [&](FillRect const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.color);
+            return command.clip_paths.is_empty();
+        },
+        [&](DrawScaledImmutableBitmap const& command) {
+            builder.add_position(command.dst_rect);
+            builder.add(command.bitmap->id());
+            builder.add(command.src_rect);
+            builder.add(command.scaling_mode);
+            return command.clip_paths.is_empty();
+        },
+        [&](SetClipRect const& command) {
+            builder.add_position(command.rect);
+            return true;
+        },
+        [&](ClearClipRect const&) {
+            return true;
+        },
+        [&](PushStackingContext const& command) {
+            builder.add(command.opacity);
+            builder.add(command.is_fixed_position);
+            builder.add_position(command.source_paintable_rect);
+            builder.add(command.post_transform_translation);
+            builder.add(command.image_rendering);
+            builder.add(command.transform.origin);
+            for (size_t row = 0; row < 4; ++row) {
+                for (size_t column = 0; column < 4; ++column)
+                    builder.add(command.transform.matrix.elements()[row][column]);
+            }
+            return !command.mask.has_value();
+        },
+        [&](PopStackingContext const&) {
+            return true;
+        },
+        [&](PaintLinearGradient const& command) {
+            builder.add_position(command.gradient_rect);
+            builder.add(command.linear_gradient_data.gradient_angle);
+            builder.add(command.linear_gradient_data.color_stops);
+            return command.clip_paths.is_empty();
+        },
+        [&](PaintRadialGradient const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.radial_gradient_data.color_stops);
+            builder.add(command.center);
+            builder.add(Gfx::IntPoint { command.size.width(), command.size.height() });
+            return command.clip_paths.is_empty();
+        },
+        [&](PaintConicGradient const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.conic_gradient_data.start_angle);
+            builder.add(command.conic_gradient_data.color_stops);
+            builder.add(command.position);
+            return command.clip_paths.is_empty();
+        },
+        [&](OneOf<PaintOuterBoxShadow, PaintInnerBoxShadow> auto const& command) {
+            auto const& params = command.outer_box_shadow_params;
+            builder.add_position(params.device_content_rect.template to_type<int>());
+            builder.add(params.corner_radii);
+            builder.add(params.border_radii.has_any_radius());
+            builder.add(params.box_shadow_data.color);
+            builder.add(params.offset_x.value());
+            builder.add(params.offset_y.value());
+            builder.add(params.blur_radius.value());
+            builder.add(params.spread_distance.value());
+            return true;
+        },
+        [&](PaintTextShadow const& command) {
+            builder.add(command.blur_radius);
+            builder.add(command.shadow_bounding_rect);
+            builder.add(command.text_rect);
+            builder.add(command.glyph_run.span());
+            builder.add(command.color);
+            builder.add(command.fragment_baseline);
+            builder.add_position(command.draw_location);
+            return true;
+        },
+        [&](FillRectWithRoundedCorners const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.color);
+            builder.add(command.top_left_radius);
+            builder.add(command.top_right_radius);
+            builder.add(command.bottom_left_radius);
+            builder.add(command.bottom_right_radius);
+            return command.clip_paths.is_empty();
+        },
+        [&](DrawEllipse const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.color);
+            builder.add(command.thickness);
+            return true;
+        },
+        [&](FillEllipse const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.color);
+            return true;
+        },
+        [&](DrawLine const& command) {
+            builder.add(command.color);
+            builder.add_position(command.from);
+            builder.add_position(command.to);
+            builder.add(command.thickness);
+            builder.add(command.style);
+            builder.add(command.alternate_color);
+            return true;
+        },
+        [&](DrawRect const& command) {
+            builder.add_position(command.rect);
+            builder.add(command.color);
+            builder.add(command.rough);
+            return true;
+        },
+        [&](DrawTriangleWave const& command) {
+            builder.add_position(command.p1);
+            builder.add_position(command.p2);
+            builder.add(command.color);
+            builder.add(command.amplitude);
+            builder.add(command.thickness);
+            return true;
+        },
+        [&](SampleUnderCorners const& command) {
+            builder.add(command.id);
+            builder.add(command.corner_radii);
+            builder.add_position(command.border_rect);
+            builder.add(command.corner_clip);
+            return true;
+        },
+        [&](BlitCornerClipping const& command) {
+            builder.add(command.id);
+            builder.add_position(command.border_rect);
+            return true;
+        },
+        [&](PaintBorders const& command) {
+            builder.add_position(command.border_rect.to_type<int>());
+            builder.add(command.corner_radii);
+            builder.add(command.borders_data.top);
+            builder.add(command.borders_data.right);
+            builder.add(command.borders_data.bottom);
+            builder.add(command.borders_data.left);
+            return true;
+        },
+        [&](auto const&) {
+            // NOTE: Paths and paint styles can't be compared cheaply, and the contents of mutable bitmaps
+            //       (e.g. those of canvases) can change without the command changing.
+            return false;
+        });
+
+    if (!has_fingerprint)
+        return {};
+    return builder.value();
+}
+
+// FIXME: Fonts rasterize and cache glyphs on first use, and paths compute their split lines lazily. Neither is
+//        safe to do from several threads at once, and reference counts aren't atomic either, so commands that
+//        paint text or paths have to stay on the main thread for now.
+static bool can_be_executed_off_the_main_thread(Command const& command)
+{
+    return command.visit(
+        [](OneOf<DrawGlyphRun, DrawText, PaintTextShadow, FillPathUsingColor, FillPathUsingPaintStyle, StrokePathUsingColor, StrokePathUsingPaintStyle, ApplyBackdropFilter> auto const&) {
+            return false;
+        },
+        [](OneOf<FillRect, DrawScaledImmutableBitmap, PaintLinearGradient, PaintRadialGradient, PaintConicGradient, FillRectWithRoundedCorners> auto const& command) {
+            return command.clip_paths.is_empty();
+        },
+        [](PushStackingContext const& command) {
+            return !command.mask.has_value();
+        },
+        [](auto const&) {
+            return true;
+        });
+}
+
+static Optional<Gfx::IntRect> command_bounding_rectangle(Command const& command)
+{
+    return command.visit(
+        [&](auto const& command) -> Optional<Gfx::IntRect> {
+            if constexpr (requires { command.bounding_rect(); })
+                return command.bounding_rect();
+            else
+                return {};
+        });
+}
+
+// Returns the rectangle of the target that each command can paint to, or an empty Optional if it may paint anywhere.
+static Vector<Optional<Gfx::IntRect>> target_rects_of_commands(CommandList const& command_list)
+{
+    struct StackingContextState {
+        Gfx::IntPoint translation;
+        // Stacking contexts that are painted into a separate bitmap can end up anywhere within their destination.
+        Optional<Gfx::IntRect> destination;
+    };
+
+    Vector<Optional<Gfx::IntRect>> rects;
+    rects.ensure_capacity(command_list.command_count());
+    Vector<StackingContextState> stacking_contexts;
+    stacking_contexts.append({});
+
+    for (size_t i = 0; i < command_list.command_count(); ++i) {
+        auto const& command = command_list.command_at(i);
+        auto state = stacking_contexts.last();
+
+        if (command.has<PushStackingContext>()) {
+            auto const& push_stacking_context = command.get<PushStackingContext>();
+            if (push_stacking_context.is_fixed_position && !state.destination.has_value())
+                state.translation = {};
+
+            auto affine_transform = Gfx::extract_2d_affine_transform(push_stacking_context.transform.matrix);
+            if (!push_stacking_context.mask.has_value() && push_stacking_context.opacity == 1.0f && affine_transform.is_identity_or_translation()) {
+                state.translation.translate_by(affine_transform.translation().to_rounded<int>() + push_stacking_context.post_transform_translation);
+            } else if (!state.destination.has_value()) {
+                auto destination = push_stacking_context.source_paintable_rect;
+                if (!push_stacking_context.mask.has_value()) {
+                    auto source_rect = push_stacking_context.source_paintable_rect.to_type<float>().translated(-push_stacking_context.transform.origin);
+                    destination = affine_transform.map(source_rect).translated(push_stacking_context.transform.origin).to_rounded<int>();
+                }
+                state.destination = destination.translated(state.translation + push_stacking_context.post_transform_translation);
+            }
+
+            // NOTE: Pushing a stacking context may sample what has been painted below it, so it goes to every tile.
+            rects.append({});
+            stacking_contexts.append(state);
+            continue;
+        }
+
+        if (command.has<PopStackingContext>()) {
+            rects.append({});
+            if (stacking_contexts.size() > 1)
+                stacking_contexts.take_last();
+            continue;
+        }
+
+        auto bounding_rect = command_bounding_rectangle(command);
+        if (!bounding_rect.has_value()) {
+            rects.append({});
+        } else if (bounding_rect->is_empty()) {
+            rects.append(Gfx::IntRect {});
+        } else if (state.destination.has_value()) {
+            rects.append(state.destination);
+        } else {
+            rects.append(bounding_rect->translated(state.translation));
+        }
+    }
+    return rects;
+}
+
+static Optional<size_t> index_of_matching_pop(CommandList const& command_list, size_t push_command_index)
+{
+    size_t nesting_level = 0;
+    for (size_t i = push_command_index; i < command_list.command_count(); ++i) {
+        auto const& command = command_list.command_at(i);
+        if (command.has<PushStackingContext>())
+            ++nesting_level;
+        else if (command.has<PopStackingContext>() && --nesting_level == 0)
+            return i;
+    }
+    return {};
+}
+
+// Returns a hash of the contents of a stacking context relative to its origin, or an empty Optional if they can't be
+// rasterized on their own.
+static Optional<u64> fingerprint_of_layer_contents(CommandList const& command_list, size_t push_command_index, size_t pop_command_index)
+{
+    auto const& source_rect = command_list.command_at(push_command_index).get<PushStackingContext>().source_paintable_rect;
+    FingerprintBuilder builder;
+    builder.add(Gfx::IntPoint { source_rect.width(), source_rect.height() });
+    for (size_t i = push_command_index + 1; i < pop_command_index; ++i) {
+        auto const& command = command_list.command_at(i);
+        // NOTE: Where fixed-position descendants end up doesn't depend on the origin of the layer.
+        if (auto const* push_stacking_context = command.get_pointer<PushStackingContext>(); push_stacking_context && push_stacking_context->is_fixed_position)
+            return {};
+        auto fingerprint = command_fingerprint(command, source_rect.location());
+        if (!fingerprint.has_value())
+            return {};
+        builder.add(*fingerprint);
+    }
+    return builder.value();
+}
+
+Vector<TiledRasterizer::LayerInFrame> TiledRasterizer::prepare_compositing_layers(CommandList& command_list, Gfx::IntRect const& target_rect, FrameStatistics& statistics)
+{
+    Vector<LayerInFrame> layers;
+    u64 layer_area_in_frame = 0;
+
+    // The translations of the stacking contexts that are painted directly into the target.
+    Vector<Gfx::IntPoint> translations;
+    translations.append({});
+
+    for (size_t i = 0; i < command_list.command_count(); ++i) {
+        auto const& command = command_list.command_at(i);
+        if (command.has<PopStackingContext>()) {
+            if (translations.size() > 1)
+                translations.take_last();
+            continue;
+        }
+        if (!command.has<PushStackingContext>())
+            continue;
+
+        auto const& push_stacking_context = command.get<PushStackingContext>();
+        auto translation = push_stacking_context.is_fixed_position ? Gfx::IntPoint {} : translations.last();
+        auto affine_transform = Gfx::extract_2d_affine_transform(push_stacking_context.transform.matrix);
+        if (!push_stacking_context.mask.has_value() && push_stacking_context.opacity == 1.0f && affine_transform.is_identity_or_translation()) {
+            translations.append(translation + affine_transform.translation().to_rounded<int>() + push_stacking_context.post_transform_translation);
+            continue;
+        }
+
+        // NOTE: Only the outermost stacking contexts that are painted into a separate bitmap can become layers, as
+        //       anything nested in them is part of their contents.
+        auto pop_command_index = index_of_matching_pop(command_list, i);
+        if (!pop_command_index.has_value())
+            break;
+        if (auto layer = prepare_compositing_layer(command_list, i, *pop_command_index, translation, target_rect, layer_area_in_frame, statistics); layer.has_value())
+            layers.append(layer.release_value());
+        i = *pop_command_index;
+    }
+    return layers;
+}
+
+Optional<TiledRasterizer::LayerInFrame> TiledRasterizer::prepare_compositing_layer(CommandList& command_list, size_t push_command_index, size_t pop_command_index, Gfx::IntPoint translation, Gfx::IntRect const& target_rect, u64& layer_area_in_frame, FrameStatistics& statistics)
+{
+    auto& push_stacking_context = command_list.command_at(push_command_index).get<PushStackingContext>();
+    if (push_stacking_context.mask.has_value())
+        return {};
+
+    auto const& source_rect = push_stacking_context.source_paintable_rect;
+    auto area = static_cast<i64>(source_rect.width()) * source_rect.height();
+    if (source_rect.is_empty() || area > max_compositing_layer_area)
+        return {};
+
+    auto affine_transform = Gfx::extract_2d_affine_transform(push_stacking_context.transform.matrix);
+    auto const& transform_origin = push_stacking_context.transform.origin;
+    auto destination = affine_transform.map(source_rect.to_type<float>().translated(-transform_origin)).translated(transform_origin).to_rounded<int>();
+    destination.translate_by(translation + push_stacking_context.post_transform_translation);
+    if (!destination.intersects(target_rect))
+        return {};
+
+    auto contents_fingerprint = fingerprint_of_layer_contents(command_list, push_command_index, pop_command_index);
+    if (!contents_fingerprint.has_value())
+        return {};
+
+    // OPTIMIZATION: Contents that change in every frame would have to be rasterized in full every time, instead of
+    //               just the part that's visible, so they only become a layer once they are the same in two frames.
+    auto it = m_compositing_layers.find(*contents_fingerprint);
+    if (it == m_compositing_layers.end()) {
+        m_compositing_layers.set(*contents_fingerprint, { .bitmap = nullptr, .last_used_frame = m_frame_count });
+        return {};
+    }
+
+    auto& layer = it->value;
+    layer.last_used_frame = m_frame_count;
+
+    // NOTE: A layer that doesn't fit into this frame's budget is painted directly into the target. Its bitmap is
+    //       dropped so the budget also limits how much memory is kept alive, but the layer stays a candidate.
+    if (layer_area_in_frame + area > max_compositing_layer_area_per_frame) {
+        layer.bitmap = nullptr;
+        return {};
+    }
+
+    if (layer.bitmap) {
+        ++statistics.reused_compositing_layer_count;
+    } else {
+        auto bitmap_or_error = Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, source_rect.size());
+        if (bitmap_or_error.is_error())
+            return {};
+        layer.bitmap = bitmap_or_error.release_value();
+        layer.bitmap->fill(Color::Transparent);
+
+        Vector<size_t> command_indices;
+        command_indices.ensure_capacity(pop_command_index - push_command_index - 1);
+        for (size_t i = push_command_index + 1; i < pop_command_index; ++i)
+            command_indices.unchecked_append(i);
+        CommandExecutorCPU executor(*layer.bitmap, source_rect.location());
+        command_list.execute(executor, command_indices);
+    }
+
+    layer_area_in_frame += area;
+    ++statistics.compositing_layer_count;
+    push_stacking_context.composited_contents = layer.bitmap.ptr();
+    return LayerInFrame {
+        .push_command_index = push_command_index,
+        .pop_command_index = pop_command_index,
+        .destination = destination,
+        .contents_fingerprint = *contents_fingerprint,
+    };
+}
+
+void TiledRasterizer::ensure_worker_threads()
+{
+    if (m_did_create_worker_threads)
+        return;
+    m_did_create_worker_threads = true;
+
+    auto worker_thread_count = min(max(Core::System::hardware_concurrency(), 1u) - 1, max_worker_thread_count);
+    for (unsigned i = 0; i < worker_thread_count; ++i) {
+        auto worker_thread_or_error = Threading::WorkerThread<Error>::create("Tile rasterizer"sv);
+        if (worker_thread_or_error.is_error()) {
+            dbgln("Unable to create tile rasterizer thread: {}", worker_thread_or_error.error());
+            break;
+        }
+        m_worker_threads.append(worker_thread_or_error.release_value());
+    }
+}
+
+void TiledRasterizer::rasterize_untiled(CommandList& command_list, Gfx::Bitmap& target)
+{
+    CommandExecutorCPU executor(target);
+    command_list.execute(executor);
+}
+
+ErrorOr<void> TiledRasterizer::rasterize_tile(CommandList& command_list, TileJob& job, Gfx::BitmapFormat format)
+{
+    auto& tile = m_tiles[job.tile_index];
+    if (!tile.bitmap)
+        tile.bitmap = TRY(Gfx::Bitmap::create(format, { tile_size, tile_size }));
+    tile.bitmap->fill(Color::Transparent);
+
+    CommandExecutorCPU executor(*tile.bitmap, job.rect.location());
+    command_list.execute(executor, job.command_indices);
+    return {};
+}
+
+void TiledRasterizer::rasterize(CommandList& command_list, Gfx::Bitmap& target, Optional<Vector<Gfx::IntRect>> const& damage_rects)
+{
+    Core::ElapsedTimer timer { Core::TimerType::Precise };
+    timer.start();
+
+    FrameStatistics statistics;
+
+    Vector<LayerInFrame> layers;
+    if (target.scale() == 1)
+        layers = prepare_compositing_layers(command_list, target.rect(), statistics);
+    ScopeGuard forget_composited_contents = [&] {
+        for (auto const& layer : layers)
+            command_list.command_at(layer.push_command_index).get<PushStackingContext>().composited_contents = nullptr;
+    };
+
+    // NOTE: Backdrop filters read back what has been painted below them, which would leave seams at the edges of
+    //       tiles, so lists that use them are rasterized as a whole.
+    bool can_be_tiled = target.scale() == 1;
+    for (size_t i = 0; can_be_tiled && i < command_list.command_count(); ++i) {
+        if (command_list.command_at(i).has<ApplyBackdropFilter>())
+            can_be_tiled = false;
+    }
+    if (!can_be_tiled) {
+        rasterize_untiled(command_list, target);
+        statistics.frame_time = timer.elapsed_time();
+        did_rasterize_frame(statistics);
+        return;
+    }
+
+    ensure_worker_threads();
+
+    auto target_rect = target.rect();
+    auto columns = ceil_div(target_rect.width(), tile_size);
+    auto rows = ceil_div(target_rect.height(), tile_size);
+    if (m_target_size != target_rect.size() || m_target_format != target.format()) {
+        m_tiles.clear();
+        m_tiles.resize(columns * rows);
+        m_target_size = target_rect.size();
+        m_target_format = target.format();
+    }
+
+    Vector<TileJob> tile_jobs;
+    tile_jobs.resize(m_tiles.size());
+    for (int row = 0; row < rows; ++row) {
+        for (int column = 0; column < columns; ++column) {
+            auto tile_index = row * columns + column;
+            tile_jobs[tile_index].tile_index = tile_index;
+            tile_jobs[tile_index].rect = Gfx::IntRect { column * tile_size, row * tile_size, tile_size, tile_size }.intersected(target_rect);
+            if (damage_rects.has_value())
+                tile_jobs[tile_index].is_damaged = tile_jobs[tile_index].rect.intersects(*damage_rects);
+        }
+    }
+
+    struct TileCommands {
+        FingerprintBuilder fingerprint;
+        bool has_fingerprint { true };
+        bool needs_main_thread { false };
+    };
+    Vector<TileCommands> tile_commands;
+    tile_commands.resize(m_tiles.size());
+
+    auto assign_to_tiles = [&](Optional<Gfx::IntRect> const& rect, ReadonlySpan<size_t> command_indices, Optional<u64> fingerprint, bool needs_main_thread) {
+        int first_column = 0;
+        int last_column = columns - 1;
+        int first_row = 0;
+        int last_row = rows - 1;
+        if (rect.has_value()) {
+            auto clipped_rect = rect->intersected(target_rect);
+            if (clipped_rect.is_empty())
+                return;
+            first_column = clipped_rect.left() / tile_size;
+            last_column = (clipped_rect.right() - 1) / tile_size;
+            first_row = clipped_rect.top() / tile_size;
+            last_row = (clipped_rect.bottom() - 1) / tile_size;
+        }
+
+        for (int row = first_row; row <= last_row; ++row) {
+            for (int column = first_column; column <= last_column; ++column) {
+                auto tile_index = row * columns + column;
+                if (!tile_jobs[tile_index].is_damaged)
+                    continue;
+                tile_jobs[tile_index].command_indices.append(command_indices.data(), command_indices.size());
+                if (fingerprint.has_value())
+                    tile_commands[tile_index].fingerprint.add(*fingerprint);
+                else
+                    tile_commands[tile_index].has_fingerprint = false;
+                if (needs_main_thread)
+                    tile_commands[tile_index].needs_main_thread = true;
+            }
+        }
+    };
+
+    auto target_rects = target_rects_of_commands(command_list);
+    size_t next_layer_index = 0;
+    for (size_t command_index = 0; command_index < command_list.command_count(); ++command_index) {
+        auto const& command = command_list.command_at(command_index);
+
+        if (next_layer_index < layers.size() && layers[next_layer_index].push_command_index == command_index) {
+            // NOTE: A compositing layer only paints within its destination, and none of its contents are executed.
+            auto const& layer = layers[next_layer_index++];
+            FingerprintBuilder fingerprint;
+            fingerprint.add(command_fingerprint(command).value());
+            fingerprint.add(layer.contents_fingerprint);
+            Array<size_t, 2> command_indices { layer.push_command_index, layer.pop_command_index };
+            assign_to_tiles(layer.destination, command_indices, fingerprint.value(), !can_be_executed_off_the_main_thread(command));
+            command_index = layer.pop_command_index;
+            continue;
+        }
+
+        assign_to_tiles(target_rects[command_index], { &command_index, 1 }, command_fingerprint(command), !can_be_executed_off_the_main_thread(command));
+    }
+
+    Vector<size_t> main_thread_jobs;
+    Vector<size_t> worker_thread_jobs;
+    for (size_t tile_index = 0; tile_index < m_tiles.size(); ++tile_index) {
+        // OPTIMIZATION: Tiles outside of the damage are still up to date in the target, so they are left alone.
+        if (!tile_jobs[tile_index].is_damaged) {
+            tile_jobs[tile_index].succeeded = true;
+            ++statistics.undamaged_tile_count;
+            continue;
+        }
+
+        auto& tile = m_tiles[tile_index];
+        Optional<u64> fingerprint;
+        if (tile_commands[tile_index].has_fingerprint)
+            fingerprint = tile_commands[tile_index].fingerprint.value();
+
+        // OPTIMIZATION: If the tile would execute the same commands as last time, the pixels in its bitmap are still good.
+        if (tile.bitmap && fingerprint.has_value() && tile.fingerprint == fingerprint) {
+            tile_jobs[tile_index].succeeded = true;
+            ++statistics.reused_tile_count;
+            continue;
+        }
+
+        tile.fingerprint = fingerprint;
+        if (tile_commands[tile_index].needs_main_thread || m_worker_threads.is_empty())
+            main_thread_jobs.append(tile_index);
+        else
+            worker_thread_jobs.append(tile_index);
+    }
+
+    Atomic<size_t> next_worker_thread_job { 0 };
+    auto run_worker_thread_jobs = [&] {
+        while (true) {
+            auto index = next_worker_thread_job.fetch_add(1);
+            if (index >= worker_thread_jobs.size())
+                return;
+            auto& job = tile_jobs[worker_thread_jobs[index]];
+            job.succeeded = !rasterize_tile(command_list, job, target.format()).is_error();
+        }
+    };
+
+    Vector<Threading::WorkerThread<Error>*> busy_worker_threads;
+    if (!worker_thread_jobs.is_empty()) {
+        for (auto& worker_thread : m_worker_threads) {
+            if (busy_worker_threads.size() >= worker_thread_jobs.size())
+                break;
+            auto did_start = worker_thread->start_task([&]() -> ErrorOr<void> {
+                run_worker_thread_jobs();
+                return {};
+            });
+            if (did_start)
+                busy_worker_threads.append(worker_thread.ptr());
+        }
+    }
+
+    for (auto tile_index : main_thread_jobs) {
+        auto& job = tile_jobs[tile_index];
+        job.succeeded = !rasterize_tile(command_list, job, target.format()).is_error();
+    }
+
+    // NOTE: Help out with whatever the worker threads haven't picked up yet.
+    run_worker_thread_jobs();
+    for (auto& worker_thread : busy_worker_threads)
+        MUST(worker_thread->wait_until_task_is_finished());
+
+    bool did_all_tiles_succeed = true;
+    for (auto& job : tile_jobs) {
+        if (!job.succeeded) {
+            did_all_tiles_succeed = false;
+            m_tiles[job.tile_index] = {};
+        }
+    }
+
+    if (!did_all_tiles_succeed) {
+        dbgln("Unable to allocate tiles for rasterization, falling back to painting the whole viewport at once");
+        rasterize_untiled(command_list, target);
+        statistics.frame_time = timer.elapsed_time();
+        did_rasterize_frame(statistics);
+        return;
+    }
+
+    Gfx::Painter painter(target);
+    for (auto const& job : tile_jobs) {
+        if (!job.is_damaged)
+            continue;
+        painter.blit(job.rect.location(), *m_tiles[job.tile_index].bitmap, { {}, job.rect.size() }, 1.0f, false);
+    }
+
+    statistics.was_tiled = true;
+    statistics.tile_count = m_tiles.size();
+    statistics.tiles_rasterized_on_worker_threads = worker_thread_jobs.size();
+    statistics.frame_time = timer.elapsed_time();
+    did_rasterize_frame(statistics);
+}
+
+void TiledRasterizer::did_rasterize_frame(FrameStatistics statistics)
+{
+    m_compositing_layers.remove_all_matching([&](u64, CompositingLayer const& layer) {
+        return layer.last_used_frame != m_frame_count;
+    });
+
+    m_last_frame_statistics = statistics;
+    m_total_frame_time += statistics.frame_time;
+    m_worst_frame_time = max(m_worst_frame_time, statistics.frame_time);
+    m_total_tile_count += statistics.tile_count;
+    m_total_reused_tile_count += statistics.reused_tile_count;
+    m_total_undamaged_tile_count += statistics.undamaged_tile_count;
+    m_total_compositing_layer_count += statistics.compositing_layer_count;
+    m_total_reused_compositing_layer_count += statistics.reused_compositing_layer_count;
+    ++m_frame_count;
+}
+
+void TiledRasterizer::dump_statistics() const
+{
+    dbgln("Rasterization statistics ({} frame(s), {} worker thread(s), {}x{} tiles)", m_frame_count, m_worker_threads.size(), tile_size, tile_size);
+    if (m_frame_count == 0)
+        return;
+
+    auto const& last_frame = m_last_frame_statistics;
+    if (last_frame.was_tiled) {
+        dbgln("  Last frame: {}us, {} tile(s), {} undamaged, {} reused, {} rasterized on worker threads",
+            last_frame.frame_time.to_microseconds(), last_frame.tile_count, last_frame.undamaged_tile_count, last_frame.reused_tile_count, last_frame.tiles_rasterized_on_worker_threads);
+    } else {
+        dbgln("  Last frame: {}us, not tiled", last_frame.frame_time.to_microseconds());
+    }
+    dbgln("  Average frame: {}us, worst frame: {}us", m_total_frame_time.to_microseconds() / static_cast<i64>(m_frame_count), m_worst_frame_time.to_microseconds());
+    dbgln("  Skipped {} undamaged and reused {} of {} tile(s)", m_total_undamaged_tile_count, m_total_reused_tile_count, m_total_tile_count);
+    dbgln("  Composited {} layer(s) in the last frame, reused {} of {} layer(s) overall, {} layer(s) cached",
+        last_frame.compositing_layer_count, m_total_reused_compositing_layer_count, m_total_compositing_layer_count, m_compositing_layers.size());
+}
+
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibGfx/Bitmap.h>
+#include <LibThreading/Forward.h>
+#include <LibWeb/Painting/CommandList.h>
+
+namespace Web::Painting {
+
+// Rasterizes a command list in tiles. Each tile only executes the commands that can touch it, and tiles are
+// spread over a pool of worker threads. Tiles whose commands did not change since the last frame are reused.
+// When damage rects are given, the target is assumed to be up to date outside of them and only the tiles that
+// intersect the damage are rasterized and copied into it.
+//
+// Stacking contexts that are painted into a separate bitmap because of their opacity or transform become compositing
+// layers once their contents stay the same for two frames. The contents of a layer are rasterized once and kept
+// until they change, so animating the opacity or transform of the stacking context, or scrolling it around, only
+// composites the layer again.
+class TiledRasterizer {
+public:
+    static constexpr int tile_size = 256;
+
+    struct FrameStatistics {
+        Duration frame_time;
+        size_t tile_count { 0 };
+        size_t reused_tile_count { 0 };
+        size_t undamaged_tile_count { 0 };
+        size_t tiles_rasterized_on_worker_threads { 0 };
+        size_t compositing_layer_count { 0 };
+        size_t reused_compositing_layer_count { 0 };
+        bool was_tiled { false };
+    };
+
+    TiledRasterizer();
+    ~TiledRasterizer();
+
+    void rasterize(CommandList&, Gfx::Bitmap& target, Optional<Vector<Gfx::IntRect>> const& damage_rects = {});
+
+    FrameStatistics const& last_frame_statistics() const { return m_last_frame_statistics; }
+    void dump_statistics() const;
+
+private:
+    struct Tile {
+        RefPtr<Gfx::Bitmap> bitmap;
+        // A hash of the commands that were rasterized into the bitmap, if all of them could be hashed.
+        Optional<u64> fingerprint;
+    };
+
+    struct TileJob {
+        size_t tile_index { 0 };
+        Gfx::IntRect rect;
+        Vector<size_t> command_indices;
+        bool is_damaged { true };
+        bool succeeded { false };
+    };
+
+    struct CompositingLayer {
+        // Null until the contents have been seen twice.
+        RefPtr<Gfx::Bitmap> bitmap;
+        u64 last_used_frame { 0 };
+    };
+
+    // A compositing layer that is used by the command list that is currently being rasterized.
+    struct LayerInFrame {
+        size_t push_command_index { 0 };
+        size_t pop_command_index { 0 };
+        Gfx::IntRect destination;
+        u64 contents_fingerprint { 0 };
+    };
+
+    Vector<LayerInFrame> prepare_compositing_layers(CommandList&, Gfx::IntRect const& target_rect, FrameStatistics&);
+    Optional<LayerInFrame> prepare_compositing_layer(CommandList&, size_t push_command_index, size_t pop_command_index, Gfx::IntPoint translation, Gfx::IntRect const& target_rect, u64& layer_area_in_frame, FrameStatistics&);
+
+    void ensure_worker_threads();
+    void rasterize_untiled(CommandList&, Gfx::Bitmap& target);
+    ErrorOr<void> rasterize_tile(CommandList&, TileJob&, Gfx::BitmapFormat);
+    void did_rasterize_frame(FrameStatistics);
+
+    Vector<Tile> m_tiles;
+    Gfx::IntSize m_target_size;
+    Gfx::BitmapFormat m_target_format { Gfx::BitmapFormat::Invalid };
+
+    // Keyed by a hash of the contents of the layer, relative to its origin.
+    HashMap<u64, CompositingLayer> m_compositing_layers;
+
+    Vector<NonnullOwnPtr<Threading::WorkerThread<Error>>> m_worker_threads;
+    bool m_did_create_worker_threads { false };
+
+    FrameStatistics m_last_frame_statistics;
+    Duration m_total_frame_time;
+    Duration m_worst_frame_time;
+    u64 m_frame_count { 0 };
+    u64 m_total_tile_count { 0 };
+    u64 m_total_reused_tile_count { 0 };
+    u64 m_total_undamaged_tile_count { 0 };
+    u64 m_total_compositing_layer_count { 0 };
+    u64 m_total_reused_compositing_layer_count { 0 };
+};
+
+}
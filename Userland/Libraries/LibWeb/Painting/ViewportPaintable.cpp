@@ -69,6 +69,9 @@ void ViewportPaintable::paint_all_phases(PaintContext& context)
 
 void ViewportPaintable::assign_scroll_frames()
 {
+    // NOTE: After laying out a subtree, some of the paintables we had scroll frames for are gone.
+    scroll_state.clear();
+
     int next_id = 0;
     for_each_in_subtree_of_type<PaintableBox>([&](auto const& paintable_box) {
         if (paintable_box.has_scrollable_overflow()) {
@@ -98,6 +101,8 @@ void ViewportPaintable::assign_scroll_frames()
 
 void ViewportPaintable::assign_clip_frames()
 {
+    clip_state.clear();
+
     for_each_in_subtree_of_type<PaintableBox>([&](auto const& paintable_box) {
         auto overflow_x = paintable_box.computed_values().overflow_x();
         auto overflow_y = paintable_box.computed_values().overflow_y();
@@ -34,8 +34,13 @@ OutOfProcessWebView::OutOfProcessWebView()
         set_content_size(content_size);
     };
 
-    on_ready_to_paint = [this]() {
-        update();
+    on_ready_to_paint = [this](auto const& damage_rects) {
+        if (m_content_scales_to_viewport) {
+            update();
+            return;
+        }
+        for (auto const& rect : damage_rects)
+            update(rect.translated(frame_thickness(), frame_thickness()));
     };
 
     on_request_file = [this](auto const& path, auto request_id) {
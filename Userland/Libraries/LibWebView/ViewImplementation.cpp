@@ -60,15 +60,20 @@ u64 ViewImplementation::page_id() const
     return m_client_state.page_index;
 }
 
-void ViewImplementation::server_did_paint(Badge<WebContentClient>, i32 bitmap_id, Gfx::IntSize size)
+void ViewImplementation::server_did_paint(Badge<WebContentClient>, i32 bitmap_id, Gfx::IntSize size, Vector<Gfx::IntRect> const& damage_rects)
 {
     if (m_client_state.back_bitmap.id == bitmap_id) {
-        m_client_state.has_usable_bitmap = true;
+        // NOTE: If we were showing the backup bitmap (or nothing at all), the whole view has changed.
+        bool had_usable_bitmap = exchange(m_client_state.has_usable_bitmap, true);
         m_client_state.back_bitmap.last_painted_size = size.to_type<Web::DevicePixels>();
         swap(m_client_state.back_bitmap, m_client_state.front_bitmap);
         m_backup_bitmap = nullptr;
-        if (on_ready_to_paint)
-            on_ready_to_paint();
+        if (on_ready_to_paint) {
+            if (had_usable_bitmap)
+                on_ready_to_paint(damage_rects);
+            else
+                on_ready_to_paint({ { {}, size } });
+        }
     }
 
     client().async_ready_to_paint(page_id());
@@ -37,7 +37,7 @@ private:
     virtual void die() override;
 
     virtual void notify_process_information(WebView::ProcessHandle const&) override;
-    virtual void did_paint(u64 page_id, Gfx::IntRect const&, i32) override;
+    virtual void did_paint(u64 page_id, Gfx::IntRect const&, i32, Vector<Gfx::IntRect> const&) override;
     virtual void did_finish_loading(u64 page_id, URL::URL const&) override;
     virtual void did_request_navigate_back(u64 page_id) override;
     virtual void did_request_navigate_forward(u64 page_id) override;
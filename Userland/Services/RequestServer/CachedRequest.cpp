@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/File.h>
+#include <RequestServer/CachedRequest.h>
+
+namespace RequestServer {
+
+CachedRequest::CachedRequest(ConnectionFromClient& client, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id, URL::URL url)
+    : Request(client, move(output_stream), request_id)
+    , m_url(move(url))
+{
+}
+
+NonnullOwnPtr<CachedRequest> CachedRequest::create(ConnectionFromClient& client, NonnullOwnPtr<Core::File>&& output_stream, i32 request_id, URL::URL url, HttpCache::Entry entry)
+{
+    auto request = adopt_own(*new CachedRequest(client, move(output_stream), request_id, move(url)));
+    request->serve_from_cache(move(entry));
+    return request;
+}
+
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullOwnPtr.h>
+#include <LibCore/Forward.h>
+#include <RequestServer/HttpCache.h>
+#include <RequestServer/Request.h>
+
+namespace RequestServer {
+
+// A request that is answered from the HTTP cache without going to the network.
+class CachedRequest final : public Request {
+public:
+    virtual ~CachedRequest() override = default;
+    static NonnullOwnPtr<CachedRequest> create(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id, URL::URL, HttpCache::Entry);
+
+    virtual URL::URL url() const override { return m_url; }
+
+private:
+    CachedRequest(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id, URL::URL);
+
+    URL::URL m_url;
+};
+
+}
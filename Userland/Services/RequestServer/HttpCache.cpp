@@ -0,0 +1,547 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Debug.h>
+#include <AK/Hex.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA1.h>
+#include <LibHTTP/Caching.h>
+#include <LibThreading/BackgroundAction.h>
+#include <RequestServer/HttpCache.h>
+
+namespace RequestServer {
+
+using ResponseHeaders = HashMap<ByteString, ByteString, CaseInsensitiveStringTraits>;
+
+static Optional<ByteString> find_request_header(HashMap<ByteString, ByteString> const& headers, StringView name)
+{
+    for (auto const& header : headers) {
+        if (header.key.equals_ignoring_ascii_case(name))
+            return header.value;
+    }
+    return {};
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-storing-header-and-trailer-
+static bool is_excluded_from_storage(StringView header_name)
+{
+    // NOTE: Cookies are not replayed from the cache, they only ever come from the network.
+    static constexpr Array excluded_headers {
+        "Connection"sv,
+        "Keep-Alive"sv,
+        "Proxy-Authenticate"sv,
+        "Proxy-Authentication-Info"sv,
+        "Proxy-Connection"sv,
+        "Set-Cookie"sv,
+        "Set-Cookie2"sv,
+        "TE"sv,
+        "Trailer"sv,
+        "Transfer-Encoding"sv,
+        "Upgrade"sv,
+    };
+    return any_of(excluded_headers, [&](auto excluded_header) { return header_name.equals_ignoring_ascii_case(excluded_header); });
+}
+
+static ByteString cache_key_for(URL::URL const& url)
+{
+    auto digest = Crypto::Hash::SHA1::hash(url.serialize(URL::ExcludeFragment::Yes));
+    return encode_hex(digest.bytes());
+}
+
+Duration HttpCache::Entry::current_age() const
+{
+    return HTTP::current_age(response_headers, request_time, response_time, UnixDateTime::now());
+}
+
+Duration HttpCache::Entry::freshness_lifetime() const
+{
+    return HTTP::freshness_lifetime(response_headers, response_time);
+}
+
+bool HttpCache::Entry::has_validators() const
+{
+    return response_headers.contains("ETag"sv) || response_headers.contains("Last-Modified"sv);
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-constructing-responses-from
+bool HttpCache::Entry::can_be_served_without_revalidation(HashMap<ByteString, ByteString> const& request_headers) const
+{
+    auto response_cache_control = HTTP::parse_cache_control(response_headers.get("Cache-Control"sv).value_or({}));
+    if (response_cache_control.no_cache)
+        return false;
+
+    auto request_cache_control_header = find_request_header(request_headers, "Cache-Control"sv);
+    auto request_cache_control = HTTP::parse_cache_control(request_cache_control_header.value_or({}));
+    if (request_cache_control.no_cache)
+        return false;
+
+    // NOTE: Pragma is only considered when there is no Cache-Control header.
+    if (!request_cache_control_header.has_value()) {
+        if (auto pragma = find_request_header(request_headers, "Pragma"sv); pragma.has_value() && pragma->contains("no-cache"sv, CaseSensitivity::CaseInsensitive))
+            return false;
+    }
+
+    auto age = current_age();
+    if (request_cache_control.max_age.has_value() && age > Duration::from_seconds(*request_cache_control.max_age))
+        return false;
+
+    return freshness_lifetime() > age;
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-sending-a-validation-reques
+void HttpCache::Entry::add_validators_to(HashMap<ByteString, ByteString>& request_headers) const
+{
+    if (auto etag = response_headers.get("ETag"sv); etag.has_value())
+        request_headers.set("If-None-Match", *etag);
+    if (auto last_modified = response_headers.get("Last-Modified"sv); last_modified.has_value())
+        request_headers.set("If-Modified-Since", *last_modified);
+}
+
+ResponseHeaders HttpCache::Entry::response_headers_for_serving() const
+{
+    auto headers = response_headers;
+    headers.set("Age", ByteString::number(max(current_age().to_seconds(), 0)));
+    return headers;
+}
+
+HttpCache& HttpCache::the()
+{
+    static HttpCache s_the;
+    return s_the;
+}
+
+// Temporary files are created next to the entries, so that they can be renamed into place.
+static constexpr StringView temporary_file_prefix = "tmp."sv;
+
+// NOTE: Temporary files are only removed by eviction once they are this old, as they may belong to a write that
+//       another process is still busy with.
+static constexpr Duration temporary_file_lifetime = Duration::from_seconds(60 * 60);
+
+HttpCache::HttpCache()
+    : m_directory(ByteString::formatted("{}/RequestServer/HTTP", Core::StandardPaths::cache_directory()))
+{
+    if (auto result = Core::Directory::create(m_directory, Core::Directory::CreateDirectories::Yes); result.is_error()) {
+        dbgln("HttpCache: Unable to create {}, caching is disabled: {}", m_directory, result.error());
+        return;
+    }
+    m_is_enabled = true;
+
+    run_in_background([this]() -> ErrorOr<void> {
+        evict_if_needed();
+        return {};
+    });
+}
+
+bool HttpCache::is_safe_method(StringView method)
+{
+    return method.is_one_of_ignoring_ascii_case("GET"sv, "HEAD"sv, "OPTIONS"sv, "TRACE"sv);
+}
+
+bool HttpCache::is_cacheable_request(StringView method, HashMap<ByteString, ByteString> const& request_headers, ReadonlyBytes body)
+{
+    if (!method.equals_ignoring_ascii_case("GET"sv) || !body.is_empty())
+        return false;
+
+    // Partial and conditional requests made by the client are passed through untouched.
+    for (auto const& header : request_headers) {
+        if (header.key.equals_ignoring_ascii_case("Range"sv) || header.key.starts_with("If-"sv, CaseSensitivity::CaseInsensitive))
+            return false;
+    }
+
+    auto cache_control = HTTP::parse_cache_control(find_request_header(request_headers, "Cache-Control"sv).value_or({}));
+    return !cache_control.no_store;
+}
+
+ByteString HttpCache::path_for(ByteString const& key, StringView extension) const
+{
+    return ByteString::formatted("{}/{}.{}", m_directory, key, extension);
+}
+
+static ErrorOr<HttpCache::Entry> read_entry(ByteString const& key, ByteString const& path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(contents));
+    if (!json.is_object())
+        return Error::from_string_literal("Cache entry metadata is not an object");
+    auto const& object = json.as_object();
+
+    HttpCache::Entry entry;
+    entry.key = key;
+    entry.url = object.get_byte_string("url"sv).value_or({});
+    entry.status_code = object.get_u32("status_code"sv).value_or(0);
+    entry.request_time = UnixDateTime::from_seconds_since_epoch(object.get_i64("request_time"sv).value_or(0));
+    entry.response_time = UnixDateTime::from_seconds_since_epoch(object.get_i64("response_time"sv).value_or(0));
+    entry.body_size = object.get_u64("body_size"sv).value_or(0);
+
+    auto read_headers = [&](StringView name, ResponseHeaders& headers) {
+        auto headers_object = object.get_object(name);
+        if (!headers_object.has_value())
+            return;
+        headers_object->for_each_member([&](auto const& header_name, auto const& value) {
+            if (value.is_string())
+                headers.set(header_name, value.as_string());
+        });
+    };
+    read_headers("response_headers"sv, entry.response_headers);
+    read_headers("varying_request_headers"sv, entry.varying_request_headers);
+
+    return entry;
+}
+
+Optional<HttpCache::Entry> HttpCache::lookup(URL::URL const& url, HashMap<ByteString, ByteString> const& request_headers)
+{
+    if (!m_is_enabled)
+        return {};
+
+    auto key = cache_key_for(url);
+
+    auto entry_or_error = read_entry(key, path_for(key, "json"sv));
+    if (entry_or_error.is_error()) {
+        auto const& error = entry_or_error.error();
+        if (error.is_errno() && error.code() == ENOENT)
+            return {};
+
+        // NOTE: Entries are moved into place atomically, so this is not a write that is still in progress.
+        dbgln_if(HTTP_CACHE_DEBUG, "HttpCache: Removing unreadable entry for {}: {}", url, error);
+        run_in_background([this, key]() -> ErrorOr<void> {
+            remove_entry(key);
+            return {};
+        });
+        return {};
+    }
+    auto entry = entry_or_error.release_value();
+    if (entry.url != url.serialize(URL::ExcludeFragment::Yes))
+        return {};
+
+    // https://www.rfc-editor.org/rfc/rfc9111.html#name-calculating-cache-keys-with
+    if (auto vary = entry.response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (find_request_header(request_headers, name) != entry.varying_request_headers.get(name))
+                return {};
+        }
+    }
+
+    // NOTE: The modification time of the metadata file is what eviction uses to find the least recently used entries.
+    run_in_background([this, key]() -> ErrorOr<void> {
+        auto result = Core::System::utime(path_for(key, "json"sv), {});
+        if (result.is_error() && result.error().code() != ENOENT)
+            return result.release_error();
+        return {};
+    });
+    return entry;
+}
+
+ErrorOr<OwnPtr<Core::MappedFile>> HttpCache::open_body(Entry const& entry)
+{
+    if (entry.body_size == 0)
+        return nullptr;
+
+    // NOTE: Another process may have replaced or evicted the entry since it was looked up, so a missing or different
+    //       body doesn't mean that the cache is corrupted.
+    auto body = TRY(Core::MappedFile::map(path_for(entry.key, "body"sv)));
+    if (body->bytes().size() != entry.body_size)
+        return Error::from_string_literal("Cached body does not have the expected size");
+    return body;
+}
+
+void HttpCache::store(URL::URL const& url, HashMap<ByteString, ByteString> const& request_headers, UnixDateTime request_time, u32 status_code, ResponseHeaders const& response_headers, ByteBuffer body)
+{
+    if (!m_is_enabled)
+        return;
+
+    auto key = cache_key_for(url);
+
+    // NOTE: A response that can't be stored still replaces whatever we had for this URL before.
+    if (!HTTP::is_storable_response(status_code, response_headers) || body.size() > max_entry_size) {
+        run_in_background([this, key]() -> ErrorOr<void> {
+            remove_entry(key);
+            return {};
+        });
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.url = url.serialize(URL::ExcludeFragment::Yes);
+    entry.status_code = status_code;
+    entry.request_time = request_time;
+    entry.response_time = UnixDateTime::now();
+    entry.body_size = body.size();
+
+    for (auto const& header : response_headers) {
+        if (!is_excluded_from_storage(header.key))
+            entry.response_headers.set(header.key, header.value);
+    }
+
+    if (auto vary = response_headers.get("Vary"sv); vary.has_value()) {
+        for (auto name : vary->split_view(',')) {
+            name = name.trim_whitespace();
+            if (auto value = find_request_header(request_headers, name); value.has_value())
+                entry.varying_request_headers.set(name, value.release_value());
+        }
+    }
+
+    run_in_background([this, entry = move(entry), body = move(body)]() -> ErrorOr<void> {
+        if (auto result = write_entry(entry, body); result.is_error()) {
+            dbgln("HttpCache: Unable to store {}: {}", entry.url, result.error());
+            remove_entry(entry.key);
+            return {};
+        }
+
+        dbgln_if(HTTP_CACHE_DEBUG, "HttpCache: Stored {} ({} bytes)", entry.url, entry.body_size);
+
+        // NOTE: Counting the size of the cache means looking at every file in it, so this only happens once this
+        //       process has written a good share of the size limit since the last time. Writes from other processes
+        //       can make the cache overshoot the limit by that much per process until one of them looks again.
+        if (m_bytes_written_since_last_scan >= max_size / 8)
+            evict_if_needed();
+        return {};
+    });
+}
+
+// https://www.rfc-editor.org/rfc/rfc9111.html#name-freshening-stored-responses
+HttpCache::Entry HttpCache::update_after_revalidation(Entry const& entry, UnixDateTime request_time, ResponseHeaders const& response_headers)
+{
+    auto updated_entry = entry;
+    updated_entry.request_time = request_time;
+    updated_entry.response_time = UnixDateTime::now();
+
+    for (auto const& header : response_headers) {
+        if (is_excluded_from_storage(header.key) || header.key.equals_ignoring_ascii_case("Content-Length"sv))
+            continue;
+        updated_entry.response_headers.set(header.key, header.value);
+    }
+
+    if (m_is_enabled) {
+        run_in_background([this, updated_entry]() -> ErrorOr<void> {
+            if (auto result = write_entry(updated_entry, {}); result.is_error())
+                dbgln("HttpCache: Unable to update {}: {}", updated_entry.url, result.error());
+            return {};
+        });
+    }
+
+    dbgln_if(HTTP_CACHE_DEBUG, "HttpCache: Revalidated {}", entry.url);
+    return updated_entry;
+}
+
+void HttpCache::invalidate(URL::URL const& url)
+{
+    if (!m_is_enabled)
+        return;
+
+    run_in_background([this, key = cache_key_for(url)]() -> ErrorOr<void> {
+        remove_entry(key);
+        return {};
+    });
+}
+
+void HttpCache::run_in_background(Function<ErrorOr<void>()> action)
+{
+    // NOTE: There is only one background thread, so these run one after another, in the order they were queued.
+    (void)Threading::BackgroundAction<Empty>::construct(
+        [action = move(action)](auto&) -> ErrorOr<Empty> {
+            TRY(action());
+            return Empty {};
+        },
+        nullptr,
+        [](Error error) {
+            dbgln("HttpCache: Background operation failed: {}", error);
+        });
+}
+
+ErrorOr<ByteString> HttpCache::write_temporary_file(ReadonlyBytes bytes)
+{
+    auto pattern = ByteString::formatted("{}/{}XXXXXX", m_directory, temporary_file_prefix);
+    Vector<char> path_buffer;
+    TRY(path_buffer.try_append(pattern.characters(), pattern.length() + 1));
+    auto fd = TRY(Core::System::mkstemp(path_buffer));
+    auto path = ByteString { path_buffer.data(), pattern.length() };
+
+    auto file_or_error = Core::File::adopt_fd(fd, Core::File::OpenMode::Write);
+    if (file_or_error.is_error()) {
+        (void)Core::System::close(fd);
+        (void)Core::System::unlink(path);
+        return file_or_error.release_error();
+    }
+
+    if (auto result = file_or_error.value()->write_until_depleted(bytes); result.is_error()) {
+        (void)Core::System::unlink(path);
+        return result.release_error();
+    }
+    return path;
+}
+
+ErrorOr<void> HttpCache::write_entry(Entry const& entry, Optional<ByteBuffer> const& body)
+{
+    JsonObject object;
+    object.set("url", entry.url);
+    object.set("status_code", entry.status_code);
+    object.set("request_time", entry.request_time.seconds_since_epoch());
+    object.set("response_time", entry.response_time.seconds_since_epoch());
+    object.set("body_size", entry.body_size);
+
+    auto write_headers = [&](ByteString const& name, ResponseHeaders const& headers) {
+        JsonObject headers_object;
+        for (auto const& header : headers)
+            headers_object.set(header.key, header.value);
+        object.set(name, move(headers_object));
+    };
+    write_headers("response_headers", entry.response_headers);
+    write_headers("varying_request_headers", entry.varying_request_headers);
+
+    auto metadata = object.to_byte_string();
+
+    // NOTE: Everything is written to uniquely named temporary files first and then moved into place, so that readers
+    //       never see a partially written entry, and concurrent writers never write to the same file.
+    auto move_into_place = [](ByteString const& temporary_path, ByteString const& path) -> ErrorOr<void> {
+        if (auto result = Core::System::rename(temporary_path, path); result.is_error()) {
+            (void)Core::System::unlink(temporary_path);
+            return result.release_error();
+        }
+        return {};
+    };
+
+    if (body.has_value()) {
+        auto temporary_body_path = TRY(write_temporary_file(*body));
+        TRY(move_into_place(temporary_body_path, path_for(entry.key, "body"sv)));
+        m_bytes_written_since_last_scan += body->size();
+    }
+
+    auto temporary_metadata_path = TRY(write_temporary_file(metadata.bytes()));
+    TRY(move_into_place(temporary_metadata_path, path_for(entry.key, "json"sv)));
+    m_bytes_written_since_last_scan += metadata.length();
+
+    return {};
+}
+
+void HttpCache::remove_entry(ByteString const& key)
+{
+    (void)Core::System::unlink(path_for(key, "json"sv));
+    (void)Core::System::unlink(path_for(key, "body"sv));
+}
+
+void HttpCache::evict_if_needed()
+{
+    m_bytes_written_since_last_scan = 0;
+
+    struct EntryOnDisk {
+        ByteString key;
+        u64 size { 0 };
+        UnixDateTime last_used;
+    };
+    HashMap<ByteString, EntryOnDisk> entries;
+    u64 total_size = 0;
+
+    auto now = UnixDateTime::now();
+    Core::DirIterator iterator(m_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto name = iterator.next_path();
+        auto path = ByteString::formatted("{}/{}", m_directory, name);
+
+        auto stat = Core::System::stat(path);
+        if (stat.is_error())
+            continue;
+        auto modification_time = UnixDateTime::from_seconds_since_epoch(stat.value().st_mtime);
+
+        if (name.starts_with(temporary_file_prefix)) {
+            // Leftovers of writes that were interrupted.
+            if (now - modification_time > temporary_file_lifetime) {
+                (void)Core::System::unlink(path);
+                continue;
+            }
+            total_size += stat.value().st_size;
+            continue;
+        }
+
+        auto key = name.substring_view(0, name.find('.').value_or(name.length()));
+        auto& entry = entries.ensure(key, [&] { return EntryOnDisk { key, 0, modification_time }; });
+        entry.size += stat.value().st_size;
+        entry.last_used = max(entry.last_used, modification_time);
+        total_size += stat.value().st_size;
+    }
+
+    dbgln_if(HTTP_CACHE_DEBUG, "HttpCache: Found {} entries ({} bytes) in {}", entries.size(), total_size, m_directory);
+    if (total_size <= max_size)
+        return;
+
+    Vector<EntryOnDisk> entries_by_last_use;
+    entries_by_last_use.ensure_capacity(entries.size());
+    for (auto& it : entries)
+        entries_by_last_use.unchecked_append(move(it.value));
+
+    quick_sort(entries_by_last_use, [](auto const& a, auto const& b) {
+        return a.last_used < b.last_used;
+    });
+
+    for (auto const& entry : entries_by_last_use) {
+        if (total_size <= max_size)
+            break;
+        dbgln_if(HTTP_CACHE_DEBUG, "HttpCache: Evicting {}", entry.key);
+        remove_entry(entry.key);
+        total_size -= entry.size;
+    }
+}
+
+CacheWriter::CacheWriter(Stream& client_stream, URL::URL url, HashMap<ByteString, ByteString> request_headers, UnixDateTime request_time, Optional<HttpCache::Entry> entry_being_revalidated)
+    : m_client_stream(client_stream)
+    , m_url(move(url))
+    , m_request_headers(move(request_headers))
+    , m_request_time(request_time)
+    , m_entry_being_revalidated(move(entry_being_revalidated))
+{
+}
+
+ErrorOr<size_t> CacheWriter::write_some(ReadonlyBytes bytes)
+{
+    auto written = TRY(m_client_stream.write_some(bytes));
+
+    if (!m_body_is_too_large) {
+        if (m_body.size() + written > HttpCache::max_entry_size || m_body.try_append(bytes.trim(written)).is_error()) {
+            m_body_is_too_large = true;
+            m_body.clear();
+        }
+    }
+
+    return written;
+}
+
+bool CacheWriter::did_receive_headers(u32 status_code, ResponseHeaders const& response_headers)
+{
+    if (!m_entry_being_revalidated.has_value())
+        return false;
+
+    auto entry = m_entry_being_revalidated.release_value();
+    if (status_code != 304)
+        return false;
+
+    m_revalidated_entry = HttpCache::the().update_after_revalidation(entry, m_request_time, response_headers);
+    return true;
+}
+
+void CacheWriter::did_finish(bool success, u32 status_code, ResponseHeaders const& response_headers)
+{
+    if (!success || m_revalidated_entry.has_value())
+        return;
+
+    if (m_body_is_too_large) {
+        HttpCache::the().invalidate(m_url);
+        return;
+    }
+
+    HttpCache::the().store(m_url, m_request_headers, m_request_time, status_code, response_headers, move(m_body));
+}
+
+}
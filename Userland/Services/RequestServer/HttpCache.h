@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/HashMap.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Stream.h>
+#include <AK/Time.h>
+#include <LibCore/Forward.h>
+#include <LibURL/URL.h>
+
+namespace RequestServer {
+
+// A private HTTP cache (RFC 9111) that is kept on disk and shared by all clients of this RequestServer.
+//
+// Every entry is stored as two files named after a hash of its URL: a JSON file with the response metadata, and a
+// file with the response body, which is memory-mapped when the entry is served. The cache is limited in size, and the
+// least recently used entries are evicted once it grows too large.
+//
+// NOTE: Several RequestServer processes share the same directory, so no state about its contents is kept in memory.
+//       Lookups always go to the disk, and the size of the cache is counted from the directory itself. All writes
+//       happen on a background thread, and become visible to other processes atomically.
+class HttpCache {
+public:
+    static constexpr u64 max_size = 256 * MiB;
+    static constexpr u64 max_entry_size = 16 * MiB;
+
+    struct Entry {
+        ByteString key;
+        ByteString url;
+        u32 status_code { 0 };
+        HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> response_headers;
+        // The values the request headers named by the response's Vary header had when the response was stored.
+        HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> varying_request_headers;
+        UnixDateTime request_time;
+        UnixDateTime response_time;
+        u64 body_size { 0 };
+
+        Duration current_age() const;
+        Duration freshness_lifetime() const;
+        bool has_validators() const;
+        bool can_be_served_without_revalidation(HashMap<ByteString, ByteString> const& request_headers) const;
+        void add_validators_to(HashMap<ByteString, ByteString>& request_headers) const;
+        HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> response_headers_for_serving() const;
+    };
+
+    static HttpCache& the();
+
+    bool is_enabled() const { return m_is_enabled; }
+    ByteString const& directory() const { return m_directory; }
+
+    static bool is_cacheable_request(StringView method, HashMap<ByteString, ByteString> const& request_headers, ReadonlyBytes body);
+    static bool is_safe_method(StringView method);
+
+    Optional<Entry> lookup(URL::URL const&, HashMap<ByteString, ByteString> const& request_headers);
+    // Returns a null pointer for empty bodies, which can't be mapped.
+    ErrorOr<OwnPtr<Core::MappedFile>> open_body(Entry const&);
+
+    void store(URL::URL const&, HashMap<ByteString, ByteString> const& request_headers, UnixDateTime request_time, u32 status_code, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers, ByteBuffer body);
+    Entry update_after_revalidation(Entry const&, UnixDateTime request_time, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers);
+    void invalidate(URL::URL const&);
+
+private:
+    HttpCache();
+
+    ByteString path_for(ByteString const& key, StringView extension) const;
+    void run_in_background(Function<ErrorOr<void>()>);
+
+    // These must only be called on the background thread.
+    ErrorOr<void> write_entry(Entry const&, Optional<ByteBuffer> const& body);
+    ErrorOr<ByteString> write_temporary_file(ReadonlyBytes);
+    void remove_entry(ByteString const& key);
+    void evict_if_needed();
+
+    ByteString m_directory;
+    bool m_is_enabled { false };
+
+    // NOTE: Only used by the background thread. Other processes write to the cache as well, so this only tells when
+    //       it's worth counting the size of the cache again.
+    u64 m_bytes_written_since_last_scan { 0 };
+};
+
+// Sits between a network job and the pipe to the client. Everything that reaches the client is also buffered, so the
+// response can be stored in the cache once it is complete. If the request revalidates a stale cache entry, that entry
+// is kept here until the response arrives.
+class CacheWriter final : public Stream {
+public:
+    CacheWriter(Stream& client_stream, URL::URL, HashMap<ByteString, ByteString> request_headers, UnixDateTime request_time, Optional<HttpCache::Entry> entry_being_revalidated);
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override { return Error::from_errno(EBADF); }
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override { return m_client_stream.is_eof(); }
+    virtual bool is_open() const override { return m_client_stream.is_open(); }
+    virtual void close() override { m_client_stream.close(); }
+
+    // Returns true if the response confirmed that the entry being revalidated is still valid, in which case the
+    // (now updated) revalidated entry should be served instead of the response.
+    bool did_receive_headers(u32 status_code, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers);
+    void did_finish(bool success, u32 status_code, HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> const& response_headers);
+
+    Optional<HttpCache::Entry> const& revalidated_entry() const { return m_revalidated_entry; }
+
+private:
+    Stream& m_client_stream;
+    URL::URL m_url;
+    HashMap<ByteString, ByteString> m_request_headers;
+    UnixDateTime m_request_time;
+    Optional<HttpCache::Entry> m_entry_being_revalidated;
+    Optional<HttpCache::Entry> m_revalidated_entry;
+
+    ByteBuffer m_body;
+    bool m_body_is_too_large { false };
+};
+
+}
@@ -12,10 +12,13 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
+#include <AK/Time.h>
 #include <AK/Types.h>
 #include <LibHTTP/HttpRequest.h>
+#include <RequestServer/CachedRequest.h>
 #include <RequestServer/ConnectionCache.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/HttpCache.h>
 #include <RequestServer/Request.h>
 
 namespace RequestServer::Detail {
@@ -24,6 +27,12 @@ template<typename TSelf, typename TJob>
 void init(TSelf* self, TJob job)
 {
     job->on_headers_received = [self](auto& headers, auto response_code) {
+        // If the response only confirms that our cached copy is still valid, the client is sent that copy instead.
+        if (auto* cache_writer = self->cache_writer(); cache_writer && response_code.has_value()) {
+            if (cache_writer->did_receive_headers(response_code.value(), headers))
+                return;
+        }
+
         if (response_code.has_value())
             self->set_status_code(response_code.value());
         self->set_response_headers(headers);
@@ -33,10 +42,19 @@ void init(TSelf* self, TJob job)
         Core::deferred_invoke([url = self->job().url(), socket = self->job().socket()] {
             ConnectionCache::request_did_finish(url, socket);
         });
+
+        auto* cache_writer = self->cache_writer();
+        if (cache_writer && cache_writer->revalidated_entry().has_value()) {
+            self->serve_from_cache(cache_writer->revalidated_entry().value());
+            return;
+        }
+
         if (auto* response = self->job().response()) {
             self->set_status_code(response->code());
             self->set_response_headers(response->headers());
             self->set_downloaded_size(response->downloaded_size());
+            if (cache_writer)
+                cache_writer->did_finish(success, response->code(), response->headers());
         }
 
         // if we didn't know the total size, pretend that the request finished successfully
@@ -70,6 +88,30 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
         return {};
     }
 
+    auto request_time = UnixDateTime::now();
+    auto request_headers = headers;
+    Optional<HttpCache::Entry> entry_to_revalidate;
+
+    bool is_cacheable = HttpCache::is_cacheable_request(method, headers, body);
+    if (is_cacheable) {
+        if (auto entry = HttpCache::the().lookup(url, headers); entry.has_value()) {
+            if (entry->can_be_served_without_revalidation(headers)) {
+                auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
+                auto cached_request = CachedRequest::create(client, move(output_stream), request_id, url, entry.release_value());
+                cached_request->set_request_fd(pipe_result.value().read_fd);
+                return cached_request;
+            }
+            if (entry->has_validators()) {
+                entry->add_validators_to(request_headers);
+                entry_to_revalidate = entry.release_value();
+            }
+        }
+    } else if (!HttpCache::is_safe_method(method)) {
+        // https://www.rfc-editor.org/rfc/rfc9111.html#name-invalidating-stored-respons
+        // NOTE: We don't wait for the response to be successful, dropping an entry too eagerly is harmless.
+        HttpCache::the().invalidate(url);
+    }
+
     HTTP::HttpRequest request;
     if (method.equals_ignoring_ascii_case("post"sv))
         request.set_method(HTTP::HttpRequest::Method::POST);
@@ -90,7 +132,7 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
     else
         request.set_method(HTTP::HttpRequest::Method::GET);
     request.set_url(url);
-    request.set_headers(headers);
+    request.set_headers(request_headers);
 
     auto allocated_body_result = ByteBuffer::copy(body);
     if (allocated_body_result.is_error())
@@ -98,9 +140,16 @@ OwnPtr<Request> start_request(TBadgedProtocol&& protocol, i32 request_id, Connec
     request.set_body(allocated_body_result.release_value());
 
     auto output_stream = MUST(Core::File::adopt_fd(pipe_result.value().write_fd, Core::File::OpenMode::Write));
-    auto job = TJob::construct(move(request), *output_stream);
+
+    OwnPtr<CacheWriter> cache_writer;
+    if (is_cacheable)
+        cache_writer = make<CacheWriter>(*output_stream, url, headers, request_time, move(entry_to_revalidate));
+
+    auto job = TJob::construct(move(request), cache_writer ? static_cast<Stream&>(*cache_writer) : *output_stream);
     auto protocol_request = TRequest::create_with_job(forward<TBadgedProtocol>(protocol), client, (TJob&)*job, move(output_stream), request_id);
     protocol_request->set_request_fd(pipe_result.value().read_fd);
+    if (cache_writer)
+        protocol_request->set_cache_writer(cache_writer.release_nonnull());
 
     if constexpr (IsSame<typename TBadgedProtocol::Type, HttpsProtocol>)
         ConnectionCache::get_or_create_connection(ConnectionCache::g_tls_connection_cache, url, job, proxy_data);
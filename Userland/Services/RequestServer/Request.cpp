@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCore/File.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
 
@@ -48,4 +49,55 @@ void Request::did_request_certificates()
     m_client.did_request_certificates({}, *this);
 }
 
+void Request::serve_from_cache(HttpCache::Entry entry)
+{
+    m_cached_entry = move(entry);
+
+    // NOTE: Nothing is sent before the event loop lets us write to the pipe. This way, a response served straight
+    //       from the cache never reaches the client before it has been told that the request was started.
+    m_cached_body_notifier = Core::Notifier::construct(m_output_stream->fd(), Core::Notifier::Type::Write);
+    m_cached_body_notifier->on_activation = [this] { continue_serving_from_cache(); };
+}
+
+void Request::continue_serving_from_cache()
+{
+    if (!m_response_headers_were_sent_from_cache) {
+        m_response_headers_were_sent_from_cache = true;
+
+        auto body = HttpCache::the().open_body(*m_cached_entry);
+        if (body.is_error()) {
+            dbgln("Request: Unable to read the cached response for {}: {}", url(), body.error());
+            m_cached_body_notifier->set_enabled(false);
+            did_finish(false);
+            return;
+        }
+        m_cached_body = body.release_value();
+
+        set_status_code(m_cached_entry->status_code);
+        set_response_headers(m_cached_entry->response_headers_for_serving());
+    }
+
+    auto remaining_body = m_cached_body ? m_cached_body->bytes().slice(m_cached_body_offset) : ReadonlyBytes {};
+    while (!remaining_body.is_empty()) {
+        auto result = m_output_stream->write_some(remaining_body);
+        if (result.is_error()) {
+            if (result.error().is_errno() && result.error().code() == EINTR)
+                continue;
+            if (result.error().is_errno() && result.error().code() == EAGAIN)
+                return;
+
+            dbgln("Request: Unable to send the cached response for {}: {}", url(), result.error());
+            m_cached_body_notifier->set_enabled(false);
+            did_finish(false);
+            return;
+        }
+        m_cached_body_offset += result.value();
+        remaining_body = remaining_body.slice(result.value());
+    }
+
+    m_cached_body_notifier->set_enabled(false);
+    did_progress(m_cached_entry->body_size, m_cached_entry->body_size);
+    did_finish(true);
+}
+
 }
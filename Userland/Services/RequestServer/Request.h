@@ -9,9 +9,13 @@
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/Notifier.h>
 #include <LibURL/URL.h>
 #include <RequestServer/Forward.h>
+#include <RequestServer/HttpCache.h>
 
 namespace RequestServer {
 
@@ -42,10 +46,18 @@ public:
     void set_downloaded_size(size_t size) { m_downloaded_size = size; }
     Core::File const& output_stream() const { return *m_output_stream; }
 
+    CacheWriter* cache_writer() { return m_cache_writer.ptr(); }
+    void set_cache_writer(NonnullOwnPtr<CacheWriter> cache_writer) { m_cache_writer = move(cache_writer); }
+
+    // Sends a cached response to the client instead of one from the network.
+    void serve_from_cache(HttpCache::Entry);
+
 protected:
     explicit Request(ConnectionFromClient&, NonnullOwnPtr<Core::File>&&, i32 request_id);
 
 private:
+    void continue_serving_from_cache();
+
     ConnectionFromClient& m_client;
     i32 m_id { 0 };
     int m_request_fd { -1 }; // Passed to client.
@@ -54,6 +66,13 @@ private:
     size_t m_downloaded_size { 0 };
     NonnullOwnPtr<Core::File> m_output_stream;
     HashMap<ByteString, ByteString, CaseInsensitiveStringTraits> m_response_headers;
+
+    OwnPtr<CacheWriter> m_cache_writer;
+    Optional<HttpCache::Entry> m_cached_entry;
+    OwnPtr<Core::MappedFile> m_cached_body;
+    size_t m_cached_body_offset { 0 };
+    bool m_response_headers_were_sent_from_cache { false };
+    RefPtr<Core::Notifier> m_cached_body_notifier;
 };
 
 }
@@ -13,25 +13,20 @@
 #include <LibTLS/Certificate.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/GeminiProtocol.h>
+#include <RequestServer/HttpCache.h>
 #include <RequestServer/HttpProtocol.h>
 #include <RequestServer/HttpsProtocol.h>
 #include <signal.h>
 
 ErrorOr<int> serenity_main(Main::Arguments)
 {
-    if constexpr (TLS_SSL_KEYLOG_DEBUG)
-        TRY(Core::System::pledge("stdio inet accept unix cpath wpath rpath sendfd recvfd sigaction"));
-    else
-        TRY(Core::System::pledge("stdio inet accept unix rpath sendfd recvfd sigaction"));
+    TRY(Core::System::pledge("stdio inet accept unix cpath wpath rpath fattr thread sendfd recvfd sigaction"));
 
 #ifdef SIGINFO
     signal(SIGINFO, [](int) { RequestServer::ConnectionCache::dump_jobs(); });
 #endif
 
-    if constexpr (TLS_SSL_KEYLOG_DEBUG)
-        TRY(Core::System::pledge("stdio inet accept unix cpath wpath rpath sendfd recvfd"));
-    else
-        TRY(Core::System::pledge("stdio inet accept unix rpath sendfd recvfd"));
+    TRY(Core::System::pledge("stdio inet accept unix cpath wpath rpath fattr thread sendfd recvfd"));
 
     // Ensure the certificates are read out here.
     // FIXME: Allow specifying extra certificates on the command line, or in other configuration.
@@ -43,6 +38,10 @@ ErrorOr<int> serenity_main(Main::Arguments)
     TRY(Core::System::unveil("/etc/timezone", "r"));
     if constexpr (TLS_SSL_KEYLOG_DEBUG)
         TRY(Core::System::unveil("/home/anon", "rwc"));
+
+    // NOTE: The HTTP cache creates its directory when it's first used, so set it up before locking down the filesystem.
+    if (auto& http_cache = RequestServer::HttpCache::the(); http_cache.is_enabled())
+        TRY(Core::System::unveil(http_cache.directory(), "rwc"sv));
     TRY(Core::System::unveil(nullptr, nullptr));
 
     RequestServer::GeminiProtocol::install();
@@ -393,6 +393,17 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString const& request,
         return;
     }
 
+    if (request == "dump-rasterization-statistics") {
+        page->dump_rasterization_statistics();
+        return;
+    }
+
+    if (request == "dump-script-timings") {
+        if (auto* document = page->page().top_level_browsing_context().active_document())
+            document->dump_script_timings();
+        return;
+    }
+
     if (request == "dump-local-storage") {
         if (auto* document = page->page().top_level_browsing_context().active_document())
             document->window()->local_storage().release_value_but_fixme_should_propagate_errors()->dump();
@@ -16,11 +16,13 @@
 #include <LibWeb/DOM/Attr.h>
 #include <LibWeb/DOM/NamedNodeMap.h>
 #include <LibWeb/HTML/BrowsingContext.h>
+#include <LibWeb/HTML/EventLoop/EventLoop.h>
 #include <LibWeb/HTML/Scripting/ClassicScript.h>
 #include <LibWeb/HTML/TraversableNavigable.h>
 #include <LibWeb/Layout/Viewport.h>
 #include <LibWeb/Painting/CommandExecutorCPU.h>
 #include <LibWeb/Painting/PaintableBox.h>
+#include <LibWeb/Painting/TiledRasterizer.h>
 #include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/Platform/Timer.h>
 #include <LibWebView/Attribute.h>
@@ -62,16 +64,23 @@ PageClient::PageClient(PageHost& owner, u64 id)
             return;
         }
 
-        auto& back_bitmap = *m_backing_stores.back_bitmap;
         auto viewport_rect = page().css_to_device_rect(page().top_level_traversable()->viewport_rect());
-        paint(viewport_rect, back_bitmap);
+        auto frame_damage = paint_next_frame(viewport_rect);
 
         auto& backing_stores = m_backing_stores;
         swap(backing_stores.front_bitmap, backing_stores.back_bitmap);
         swap(backing_stores.front_bitmap_id, backing_stores.back_bitmap_id);
+        backing_stores.back_bitmap_damage = frame_damage;
+
+        // NOTE: The UI process keeps showing the previous frame outside of the damaged parts of the new one.
+        Vector<Gfx::IntRect> damage_rects;
+        if (frame_damage.has_value())
+            damage_rects = frame_damage.release_value();
+        else
+            damage_rects.append({ {}, viewport_rect.size().to_type<int>() });
 
         m_paint_state = PaintState::WaitingForClient;
-        client().async_did_paint(m_id, viewport_rect.to_type<int>(), backing_stores.front_bitmap_id);
+        client().async_did_paint(m_id, viewport_rect.to_type<int>(), backing_stores.front_bitmap_id, move(damage_rects));
     });
 
 #ifdef HAS_ACCELERATED_GRAPHICS
@@ -86,6 +95,8 @@ PageClient::PageClient(PageHost& owner, u64 id)
 #endif
 }
 
+PageClient::~PageClient() = default;
+
 void PageClient::schedule_repaint()
 {
     if (m_paint_state != PaintState::Ready) {
@@ -108,8 +119,9 @@ void PageClient::ready_to_paint()
 
     if (old_paint_state == PaintState::PaintWhenReady) {
         // NOTE: Repainting always has to be scheduled from HTML event loop processing steps
-        //       to make sure style and layout are up-to-date.
-        page().top_level_traversable()->set_needs_display();
+        //       to make sure style and layout are up-to-date. The navigable still needs a repaint
+        //       (and keeps its damage) until it gets painted, so scheduling the event loop is enough.
+        Web::HTML::main_thread_event_loop().schedule();
     }
 }
 
@@ -119,6 +131,10 @@ void PageClient::add_backing_store(i32 front_bitmap_id, Gfx::ShareableBitmap con
     m_backing_stores.back_bitmap_id = back_bitmap_id;
     m_backing_stores.front_bitmap = *const_cast<Gfx::ShareableBitmap&>(front_bitmap).bitmap();
     m_backing_stores.back_bitmap = *const_cast<Gfx::ShareableBitmap&>(back_bitmap).bitmap();
+
+    // NOTE: Neither of the new bitmaps has been painted into yet.
+    m_backing_stores.back_bitmap_damage = {};
+    page().top_level_traversable()->set_needs_display();
 }
 
 void PageClient::visit_edges(JS::Cell::Visitor& visitor)
@@ -200,7 +216,42 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
 {
     Web::Painting::CommandList painting_commands;
     Web::Painting::RecordingPainter recording_painter(painting_commands);
+    record_painting_commands(recording_painter, content_rect, paint_options);
+    rasterize(painting_commands, target);
+}
+
+// Paints the next frame into the back bitmap and returns the parts of the viewport (in device pixels) that changed,
+// or an empty Optional if all of it did.
+Optional<Vector<Gfx::IntRect>> PageClient::paint_next_frame(Web::DevicePixelRect const& content_rect)
+{
+    Web::Painting::CommandList painting_commands;
+    Web::Painting::RecordingPainter recording_painter(painting_commands);
+    record_painting_commands(recording_painter, content_rect, {});
+
+    // NOTE: The damage has to be taken after recording, as that's when paint-only properties get resolved.
+    Optional<Vector<Gfx::IntRect>> frame_damage;
+    if (auto damage = page().top_level_traversable()->take_damage(); damage.has_value()) {
+        frame_damage = Vector<Gfx::IntRect> {};
+        for (auto const& rect : *damage) {
+            // NOTE: Anti-aliased edges may bleed into the pixels around the damaged rect, so it's inflated a little.
+            frame_damage->append(page().enclosing_device_rect(rect).to_type<int>().inflated(2, 2));
+        }
+    }
+
+    // The back bitmap is one frame behind, so what changed in the previous frame has to be repainted as well.
+    auto& back_bitmap_damage = m_backing_stores.back_bitmap_damage;
+    Optional<Vector<Gfx::IntRect>> damage_to_repaint;
+    if (frame_damage.has_value() && back_bitmap_damage.has_value()) {
+        damage_to_repaint = *frame_damage;
+        damage_to_repaint->extend(*back_bitmap_damage);
+    }
 
+    rasterize(painting_commands, *m_backing_stores.back_bitmap, damage_to_repaint);
+    return frame_damage;
+}
+
+void PageClient::record_painting_commands(Web::Painting::RecordingPainter& recording_painter, Web::DevicePixelRect const& content_rect, Web::PaintOptions paint_options)
+{
     Gfx::IntRect bitmap_rect { {}, content_rect.size().to_type<int>() };
     recording_painter.fill_rect(bitmap_rect, Web::CSS::SystemColor::canvas());
 
@@ -209,7 +260,10 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
     paint_config.should_show_line_box_borders = m_should_show_line_box_borders;
     paint_config.has_focus = m_has_focus;
     page().top_level_traversable()->paint(recording_painter, paint_config);
+}
 
+void PageClient::rasterize(Web::Painting::CommandList& painting_commands, Gfx::Bitmap& target, Optional<Vector<Gfx::IntRect>> const& damage_rects)
+{
     if (s_use_gpu_painter) {
 #ifdef HAS_ACCELERATED_GRAPHICS
         Web::Painting::CommandExecutorGPU painting_command_executor(*m_accelerated_graphics_context, target);
@@ -223,9 +277,19 @@ void PageClient::paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap& ta
         }
 #endif
     } else {
-        Web::Painting::CommandExecutorCPU painting_command_executor(target);
-        painting_commands.execute(painting_command_executor);
+        if (!m_tiled_rasterizer)
+            m_tiled_rasterizer = make<Web::Painting::TiledRasterizer>();
+        m_tiled_rasterizer->rasterize(painting_commands, target, damage_rects);
+    }
+}
+
+void PageClient::dump_rasterization_statistics() const
+{
+    if (!m_tiled_rasterizer) {
+        dbgln("No frames have been rasterized on the CPU yet");
+        return;
     }
+    m_tiled_rasterizer->dump_statistics();
 }
 
 void PageClient::set_viewport_rect(Web::DevicePixelRect const& rect)
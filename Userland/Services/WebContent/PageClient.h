@@ -40,6 +40,7 @@ public:
     ErrorOr<void> connect_to_webdriver(ByteString const& webdriver_ipc_path);
 
     virtual void paint(Web::DevicePixelRect const& content_rect, Gfx::Bitmap&, Web::PaintOptions = {}) override;
+    void dump_rasterization_statistics() const;
 
     void set_palette_impl(Gfx::PaletteImpl&);
     void set_viewport_rect(Web::DevicePixelRect const&);
@@ -84,9 +85,14 @@ public:
 
 private:
     PageClient(PageHost&, u64 id);
+    virtual ~PageClient() override;
 
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    void record_painting_commands(Web::Painting::RecordingPainter&, Web::DevicePixelRect const& content_rect, Web::PaintOptions);
+    void rasterize(Web::Painting::CommandList&, Gfx::Bitmap&, Optional<Vector<Gfx::IntRect>> const& damage_rects = {});
+    Optional<Vector<Gfx::IntRect>> paint_next_frame(Web::DevicePixelRect const& content_rect);
+
     // ^PageClient
     virtual bool is_connection_open() const override;
     virtual Gfx::Palette palette() const override;
@@ -192,9 +198,15 @@ private:
         i32 back_bitmap_id { -1 };
         RefPtr<Gfx::Bitmap> front_bitmap;
         RefPtr<Gfx::Bitmap> back_bitmap;
+
+        // The parts of the back bitmap that are out of date, i.e. what changed in the frame that was painted into the
+        // front bitmap. An empty Optional means that all of it is out of date.
+        Optional<Vector<Gfx::IntRect>> back_bitmap_damage;
     };
     BackingStores m_backing_stores;
 
+    OwnPtr<Web::Painting::TiledRasterizer> m_tiled_rasterizer;
+
     // NOTE: These documents are not visited, but manually removed from the map on document finalization.
     HashMap<JS::RawGCPtr<Web::DOM::Document>, JS::NonnullGCPtr<WebContentConsoleClient>> m_console_clients;
     WeakPtr<WebContentConsoleClient> m_top_level_document_console_client;
@@ -30,6 +30,11 @@
 
 namespace WebServer {
 
+static ByteString http_date(time_t timestamp)
+{
+    return Core::DateTime::from_timestamp(timestamp).to_byte_string("%a, %d %b %Y %H:%M:%S GMT"sv, Core::DateTime::LocalTime::No);
+}
+
 Client::Client(NonnullOwnPtr<Core::BufferedTCPSocket> socket, Core::EventReceiver* parent)
     : Core::EventReceiver(parent)
     , m_socket(move(socket))
@@ -166,11 +171,21 @@ ErrorOr<bool> Client::handle_request(HTTP::HttpRequest const& request)
         return false;
     }
 
+    auto const last_modified = TRY(Core::System::stat(real_path.bytes_as_string_view())).st_mtime;
+    if (auto it = request.headers().find_if([](auto& header) { return header.name.equals_ignoring_ascii_case("If-Modified-Since"sv); }); !it.is_end()) {
+        auto if_modified_since = Core::DateTime::parse("%a, %d %b %Y %H:%M:%S %Z"sv, it->value);
+        if (if_modified_since.has_value() && last_modified <= if_modified_since->timestamp()) {
+            TRY(send_not_modified(last_modified, request));
+            return true;
+        }
+    }
+
     auto stream = TRY(Core::File::open(real_path.bytes_as_string_view(), Core::File::OpenMode::Read));
 
     auto const info = ContentInfo {
         .type = TRY(String::from_utf8(Core::guess_mime_type_based_on_filename(real_path.bytes_as_string_view()))),
-        .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view())))
+        .length = static_cast<u64>(TRY(FileSystem::size_from_stat(real_path.bytes_as_string_view()))),
+        .last_modified = last_modified,
     };
     TRY(send_response(*stream, request, move(info)));
     return true;
@@ -183,7 +198,10 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
     TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
     TRY(builder.try_append("X-Frame-Options: SAMEORIGIN\r\n"sv));
     TRY(builder.try_append("X-Content-Type-Options: nosniff\r\n"sv));
-    TRY(builder.try_append("Pragma: no-cache\r\n"sv));
+    // NOTE: Clients may keep copies of our files, but have to check with us whether they changed before using them.
+    TRY(builder.try_append("Cache-Control: no-cache\r\n"sv));
+    if (content_info.last_modified.has_value())
+        TRY(builder.try_appendff("Last-Modified: {}\r\n", http_date(*content_info.last_modified)));
     if (content_info.type == "text/plain")
         TRY(builder.try_appendff("Content-Type: {}; charset=utf-8\r\n", content_info.type));
     else
@@ -224,6 +242,22 @@ ErrorOr<void> Client::send_response(Stream& response, HTTP::HttpRequest const& r
     return {};
 }
 
+ErrorOr<void> Client::send_not_modified(time_t last_modified, HTTP::HttpRequest const& request)
+{
+    StringBuilder builder;
+    TRY(builder.try_append("HTTP/1.0 304 Not Modified\r\n"sv));
+    TRY(builder.try_append("Server: WebServer (SerenityOS)\r\n"sv));
+    TRY(builder.try_append("Cache-Control: no-cache\r\n"sv));
+    TRY(builder.try_appendff("Last-Modified: {}\r\n", http_date(last_modified)));
+    TRY(builder.try_append("\r\n"sv));
+
+    auto builder_contents = TRY(builder.to_byte_buffer());
+    TRY(m_socket->write_until_depleted(builder_contents));
+
+    log_response(304, request);
+    return {};
+}
+
 ErrorOr<void> Client::send_redirect(StringView redirect_path, HTTP::HttpRequest const& request)
 {
     StringBuilder builder;
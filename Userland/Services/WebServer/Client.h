@@ -29,12 +29,14 @@ private:
     struct ContentInfo {
         String type;
         u64 length {};
+        Optional<time_t> last_modified {};
     };
 
     ErrorOr<void, WrappedError> on_ready_to_read();
     ErrorOr<bool> handle_request(HTTP::HttpRequest const&);
     ErrorOr<void> send_response(Stream&, HTTP::HttpRequest const&, ContentInfo);
     ErrorOr<void> send_redirect(StringView redirect, HTTP::HttpRequest const&);
+    ErrorOr<void> send_not_modified(time_t last_modified, HTTP::HttpRequest const&);
     ErrorOr<void> send_error_response(unsigned code, HTTP::HttpRequest const&, Vector<String> const& headers = {});
     void die();
     void log_response(unsigned code, HTTP::HttpRequest const&);
@@ -5,8 +5,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
 #include <AK/ByteBuffer.h>
 #include <AK/ByteString.h>
+#include <AK/Random.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
@@ -14,8 +16,10 @@
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -40,15 +44,18 @@ static Result average_result(Vector<Result> const& results)
 }
 
 static ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer& buffer, bool allow_cache);
+static ErrorOr<void> benchmark_iops(ByteString const& device, size_t block_size, Vector<size_t> const& queue_depths, Duration time_per_benchmark);
 
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     using namespace AK::TimeLiterals;
 
     ByteString directory = ".";
+    ByteString device;
     i64 time_per_benchmark_sec = 10;
     Vector<size_t> file_sizes;
     Vector<size_t> block_sizes;
+    Vector<size_t> queue_depths;
     bool allow_cache = false;
 
     Core::ArgsParser args_parser;
@@ -57,10 +64,22 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.add_option(time_per_benchmark_sec, "Time elapsed per benchmark (seconds)", "time-per-benchmark", 't', "time-per-benchmark");
     args_parser.add_option(file_sizes, "A comma-separated list of file sizes", "file-size", 'f', "file-size");
     args_parser.add_option(block_sizes, "A comma-separated list of block sizes", "block-size", 'b', "block-size");
+    args_parser.add_option(queue_depths, "Measure random read IOPS at a comma-separated list of queue depths instead", "queue-depth", 'q', "queue-depth");
+    args_parser.add_option(device, "Path to the block device to measure random read IOPS on (e.g. /dev/hda)", "device", 'D', "device");
     args_parser.parse(arguments);
 
     Duration const time_per_benchmark = Duration::from_seconds(time_per_benchmark_sec);
 
+    if (!queue_depths.is_empty()) {
+        if (device.is_empty()) {
+            warnln("Measuring IOPS requires a block device, use --device");
+            return 1;
+        }
+        size_t block_size = block_sizes.is_empty() ? 4096 : block_sizes.first();
+        TRY(benchmark_iops(device, block_size, queue_depths, time_per_benchmark));
+        return 0;
+    }
+
     if (file_sizes.size() == 0) {
         file_sizes = { 131072, 262144, 524288, 1048576, 5242880 };
     }
@@ -143,3 +162,94 @@ ErrorOr<Result> benchmark(ByteString const& filename, int file_size, ByteBuffer&
     result.read_bps = (u64)(timer.elapsed_milliseconds() ? (file_size / timer.elapsed_milliseconds()) : file_size) * 1000;
     return result;
 }
+
+ErrorOr<void> benchmark_iops(ByteString const& device, size_t block_size, Vector<size_t> const& queue_depths, Duration time_per_benchmark)
+{
+    // NOTE: Reading from the raw block device bypasses the file system, so the reads are neither served
+    //       from the block cache nor serialized by an inode lock, and every one of them reaches the device.
+    int flags = O_RDONLY | O_DIRECT;
+    int fd = TRY(Core::System::open(device, flags));
+    u64 device_size = 0;
+    u64 device_block_size = 0;
+    TRY(Core::System::ioctl(fd, STORAGE_DEVICE_GET_SIZE, &device_size));
+    TRY(Core::System::ioctl(fd, STORAGE_DEVICE_GET_BLOCK_SIZE, &device_block_size));
+    TRY(Core::System::close(fd));
+
+    if (block_size == 0 || device_block_size == 0 || block_size % device_block_size != 0) {
+        warnln("Block size must be a multiple of the device block size ({})", device_block_size);
+        return Error::from_errno(EINVAL);
+    }
+    // NOTE: Storage devices transfer at most one page per read() call.
+    if (block_size > static_cast<size_t>(sysconf(_SC_PAGESIZE))) {
+        warnln("Block size must not be larger than the page size");
+        return Error::from_errno(EINVAL);
+    }
+    u64 block_count = device_size / block_size;
+    if (block_count == 0) {
+        warnln("Device must be at least one block large");
+        return Error::from_errno(EINVAL);
+    }
+
+    outln("Device: {} size={} block_size={}", device, device_size, block_size);
+
+    for (auto queue_depth : queue_depths) {
+        if (queue_depth == 0)
+            continue;
+
+        // NOTE: Every worker keeps exactly one synchronous read in flight, so the number of
+        //       workers is the number of requests the kernel can queue up for the device.
+        Atomic<bool> should_stop { false };
+        Atomic<u64> completed_reads { 0 };
+        Atomic<bool> failed { false };
+        Vector<NonnullRefPtr<Threading::Thread>> workers;
+        TRY(workers.try_ensure_capacity(queue_depth));
+
+        outln("Running: queue_depth={} block_size={}", queue_depth, block_size);
+        auto timer = Core::ElapsedTimer::start_new();
+        for (size_t i = 0; i < queue_depth; ++i) {
+            auto worker = TRY(Threading::Thread::try_create([&]() -> intptr_t {
+                auto worker_fd_or_error = Core::System::open(device, flags);
+                if (worker_fd_or_error.is_error()) {
+                    warnln("{}", worker_fd_or_error.release_error());
+                    failed = true;
+                    return 1;
+                }
+                int worker_fd = worker_fd_or_error.release_value();
+                auto worker_buffer_or_error = ByteBuffer::create_uninitialized(block_size);
+                if (worker_buffer_or_error.is_error()) {
+                    failed = true;
+                    (void)Core::System::close(worker_fd);
+                    return 1;
+                }
+                auto worker_buffer = worker_buffer_or_error.release_value();
+                while (!should_stop.load(AK::memory_order_relaxed)) {
+                    off_t offset = static_cast<off_t>(get_random_uniform_64(block_count)) * block_size;
+                    if (pread(worker_fd, worker_buffer.data(), block_size, offset) != static_cast<ssize_t>(block_size)) {
+                        perror("pread");
+                        failed = true;
+                        break;
+                    }
+                    completed_reads.fetch_add(1, AK::memory_order_relaxed);
+                }
+                (void)Core::System::close(worker_fd);
+                return 0;
+            },
+                "disk_benchmark"sv));
+            worker->start();
+            workers.unchecked_append(move(worker));
+        }
+
+        usleep(time_per_benchmark.to_microseconds());
+        should_stop = true;
+        for (auto& worker : workers)
+            (void)worker->join();
+
+        if (failed)
+            return Error::from_string_literal("Reading from the block device failed");
+
+        auto elapsed_milliseconds = max<i64>(timer.elapsed_milliseconds(), 1);
+        auto reads = completed_reads.load();
+        outln("Finished: queue_depth={} reads={} time={}ms iops={} read_bps={}", queue_depth, reads, elapsed_milliseconds, reads * 1000 / elapsed_milliseconds, reads * block_size * 1000 / elapsed_milliseconds);
+    }
+    return {};
+}
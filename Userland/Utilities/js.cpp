@@ -15,14 +15,17 @@
 #include <LibJS/Bytecode/BasicBlock.h>
 #include <LibJS/Bytecode/Generator.h>
 #include <LibJS/Bytecode/Interpreter.h>
+#include <LibJS/Bytecode/PassManager.h>
 #include <LibJS/Console.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
+#include <LibJS/JIT/Compiler.h>
 #include <LibJS/Parser.h>
 #include <LibJS/Print.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DeclarativeEnvironment.h>
 #include <LibJS/Runtime/GlobalEnvironment.h>
 #include <LibJS/Runtime/JSONObject.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/StringPrototype.h>
 #include <LibJS/Runtime/ValueInlines.h>
 #include <LibJS/SourceTextModule.h>
@@ -78,12 +81,26 @@ static bool s_as_module = false;
 static bool s_print_last_result = false;
 static bool s_strip_ansi = false;
 static bool s_disable_source_location_hints = false;
+static bool s_dump_inline_cache_statistics = false;
+static bool s_dump_gc_statistics = false;
+static bool s_dump_shape_statistics = false;
 static RefPtr<Line::Editor> s_editor;
 static String s_history_path = String {};
 static int s_repl_line_level = 0;
 static bool s_keep_running_repl = true;
 static int s_exit_code = 0;
 
+static void dump_shape_statistics()
+{
+    auto statistics = JS::Shape::gather_memory_statistics(g_vm->heap());
+    for (auto const& [realm, realm_statistics] : statistics) {
+        warnln("Shapes of realm {:p}:", realm);
+        warnln("  {} shapes ({} dictionaries), {} bytes", realm_statistics.shape_count, realm_statistics.dictionary_shape_count, realm_statistics.shape_bytes);
+        warnln("  {} property tables, {} bytes", realm_statistics.property_table_count, realm_statistics.property_table_bytes);
+        warnln("  {} bytes of transition tables", realm_statistics.transition_table_bytes);
+    }
+}
+
 static ErrorOr<void> print(JS::Value value, Stream& stream)
 {
     JS::PrintContext print_context { .vm = *g_vm, .stream = stream, .strip_ansi = s_strip_ansi };
@@ -544,11 +561,16 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     args_parser.set_general_help("This is a JavaScript interpreter.");
     args_parser.add_option(s_dump_ast, "Dump the AST", "dump-ast", 'A');
     args_parser.add_option(JS::Bytecode::g_dump_bytecode, "Dump the bytecode", "dump-bytecode", 'd');
+    args_parser.add_option(JS::Bytecode::g_optimize_bytecode, "Optimize the bytecode", "optimize-bytecode", 'p');
+    args_parser.add_option(JS::JIT::g_jit_enabled, "Compile hot bytecode to native code", "jit", 'j');
+    args_parser.add_option(s_dump_inline_cache_statistics, "Dump inline cache statistics on exit", "dump-inline-cache-stats", {});
     args_parser.add_option(s_as_module, "Treat as module", "as-module", 'm');
     args_parser.add_option(s_print_last_result, "Print last result", "print-last-result", 'l');
     args_parser.add_option(s_strip_ansi, "Disable ANSI colors", "disable-ansi-colors", 'i');
     args_parser.add_option(s_disable_source_location_hints, "Disable source location hints", "disable-source-location-hints", 'h');
     args_parser.add_option(gc_on_every_allocation, "GC on every allocation", "gc-on-every-allocation", 'g');
+    args_parser.add_option(s_dump_gc_statistics, "Dump garbage collection statistics on exit", "gc-stats", {});
+    args_parser.add_option(s_dump_shape_statistics, "Dump shape memory statistics on exit", "shape-stats", {});
     args_parser.add_option(disable_syntax_highlight, "Disable live syntax highlighting", "no-syntax-highlight", 's');
     args_parser.add_option(disable_debug_printing, "Disable debug output", "disable-debug-output", {});
     args_parser.add_option(evaluate_script, "Evaluate argument as a script", "evaluate", 'c', "script");
@@ -848,7 +870,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         // We resolve modules as if it is the first file
 
-        if (!TRY(parse_and_run(realm, builder.string_view(), source_name)))
+        auto result = TRY(parse_and_run(realm, builder.string_view(), source_name));
+        if (s_dump_inline_cache_statistics)
+            JS::Bytecode::g_inline_cache_statistics.dump();
+        if (s_dump_gc_statistics)
+            g_vm->heap().statistics().dump();
+        if (s_dump_shape_statistics)
+            dump_shape_statistics();
+        if (!result)
             return 1;
     }
 
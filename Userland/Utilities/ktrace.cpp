@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <Kernel/API/SyscallString.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <unistd.h>
+
+static constexpr StringView trace_categories_path = "/sys/kernel/conf/trace_categories"sv;
+static constexpr StringView trace_path = "/sys/kernel/trace"sv;
+
+// NOTE: Per-CPU scheduler lanes are placed in a synthetic process so they don't collide with real PIDs.
+static constexpr i64 cpu_lanes_pid = -1;
+
+class ChromeTraceWriter {
+public:
+    void add_event(JsonObject const& event)
+    {
+        auto type = event.get_byte_string("type"sv).value_or({});
+        auto cpu = event.get_u32("cpu"sv).value_or(0);
+        auto timestamp_us = static_cast<double>(event.get_u64("timestamp"sv).value_or(0)) / 1000.0;
+        auto pid = event.get_u32("pid"sv).value_or(0);
+        auto tid = event.get_u32("tid"sv).value_or(0);
+        auto arg1 = event.get_u64("arg1"sv).value_or(0);
+        auto arg2 = event.get_u64("arg2"sv).value_or(0);
+
+        JsonObject trace_event;
+        trace_event.set("ts", timestamp_us);
+        trace_event.set("pid", pid);
+        trace_event.set("tid", tid);
+
+        if (type == "context_switch"sv) {
+            m_seen_cpus.set(cpu);
+            if (auto previous = m_running_on_cpu.get(cpu); previous.has_value()) {
+                JsonObject slice;
+                slice.set("name", ByteString::formatted("{} ({})", previous->tid, previous->pid));
+                slice.set("cat", "scheduler");
+                slice.set("ph", "X");
+                slice.set("ts", previous->since_us);
+                slice.set("dur", timestamp_us - previous->since_us);
+                slice.set("pid", cpu_lanes_pid);
+                slice.set("tid", cpu);
+                m_events.must_append(move(slice));
+            }
+            m_running_on_cpu.set(cpu, { timestamp_us, static_cast<u32>(arg1), static_cast<u32>(arg2) });
+            return;
+        }
+
+        if (type == "syscall_enter"sv || type == "syscall_exit"sv) {
+            auto function = static_cast<Syscall::Function>(arg1);
+            trace_event.set("name", arg1 < Syscall::Function::__Count ? Syscall::to_string(function) : "Unknown"sv);
+            trace_event.set("cat", "syscall");
+            if (type == "syscall_enter"sv) {
+                trace_event.set("ph", "B");
+            } else {
+                trace_event.set("ph", "E");
+                JsonObject args;
+                args.set("result", static_cast<i64>(arg2));
+                trace_event.set("args", move(args));
+            }
+        } else if (type == "page_fault"sv) {
+            trace_event.set("name", "page_fault");
+            trace_event.set("cat", "page_fault");
+            trace_event.set("ph", "i");
+            trace_event.set("s", "t");
+            JsonObject args;
+            args.set("address", ByteString::formatted("{:p}", arg1));
+            args.set("ip", ByteString::formatted("{:p}", arg2));
+            trace_event.set("args", move(args));
+        } else if (type == "block_read_start"sv || type == "block_write_start"sv) {
+            auto name = type == "block_read_start"sv ? "read"sv : "write"sv;
+            m_pending_block_requests.set(arg1, name);
+            trace_event.set("name", name);
+            trace_event.set("cat", "block_io");
+            trace_event.set("ph", "b");
+            trace_event.set("id", ByteString::formatted("{:p}", arg1));
+            JsonObject args;
+            args.set("blocks", arg2);
+            trace_event.set("args", move(args));
+        } else if (type == "block_request_complete"sv) {
+            auto name = m_pending_block_requests.take(arg1);
+            if (!name.has_value())
+                return;
+            trace_event.set("name", *name);
+            trace_event.set("cat", "block_io");
+            trace_event.set("ph", "e");
+            trace_event.set("id", ByteString::formatted("{:p}", arg1));
+            JsonObject args;
+            args.set("result", arg2);
+            trace_event.set("args", move(args));
+        } else if (type == "packet_receive"sv || type == "packet_transmit"sv) {
+            trace_event.set("name", type == "packet_receive"sv ? "rx"sv : "tx"sv);
+            trace_event.set("cat", "network");
+            trace_event.set("ph", "i");
+            trace_event.set("s", "t");
+            JsonObject args;
+            args.set("size", arg1);
+            trace_event.set("args", move(args));
+        } else {
+            return;
+        }
+        m_events.must_append(move(trace_event));
+    }
+
+    ByteString finish()
+    {
+        auto add_metadata = [&](StringView name, i64 pid, Optional<u32> tid, ByteString value) {
+            JsonObject metadata;
+            metadata.set("name", name);
+            metadata.set("ph", "M");
+            metadata.set("pid", pid);
+            if (tid.has_value())
+                metadata.set("tid", *tid);
+            JsonObject args;
+            args.set("name", move(value));
+            metadata.set("args", move(args));
+            m_events.must_append(move(metadata));
+        };
+        add_metadata("process_name"sv, cpu_lanes_pid, {}, "CPUs");
+        for (auto cpu : m_seen_cpus)
+            add_metadata("thread_name"sv, cpu_lanes_pid, cpu, ByteString::formatted("CPU {}", cpu));
+
+        JsonObject trace;
+        trace.set("traceEvents", move(m_events));
+        trace.set("displayTimeUnit", "ns");
+        return trace.to_byte_string();
+    }
+
+private:
+    struct RunningThread {
+        double since_us { 0 };
+        u32 pid { 0 };
+        u32 tid { 0 };
+    };
+
+    JsonArray m_events;
+    HashMap<u32, RunningThread> m_running_on_cpu;
+    HashTable<u32> m_seen_cpus;
+    HashMap<u64, StringView> m_pending_block_requests;
+};
+
+static ErrorOr<void> set_trace_categories(StringView categories)
+{
+    auto file = TRY(Core::File::open(trace_categories_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_until_depleted(categories.bytes()));
+    return {};
+}
+
+static ErrorOr<u64> drain_trace(ChromeTraceWriter& writer)
+{
+    auto file = TRY(Core::File::open(trace_path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    auto json = TRY(JsonValue::from_string(contents));
+    auto const& object = json.as_object();
+    if (auto events = object.get_array("events"sv); events.has_value()) {
+        events->for_each([&](JsonValue const& event) {
+            writer.add_event(event.as_object());
+        });
+    }
+    return object.get_u64("lost_events"sv).value_or(0);
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    StringView categories = "all"sv;
+    StringView output_path = "trace.json"sv;
+    u32 duration_in_seconds = 5;
+    u32 poll_interval_in_ms = 100;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Record kernel tracepoints and write them out in the Chrome trace event format.");
+    args_parser.add_option(categories, "Comma-separated tracepoint categories to enable (scheduler, page_fault, syscall, block_io, network or all)", "categories", 'c', "categories");
+    args_parser.add_option(output_path, "Path to write the trace to", "output", 'o', "path");
+    args_parser.add_option(duration_in_seconds, "Number of seconds to record for", "duration", 'd', "seconds");
+    args_parser.add_option(poll_interval_in_ms, "How often to drain the kernel trace buffers", "interval", 'i', "milliseconds");
+    args_parser.parse(arguments);
+
+    TRY(Core::System::pledge("stdio rpath wpath cpath"));
+
+    auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+
+    TRY(set_trace_categories(categories));
+
+    ChromeTraceWriter writer;
+    u64 lost_events = 0;
+    auto timer = Core::ElapsedTimer::start_new();
+    auto result = [&]() -> ErrorOr<void> {
+        while (timer.elapsed_milliseconds() < static_cast<i64>(duration_in_seconds) * 1000) {
+            usleep(poll_interval_in_ms * 1000);
+            lost_events += TRY(drain_trace(writer));
+        }
+        return {};
+    }();
+
+    TRY(set_trace_categories("none"sv));
+    TRY(result);
+    lost_events += TRY(drain_trace(writer));
+
+    auto trace = writer.finish();
+    TRY(output_file->write_until_depleted(trace.bytes()));
+
+    if (lost_events > 0)
+        warnln("ktrace: {} events were lost, try a shorter poll interval", lost_events);
+    return 0;
+}
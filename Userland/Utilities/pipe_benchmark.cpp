@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024, the SerenityOS developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/NumberFormat.h>
+#include <AK/Vector.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/ElapsedTimer.h>
+#include <LibCore/System.h>
+#include <LibMain/Main.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+static ErrorOr<u64> run_benchmark(size_t pipe_size, size_t block_size, size_t total_size)
+{
+    auto fds = TRY(Core::System::pipe2(0));
+    auto actual_pipe_size = TRY(Core::System::fcntl(fds[1], F_SETPIPE_SZ, pipe_size));
+    if (static_cast<size_t>(actual_pipe_size) != pipe_size)
+        warnln("Pipe size {} was rounded up to {}", pipe_size, actual_pipe_size);
+
+    auto buffer = TRY(ByteBuffer::create_zeroed(block_size));
+
+    auto pid = TRY(Core::System::fork());
+    if (pid == 0) {
+        TRY(Core::System::close(fds[0]));
+        for (size_t total_written = 0; total_written < total_size;) {
+            auto chunk = buffer.bytes().trim(total_size - total_written);
+            total_written += TRY(Core::System::write(fds[1], chunk));
+        }
+        TRY(Core::System::close(fds[1]));
+        _exit(0);
+    }
+
+    TRY(Core::System::close(fds[1]));
+    auto timer = Core::ElapsedTimer::start_new();
+    size_t total_read = 0;
+    while (true) {
+        auto nread = TRY(Core::System::read(fds[0], buffer));
+        if (nread == 0)
+            break;
+        total_read += nread;
+    }
+    auto elapsed_ms = timer.elapsed_milliseconds();
+    TRY(Core::System::close(fds[0]));
+    (void)TRY(Core::System::waitpid(pid));
+
+    if (total_read != total_size)
+        warnln("Only read {} out of {} bytes", total_read, total_size);
+    return elapsed_ms > 0 ? total_read * 1000 / elapsed_ms : total_read * 1000;
+}
+
+ErrorOr<int> serenity_main(Main::Arguments arguments)
+{
+    Vector<size_t> pipe_sizes;
+    Vector<size_t> block_sizes;
+    size_t total_size = 256 * MiB;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Measure pipe throughput between two processes for various pipe buffer and transfer sizes.");
+    args_parser.add_option(pipe_sizes, "A comma-separated list of pipe buffer sizes", "pipe-size", 'p', "pipe-size");
+    args_parser.add_option(block_sizes, "A comma-separated list of read/write sizes", "block-size", 'b', "block-size");
+    args_parser.add_option(total_size, "Number of bytes to transfer per run", "total-size", 's', "bytes");
+    args_parser.parse(arguments);
+
+    if (pipe_sizes.is_empty())
+        pipe_sizes = { 4096, 16384, 65536, 262144, 1048576 };
+    if (block_sizes.is_empty())
+        block_sizes = { 512, 4096, 65536 };
+
+    for (auto pipe_size : pipe_sizes) {
+        for (auto block_size : block_sizes) {
+            auto bytes_per_second = TRY(run_benchmark(pipe_size, block_size, total_size));
+            outln("pipe_size={} block_size={} throughput={}/s", pipe_size, block_size, human_readable_size(bytes_per_second));
+        }
+    }
+    return 0;
+}
@@ -7,12 +7,26 @@
 #include <LibCore/ArgsParser.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
+#include <errno.h>
 #include <serenity.h>
 #include <stdio.h>
 #include <stdlib.h>
 
 static Optional<pid_t> determine_pid_to_profile(StringView pid_argument, bool all_processes);
 
+static ErrorOr<void> enable_profiling(pid_t pid, u64 event_mask)
+{
+    auto result = Core::System::profiling_enable(pid, event_mask);
+    if (!result.is_error() || result.error().code() != ENOTSUP || (event_mask & PERF_EVENT_MASK_HARDWARE_COUNTERS) == 0)
+        return result;
+
+    // NOTE: Many CPUs (and most emulators) don't give us usable performance counters, fall back to timer samples.
+    warnln("Hardware performance counters are not available, falling back to timer-based sampling.");
+    event_mask &= ~PERF_EVENT_MASK_HARDWARE_COUNTERS;
+    event_mask |= PERF_EVENT_SAMPLE;
+    return Core::System::profiling_enable(pid, event_mask);
+}
+
 ErrorOr<int> serenity_main(Main::Arguments arguments)
 {
     Core::ArgsParser args_parser;
@@ -54,6 +68,14 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
                 event_mask |= PERF_EVENT_SYSCALL;
             else if (event_type == "filesystem")
                 event_mask |= PERF_EVENT_FILESYSTEM;
+            else if (event_type == "cpu_cycles")
+                event_mask |= PERF_EVENT_CPU_CYCLES;
+            else if (event_type == "instructions")
+                event_mask |= PERF_EVENT_INSTRUCTIONS;
+            else if (event_type == "cache_misses")
+                event_mask |= PERF_EVENT_CACHE_MISSES;
+            else if (event_type == "branch_misses")
+                event_mask |= PERF_EVENT_BRANCH_MISSES;
             else {
                 warnln("Unknown event type '{}' specified.", event_type);
                 exit(1);
@@ -66,6 +88,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     auto print_types = [] {
         outln();
         outln("Event type can be one of: sample, context_switch, page_fault, syscall, filesystem, kmalloc and kfree.");
+        outln("Hardware counter event types (if supported by the CPU): cpu_cycles, instructions, cache_misses and branch_misses.");
     };
 
     if (!args_parser.parse(arguments, Core::ArgsParser::FailureBehavior::PrintUsage)) {
@@ -96,7 +119,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
 
         pid_t pid = pid_opt.value();
         if (wait || enable) {
-            TRY(Core::System::profiling_enable(pid, event_mask));
+            TRY(enable_profiling(pid, event_mask));
 
             if (!wait)
                 return 0;
@@ -117,7 +140,7 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     }
 
     dbgln("Enabling profiling for PID {}", getpid());
-    TRY(Core::System::profiling_enable(getpid(), event_mask));
+    TRY(enable_profiling(getpid(), event_mask));
     TRY(Core::System::exec(command[0], command, Core::System::SearchInPath::Yes));
 
     return 0;